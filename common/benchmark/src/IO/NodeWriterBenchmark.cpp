@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "IO/NodeWriter.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+constexpr size_t NumWorldBrushes = 50'000;
+constexpr size_t NumEntities = 1'000;
+constexpr size_t NumBrushesPerEntity = 10;
+
+/**
+ * Counts and discards the characters written to it, so that only the time spent
+ * serializing is measured.
+ */
+class CountingStreamBuf : public std::streambuf
+{
+private:
+  size_t m_count = 0;
+
+public:
+  size_t count() const { return m_count; }
+
+protected:
+  int_type overflow(const int_type c) override
+  {
+    ++m_count;
+    return c;
+  }
+
+  std::streamsize xsputn(const char*, const std::streamsize count) override
+  {
+    m_count += static_cast<size_t>(count);
+    return count;
+  }
+};
+
+Model::BrushNode* makeBrushNode(Model::BrushBuilder& builder, const size_t i)
+{
+  const auto min = vm::vec3{
+    double(i % 64) * 64.0, double((i / 64) % 64) * 64.0, double(i / 4096) * 64.0};
+  const auto bounds = vm::bbox3{min, min + vm::vec3{32.0, 32.0, 32.0}};
+  return new Model::BrushNode{
+    builder.createCuboid(bounds, "texture" + std::to_string(i % 16)).value()};
+}
+
+void makeWorld(Model::WorldNode& worldNode)
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  auto builder = Model::BrushBuilder{worldNode.mapFormat(), worldBounds};
+
+  for (size_t i = 0; i < NumWorldBrushes; ++i)
+  {
+    worldNode.defaultLayer()->addChild(makeBrushNode(builder, i));
+  }
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    auto* entityNode = new Model::EntityNode{Model::Entity{
+      {}, {{"classname", "func_detail"}, {"targetname", std::to_string(i)}}}};
+    for (size_t j = 0; j < NumBrushesPerEntity; ++j)
+    {
+      entityNode->addChild(makeBrushNode(builder, i * NumBrushesPerEntity + j));
+    }
+    worldNode.defaultLayer()->addChild(entityNode);
+  }
+}
+} // namespace
+
+TEST_CASE("NodeWriterBenchmark.writeMap")
+{
+  auto worldNode = Model::WorldNode{{}, {}, Model::MapFormat::Valve};
+  makeWorld(worldNode);
+
+  auto streamBuf = CountingStreamBuf{};
+  auto stream = std::ostream{&streamBuf};
+  timeLambda(
+    [&]() {
+      auto writer = NodeWriter{worldNode, stream};
+      writer.writeMap();
+    },
+    "write map with "
+      + std::to_string(NumWorldBrushes + NumEntities * NumBrushesPerEntity)
+      + " brushes");
+
+  auto stringStream = std::stringstream{};
+  timeLambda(
+    [&]() {
+      auto writer = NodeWriter{worldNode, stringStream};
+      writer.writeMap();
+    },
+    "write map with "
+      + std::to_string(NumWorldBrushes + NumEntities * NumBrushesPerEntity)
+      + " brushes to string");
+
+  CHECK(streamBuf.count() == stringStream.str().size());
+}
+} // namespace TrenchBroom::IO
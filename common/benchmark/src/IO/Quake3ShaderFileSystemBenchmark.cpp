@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "IO/File.h"
+#include "IO/ImageFileSystem.h"
+#include "IO/PathInfo.h"
+#include "IO/Quake3ShaderFileSystem.h"
+#include "IO/VirtualFileSystem.h"
+#include "Logger.h"
+
+#include "kdl/result.h"
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+constexpr size_t NumShaderFiles = 200;
+constexpr size_t NumShadersPerFile = 50;
+constexpr size_t NumImages = 15'000;
+
+std::shared_ptr<File> makeFile(const std::string& contents)
+{
+  auto buffer = std::make_unique<char[]>(contents.size());
+  std::memcpy(buffer.get(), contents.data(), contents.size());
+  return std::make_shared<OwningBufferFile>(std::move(buffer), contents.size());
+}
+
+std::string shaderName(const size_t index)
+{
+  return "textures/set" + std::to_string(index % NumShaderFiles) + "/shader"
+         + std::to_string(index);
+}
+
+/**
+ * Contains NumShaderFiles shader scripts with NumShadersPerFile shaders each, and
+ * NumImages images. Two thirds of the shaders have a corresponding image.
+ */
+class SyntheticShaderFileSystem : public ImageFileSystemBase
+{
+private:
+  Result<void> doReadDirectory() override
+  {
+    const auto emptyFile = makeFile("");
+
+    for (size_t i = 0; i < NumShaderFiles; ++i)
+    {
+      auto script = std::string{};
+      for (size_t j = 0; j < NumShadersPerFile; ++j)
+      {
+        const auto name = shaderName(i * NumShadersPerFile + j);
+        script += name + "\n{\n  qer_editorimage " + name
+                  + ".tga\n  surfaceparm nolightmap\n  {\n    map " + name
+                  + ".tga\n    blendFunc GL_ONE GL_ZERO\n  }\n}\n\n";
+      }
+
+      auto file = makeFile(script);
+      addFile(
+        "scripts/shaders" + std::to_string(i) + ".shader",
+        [file = std::move(file)]() -> Result<std::shared_ptr<File>> { return file; });
+    }
+
+    for (size_t i = 0; i < NumImages; ++i)
+    {
+      const auto name = i % 3 == 2 ? shaderName(i) + "_image" : shaderName(i);
+      addFile(
+        name + ".tga", [=]() -> Result<std::shared_ptr<File>> { return emptyFile; });
+    }
+
+    return kdl::void_success;
+  }
+};
+} // namespace
+
+TEST_CASE("Quake3ShaderFileSystemBenchmark.loadAndLinkShaders")
+{
+  auto logger = NullLogger{};
+
+  auto fs = VirtualFileSystem{};
+  fs.mount("", createImageFileSystem<SyntheticShaderFileSystem>().value());
+
+  timeLambda(
+    [&]() {
+      fs.mount(
+        "",
+        createImageFileSystem<Quake3ShaderFileSystem>(
+          fs,
+          "scripts",
+          std::vector<std::filesystem::path>{"textures"},
+          logger)
+          .value());
+    },
+    "load " + std::to_string(NumShaderFiles * NumShadersPerFile)
+      + " shaders and link them with " + std::to_string(NumImages) + " images");
+
+  CHECK(fs.pathInfo("textures/set0/shader0") == PathInfo::File);
+  CHECK(fs.pathInfo("textures/set2/shader2_image") == PathInfo::File);
+  CHECK(fs.pathInfo("textures/set2/shader2") == PathInfo::File);
+  CHECK(fs.pathInfo("textures/set1/shader14001") == PathInfo::File);
+}
+
+} // namespace TrenchBroom::IO
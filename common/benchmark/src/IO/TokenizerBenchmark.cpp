@@ -0,0 +1,227 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "IO/StandardMapParser.h"
+#include "IO/TestParserStatus.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/EntityProperties.h"
+#include "Model/MapFormat.h"
+
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+// counts all allocations made through the global operator new so that the benchmarks can
+// report the number of allocations per parsed brush face
+std::atomic<size_t> allocationCount = 0;
+} // namespace
+
+void* operator new(const std::size_t size)
+{
+  ++allocationCount;
+  if (auto* ptr = std::malloc(size > 0 ? size : 1))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+constexpr size_t NumBrushes = 50'000;
+constexpr size_t NumFaces = NumBrushes * 6;
+
+std::string makeMap()
+{
+  auto str = std::string{"{\n\"classname\" \"worldspawn\"\n"};
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    const auto x = double(i % 64) * 64.0;
+    const auto y = double((i / 64) % 64) * 64.0;
+    const auto z = double(i / 4096) * 64.0;
+
+    // alternate between short texture names and long ones that don't fit into the small
+    // string buffer
+    const auto* textureName = i % 2 == 0 ? "tex" : "base_wall/concrete_dark_trim";
+
+    str += fmt::format(
+      R"({{
+( {0} {1} {2} ) ( {0} {1} {5} ) ( {3} {1} {2} ) {6} 0 0 0 1 1
+( {0} {1} {2} ) ( {0} {4} {2} ) ( {0} {1} {5} ) {6} 0 0 0 1 1
+( {0} {1} {2} ) ( {3} {1} {2} ) ( {0} {4} {2} ) {6} 0 0 0 1 1
+( {3} {4} {5} ) ( {0} {4} {5} ) ( {3} {4} {2} ) {6} 0 0 0 1 1
+( {3} {4} {5} ) ( {3} {4} {2} ) ( {3} {1} {5} ) {6} 0 0 0 1 1
+( {3} {4} {5} ) ( {3} {1} {5} ) ( {0} {4} {5} ) {6} 0 0 0 1 1
+}}
+)",
+      x,
+      y,
+      z,
+      x + 32.5,
+      y + 32.5,
+      z + 32.5,
+      textureName);
+  }
+  str += "}\n";
+  return str;
+}
+
+/**
+ * Parses a map without creating any nodes, so that only the cost of tokenizing and
+ * converting the token values is measured.
+ */
+class NullMapParser : public StandardMapParser
+{
+private:
+  size_t m_faceCount = 0;
+
+public:
+  explicit NullMapParser(std::string_view str)
+    : StandardMapParser{str, Model::MapFormat::Standard, Model::MapFormat::Standard}
+  {
+  }
+
+  using StandardMapParser::parseEntities;
+
+  size_t faceCount() const { return m_faceCount; }
+
+private:
+  void onBeginEntity(size_t, std::vector<Model::EntityProperty>, ParserStatus&) override
+  {
+  }
+  void onEndEntity(size_t, size_t, ParserStatus&) override {}
+  void onBeginBrush(size_t, ParserStatus&) override {}
+  void onEndBrush(size_t, size_t, ParserStatus&) override {}
+  void onStandardBrushFace(
+    size_t,
+    Model::MapFormat,
+    const vm::vec3&,
+    const vm::vec3&,
+    const vm::vec3&,
+    Model::BrushFaceAttributes,
+    ParserStatus&) override
+  {
+    ++m_faceCount;
+  }
+  void onValveBrushFace(
+    size_t,
+    Model::MapFormat,
+    const vm::vec3&,
+    const vm::vec3&,
+    const vm::vec3&,
+    Model::BrushFaceAttributes,
+    const vm::vec3&,
+    const vm::vec3&,
+    ParserStatus&) override
+  {
+    ++m_faceCount;
+  }
+  void onPatch(
+    size_t,
+    size_t,
+    Model::MapFormat,
+    size_t,
+    size_t,
+    std::vector<vm::vec<FloatType, 5>>,
+    std::string,
+    ParserStatus&) override
+  {
+  }
+};
+} // namespace
+
+TEST_CASE("TokenizerBenchmark.tokenizeMap")
+{
+  const auto str = makeMap();
+
+  auto tokenCount = size_t(0);
+  auto sum = 0.0;
+  const auto allocationsBefore = allocationCount.load();
+
+  timeLambda(
+    [&]() {
+      auto tokenizer = QuakeMapTokenizer{str};
+      for (auto token = tokenizer.nextToken(); !token.hasType(QuakeMapToken::Eof);
+           token = tokenizer.nextToken())
+      {
+        if (token.hasType(QuakeMapToken::Number))
+        {
+          sum += token.toFloat<double>();
+        }
+        ++tokenCount;
+      }
+    },
+    fmt::format("tokenize {} bytes", str.size()));
+
+  const auto allocations = allocationCount.load() - allocationsBefore;
+  printf(
+    "%zu tokens, %zu allocations (%.2f per face)\n",
+    tokenCount,
+    allocations,
+    double(allocations) / double(NumFaces));
+
+  CHECK(sum > 0.0);
+}
+
+TEST_CASE("TokenizerBenchmark.parseMap")
+{
+  const auto str = makeMap();
+
+  auto status = TestParserStatus{};
+  auto parser = NullMapParser{str};
+  const auto allocationsBefore = allocationCount.load();
+
+  timeLambda(
+    [&]() { parser.parseEntities(status); }, fmt::format("parse {} bytes", str.size()));
+
+  const auto allocations = allocationCount.load() - allocationsBefore;
+  printf(
+    "%zu faces, %zu allocations (%.2f per face)\n",
+    parser.faceCount(),
+    allocations,
+    double(allocations) / double(parser.faceCount()));
+
+  CHECK(parser.faceCount() == NumFaces);
+}
+} // namespace IO
+} // namespace TrenchBroom
@@ -0,0 +1,129 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include "vm/bbox.h"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+constexpr size_t NumWorldBrushes = 20'000;
+constexpr size_t NumEntities = 500;
+constexpr size_t NumBrushesPerEntity = 10;
+
+void appendBrush(std::string& str, const size_t i)
+{
+  const auto x = double(i % 64) * 64.0;
+  const auto y = double((i / 64) % 64) * 64.0;
+  const auto z = double(i / 4096) * 64.0;
+
+  str += fmt::format(
+    R"({{
+( {0} {1} {2} ) ( {0} {1} {5} ) ( {3} {1} {2} ) tex1 0 0 0 1 1
+( {0} {1} {2} ) ( {0} {4} {2} ) ( {0} {1} {5} ) tex2 0 0 0 1 1
+( {0} {1} {2} ) ( {3} {1} {2} ) ( {0} {4} {2} ) tex3 0 0 0 1 1
+( {3} {4} {5} ) ( {0} {4} {5} ) ( {3} {4} {2} ) tex4 0 0 0 1 1
+( {3} {4} {5} ) ( {3} {4} {2} ) ( {3} {1} {5} ) tex5 0 0 0 1 1
+( {3} {4} {5} ) ( {3} {1} {5} ) ( {0} {4} {5} ) tex6 0 0 0 1 1
+}}
+)",
+    x,
+    y,
+    z,
+    x + 32.0,
+    y + 32.0,
+    z + 32.0);
+}
+
+std::string makeMap()
+{
+  auto str = std::string{"{\n\"classname\" \"worldspawn\"\n"};
+  for (size_t i = 0; i < NumWorldBrushes; ++i)
+  {
+    appendBrush(str, i);
+  }
+  str += "}\n";
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    str += fmt::format("{{\n\"classname\" \"func_wall\"\n\"targetname\" \"wall{}\"\n", i);
+    for (size_t j = 0; j < NumBrushesPerEntity; ++j)
+    {
+      appendBrush(str, i * NumBrushesPerEntity + j);
+    }
+    str += "}\n";
+  }
+
+  return str;
+}
+
+double readMap(const std::string& str, const size_t parserChunkCount)
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  auto status = TestParserStatus{};
+
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  auto reader = WorldReader{str, Model::MapFormat::Standard, {}};
+  reader.setParserChunkCount(parserChunkCount);
+  auto worldNode = reader.read(worldBounds, status);
+
+  const auto end = std::chrono::high_resolution_clock::now();
+
+  REQUIRE(worldNode != nullptr);
+  return std::chrono::duration<double>(end - start).count() * 1000.0;
+}
+} // namespace
+
+TEST_CASE("WorldReaderBenchmark.readInChunks")
+{
+  const auto str = makeMap();
+  const auto maxChunkCount =
+    std::max(size_t(std::thread::hardware_concurrency()), size_t(1)) * 4;
+
+  printf("Reading a map of %zu bytes\n", str.size());
+
+  const auto sequentialTime = readMap(str, 1);
+  printf("1 chunk: %fms\n", sequentialTime);
+
+  for (size_t chunkCount = 2; chunkCount <= maxChunkCount; chunkCount *= 2)
+  {
+    const auto time = readMap(str, chunkCount);
+    printf(
+      "%zu chunks: %fms (speed-up %.2fx)\n", chunkCount, time, sequentialTime / time);
+  }
+}
+} // namespace IO
+} // namespace TrenchBroom
@@ -0,0 +1,178 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+#include "Model/Polyhedron3.h"
+
+#include "kdl/parallel.h"
+#include "kdl/result.h"
+#include "kdl/result_fold.h"
+#include "kdl/vector_utils.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr auto Format = MapFormat::Standard;
+const auto WorldBounds = vm::bbox3{8192.0};
+
+constexpr size_t GridSize = 10;
+constexpr auto BrushSize = 128.0;
+
+/**
+ * Returns GridSize * GridSize * GridSize cubes of size BrushSize which are placed on a
+ * regular grid so that neighbouring cubes touch.
+ */
+std::vector<Brush> makeBrushGrid(const std::string& textureName)
+{
+  const auto builder = BrushBuilder{Format, WorldBounds};
+
+  auto result = std::vector<Brush>{};
+  result.reserve(GridSize * GridSize * GridSize);
+
+  for (size_t x = 0; x < GridSize; ++x)
+  {
+    for (size_t y = 0; y < GridSize; ++y)
+    {
+      for (size_t z = 0; z < GridSize; ++z)
+      {
+        const auto min = vm::vec3{double(x), double(y), double(z)} * BrushSize;
+        result.push_back(builder
+                           .createCuboid(
+                             vm::bbox3{min, min + vm::vec3::fill(BrushSize)}, textureName)
+                           .value());
+      }
+    }
+  }
+
+  return result;
+}
+} // namespace
+
+TEST_CASE("CsgBenchmark.subtract")
+{
+  const auto minuends = makeBrushGrid("minuend");
+
+  // a few long beams that cut through the grid along each axis
+  const auto builder = BrushBuilder{Format, WorldBounds};
+  const auto length = double(GridSize) * BrushSize;
+  auto subtrahendBrushes = std::vector<Brush>{};
+  for (size_t i = 0; i < GridSize; i += 2)
+  {
+    const auto offset = double(i) * BrushSize + BrushSize / 4.0;
+    const auto width = BrushSize / 2.0;
+    subtrahendBrushes.push_back(
+      builder
+        .createCuboid(
+          vm::bbox3{{0.0, offset, offset}, {length, offset + width, offset + width}},
+          "subtrahend")
+        .value());
+    subtrahendBrushes.push_back(
+      builder
+        .createCuboid(
+          vm::bbox3{{offset, 0.0, offset}, {offset + width, length, offset + width}},
+          "subtrahend")
+        .value());
+    subtrahendBrushes.push_back(
+      builder
+        .createCuboid(
+          vm::bbox3{{offset, offset, 0.0}, {offset + width, offset + width, length}},
+          "subtrahend")
+        .value());
+  }
+
+  const auto subtrahends =
+    kdl::vec_transform(subtrahendBrushes, [](const auto& brush) { return &brush; });
+
+  const auto subtract = [&](const Brush& minuend) {
+    return kdl::fold_results(
+      minuend.subtract(Format, WorldBounds, "texture", subtrahends));
+  };
+
+  auto results = std::vector<Result<std::vector<Brush>>>{};
+  timeLambda(
+    [&]() { results = kdl::vec_transform(minuends, subtract); },
+    "subtract " + std::to_string(subtrahends.size()) + " brushes from "
+      + std::to_string(minuends.size()) + " brushes");
+  CHECK(kdl::fold_results(std::move(results)).is_success());
+
+  timeLambda(
+    [&]() { results = kdl::vec_parallel_transform(minuends, subtract); },
+    "subtract " + std::to_string(subtrahends.size()) + " brushes from "
+      + std::to_string(minuends.size()) + " brushes in parallel");
+  CHECK(kdl::fold_results(std::move(results)).is_success());
+}
+
+TEST_CASE("CsgBenchmark.hollow")
+{
+  const auto brushes = makeBrushGrid("texture");
+
+  const auto hollow = [&](const Brush& brush) {
+    auto shrunkenBrush = brush;
+    return shrunkenBrush.expand(WorldBounds, -16.0, true).and_then([&]() {
+      return kdl::fold_results(
+        brush.subtract(Format, WorldBounds, "texture", shrunkenBrush));
+    });
+  };
+
+  auto results = std::vector<Result<std::vector<Brush>>>{};
+  timeLambda(
+    [&]() { results = kdl::vec_transform(brushes, hollow); },
+    "hollow " + std::to_string(brushes.size()) + " brushes");
+  CHECK(kdl::fold_results(std::move(results)).is_success());
+}
+
+TEST_CASE("CsgBenchmark.convexMerge")
+{
+  const auto brushes = makeBrushGrid("texture");
+
+  auto result = Result<Brush>{Error{"not merged"}};
+  timeLambda(
+    [&]() {
+      auto points = std::vector<vm::vec3>{};
+      for (const auto& brush : brushes)
+      {
+        for (const auto* vertex : brush.vertices())
+        {
+          points.push_back(vertex->position());
+        }
+      }
+
+      const auto polyhedron = Polyhedron3{std::move(points)};
+      const auto builder = BrushBuilder{Format, WorldBounds};
+      result = builder.createBrush(polyhedron, "texture").transform([&](auto brush) {
+        brush.cloneFaceAttributesFrom(
+          kdl::vec_transform(brushes, [](const auto& b) { return &b; }));
+        return brush;
+      });
+    },
+    "merge " + std::to_string(brushes.size()) + " brushes");
+  CHECK(result.is_success());
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityNodeIndex.h"
+#include "Model/EntityProperties.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumEntities = 20'000;
+constexpr size_t NumQueries = 10'000;
+
+/**
+ * Creates NumEntities entities that form a chain of target / targetname links, similar
+ * to what is found in large maps.
+ */
+std::vector<std::unique_ptr<EntityNode>> makeEntities()
+{
+  const auto classnames = std::vector<std::string>{
+    "func_door", "trigger_once", "light", "info_notnull", "func_button"};
+
+  auto result = std::vector<std::unique_ptr<EntityNode>>{};
+  result.reserve(NumEntities);
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    result.push_back(std::make_unique<EntityNode>(
+      EntityPropertyConfig{},
+      std::initializer_list<EntityProperty>{
+        {EntityPropertyKeys::Classname, classnames[i % classnames.size()]},
+        {EntityPropertyKeys::Origin, std::to_string(i) + " 0 0"},
+        {EntityPropertyKeys::Targetname, "t" + std::to_string(i)},
+        {EntityPropertyKeys::Target, "t" + std::to_string(i + 1)},
+        {"spawnflags", std::to_string(i % 8)},
+      }));
+  }
+
+  return result;
+}
+
+std::vector<EntityNodeBase*> getNodes(
+  const std::vector<std::unique_ptr<EntityNode>>& entityNodes)
+{
+  auto result = std::vector<EntityNodeBase*>{};
+  result.reserve(entityNodes.size());
+  for (const auto& entityNode : entityNodes)
+  {
+    result.push_back(entityNode.get());
+  }
+  return result;
+}
+
+size_t findTargets(const EntityNodeIndex& index)
+{
+  auto count = size_t(0);
+  for (size_t i = 0; i < NumQueries; ++i)
+  {
+    count += index
+               .findEntityNodes(
+                 EntityNodeIndexQuery::exact(EntityPropertyKeys::Targetname),
+                 "t" + std::to_string((i * 7) % NumEntities))
+               .size();
+  }
+  return count;
+}
+
+} // namespace
+
+TEST_CASE("EntityNodeIndexBenchmark.buildAndQuery")
+{
+  const auto entityNodes = makeEntities();
+  const auto nodes = getNodes(entityNodes);
+
+  auto insertedIndex = EntityNodeIndex{};
+  timeLambda(
+    [&]() {
+      for (auto* node : nodes)
+      {
+        insertedIndex.addEntityNode(node);
+      }
+    },
+    "add " + std::to_string(nodes.size()) + " entities to the index one by one");
+
+  auto builtIndex = EntityNodeIndex{};
+  timeLambda(
+    [&]() { builtIndex.rebuild(nodes); },
+    "build the index from " + std::to_string(nodes.size()) + " entities");
+
+  auto insertedCount = size_t(0);
+  timeLambda(
+    [&]() { insertedCount = findTargets(insertedIndex); },
+    "find " + std::to_string(NumQueries) + " targets in the incrementally built index");
+
+  auto builtCount = size_t(0);
+  timeLambda(
+    [&]() { builtCount = findTargets(builtIndex); },
+    "find " + std::to_string(NumQueries) + " targets in the bulk built index");
+
+  CHECK(insertedCount == NumQueries);
+  CHECK(builtCount == NumQueries);
+}
+
+} // namespace TrenchBroom::Model
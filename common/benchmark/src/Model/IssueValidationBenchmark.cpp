@@ -0,0 +1,162 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/EmptyGroupValidator.h"
+#include "Model/EntityNode.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/IssueTracker.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/MixedBrushContentsValidator.h"
+#include "Model/NonIntegerVerticesValidator.h"
+#include "Model/PatchNode.h"
+#include "Model/WorldBoundsValidator.h"
+#include "Model/WorldNode.h"
+
+#include "kdl/overload.h"
+#include "kdl/result.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumGroups = 1'000;
+constexpr size_t NumBrushesPerGroup = 100;
+constexpr size_t NumChangedBrushes = 100;
+
+/**
+ * Adds NumGroups groups with NumBrushesPerGroup brushes each to the given world. Every
+ * tenth brush has non integer vertices.
+ */
+std::vector<BrushNode*> makeBrushes(WorldNode& worldNode, const vm::bbox3& worldBounds)
+{
+  const auto builder = BrushBuilder{worldNode.mapFormat(), worldBounds};
+  const auto cube = builder.createCube(64.0, "texture").value();
+  const auto offCube =
+    builder.createCuboid(vm::bbox3{{0.5, 0.5, 0.5}, {64.5, 64.5, 64.5}}, "texture")
+      .value();
+
+  auto result = std::vector<BrushNode*>{};
+  result.reserve(NumGroups * NumBrushesPerGroup);
+
+  for (size_t i = 0; i < NumGroups; ++i)
+  {
+    auto* groupNode = new GroupNode{Group{"group " + std::to_string(i)}};
+    for (size_t j = 0; j < NumBrushesPerGroup; ++j)
+    {
+      auto* brushNode = new BrushNode{j % 10 == 0 ? offCube : cube};
+      groupNode->addChild(brushNode);
+      result.push_back(brushNode);
+    }
+    worldNode.defaultLayer()->addChild(groupNode);
+  }
+
+  return result;
+}
+
+void registerValidators(WorldNode& worldNode, const vm::bbox3& worldBounds)
+{
+  worldNode.registerValidator(std::make_unique<EmptyGroupValidator>());
+  worldNode.registerValidator(std::make_unique<NonIntegerVerticesValidator>());
+  worldNode.registerValidator(std::make_unique<MixedBrushContentsValidator>());
+  worldNode.registerValidator(std::make_unique<WorldBoundsValidator>(worldBounds));
+}
+
+} // namespace
+
+TEST_CASE("IssueValidationBenchmark.validateWorld")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  const auto brushNodes = makeBrushes(worldNode, worldBounds);
+  registerValidators(worldNode, worldBounds);
+
+  const auto validators = worldNode.registeredValidators();
+  const auto expectedIssueCount = brushNodes.size() / 10;
+
+  auto issueCount = size_t(0);
+
+  // this mirrors what the issue browser used to do after every change
+  timeLambda(
+    [&]() {
+      issueCount = 0;
+      const auto validate = [&](auto* node) {
+        issueCount += node->issues(validators).size();
+      };
+
+      worldNode.accept(kdl::overload(
+        [&](auto&& thisLambda, WorldNode* world) {
+          validate(world);
+          world->visitChildren(thisLambda);
+        },
+        [&](auto&& thisLambda, LayerNode* layer) {
+          validate(layer);
+          layer->visitChildren(thisLambda);
+        },
+        [&](auto&& thisLambda, GroupNode* group) {
+          validate(group);
+          group->visitChildren(thisLambda);
+        },
+        [&](auto&& thisLambda, EntityNode* entity) {
+          validate(entity);
+          entity->visitChildren(thisLambda);
+        },
+        [&](BrushNode* brush) { validate(brush); },
+        [&](PatchNode* patch) { validate(patch); }));
+    },
+    "validate " + std::to_string(brushNodes.size()) + " brushes serially");
+  CHECK(issueCount == expectedIssueCount);
+
+  // drop the issues collected above and start over
+  worldNode.unregisterAllValidators();
+  registerValidators(worldNode, worldBounds);
+  auto& issueTracker = worldNode.issueTracker();
+  issueTracker.takeInvalidatedNodes();
+
+  const auto allValidators = worldNode.registeredValidators();
+  timeLambda(
+    [&]() { issueCount = issueTracker.validate(allValidators).size(); },
+    "validate " + std::to_string(brushNodes.size()) + " brushes using the issue tracker");
+  CHECK(issueCount == expectedIssueCount);
+
+  const auto changedBrushNodes = std::vector<BrushNode*>{
+    brushNodes.begin(), brushNodes.begin() + NumChangedBrushes};
+  for (auto* brushNode : changedBrushNodes)
+  {
+    brushNode->setBrush(brushNode->brush());
+  }
+
+  timeLambda(
+    [&]() { issueCount = issueTracker.validate(allValidators).size(); },
+    "validate " + std::to_string(changedBrushNodes.size())
+      + " changed brushes using the issue tracker");
+  CHECK(issueCount == NumChangedBrushes / 10);
+}
+
+} // namespace TrenchBroom::Model
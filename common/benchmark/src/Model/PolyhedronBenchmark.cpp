@@ -0,0 +1,158 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+#include "Model/Polyhedron3.h"
+
+#include "kdl/result.h"
+#include "kdl/result_fold.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/constants.h"
+#include "vm/plane.h"
+#include "vm/vec.h"
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t PolyhedronCount = 2000;
+constexpr size_t PointCount = 32;
+
+/**
+ * Returns PolyhedronCount sets of PointCount points which are scattered over spheres of
+ * varying radius.
+ */
+std::vector<std::vector<vm::vec3>> makePointSets()
+{
+  auto rng = std::mt19937{42};
+  auto angle = std::uniform_real_distribution<double>{0.0, vm::C::two_pi()};
+  auto height = std::uniform_real_distribution<double>{-1.0, 1.0};
+  auto radius = std::uniform_real_distribution<double>{16.0, 256.0};
+
+  auto result = std::vector<std::vector<vm::vec3>>{};
+  result.reserve(PolyhedronCount);
+  for (size_t i = 0; i < PolyhedronCount; ++i)
+  {
+    const auto r = radius(rng);
+    auto points = std::vector<vm::vec3>{};
+    points.reserve(PointCount);
+    for (size_t j = 0; j < PointCount; ++j)
+    {
+      const auto a = angle(rng);
+      const auto z = height(rng);
+      const auto s = std::sqrt(1.0 - z * z);
+      points.emplace_back(r * s * std::cos(a), r * s * std::sin(a), r * z);
+    }
+    result.push_back(std::move(points));
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("PolyhedronBenchmark.convexHull")
+{
+  const auto pointSets = makePointSets();
+
+  auto polyhedra = std::vector<Polyhedron3>{};
+  polyhedra.reserve(pointSets.size());
+  timeLambda(
+    [&]() {
+      for (const auto& points : pointSets)
+      {
+        polyhedra.emplace_back(points);
+      }
+    },
+    "build " + std::to_string(pointSets.size()) + " convex hulls of "
+      + std::to_string(PointCount) + " points");
+
+  timeLambda(
+    [&]() { polyhedra.clear(); },
+    "destroy " + std::to_string(pointSets.size()) + " polyhedra");
+}
+
+TEST_CASE("PolyhedronBenchmark.brushConstruction")
+{
+  const auto pointSets = makePointSets();
+  const auto builder = BrushBuilder{MapFormat::Standard, vm::bbox3{8192.0}};
+
+  auto brushes = std::vector<Result<Brush>>{};
+  timeLambda(
+    [&]() {
+      brushes = kdl::vec_transform(pointSets, [&](const auto& points) {
+        return builder.createBrush(points, "texture");
+      });
+    },
+    "create " + std::to_string(pointSets.size()) + " brushes from "
+      + std::to_string(PointCount) + " points");
+  CHECK(kdl::fold_results(std::move(brushes)).is_success());
+}
+
+TEST_CASE("PolyhedronBenchmark.copyAndClip")
+{
+  const auto pointSets = makePointSets();
+  auto polyhedra = std::vector<Polyhedron3>{};
+  polyhedra.reserve(pointSets.size());
+  for (const auto& points : pointSets)
+  {
+    polyhedra.emplace_back(points);
+  }
+
+  const auto planes = std::vector<vm::plane3>{
+    {8.0, vm::normalize(vm::vec3{1, 1, 1})},
+    {8.0, vm::normalize(vm::vec3{-1, 1, 0})},
+    {0.0, vm::normalize(vm::vec3{0, -1, 1})},
+  };
+
+  auto copies = std::vector<Polyhedron3>{};
+  copies.reserve(polyhedra.size());
+  timeLambda(
+    [&]() {
+      for (const auto& polyhedron : polyhedra)
+      {
+        copies.push_back(polyhedron);
+      }
+    },
+    "copy " + std::to_string(polyhedra.size()) + " polyhedra");
+
+  timeLambda(
+    [&]() {
+      for (auto& copy : copies)
+      {
+        for (const auto& plane : planes)
+        {
+          copy.clip(plane);
+        }
+      }
+    },
+    "clip " + std::to_string(copies.size()) + " polyhedra with "
+      + std::to_string(planes.size()) + " planes");
+}
+
+} // namespace TrenchBroom::Model
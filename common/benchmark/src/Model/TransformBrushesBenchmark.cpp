@@ -0,0 +1,206 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/LinkedGroupUtils.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include "kdl/parallel.h"
+#include "kdl/result.h"
+#include "kdl/result_fold.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/mat_ext.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumGroups = 5'000;
+constexpr size_t NumBrushesPerGroup = 10;
+constexpr size_t NumLinkedGroups = 2;
+
+/**
+ * Adds NumGroups groups with NumBrushesPerGroup brushes each to the given world. Every
+ * NumLinkedGroups consecutive groups are linked to each other.
+ */
+std::vector<BrushNode*> makeLinkedGroups(
+  WorldNode& worldNode, const vm::bbox3& worldBounds)
+{
+  auto builder = BrushBuilder{worldNode.mapFormat(), worldBounds};
+
+  auto result = std::vector<BrushNode*>{};
+  result.reserve(NumGroups * NumBrushesPerGroup);
+
+  for (size_t i = 0; i < NumGroups; ++i)
+  {
+    const auto linkIndex = i / NumLinkedGroups;
+
+    auto* groupNode = new GroupNode{Group{"group " + std::to_string(i)}};
+    groupNode->setLinkId("group " + std::to_string(linkIndex));
+
+    for (size_t j = 0; j < NumBrushesPerGroup; ++j)
+    {
+      auto* brushNode = new BrushNode{builder.createCube(64.0, "texture").value()};
+      brushNode->setLinkId(
+        "brush " + std::to_string(linkIndex) + " " + std::to_string(j));
+      groupNode->addChild(brushNode);
+      result.push_back(brushNode);
+    }
+
+    worldNode.defaultLayer()->addChild(groupNode);
+  }
+
+  return result;
+}
+} // namespace
+
+TEST_CASE("TransformBrushesBenchmark.transformLinkedBrushes")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  const auto brushNodes = makeLinkedGroups(worldNode, worldBounds);
+
+  const auto transformation = vm::translation_matrix(vm::vec3{16.0, 0.0, 0.0});
+
+  // this mirrors the per brush work done by MapDocument::transformObjects
+  const auto transformBrush = [&](auto collectLinkedBrushes) {
+    return [&, collectLinkedBrushes](BrushNode* brushNode) -> Result<Brush> {
+      const auto lockTextures = collectLinkedBrushes(*brushNode).size() > 1;
+
+      auto brush = brushNode->brush();
+      return brush.transform(worldBounds, transformation, lockTextures)
+        .transform([&]() { return std::move(brush); });
+    };
+  };
+
+  auto transformedBrushes = std::vector<Result<Brush>>{};
+  timeLambda(
+    [&]() {
+      transformedBrushes = kdl::vec_parallel_transform(
+        brushNodes, transformBrush([&](const BrushNode& brushNode) {
+          return collectLinkedNodes(worldNode, brushNode);
+        }));
+    },
+    "transform " + std::to_string(brushNodes.size())
+      + " linked brushes using the link ID index");
+
+  CHECK(kdl::fold_results(std::move(transformedBrushes)).is_success());
+
+  // looking up the linked nodes by traversing the world is quadratic in the number of
+  // brushes, so only a small subset is transformed this way
+  const auto someBrushNodes =
+    std::vector<BrushNode*>{brushNodes.begin(), brushNodes.begin() + 500};
+  timeLambda(
+    [&]() {
+      transformedBrushes = kdl::vec_parallel_transform(
+        someBrushNodes, transformBrush([&](const BrushNode& brushNode) {
+          return collectLinkedNodes(std::vector<Node*>{&worldNode}, brushNode);
+        }));
+    },
+    "transform " + std::to_string(someBrushNodes.size())
+      + " linked brushes by traversing the world");
+
+  CHECK(kdl::fold_results(std::move(transformedBrushes)).is_success());
+}
+
+TEST_CASE("TransformBrushesBenchmark.transformBrushGeometry")
+{
+  constexpr size_t NumBrushes = 20'000;
+
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+  const auto brushes = std::vector<Brush>(
+    NumBrushes,
+    builder
+      .createBrush(
+        std::vector<vm::vec3>{
+          {64, -64, 16},
+          {64, 64, 16},
+          {64, -64, -16},
+          {64, 64, -16},
+          {48, 64, 16},
+          {48, 64, -16}},
+        "texture")
+      .value());
+
+  // rebuilding the geometry from the transformed faces is what Brush::transform does
+  // for transformations which are not a translation or a rotation by 90 degrees
+  const auto rebuild = [&](const vm::mat4x4& transformation) {
+    return [&, transformation](const Brush& brush) -> Result<Brush> {
+      auto faces = brush.faces();
+      for (auto& face : faces)
+      {
+        if (face.transform(transformation, false).is_error())
+        {
+          return Error{"Brush has invalid face"};
+        }
+      }
+      return Brush::create(worldBounds, std::move(faces));
+    };
+  };
+
+  const auto transform = [&](const vm::mat4x4& transformation) {
+    return [&, transformation](const Brush& brush) {
+      auto transformedBrush = brush;
+      return transformedBrush.transform(worldBounds, transformation, false)
+        .transform([&]() { return std::move(transformedBrush); });
+    };
+  };
+
+  const auto translation = vm::translation_matrix(vm::vec3{16.0, 32.0, 8.0});
+  const auto rotation = vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0));
+
+  auto results = std::vector<Result<Brush>>{};
+  timeLambda(
+    [&]() { results = kdl::vec_transform(brushes, rebuild(translation)); },
+    "translate " + std::to_string(NumBrushes) + " brushes by rebuilding their geometry");
+  CHECK(kdl::fold_results(std::move(results)).is_success());
+
+  timeLambda(
+    [&]() { results = kdl::vec_transform(brushes, transform(translation)); },
+    "translate " + std::to_string(NumBrushes)
+      + " brushes by transforming their geometry");
+  CHECK(kdl::fold_results(std::move(results)).is_success());
+
+  timeLambda(
+    [&]() { results = kdl::vec_transform(brushes, rebuild(rotation)); },
+    "rotate " + std::to_string(NumBrushes) + " brushes by rebuilding their geometry");
+  CHECK(kdl::fold_results(std::move(results)).is_success());
+
+  timeLambda(
+    [&]() { results = kdl::vec_transform(brushes, transform(rotation)); },
+    "rotate " + std::to_string(NumBrushes) + " brushes by transforming their geometry");
+  CHECK(kdl::fold_results(std::move(results)).is_success());
+}
+
+} // namespace TrenchBroom::Model
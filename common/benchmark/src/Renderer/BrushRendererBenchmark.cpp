@@ -29,13 +29,16 @@
 #include "Model/MapFormat.h"
 #include "Model/WorldNode.h"
 #include "Renderer/BrushRenderer.h"
+#include "Renderer/PerspectiveCamera.h"
 
 #include "kdl/result.h"
+#include "kdl/thread_pool.h"
 
 #include <algorithm>
 #include <chrono>
 #include <string>
 #include <tuple>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
@@ -154,5 +157,111 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
   kdl::vec_clear_and_delete(brushes);
   kdl::vec_clear_and_delete(textures);
 }
+
+TEST_CASE("BrushRendererBenchmark.benchValidateScaling")
+{
+  auto [brushes, textures] = makeBrushes();
+
+  printf(
+    "validating on up to %zu threads\n", kdl::default_thread_pool().thread_count() + 1);
+
+  for (const auto brushCount : {NumBrushes / 16, NumBrushes / 4, NumBrushes})
+  {
+    BrushRenderer r;
+    for (size_t i = 0; i < brushCount; ++i)
+    {
+      r.addBrush(brushes[i]);
+      brushes[i]->invalidateVertexCache();
+    }
+
+    timeLambda(
+      [&]() { r.validate(); },
+      "validate " + std::to_string(brushCount) + " brushes with invalid vertex caches");
+
+    r.invalidate();
+    timeLambda(
+      [&]() { r.validate(); },
+      "validate " + std::to_string(brushCount) + " brushes with valid vertex caches");
+  }
+
+  kdl::vec_clear_and_delete(brushes);
+  kdl::vec_clear_and_delete(textures);
+}
+
+TEST_CASE("BrushRendererBenchmark.benchFrustumCulling")
+{
+  // make brushes on a regular grid that fills the world
+  constexpr auto GridSize = 40;
+  constexpr auto CellSize = 192.0;
+
+  const auto worldBounds = vm::bbox3{4096.0};
+  const auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+
+  auto brushes = std::vector<Model::BrushNode*>{};
+  for (int x = 0; x < GridSize; ++x)
+  {
+    for (int y = 0; y < GridSize; ++y)
+    {
+      for (int z = 0; z < GridSize; ++z)
+      {
+        const auto min =
+          vm::vec3{double(x), double(y), double(z)} * CellSize - vm::vec3::fill(3840.0);
+        const auto bounds = vm::bbox3{min, min + vm::vec3::fill(64.0)};
+        brushes.push_back(
+          new Model::BrushNode{builder.createCuboid(bounds, "texture").value()});
+      }
+    }
+  }
+
+  BrushRenderer r;
+  for (auto* brush : brushes)
+  {
+    r.addBrush(brush);
+  }
+  r.validate();
+
+  // a camera in a corner of the world that looks along the x axis
+  const auto camera = PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    Camera::Viewport{0, 0, 1920, 1080},
+    vm::vec3f{-4000.0f, -2048.0f, -2048.0f},
+    vm::vec3f::pos_x(),
+    vm::vec3f::pos_z()};
+
+  constexpr auto NumFrames = 1000;
+  auto visibleBuckets = std::vector<BrushRenderer::BucketKey>{};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumFrames; ++i)
+      {
+        visibleBuckets = r.visibleBuckets(camera);
+      }
+    },
+    "cull " + std::to_string(r.buckets().size()) + " buckets "
+      + std::to_string(NumFrames) + " times");
+
+  const auto visibleBucketSet =
+    std::unordered_set<BrushRenderer::BucketKey, BrushRenderer::BucketKeyHash>{
+      visibleBuckets.begin(), visibleBuckets.end()};
+  const auto visibleBrushCount = std::count_if(
+    brushes.begin(), brushes.end(), [&](const auto* brushNode) {
+      const auto bucketKey =
+        detail::get_container(brushNode->logicalBounds(), BrushRenderer::BucketSize);
+      return visibleBucketSet.count(bucketKey) > 0;
+    });
+
+  printf(
+    "%zu of %zu buckets with %zu of %zu brushes are visible\n",
+    visibleBuckets.size(),
+    r.buckets().size(),
+    size_t(visibleBrushCount),
+    brushes.size());
+
+  CHECK(visibleBrushCount < static_cast<std::ptrdiff_t>(brushes.size()));
+
+  kdl::vec_clear_and_delete(brushes);
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -0,0 +1,176 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "FloatType.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+#include "Model/PickResult.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/VertexHandleManager.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::View
+{
+namespace
+{
+constexpr size_t NumBrushesPerAxis = 25;
+constexpr size_t NumLayers = 20;
+constexpr size_t NumRaysPerAxis = 32;
+
+/**
+ * Creates a grid of separate cubes with 100k vertex handles in total.
+ */
+std::vector<std::unique_ptr<Model::BrushNode>> makeBrushes()
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<std::unique_ptr<Model::BrushNode>>{};
+  result.reserve(NumBrushesPerAxis * NumBrushesPerAxis * NumLayers);
+
+  for (size_t x = 0; x < NumBrushesPerAxis; ++x)
+  {
+    for (size_t y = 0; y < NumBrushesPerAxis; ++y)
+    {
+      for (size_t z = 0; z < NumLayers; ++z)
+      {
+        const auto min = vm::vec3{vm::vec<size_t, 3>{x, y, z}} * 64.0;
+        result.push_back(std::make_unique<Model::BrushNode>(
+          builder.createCuboid(vm::bbox3{min, min + vm::vec3::fill(32.0)}, "texture")
+            .value()));
+      }
+    }
+  }
+
+  return result;
+}
+
+std::vector<vm::ray3> makePickRays(const Renderer::Camera& camera)
+{
+  const auto& viewport = camera.viewport();
+
+  auto result = std::vector<vm::ray3>{};
+  result.reserve(NumRaysPerAxis * NumRaysPerAxis);
+
+  for (size_t x = 0; x < NumRaysPerAxis; ++x)
+  {
+    for (size_t y = 0; y < NumRaysPerAxis; ++y)
+    {
+      const auto fx = (float(x) + 0.5f) / float(NumRaysPerAxis);
+      const auto fy = (float(y) + 0.5f) / float(NumRaysPerAxis);
+      const auto screenX = float(viewport.width) * fx;
+      const auto screenY = float(viewport.height) * fy;
+      result.push_back(vm::ray3{camera.pickRay(screenX, screenY)});
+    }
+  }
+
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("VertexHandleManagerBenchmark.pickAndFindIncidentBrushes")
+{
+  const auto brushNodes = makeBrushes();
+
+  auto manager = VertexHandleManager{};
+  timeLambda(
+    [&]() {
+      for (const auto& brushNode : brushNodes)
+      {
+        manager.addHandles(brushNode.get());
+      }
+    },
+    "add " + std::to_string(brushNodes.size()) + " brushes to the handle manager");
+
+  const auto handles = manager.allHandles();
+  REQUIRE(handles.size() == 100'000u);
+
+  // looking at the grid of cubes from one of its corners
+  const auto camera = Renderer::PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8000.0f,
+    Renderer::Camera::Viewport{0, 0, 1920, 1080},
+    vm::vec3f{-256.0f, -256.0f, 1536.0f},
+    vm::normalize(vm::vec3f{1.0f, 1.0f, -0.75f}),
+    vm::vec3f::pos_z()};
+  const auto pickRays = makePickRays(camera);
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+
+  auto expectedHits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& pickRay : pickRays)
+      {
+        for (const auto& handle : handles)
+        {
+          if (camera.pickPointHandle(pickRay, handle, handleRadius))
+          {
+            ++expectedHits;
+          }
+        }
+      }
+    },
+    "pick " + std::to_string(pickRays.size()) + " rays by testing every handle");
+
+  auto actualHits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& pickRay : pickRays)
+      {
+        auto pickResult = Model::PickResult{};
+        manager.pick(pickRay, camera, pickResult);
+        actualHits += pickResult.size();
+      }
+    },
+    "pick " + std::to_string(pickRays.size()) + " rays using the handle manager");
+
+  CHECK(actualHits == expectedHits);
+
+  auto incidentBrushes = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& handle : handles)
+      {
+        incidentBrushes += manager.findIncidentBrushes(handle).size();
+      }
+    },
+    "find incident brushes of " + std::to_string(handles.size()) + " handles");
+
+  CHECK(incidentBrushes == handles.size());
+}
+
+} // namespace TrenchBroom::View
@@ -28,14 +28,55 @@
 #include "Model/EntityNode.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
 
+#include "kdl/thread_pool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
 namespace TrenchBroom
 {
 namespace Assets
 {
+namespace
+{
+size_t loadThreadCount()
+{
+  // loading models is mostly bound by file access, so a few threads are sufficient
+  return std::clamp(size_t(std::thread::hardware_concurrency()), size_t(1), size_t(4));
+}
+} // namespace
+
+struct EntityModelManager::LoadState
+{
+  struct LoadedModel
+  {
+    std::filesystem::path path;
+    std::unique_ptr<EntityModel> model;
+    std::vector<std::pair<LogLevel, std::string>> messages;
+  };
+
+  std::mutex mutex;
+  std::condition_variable condition;
+
+  bool cancelled = false;
+  size_t runningTasks = 0;
+
+  // frames to load with the model, by model path
+  std::map<std::filesystem::path, std::vector<size_t>> requestedFrames;
+  std::vector<LoadedModel> loadedModels;
+
+  std::function<void()> modelsLoadedCallback;
+};
+
 EntityModelManager::EntityModelManager(
   const int magFilter, const int minFilter, Logger& logger)
   : m_logger(logger)
   , m_loader(nullptr)
+  , m_loadState(std::make_shared<LoadState>())
   , m_minFilter(minFilter)
   , m_magFilter(magFilter)
   , m_resetTextureMode(false)
@@ -49,6 +90,19 @@ EntityModelManager::~EntityModelManager()
 
 void EntityModelManager::clear()
 {
+  {
+    // wait until no task uses the loader anymore, tasks that have not started yet will
+    // see the cancellation and do nothing
+    auto lock = std::unique_lock{m_loadState->mutex};
+    m_loadState->cancelled = true;
+    m_loadState->modelsLoadedCallback = nullptr;
+    m_loadState->condition.wait(lock, [&]() { return m_loadState->runningTasks == 0; });
+  }
+
+  m_loadState = std::make_shared<LoadState>();
+  m_loadState->modelsLoadedCallback = m_modelsLoadedCallback;
+  m_pendingModels.clear();
+
   m_renderers.clear();
   m_models.clear();
   m_rendererMismatches.clear();
@@ -73,10 +127,64 @@ void EntityModelManager::setLoader(const IO::EntityModelLoader* loader)
   m_loader = loader;
 }
 
+void EntityModelManager::setModelsLoadedCallback(
+  std::function<void()> modelsLoadedCallback)
+{
+  m_modelsLoadedCallback = std::move(modelsLoadedCallback);
+
+  const auto lock = std::lock_guard{m_loadState->mutex};
+  m_loadState->modelsLoadedCallback = m_modelsLoadedCallback;
+}
+
+std::vector<std::filesystem::path> EntityModelManager::commitLoadedModels()
+{
+  auto loadedModels = std::vector<LoadState::LoadedModel>{};
+  {
+    const auto lock = std::lock_guard{m_loadState->mutex};
+    loadedModels = std::exchange(m_loadState->loadedModels, {});
+  }
+
+  auto paths = std::vector<std::filesystem::path>{};
+  paths.reserve(loadedModels.size());
+
+  for (auto& loadedModel : loadedModels)
+  {
+    for (const auto& [level, message] : loadedModel.messages)
+    {
+      m_logger.log(level, message);
+    }
+
+    if (loadedModel.model)
+    {
+      const auto [pos, success] =
+        m_models.emplace(loadedModel.path, std::move(loadedModel.model));
+      assert(success);
+      unused(success);
+
+      m_unpreparedModels.push_back(pos->second.get());
+      m_logger.debug() << "Loaded entity model " << loadedModel.path;
+    }
+    else
+    {
+      m_modelMismatches.insert(loadedModel.path);
+    }
+
+    m_pendingModels.erase(loadedModel.path);
+    paths.push_back(std::move(loadedModel.path));
+  }
+
+  return paths;
+}
+
+bool EntityModelManager::isLoading(const std::filesystem::path& path) const
+{
+  return m_pendingModels.count(path) > 0;
+}
+
 Renderer::TexturedRenderer* EntityModelManager::renderer(
   const Assets::ModelSpecification& spec) const
 {
-  auto* entityModel = safeGetModel(spec.path);
+  auto* entityModel = safeGetModel(spec.path, spec.frameIndex);
 
   if (entityModel == nullptr)
   {
@@ -118,7 +226,7 @@ Renderer::TexturedRenderer* EntityModelManager::renderer(
 const EntityModelFrame* EntityModelManager::frame(
   const Assets::ModelSpecification& spec) const
 {
-  auto* model = this->safeGetModel(spec.path);
+  auto* model = this->safeGetModel(spec.path, spec.frameIndex);
   if (model == nullptr)
   {
     return nullptr;
@@ -137,7 +245,8 @@ const EntityModelFrame* EntityModelManager::frame(
   }
 }
 
-EntityModel* EntityModelManager::model(const std::filesystem::path& path) const
+EntityModel* EntityModelManager::model(
+  const std::filesystem::path& path, const size_t frameIndex) const
 {
   if (path.empty())
   {
@@ -155,6 +264,12 @@ EntityModel* EntityModelManager::model(const std::filesystem::path& path) const
     return nullptr;
   }
 
+  if (m_modelsLoadedCallback)
+  {
+    requestModel(path, frameIndex);
+    return nullptr;
+  }
+
   try
   {
     const auto [pos, success] = m_models.emplace(path, loadModel(path));
@@ -176,11 +291,12 @@ EntityModel* EntityModelManager::model(const std::filesystem::path& path) const
   }
 }
 
-EntityModel* EntityModelManager::safeGetModel(const std::filesystem::path& path) const
+EntityModel* EntityModelManager::safeGetModel(
+  const std::filesystem::path& path, const size_t frameIndex) const
 {
   try
   {
-    return model(path);
+    return model(path, frameIndex);
   }
   catch (const GameException&)
   {
@@ -210,6 +326,99 @@ void EntityModelManager::loadFrame(
   }
 }
 
+void EntityModelManager::requestModel(
+  const std::filesystem::path& path, const size_t frameIndex) const
+{
+  ensure(m_loader != nullptr, "loader is null");
+
+  {
+    const auto lock = std::lock_guard{m_loadState->mutex};
+    auto& frames = m_loadState->requestedFrames[path];
+    if (std::find(frames.begin(), frames.end(), frameIndex) == frames.end())
+    {
+      frames.push_back(frameIndex);
+    }
+  }
+
+  if (!m_pendingModels.insert(path).second)
+  {
+    // already being loaded
+    return;
+  }
+
+  if (!m_loadPool)
+  {
+    m_loadPool = std::make_unique<kdl::thread_pool>(loadThreadCount());
+  }
+
+  m_loadPool->submit([state = m_loadState, loader = m_loader, path]() {
+    {
+      const auto lock = std::lock_guard{state->mutex};
+      if (state->cancelled)
+      {
+        return;
+      }
+      ++state->runningTasks;
+    }
+
+    auto logger = BufferedLogger{};
+    auto model = std::unique_ptr<EntityModel>{};
+    try
+    {
+      model = loader->initializeModel(path, logger);
+    }
+    catch (const Exception& e)
+    {
+      logger.error() << e.what();
+    }
+
+    if (model)
+    {
+      // load the frames that were requested until now, other frames are loaded on demand
+      auto frameIndices = std::vector<size_t>{};
+      {
+        const auto lock = std::lock_guard{state->mutex};
+        frameIndices = std::move(state->requestedFrames[path]);
+        state->requestedFrames.erase(path);
+      }
+
+      for (const auto frameIndex : frameIndices)
+      {
+        if (frameIndex < model->frameCount() && !model->frame(frameIndex)->loaded())
+        {
+          try
+          {
+            loader->loadFrame(path, frameIndex, *model, logger);
+          }
+          catch (const Exception& e)
+          {
+            logger.error() << "Could not load entity model frame " << path << ", "
+                           << frameIndex << ": " << e.what();
+          }
+        }
+      }
+    }
+
+    const auto lock = std::lock_guard{state->mutex};
+    --state->runningTasks;
+    state->condition.notify_all();
+
+    if (!state->cancelled)
+    {
+      state->requestedFrames.erase(path);
+
+      const auto notify = state->loadedModels.empty();
+      state->loadedModels.push_back(
+        LoadState::LoadedModel{path, std::move(model), std::move(logger.messages)});
+
+      if (notify && state->modelsLoadedCallback)
+      {
+        state->modelsLoadedCallback();
+      }
+    }
+  });
+}
+
 void EntityModelManager::prepare(Renderer::VboManager& vboManager)
 {
   resetTextureMode();
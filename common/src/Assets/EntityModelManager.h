@@ -22,10 +22,16 @@
 #include "kdl/vector_set.h"
 
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
 
+namespace kdl
+{
+class thread_pool;
+}
+
 namespace TrenchBroom
 {
 class Logger;
@@ -65,9 +71,16 @@ private:
   using RendererMismatches = kdl::vector_set<ModelSpecification>;
   using RendererList = std::vector<Renderer::TexturedRenderer*>;
 
+  struct LoadState;
+
   Logger& m_logger;
   const IO::EntityModelLoader* m_loader;
 
+  std::function<void()> m_modelsLoadedCallback;
+  mutable std::unique_ptr<kdl::thread_pool> m_loadPool;
+  std::shared_ptr<LoadState> m_loadState;
+  mutable kdl::vector_set<std::filesystem::path> m_pendingModels;
+
   int m_minFilter;
   int m_magFilter;
   bool m_resetTextureMode;
@@ -84,19 +97,52 @@ public:
   EntityModelManager(int magFilter, int minFilter, Logger& logger);
   ~EntityModelManager();
 
+  /**
+   * Removes all models and renderers. Models that are currently being loaded in the
+   * background are discarded. Blocks until no model is being read by a background thread
+   * anymore, so that the loader can be released safely afterwards.
+   */
   void clear();
 
   void setTextureMode(int minFilter, int magFilter);
   void setLoader(const IO::EntityModelLoader* loader);
+
+  /**
+   * Enables loading models in the background. If a callback is set, requesting a model
+   * that is not loaded yet returns null and schedules the model to be loaded by a worker
+   * thread. Requests for a model that is already being loaded are ignored.
+   *
+   * The given callback is called on a worker thread when loaded models are waiting to be
+   * committed, see commitLoadedModels(). It is called once per batch, i.e. it is not
+   * called again until the waiting models have been committed.
+   *
+   * If no callback is set, models are loaded synchronously when they are requested.
+   */
+  void setModelsLoadedCallback(std::function<void()> modelsLoadedCallback);
+
+  /**
+   * Makes the models that were loaded in the background available and returns their
+   * paths, including the paths of models that could not be loaded. Must be called on the
+   * thread that requests the models.
+   */
+  std::vector<std::filesystem::path> commitLoadedModels();
+
+  /**
+   * Indicates whether the model with the given path is being loaded in the background,
+   * i.e. it was requested and has not been committed yet.
+   */
+  bool isLoading(const std::filesystem::path& path) const;
+
   Renderer::TexturedRenderer* renderer(const ModelSpecification& spec) const;
 
   const EntityModelFrame* frame(const ModelSpecification& spec) const;
 
 private:
-  EntityModel* model(const std::filesystem::path& path) const;
-  EntityModel* safeGetModel(const std::filesystem::path& path) const;
+  EntityModel* model(const std::filesystem::path& path, size_t frameIndex) const;
+  EntityModel* safeGetModel(const std::filesystem::path& path, size_t frameIndex) const;
   std::unique_ptr<EntityModel> loadModel(const std::filesystem::path& path) const;
   void loadFrame(const ModelSpecification& spec, EntityModel& model) const;
+  void requestModel(const std::filesystem::path& path, size_t frameIndex) const;
 
 public:
   void prepare(Renderer::VboManager& vboManager);
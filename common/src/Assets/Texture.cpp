@@ -21,6 +21,7 @@
 
 #include "Assets/TextureBuffer.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureResidency.h"
 #include "Macros.h"
 #include "Renderer/GL.h"
 
@@ -32,6 +33,7 @@
 #include <algorithm> // for std::max
 #include <cassert>
 #include <ostream>
+#include <utility>
 
 namespace TrenchBroom::Assets
 {
@@ -199,7 +201,13 @@ Texture::Texture(
 {
 }
 
-Texture::~Texture() = default;
+Texture::~Texture()
+{
+  if (m_residency)
+  {
+    m_residency->textureReleased(*this);
+  }
+}
 
 Texture::Texture(Texture&& other)
   : m_name{std::move(other.m_name)}
@@ -216,12 +224,28 @@ Texture::Texture(Texture&& other)
   , m_blendFunc{std::move(other.m_blendFunc)}
   , m_textureId{std::move(other.m_textureId)}
   , m_buffers{std::move(other.m_buffers)}
+  , m_loader{std::move(other.m_loader)}
+  , m_minFilter{other.m_minFilter}
+  , m_magFilter{other.m_magFilter}
+  , m_uploaded{other.m_uploaded}
+  , m_residency{other.m_residency}
   , m_gameData{std::move(other.m_gameData)}
 {
+  if (m_residency)
+  {
+    m_residency->textureMoved(other, *this);
+  }
+  other.m_uploaded = false;
+  other.m_residency = nullptr;
 }
 
 Texture& Texture::operator=(Texture&& other)
 {
+  if (m_residency)
+  {
+    m_residency->textureReleased(*this);
+  }
+
   m_name = std::move(other.m_name);
   m_absolutePath = std::move(other.m_absolutePath);
   m_relativePath = std::move(other.m_relativePath);
@@ -236,7 +260,19 @@ Texture& Texture::operator=(Texture&& other)
   m_blendFunc = std::move(other.m_blendFunc);
   m_textureId = std::move(other.m_textureId);
   m_buffers = std::move(other.m_buffers);
+  m_loader = std::move(other.m_loader);
+  m_minFilter = other.m_minFilter;
+  m_magFilter = other.m_magFilter;
+  m_uploaded = other.m_uploaded;
+  m_residency = other.m_residency;
   m_gameData = std::move(other.m_gameData);
+
+  if (m_residency)
+  {
+    m_residency->textureMoved(other, *this);
+  }
+  other.m_uploaded = false;
+  other.m_residency = nullptr;
   return *this;
 }
 
@@ -349,16 +385,77 @@ void Texture::decUsageCount()
   unused(previous);
 }
 
+void Texture::setLoader(TextureLoader loader)
+{
+  m_loader = std::move(loader);
+}
+
+Texture::BufferList Texture::takeBuffers()
+{
+  return std::exchange(m_buffers, BufferList{});
+}
+
 bool Texture::isPrepared() const
 {
   return m_textureId != 0;
 }
 
-void Texture::prepare(const GLuint textureId, const int minFilter, const int magFilter)
+void Texture::prepare(
+  const GLuint textureId,
+  const int minFilter,
+  const int magFilter,
+  TextureResidency* residency)
 {
   assert(textureId > 0);
   assert(m_textureId == 0);
 
+  if (!m_buffers.empty() || m_loader)
+  {
+    m_textureId = textureId;
+    m_minFilter = minFilter;
+    m_magFilter = magFilter;
+    m_residency = m_loader ? residency : nullptr;
+
+    if (m_residency && !m_buffers.empty())
+    {
+      // may release the pixel data of other textures
+      m_residency->textureLoaded(*this, bufferSize(m_buffers));
+    }
+  }
+}
+
+void Texture::loadBuffers() const
+{
+  assert(m_buffers.empty());
+  assert(m_loader);
+
+  if (m_residency)
+  {
+    // the residency may load the pixel data in the background
+    m_residency->requestTexture(*this);
+  }
+  else
+  {
+    const auto decoder = m_loader();
+    setLoadedBuffers(decoder ? decoder() : BufferList{});
+  }
+}
+
+void Texture::setLoadedBuffers(BufferList buffers) const
+{
+  m_buffers = std::move(buffers);
+  if (m_buffers.empty())
+  {
+    // don't try again
+    m_loader = nullptr;
+  }
+}
+
+void Texture::upload() const
+{
+  assert(isPrepared());
+  assert(!m_uploaded);
+
   if (!m_buffers.empty())
   {
     const auto compressed = isCompressedFormat(m_format);
@@ -370,9 +467,9 @@ void Texture::prepare(const GLuint textureId, const int minFilter, const int mag
     glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
     glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
 
-    glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
-    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
-    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
+    glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_minFilter));
+    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_magFilter));
     glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
     glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
 
@@ -433,15 +530,24 @@ void Texture::prepare(const GLuint textureId, const int minFilter, const int mag
     }
 
     m_buffers.clear();
-    m_textureId = textureId;
+    m_buffers.shrink_to_fit();
+    m_uploaded = true;
+
+    if (m_residency)
+    {
+      m_residency->textureUploaded(*this);
+    }
   }
 }
 
 void Texture::setMode(const int minFilter, const int magFilter)
 {
-  if (isPrepared())
+  m_minFilter = minFilter;
+  m_magFilter = magFilter;
+
+  if (m_uploaded)
   {
-    activate();
+    glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
     if (m_type == TextureType::Masked)
     {
       // Force GL_NEAREST filtering for masked textures.
@@ -453,13 +559,22 @@ void Texture::setMode(const int minFilter, const int magFilter)
       glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
       glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
     }
-    deactivate();
+    glAssert(glBindTexture(GL_TEXTURE_2D, 0));
   }
 }
 
 void Texture::activate() const
 {
-  if (isPrepared())
+  if (isPrepared() && !m_uploaded)
+  {
+    if (m_buffers.empty() && m_loader)
+    {
+      loadBuffers();
+    }
+    upload();
+  }
+
+  if (m_uploaded)
   {
     glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
 
@@ -497,7 +612,7 @@ void Texture::activate() const
 
 void Texture::deactivate() const
 {
-  if (isPrepared())
+  if (m_uploaded)
   {
     if (m_blendFunc.enable != TextureBlendFunc::Enable::UseDefault)
     {
@@ -524,6 +639,19 @@ void Texture::deactivate() const
   }
 }
 
+bool Texture::isUploaded() const
+{
+  return m_uploaded;
+}
+
+void Texture::evict() const
+{
+  assert(m_loader);
+
+  m_buffers.clear();
+  m_buffers.shrink_to_fit();
+}
+
 const Texture::BufferList& Texture::buffersIfUnprepared() const
 {
   return m_buffers;
@@ -29,6 +29,7 @@
 
 #include <atomic>
 #include <filesystem>
+#include <functional>
 #include <set>
 #include <string>
 #include <variant>
@@ -36,6 +37,7 @@
 
 namespace TrenchBroom::Assets
 {
+class TextureResidency;
 
 enum class TextureType
 {
@@ -99,6 +101,19 @@ using GameData = std::variant<std::monostate, Q2Data>;
 
 std::ostream& operator<<(std::ostream& lhs, const GameData& rhs);
 
+/**
+ * Decodes the pixel data of a texture. Returns an empty vector if the data could not be
+ * decoded. A decoder may be called on any thread, so it must not access any file system.
+ */
+using TextureDecoder = std::function<std::vector<TextureBuffer>()>;
+
+/**
+ * Opens the file of a texture and returns a decoder for its pixel data, or null if the
+ * file could not be opened. A loader is only called on the thread that renders the
+ * texture.
+ */
+using TextureLoader = std::function<TextureDecoder()>;
+
 class Texture
 {
 private:
@@ -130,8 +145,14 @@ private:
   // Quake 3 blend function, move to materials
   TextureBlendFunc m_blendFunc;
 
-  mutable GLuint m_textureId;
+  GLuint m_textureId;
   mutable BufferList m_buffers;
+  mutable TextureLoader m_loader;
+
+  int m_minFilter{0};
+  int m_magFilter{0};
+  mutable bool m_uploaded{false};
+  TextureResidency* m_residency{nullptr};
 
   GameData m_gameData;
 
@@ -224,17 +245,50 @@ public:
   void incUsageCount();
   void decUsageCount();
 
+  /**
+   * Sets a function that loads the pixel data of this texture. If a loader is set, the
+   * texture need not hold its pixel data until it is first used, and the pixel data can
+   * be released by the residency passed to prepare().
+   */
+  void setLoader(TextureLoader loader);
+
+  /**
+   * Moves the pixel data out of this texture.
+   */
+  BufferList takeBuffers();
+
   bool isPrepared() const;
-  void prepare(GLuint textureId, int minFilter, int magFilter);
+
+  /**
+   * Assigns the given texture id to this texture. The pixel data is uploaded when the
+   * texture is first activated.
+   *
+   * If a residency is given and this texture has a loader, the residency keeps track of
+   * the pixel data of this texture until it is uploaded. It may release the pixel data
+   * to stay within its memory budget, and it loads missing pixel data when the texture
+   * is activated.
+   */
+  void prepare(
+    GLuint textureId,
+    int minFilter,
+    int magFilter,
+    TextureResidency* residency = nullptr);
   void setMode(int minFilter, int magFilter);
 
+  /**
+   * Uploads the pixel data if necessary and binds this texture. If the pixel data is not
+   * available and is being loaded in the background, the texture is not bound and
+   * isUploaded() returns false afterwards.
+   */
   void activate() const;
   void deactivate() const;
 
+  bool isUploaded() const;
+
 public: // exposed for tests only
   /**
    * Returns the texture data in the format returned by format().
-   * Once prepare() is called, this will be an empty vector.
+   * Once the texture is uploaded, this will be an empty vector.
    */
   const BufferList& buffersIfUnprepared() const;
   /**
@@ -242,6 +296,25 @@ public: // exposed for tests only
    */
   GLenum format() const;
   TextureType type() const;
+
+private:
+  void loadBuffers() const;
+  void upload() const;
+
+  friend class TextureResidency;
+
+  /**
+   * Sets the pixel data that was loaded by the loader. If the given buffers are empty,
+   * the loader is discarded so that it isn't called again.
+   */
+  void setLoadedBuffers(BufferList buffers) const;
+
+  /**
+   * Releases the pixel data of this texture. It will be loaded again when the texture is
+   * next activated. Called by the residency, which has already stopped tracking this
+   * texture.
+   */
+  void evict() const;
 };
 
 } // namespace TrenchBroom::Assets
@@ -25,6 +25,7 @@
 
 #include <FreeImage.h>
 #include <algorithm> // for std::max
+#include <numeric>
 
 namespace TrenchBroom
 {
@@ -60,6 +61,14 @@ size_t TextureBuffer::size() const
   return m_size;
 }
 
+size_t bufferSize(const TextureBufferList& buffers)
+{
+  return std::accumulate(
+    buffers.begin(), buffers.end(), size_t(0), [](const auto size, const auto& buffer) {
+      return size + buffer.size();
+    });
+}
+
 vm::vec2s sizeAtMipLevel(const size_t width, const size_t height, const size_t level)
 {
   assert(width > 0);
@@ -47,6 +47,8 @@ public:
 };
 using TextureBufferList = std::vector<TextureBuffer>;
 
+size_t bufferSize(const TextureBufferList& buffers);
+
 vm::vec2s sizeAtMipLevel(size_t width, size_t height, size_t level);
 bool isCompressedFormat(GLenum format);
 size_t blockSizeForFormat(GLenum format);
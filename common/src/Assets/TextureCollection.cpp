@@ -119,7 +119,8 @@ bool TextureCollection::prepared() const
   return !m_textureIds.empty();
 }
 
-void TextureCollection::prepare(const int minFilter, const int magFilter)
+void TextureCollection::prepare(
+  const int minFilter, const int magFilter, TextureResidency* residency)
 {
   assert(!prepared());
 
@@ -132,7 +133,7 @@ void TextureCollection::prepare(const int minFilter, const int magFilter)
     for (size_t i = 0; i < textureCount(); ++i)
     {
       auto& texture = m_textures[i];
-      texture.prepare(m_textureIds[i], minFilter, magFilter);
+      texture.prepare(m_textureIds[i], minFilter, magFilter, residency);
     }
   }
 }
@@ -30,6 +30,7 @@
 
 namespace TrenchBroom::Assets
 {
+class TextureResidency;
 
 class TextureCollection
 {
@@ -74,7 +75,7 @@ public:
   Texture* textureByName(const std::string& name);
 
   bool prepared() const;
-  void prepare(int minFilter, int magFilter);
+  void prepare(int minFilter, int magFilter, TextureResidency* residency = nullptr);
   void setTextureMode(int minFilter, int magFilter);
 };
 
@@ -21,9 +21,11 @@
 
 #include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureName.h"
 #include "Error.h"
 #include "Exceptions.h"
 #include "IO/LoadTextureCollection.h"
+#include "IO/TextureMetadataCache.h"
 #include "Logger.h"
 
 #include "kdl/map_utils.h"
@@ -46,6 +48,7 @@ TextureManager::TextureManager(int magFilter, int minFilter, Logger& logger)
   : m_logger{logger}
   , m_minFilter{minFilter}
   , m_magFilter{magFilter}
+  , m_metadataCache{std::make_unique<IO::TextureMetadataCache>()}
 {
 }
 
@@ -64,6 +67,25 @@ void TextureManager::reload(
     });
 }
 
+void TextureManager::setMetadataCachePath(
+  std::optional<std::filesystem::path> metadataCachePath)
+{
+  if (metadataCachePath == m_metadataCachePath)
+  {
+    return;
+  }
+
+  m_metadataCachePath = std::move(metadataCachePath);
+  m_metadataCache->clear();
+
+  if (m_metadataCachePath)
+  {
+    m_metadataCache->load(*m_metadataCachePath).transform_error([&](const auto& e) {
+      m_logger.debug() << "Could not load texture metadata cache: " << e.msg;
+    });
+  }
+}
+
 void TextureManager::setTextureCollections(std::vector<TextureCollection> collections)
 {
   for (auto& collection : collections)
@@ -90,7 +112,12 @@ void TextureManager::setTextureCollections(
 
     if (it == collections.end() || !it->loaded())
     {
-      IO::loadTextureCollection(path, fs, textureConfig, m_logger)
+      IO::loadTextureCollection(
+        path,
+        fs,
+        textureConfig,
+        m_logger,
+        m_metadataCachePath ? m_metadataCache.get() : nullptr)
         .transform_error([&](const auto& error) {
           if (it == collections.end())
           {
@@ -120,6 +147,13 @@ void TextureManager::setTextureCollections(
 
   updateTextures();
   m_toRemove = kdl::vec_concat(std::move(m_toRemove), std::move(collections));
+
+  if (m_metadataCachePath && m_metadataCache->modified())
+  {
+    m_metadataCache->save(*m_metadataCachePath).transform_error([&](const auto& e) {
+      m_logger.warn() << "Could not save texture metadata cache: " << e.msg;
+    });
+  }
 }
 
 void TextureManager::addTextureCollection(Assets::TextureCollection collection)
@@ -137,11 +171,13 @@ void TextureManager::addTextureCollection(Assets::TextureCollection collection)
 
 void TextureManager::clear()
 {
+  m_residency.cancelDecoding();
   m_collections.clear();
 
   m_toPrepare.clear();
   m_texturesByName.clear();
   m_textures.clear();
+  m_texturesByKeyId.clear();
 
   // Remove logging because it might fail when the document is already destroyed.
 }
@@ -153,6 +189,27 @@ void TextureManager::setTextureMode(const int minFilter, const int magFilter)
   m_resetTextureMode = true;
 }
 
+void TextureManager::setMemoryBudget(std::optional<size_t> memoryBudget)
+{
+  m_residency.setMemoryBudget(std::move(memoryBudget));
+}
+
+const TextureResidencyStats& TextureManager::residencyStats() const
+{
+  return m_residency.stats();
+}
+
+void TextureManager::setTexturesDecodedCallback(
+  std::function<void()> texturesDecodedCallback)
+{
+  m_residency.setTexturesDecodedCallback(std::move(texturesDecodedCallback));
+}
+
+size_t TextureManager::commitDecodedTextures()
+{
+  return m_residency.commitDecodedTextures();
+}
+
 void TextureManager::commitChanges()
 {
   resetTextureMode();
@@ -162,8 +219,9 @@ void TextureManager::commitChanges()
 
 const Texture* TextureManager::texture(const std::string& name) const
 {
-  auto it = m_texturesByName.find(kdl::str_to_lower(name));
-  return it != m_texturesByName.end() ? it->second : nullptr;
+  const auto keyId = TextureName::findKeyId(name);
+  return keyId && *keyId < m_texturesByKeyId.size() ? m_texturesByKeyId[*keyId]
+                                                    : nullptr;
 }
 
 Texture* TextureManager::texture(const std::string& name)
@@ -171,6 +229,17 @@ Texture* TextureManager::texture(const std::string& name)
   return const_cast<Texture*>(const_cast<const TextureManager*>(this)->texture(name));
 }
 
+const Texture* TextureManager::texture(const TextureName& name) const
+{
+  const auto keyId = name.keyId();
+  return keyId < m_texturesByKeyId.size() ? m_texturesByKeyId[keyId] : nullptr;
+}
+
+Texture* TextureManager::texture(const TextureName& name)
+{
+  return const_cast<Texture*>(const_cast<const TextureManager*>(this)->texture(name));
+}
+
 const std::vector<const Texture*>& TextureManager::textures() const
 {
   return m_textures;
@@ -198,7 +267,7 @@ void TextureManager::prepare()
   for (const auto index : m_toPrepare)
   {
     auto& collection = m_collections[index];
-    collection.prepare(m_minFilter, m_magFilter);
+    collection.prepare(m_minFilter, m_magFilter, &m_residency);
   }
   m_toPrepare.clear();
 }
@@ -229,6 +298,17 @@ void TextureManager::updateTextures()
   m_textures = kdl::vec_transform(kdl::map_values(m_texturesByName), [](auto* t) {
     return const_cast<const Texture*>(t);
   });
+
+  m_texturesByKeyId.clear();
+  for (auto* texture : kdl::map_values(m_texturesByName))
+  {
+    const auto keyId = TextureName{texture->name()}.keyId();
+    if (keyId >= m_texturesByKeyId.size())
+    {
+      m_texturesByKeyId.resize(keyId + 1, nullptr);
+    }
+    m_texturesByKeyId[keyId] = texture;
+  }
 }
 } // namespace Assets
 } // namespace TrenchBroom
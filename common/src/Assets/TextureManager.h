@@ -20,9 +20,13 @@
 #pragma once
 
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureResidency.h"
 
 #include <filesystem>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -33,6 +37,7 @@ class Logger;
 namespace IO
 {
 class FileSystem;
+class TextureMetadataCache;
 } // namespace IO
 
 namespace Model
@@ -44,12 +49,16 @@ namespace Assets
 {
 class Texture;
 class TextureCollection;
+class TextureName;
 
 class TextureManager
 {
 private:
   Logger& m_logger;
 
+  // must outlive the texture collections
+  TextureResidency m_residency;
+
   std::vector<TextureCollection> m_collections;
 
   std::vector<size_t> m_toPrepare;
@@ -58,16 +67,32 @@ private:
   std::map<std::string, Texture*> m_texturesByName;
   std::vector<const Texture*> m_textures;
 
+  /**
+   * Maps the key ids of interned texture names to textures, see TextureName::keyId().
+   * Rebuilt whenever the texture collections change.
+   */
+  std::vector<Texture*> m_texturesByKeyId;
+
   int m_minFilter;
   int m_magFilter;
   bool m_resetTextureMode{false};
 
+  std::optional<std::filesystem::path> m_metadataCachePath;
+  std::unique_ptr<IO::TextureMetadataCache> m_metadataCache;
+
 public:
   TextureManager(int magFilter, int minFilter, Logger& logger);
   ~TextureManager();
 
   void reload(const IO::FileSystem& fs, const Model::TextureConfig& textureConfig);
 
+  /**
+   * Sets the path of the file that caches texture metadata across sessions, or disables
+   * the cache if the given path is empty. The cache file is read immediately and written
+   * whenever new textures were added to the cache during a reload.
+   */
+  void setMetadataCachePath(std::optional<std::filesystem::path> metadataCachePath);
+
   // for testing
   void setTextureCollections(std::vector<TextureCollection> collections);
 
@@ -83,11 +108,44 @@ public:
   void clear();
 
   void setTextureMode(int minFilter, int magFilter);
+
+  /**
+   * Sets the maximum number of bytes of pixel data that textures may hold in memory until
+   * they are uploaded, or removes the limit if the given value is empty. The pixel data
+   * exceeding the budget is released, least recently loaded first, and loaded again when
+   * the texture is used.
+   */
+  void setMemoryBudget(std::optional<size_t> memoryBudget);
+  const TextureResidencyStats& residencyStats() const;
+
+  /**
+   * Decodes missing pixel data in the background. The given callback is called on a
+   * worker thread when decoded pixel data is waiting to be committed, see
+   * commitDecodedTextures(). If no callback is set, the pixel data is decoded when a
+   * texture is used.
+   *
+   * The texture files are still opened on the rendering thread, so the file system
+   * passed to reload() must outlive the textures or be cleared before it is destroyed.
+   */
+  void setTexturesDecodedCallback(std::function<void()> texturesDecodedCallback);
+
+  /**
+   * Hands the pixel data that was decoded in the background to its textures. Returns the
+   * number of textures that can now be uploaded.
+   */
+  size_t commitDecodedTextures();
+
   void commitChanges();
 
   const Texture* texture(const std::string& name) const;
   Texture* texture(const std::string& name);
 
+  /**
+   * Returns the texture with the given name, compared case insensitively, in O(1).
+   */
+  const Texture* texture(const TextureName& name) const;
+  Texture* texture(const TextureName& name);
+
   const std::vector<const Texture*>& textures() const;
   const std::vector<TextureCollection>& collections() const;
 
@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TextureName.h"
+
+#include "kdl/string_format.h"
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace TrenchBroom::Assets
+{
+
+struct TextureName::Entry
+{
+  std::string name;
+  size_t keyId;
+};
+
+struct TextureName::Table
+{
+  std::shared_mutex mutex;
+
+  // maps the texture names to their entries
+  std::unordered_map<std::string, std::unique_ptr<Entry>> entries;
+
+  // maps the lower case texture names to their key ids
+  std::unordered_map<std::string, size_t> keyIds;
+};
+
+TextureName::Table& TextureName::table()
+{
+  // never destroyed so that texture names can be used during static destruction
+  static auto* table = new Table{};
+  return *table;
+}
+
+TextureName::TextureName(const std::string_view name)
+{
+  auto& table = TextureName::table();
+  auto key = std::string{name};
+
+  {
+    const auto lock = std::shared_lock{table.mutex};
+    if (const auto it = table.entries.find(key); it != table.entries.end())
+    {
+      m_entry = it->second.get();
+      return;
+    }
+  }
+
+  const auto lock = std::unique_lock{table.mutex};
+  auto& entry = table.entries[key];
+  if (!entry)
+  {
+    const auto keyIdIt =
+      table.keyIds.emplace(kdl::str_to_lower(name), table.keyIds.size()).first;
+    entry = std::make_unique<Entry>(Entry{std::move(key), keyIdIt->second});
+  }
+  m_entry = entry.get();
+}
+
+const std::string& TextureName::name() const
+{
+  return m_entry->name;
+}
+
+size_t TextureName::keyId() const
+{
+  return m_entry->keyId;
+}
+
+std::optional<size_t> TextureName::findKeyId(const std::string_view name)
+{
+  auto& table = TextureName::table();
+
+  const auto lock = std::shared_lock{table.mutex};
+  const auto it = table.keyIds.find(kdl::str_to_lower(name));
+  return it != table.keyIds.end() ? std::optional{it->second} : std::nullopt;
+}
+
+bool operator==(const TextureName& lhs, const TextureName& rhs)
+{
+  return lhs.m_entry == rhs.m_entry;
+}
+
+bool operator!=(const TextureName& lhs, const TextureName& rhs)
+{
+  return !(lhs == rhs);
+}
+
+bool operator<(const TextureName& lhs, const TextureName& rhs)
+{
+  return lhs != rhs && lhs.name() < rhs.name();
+}
+
+bool operator<=(const TextureName& lhs, const TextureName& rhs)
+{
+  return !(rhs < lhs);
+}
+
+bool operator>(const TextureName& lhs, const TextureName& rhs)
+{
+  return rhs < lhs;
+}
+
+bool operator>=(const TextureName& lhs, const TextureName& rhs)
+{
+  return !(lhs < rhs);
+}
+
+std::ostream& operator<<(std::ostream& str, const TextureName& textureName)
+{
+  str << textureName.name();
+  return str;
+}
+
+} // namespace TrenchBroom::Assets
@@ -0,0 +1,79 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace TrenchBroom::Assets
+{
+
+/**
+ * An interned texture name.
+ *
+ * All texture names are stored in a global table, and a TextureName is just a pointer
+ * into that table. Copying and comparing texture names is cheap, and all faces that
+ * share a texture name share the same string.
+ *
+ * Texture names are case sensitive, but every texture name has a key id which is the same
+ * for all names that differ only in case. The key ids are dense, so they can be used to
+ * index into a vector that maps texture names to textures case insensitively.
+ *
+ * Interning a texture name is thread safe. The global table never shrinks.
+ */
+class TextureName
+{
+private:
+  struct Entry;
+  struct Table;
+
+  const Entry* m_entry;
+
+  static Table& table();
+
+public:
+  explicit TextureName(std::string_view name);
+
+  const std::string& name() const;
+
+  /**
+   * Returns the key id of this texture name. Two texture names have the same key id if
+   * and only if they are equal when compared case insensitively.
+   */
+  size_t keyId() const;
+
+  /**
+   * Returns the key id of the given name if any texture name that is equal to it when
+   * compared case insensitively was interned. Does not intern the given name.
+   */
+  static std::optional<size_t> findKeyId(std::string_view name);
+
+  friend bool operator==(const TextureName& lhs, const TextureName& rhs);
+  friend bool operator!=(const TextureName& lhs, const TextureName& rhs);
+  friend bool operator<(const TextureName& lhs, const TextureName& rhs);
+  friend bool operator<=(const TextureName& lhs, const TextureName& rhs);
+  friend bool operator>(const TextureName& lhs, const TextureName& rhs);
+  friend bool operator>=(const TextureName& lhs, const TextureName& rhs);
+
+  friend std::ostream& operator<<(std::ostream& str, const TextureName& textureName);
+};
+
+} // namespace TrenchBroom::Assets
@@ -0,0 +1,356 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureResidency.h"
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "Ensure.h"
+
+#include "kdl/thread_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom::Assets
+{
+namespace
+{
+size_t decodeThreadCount()
+{
+  return std::clamp(size_t(std::thread::hardware_concurrency()), size_t(1), size_t(4));
+}
+
+TextureBufferList decode(const TextureDecoder& decoder)
+{
+  try
+  {
+    return decoder();
+  }
+  catch (const std::exception&)
+  {
+    return {};
+  }
+}
+} // namespace
+
+struct TextureResidency::DecodeState
+{
+  struct DecodedTexture
+  {
+    size_t requestId;
+    TextureBufferList buffers;
+  };
+
+  std::mutex mutex;
+  std::condition_variable condition;
+
+  bool cancelled = false;
+  size_t runningTasks = 0;
+
+  std::vector<DecodedTexture> decodedTextures;
+
+  std::function<void()> texturesDecodedCallback;
+};
+
+TextureResidency::TextureResidency()
+  : m_decodeState{std::make_shared<DecodeState>()}
+{
+}
+
+TextureResidency::~TextureResidency()
+{
+  cancelDecoding();
+}
+
+void TextureResidency::setMemoryBudget(std::optional<size_t> memoryBudget)
+{
+  m_memoryBudget = std::move(memoryBudget);
+  evictTextures();
+}
+
+const std::optional<size_t>& TextureResidency::memoryBudget() const
+{
+  return m_memoryBudget;
+}
+
+void TextureResidency::setTexturesDecodedCallback(
+  std::function<void()> texturesDecodedCallback)
+{
+  m_texturesDecodedCallback = std::move(texturesDecodedCallback);
+
+  const auto lock = std::lock_guard{m_decodeState->mutex};
+  m_decodeState->texturesDecodedCallback = m_texturesDecodedCallback;
+}
+
+size_t TextureResidency::commitDecodedTextures()
+{
+  auto decodedTextures = std::vector<DecodeState::DecodedTexture>{};
+  {
+    const auto lock = std::lock_guard{m_decodeState->mutex};
+    decodedTextures = std::exchange(m_decodeState->decodedTextures, {});
+  }
+
+  auto count = size_t(0);
+  for (auto& decodedTexture : decodedTextures)
+  {
+    const auto it = m_pendingTextures.find(decodedTexture.requestId);
+    if (it == m_pendingTextures.end())
+    {
+      // the texture was released while it was being decoded
+      continue;
+    }
+
+    const auto* texture = it->second;
+    m_pendingRequestIds.erase(texture);
+    m_pendingTextures.erase(it);
+
+    const auto size = bufferSize(decodedTexture.buffers);
+    texture->setLoadedBuffers(std::move(decodedTexture.buffers));
+    if (size > 0)
+    {
+      m_stats.decodedBytes += size;
+      addEntry(*texture, size, true);
+    }
+
+    // a texture that could not be decoded is also ready, it won't be loaded again
+    ++count;
+  }
+
+  evictTextures();
+  return count;
+}
+
+void TextureResidency::cancelDecoding()
+{
+  {
+    // wait until no task decodes anymore, tasks that have not started yet will see the
+    // cancellation and do nothing
+    auto lock = std::unique_lock{m_decodeState->mutex};
+    m_decodeState->cancelled = true;
+    m_decodeState->texturesDecodedCallback = nullptr;
+    m_decodeState->condition.wait(
+      lock, [&]() { return m_decodeState->runningTasks == 0; });
+  }
+
+  m_decodeState = std::make_shared<DecodeState>();
+  m_decodeState->texturesDecodedCallback = m_texturesDecodedCallback;
+
+  // the pixel data of these textures is requested again when they are next activated
+  m_pendingRequestIds.clear();
+  m_pendingTextures.clear();
+}
+
+const TextureResidencyStats& TextureResidency::stats() const
+{
+  return m_stats;
+}
+
+bool TextureResidency::isResident(const Texture& texture) const
+{
+  return m_entryIndex.find(&texture) != m_entryIndex.end();
+}
+
+bool TextureResidency::isDecoding(const Texture& texture) const
+{
+  return m_pendingRequestIds.find(&texture) != m_pendingRequestIds.end();
+}
+
+void TextureResidency::textureLoaded(const Texture& texture, const size_t size)
+{
+  addEntry(texture, size, false);
+  evictTextures();
+}
+
+void TextureResidency::requestTexture(const Texture& texture)
+{
+  assert(texture.m_loader);
+
+  if (isDecoding(texture))
+  {
+    return;
+  }
+
+  ++m_stats.misses;
+
+  // open the file on this thread so that the workers needn't access the file system
+  auto decoder = texture.m_loader();
+  if (!decoder)
+  {
+    texture.setLoadedBuffers({});
+    return;
+  }
+
+  if (!m_texturesDecodedCallback)
+  {
+    auto buffers = decode(decoder);
+    const auto size = bufferSize(buffers);
+    texture.setLoadedBuffers(std::move(buffers));
+    if (size > 0)
+    {
+      m_stats.decodedBytes += size;
+      addEntry(texture, size, true);
+      evictTextures();
+    }
+    return;
+  }
+
+  const auto requestId = m_nextRequestId++;
+  m_pendingRequestIds.emplace(&texture, requestId);
+  m_pendingTextures.emplace(requestId, &texture);
+
+  if (!m_decodePool)
+  {
+    m_decodePool = std::make_unique<kdl::thread_pool>(decodeThreadCount());
+  }
+
+  m_decodePool->submit(
+    [state = m_decodeState, requestId, decoder = std::move(decoder)]() {
+      {
+        const auto lock = std::lock_guard{state->mutex};
+        if (state->cancelled)
+        {
+          return;
+        }
+        ++state->runningTasks;
+      }
+
+      auto buffers = decode(decoder);
+
+      const auto lock = std::lock_guard{state->mutex};
+      --state->runningTasks;
+      state->condition.notify_all();
+
+      if (!state->cancelled)
+      {
+        const auto notify = state->decodedTextures.empty();
+        state->decodedTextures.push_back(
+          DecodeState::DecodedTexture{requestId, std::move(buffers)});
+
+        if (notify && state->texturesDecodedCallback)
+        {
+          state->texturesDecodedCallback();
+        }
+      }
+    });
+}
+
+void TextureResidency::textureUploaded(const Texture& texture)
+{
+  const auto it = m_entryIndex.find(&texture);
+  ensure(it != m_entryIndex.end(), "texture is resident");
+
+  if (!it->second->requested)
+  {
+    // the pixel data was kept since the texture was loaded
+    ++m_stats.hits;
+  }
+
+  removeEntry(texture);
+}
+
+void TextureResidency::textureMoved(const Texture& from, const Texture& to)
+{
+  if (const auto it = m_entryIndex.find(&from); it != m_entryIndex.end())
+  {
+    auto entryIt = it->second;
+    entryIt->texture = &to;
+
+    m_entryIndex.erase(it);
+    m_entryIndex.emplace(&to, entryIt);
+  }
+
+  if (const auto it = m_pendingRequestIds.find(&from); it != m_pendingRequestIds.end())
+  {
+    const auto requestId = it->second;
+    m_pendingRequestIds.erase(it);
+    m_pendingRequestIds.emplace(&to, requestId);
+    m_pendingTextures[requestId] = &to;
+  }
+}
+
+void TextureResidency::textureReleased(const Texture& texture)
+{
+  if (isResident(texture))
+  {
+    removeEntry(texture);
+  }
+
+  if (const auto it = m_pendingRequestIds.find(&texture); it != m_pendingRequestIds.end())
+  {
+    // the decoded pixel data will be discarded when it is committed
+    m_pendingTextures.erase(it->second);
+    m_pendingRequestIds.erase(it);
+  }
+}
+
+void TextureResidency::addEntry(
+  const Texture& texture, const size_t size, const bool requested)
+{
+  assert(!isResident(texture));
+
+  m_entries.push_front(Entry{&texture, size, requested});
+  m_entryIndex.emplace(&texture, m_entries.begin());
+
+  ++m_stats.residentCount;
+  m_stats.residentBytes += size;
+}
+
+void TextureResidency::removeEntry(const Texture& texture)
+{
+  const auto it = m_entryIndex.find(&texture);
+  assert(it != m_entryIndex.end());
+
+  --m_stats.residentCount;
+  m_stats.residentBytes -= it->second->size;
+
+  m_entries.erase(it->second);
+  m_entryIndex.erase(it);
+}
+
+void TextureResidency::evictTextures()
+{
+  // the pixel data of requested textures is kept until they are uploaded
+  auto it = m_entries.end();
+  while (m_memoryBudget && m_stats.residentBytes > *m_memoryBudget
+         && it != m_entries.begin())
+  {
+    --it;
+    if (!it->requested)
+    {
+      const auto* texture = it->texture;
+      --m_stats.residentCount;
+      m_stats.residentBytes -= it->size;
+
+      m_entryIndex.erase(texture);
+      it = m_entries.erase(it);
+      texture->evict();
+
+      ++m_stats.evictions;
+    }
+  }
+}
+
+} // namespace TrenchBroom::Assets
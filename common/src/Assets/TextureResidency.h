@@ -0,0 +1,161 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace kdl
+{
+class thread_pool;
+}
+
+namespace TrenchBroom::Assets
+{
+class Texture;
+
+struct TextureResidencyStats
+{
+  /**
+   * The number of bytes of pixel data that were decoded on demand.
+   */
+  size_t decodedBytes = 0;
+
+  /**
+   * The number of textures and the number of bytes of pixel data that are currently held
+   * in memory, waiting to be uploaded.
+   */
+  size_t residentCount = 0;
+  size_t residentBytes = 0;
+
+  /**
+   * The number of textures that were uploaded from pixel data held in memory (hits), and
+   * the number of textures whose pixel data had to be loaded before they could be
+   * uploaded (misses).
+   */
+  size_t hits = 0;
+  size_t misses = 0;
+
+  /**
+   * The number of textures whose pixel data was released to stay within the memory
+   * budget.
+   */
+  size_t evictions = 0;
+};
+
+/**
+ * Keeps track of the pixel data that textures hold in memory until they are uploaded,
+ * and loads missing pixel data when a texture is used.
+ *
+ * Only textures that can reload their pixel data are tracked, see Texture::setLoader.
+ * When the pixel data exceeds the memory budget, the pixel data of the least recently
+ * loaded textures is released, and it is loaded again when the texture is next used.
+ * The pixel data of textures that were requested for rendering is never released before
+ * they are uploaded, so the budget may be exceeded by these textures.
+ *
+ * If a callback is set, missing pixel data is decoded by worker threads, otherwise it is
+ * decoded synchronously when it is requested. The texture files are opened on the calling
+ * thread, so the workers never access the game file system.
+ *
+ * Must only be used on the thread that owns the OpenGL context.
+ */
+class TextureResidency
+{
+private:
+  struct Entry
+  {
+    const Texture* texture;
+    size_t size;
+    bool requested;
+  };
+
+  struct DecodeState;
+
+  std::optional<size_t> m_memoryBudget;
+
+  // the textures holding pixel data, the most recently loaded first
+  std::list<Entry> m_entries;
+  std::unordered_map<const Texture*, std::list<Entry>::iterator> m_entryIndex;
+
+  std::function<void()> m_texturesDecodedCallback;
+  std::unique_ptr<kdl::thread_pool> m_decodePool;
+  std::shared_ptr<DecodeState> m_decodeState;
+
+  // the textures whose pixel data is being decoded in the background, by request id
+  std::unordered_map<const Texture*, size_t> m_pendingRequestIds;
+  std::unordered_map<size_t, const Texture*> m_pendingTextures;
+  size_t m_nextRequestId = 0;
+
+  TextureResidencyStats m_stats;
+
+public:
+  TextureResidency();
+  ~TextureResidency();
+
+  /**
+   * Sets the maximum number of bytes of pixel data that textures may hold in memory, or
+   * removes the limit if the given value is empty. Pixel data exceeding the budget is
+   * released immediately.
+   */
+  void setMemoryBudget(std::optional<size_t> memoryBudget);
+  const std::optional<size_t>& memoryBudget() const;
+
+  /**
+   * Enables decoding pixel data in the background. The given callback is called on a
+   * worker thread when decoded pixel data is waiting to be committed, see
+   * commitDecodedTextures(). It is called once per batch, i.e. it is not called again
+   * until the waiting pixel data has been committed.
+   */
+  void setTexturesDecodedCallback(std::function<void()> texturesDecodedCallback);
+
+  /**
+   * Hands the pixel data that was decoded in the background to its textures. Returns the
+   * number of textures that can now be uploaded.
+   */
+  size_t commitDecodedTextures();
+
+  /**
+   * Discards all pending decode requests. Blocks until no pixel data is being decoded by
+   * a worker thread anymore.
+   */
+  void cancelDecoding();
+
+  const TextureResidencyStats& stats() const;
+  bool isResident(const Texture& texture) const;
+  bool isDecoding(const Texture& texture) const;
+
+  // called by Texture
+  void textureLoaded(const Texture& texture, size_t size);
+  void requestTexture(const Texture& texture);
+  void textureUploaded(const Texture& texture);
+  void textureMoved(const Texture& from, const Texture& to);
+  void textureReleased(const Texture& texture);
+
+private:
+  void addEntry(const Texture& texture, size_t size, bool requested);
+  void removeEntry(const Texture& texture);
+  void evictTextures();
+};
+
+} // namespace TrenchBroom::Assets
@@ -65,6 +65,12 @@ PathInfo DiskFileSystem::pathInfo(const std::filesystem::path& path) const
     .value();
 }
 
+Result<std::filesystem::path> DiskFileSystem::diskFilePath(
+  const std::filesystem::path& path) const
+{
+  return makeAbsolute(path).transform(Disk::fixPath);
+}
+
 Result<std::vector<std::filesystem::path>> DiskFileSystem::doFind(
   const std::filesystem::path& path, const TraversalMode traversalMode) const
 {
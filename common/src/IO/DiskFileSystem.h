@@ -42,6 +42,8 @@ public:
     const std::filesystem::path& path) const override;
 
   PathInfo pathInfo(const std::filesystem::path& path) const override;
+  Result<std::filesystem::path> diskFilePath(
+    const std::filesystem::path& path) const override;
 
 protected:
   Result<std::vector<std::filesystem::path>> doFind(
@@ -35,6 +35,7 @@ namespace TrenchBroom::IO
 {
 enum class TraversalMode;
 class CFile;
+class MappedFile;
 class File;
 enum class PathInfo;
 
@@ -52,6 +53,7 @@ Result<std::vector<std::filesystem::path>> find(
   const PathMatcher& pathMatcher = matchAnyPath);
 
 Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path);
+Result<std::shared_ptr<MappedFile>> mapFile(const std::filesystem::path& path);
 
 template <typename Stream, typename F>
 auto withStream(
@@ -132,23 +132,32 @@ Result<void> DkPakFileSystem::doReadDirectory()
       const auto entrySize = compressed ? compressedSize : uncompressedSize;
 
       const auto entryPath = std::filesystem::path(kdl::str_to_lower(entryName));
-      auto entryFile = std::make_shared<FileView>(m_file, entryAddress, entrySize);
 
       if (compressed)
       {
+        auto entryFile = std::make_shared<FileView>(m_file, entryAddress, entrySize);
         addFile(
           entryPath,
-          [entryFile = std::move(entryFile),
+          [file = m_file,
+           entryFile = std::move(entryFile),
            uncompressedSize]() -> Result<std::shared_ptr<File>> {
-            return decompress(entryFile, uncompressedSize).transform([&](auto data) {
-              return std::static_pointer_cast<File>(
-                std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
-            });
+            return file->checkUnchanged()
+              .and_then([&]() { return decompress(entryFile, uncompressedSize); })
+              .transform([&](auto data) {
+                return std::static_pointer_cast<File>(
+                  std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+              });
           });
       }
       else
       {
-        addFile(entryPath, [entryFile = std::move(entryFile)]() { return entryFile; });
+        addFile(
+          entryPath,
+          [file = m_file, entryAddress, entrySize]() -> Result<std::shared_ptr<File>> {
+            // the pak file remains mapped, so the entry is copied in case the pak file is
+            // truncated while the entry is still being read
+            return file->buffer(entryAddress, entrySize);
+          });
       }
     }
     return kdl::void_success;
@@ -27,9 +27,9 @@
 
 namespace TrenchBroom::IO
 {
-class CFile;
+class MappedFile;
 
-class DkPakFileSystem : public ImageFileSystem<CFile>
+class DkPakFileSystem : public ImageFileSystem<MappedFile>
 {
 public:
   using ImageFileSystem::ImageFileSystem;
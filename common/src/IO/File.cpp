@@ -23,8 +23,26 @@
 
 #include "kdl/result.h"
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <string>
 
 namespace TrenchBroom::IO
 {
@@ -195,6 +213,185 @@ Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path)
   });
 }
 
+namespace
+{
+// An empty file cannot be mapped, so empty files are represented by this buffer.
+const char EmptyFileData[1] = {0};
+
+#ifdef _WIN32
+Result<kdl::resource<const char*>> mapFile(
+  const std::filesystem::path& path, const size_t size)
+{
+  auto file = kdl::resource{
+    CreateFileW(
+      path.wstring().c_str(),
+      GENERIC_READ,
+      // let other programs modify, replace or delete the file while it is mapped
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr),
+    [](auto handle) {
+      if (handle != INVALID_HANDLE_VALUE)
+      {
+        CloseHandle(handle);
+      }
+    }};
+  if (*file == INVALID_HANDLE_VALUE)
+  {
+    return Error{"Cannot open file " + path.string()};
+  }
+
+  if (size == 0)
+  {
+    return kdl::resource<const char*>{EmptyFileData, [](auto) {}};
+  }
+
+  // the view keeps the mapping alive, so both handles can be closed once it is created
+  auto mapping = kdl::resource{
+    CreateFileMappingW(*file, nullptr, PAGE_READONLY, 0, 0, nullptr), [](auto handle) {
+      if (handle)
+      {
+        CloseHandle(handle);
+      }
+    }};
+  if (!*mapping)
+  {
+    return Error{"Cannot map file " + path.string()};
+  }
+
+  const auto* data =
+    static_cast<const char*>(MapViewOfFile(*mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!data)
+  {
+    return Error{"Cannot map file " + path.string()};
+  }
+
+  return kdl::resource<const char*>{
+    data, [](auto view) { UnmapViewOfFile(static_cast<const void*>(view)); }};
+}
+#else
+Result<kdl::resource<const char*>> mapFile(
+  const std::filesystem::path& path, const size_t size)
+{
+  auto file = kdl::resource{::open(path.c_str(), O_RDONLY), [](auto fd) {
+                              if (fd >= 0)
+                              {
+                                ::close(fd);
+                              }
+                            }};
+  if (*file < 0)
+  {
+    return Error{"Cannot open file " + path.string() + ": " + std::strerror(errno)};
+  }
+
+  if (size == 0)
+  {
+    return kdl::resource<const char*>{EmptyFileData, [](auto) {}};
+  }
+
+  // the mapping remains valid after the file descriptor is closed
+  auto* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, *file, 0);
+  if (data == MAP_FAILED)
+  {
+    return Error{"Cannot map file " + path.string() + ": " + std::strerror(errno)};
+  }
+
+  return kdl::resource<const char*>{static_cast<const char*>(data), [size](auto view) {
+                                      ::munmap(const_cast<char*>(view), size);
+                                    }};
+}
+#endif
+} // namespace
+
+MappedFile::MappedFile(
+  std::filesystem::path path,
+  kdl::resource<const char*> data,
+  const size_t size,
+  const std::filesystem::file_time_type modificationTime)
+  : m_path{std::move(path)}
+  , m_data{std::move(data)}
+  , m_size{size}
+  , m_modificationTime{modificationTime}
+{
+}
+
+Reader MappedFile::reader() const
+{
+  return Reader::from(begin(), end());
+}
+
+size_t MappedFile::size() const
+{
+  return m_size;
+}
+
+const std::filesystem::path& MappedFile::path() const
+{
+  return m_path;
+}
+
+const char* MappedFile::begin() const
+{
+  return *m_data;
+}
+
+const char* MappedFile::end() const
+{
+  return *m_data + m_size;
+}
+
+Result<void> MappedFile::checkUnchanged() const
+{
+  auto error = std::error_code{};
+  const auto size = std::filesystem::file_size(m_path, error);
+  const auto modificationTime =
+    !error ? std::filesystem::last_write_time(m_path, error)
+           : std::filesystem::file_time_type{};
+  if (error || size != m_size || modificationTime != m_modificationTime)
+  {
+    return Error{"File " + m_path.string() + " was changed on the disk"};
+  }
+  return kdl::void_success;
+}
+
+Result<std::shared_ptr<File>> MappedFile::buffer(
+  const size_t position, const size_t size) const
+{
+  if (position > m_size || size > m_size - position)
+  {
+    return Error{
+      "Cannot read " + std::to_string(size) + " bytes at position "
+      + std::to_string(position) + " of file " + m_path.string()};
+  }
+
+  return checkUnchanged().transform([&]() {
+    auto buffer = std::make_unique<char[]>(size);
+    std::copy_n(begin() + position, size, buffer.get());
+    return std::static_pointer_cast<File>(
+      std::make_shared<OwningBufferFile>(std::move(buffer), size));
+  });
+}
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path)
+{
+  auto error = std::error_code{};
+  const auto size = std::filesystem::file_size(path, error);
+  const auto modificationTime = !error ? std::filesystem::last_write_time(path, error)
+                                       : std::filesystem::file_time_type{};
+  if (error)
+  {
+    return Error{"Cannot open file " + path.string() + ": " + error.message()};
+  }
+
+  return mapFile(path, size_t(size)).transform([&](auto data) {
+    // NOLINTNEXTLINE
+    return std::shared_ptr<MappedFile>{
+      new MappedFile{path, std::move(data), size_t(size), modificationTime}};
+  });
+}
+
 FileView::FileView(std::shared_ptr<File> file, const size_t offset, const size_t length)
   : m_file{std::move(file)}
   , m_offset{offset}
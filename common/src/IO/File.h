@@ -126,6 +126,75 @@ private:
 
 Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
 
+/**
+ * A file that is backed by a read only memory mapping of a physical file on the disk.
+ * The file is mapped in createMappedFile and unmapped in the destructor.
+ *
+ * Readers access the mapped memory directly, so multiple readers can be used
+ * concurrently, and neither buffering a reader nor creating a FileView copies any data.
+ *
+ * Other programs may modify the file while it is mapped. On Windows, the file cannot be
+ * truncated while it is mapped, but on POSIX systems, accessing mapped memory beyond the
+ * end of a truncated file raises SIGBUS. Therefore, files should only be kept mapped
+ * while they are read, and long lived mappings must be checked with checkUnchanged()
+ * before they are accessed again. Data that is handed out to be read later must be copied
+ * with buffer().
+ */
+class MappedFile : public File
+{
+private:
+  std::filesystem::path m_path;
+  kdl::resource<const char*> m_data;
+  size_t m_size;
+  std::filesystem::file_time_type m_modificationTime;
+
+  /**
+   * Creates a new file with the given path, mapped memory, size in bytes and the
+   * modification time of the file when it was mapped.
+   */
+  MappedFile(
+    std::filesystem::path path,
+    kdl::resource<const char*> data,
+    size_t size,
+    std::filesystem::file_time_type modificationTime);
+
+public:
+  friend Result<std::shared_ptr<MappedFile>> createMappedFile(
+    const std::filesystem::path& path);
+
+  Reader reader() const override;
+  size_t size() const override;
+
+  /**
+   * Returns the path of the mapped file on the disk.
+   */
+  const std::filesystem::path& path() const;
+
+  /**
+   * Returns the beginning of the mapped memory.
+   */
+  const char* begin() const;
+
+  /**
+   * Returns the end of the mapped memory.
+   */
+  const char* end() const;
+
+  /**
+   * Returns an error if the size or the modification time of the file on the disk
+   * changed since it was mapped. The mapped memory should not be accessed in that case.
+   */
+  Result<void> checkUnchanged() const;
+
+  /**
+   * Copies the given portion of the mapped memory into a new file. Returns an error if the
+   * portion is out of bounds or if the file was changed on the disk since it was mapped.
+   */
+  Result<std::shared_ptr<File>> buffer(size_t position, size_t size) const;
+};
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path);
+
 /**
  * A file that is backed by a portion of a physical file.
  */
@@ -38,6 +38,12 @@ namespace TrenchBroom::IO
 
 FileSystem::~FileSystem() = default;
 
+Result<std::filesystem::path> FileSystem::diskFilePath(
+  const std::filesystem::path& path) const
+{
+  return Error{"'" + path.string() + "' is not backed by a file on the disk"};
+}
+
 Result<std::vector<std::filesystem::path>> FileSystem::find(
   const std::filesystem::path& path,
   const TraversalMode traversalMode,
@@ -51,6 +51,15 @@ public:
    */
   virtual PathInfo pathInfo(const std::filesystem::path& path) const = 0;
 
+  /** Returns the path of the file on the disk that contains the file at the given path.
+   * This is either the file itself or the archive that contains it.
+   *
+   * @return the path of the file on the disk or an error if the file at the given path is
+   * not backed by a file on the disk
+   */
+  virtual Result<std::filesystem::path> diskFilePath(
+    const std::filesystem::path& path) const;
+
   /** Returns a vector of paths listing the contents of the directory  at the given path
    * that satisfy the given path matcher. The returned paths are relative to the root of
    * this file system.
@@ -64,11 +64,12 @@ Result<void> IdPakFileSystem::doReadDirectory()
       const auto entrySize = reader.readSize<int32_t>();
 
       const auto entryPath = std::filesystem::path{kdl::str_to_lower(entryName)};
-      auto entryFile = std::static_pointer_cast<File>(
-        std::make_shared<FileView>(m_file, entryAddress, entrySize));
       addFile(
-        entryPath, [entryFile = std::move(entryFile)]() -> Result<std::shared_ptr<File>> {
-          return entryFile;
+        entryPath,
+        [file = m_file, entryAddress, entrySize]() -> Result<std::shared_ptr<File>> {
+          // the pak file remains mapped, so the entry is copied in case the pak file is
+          // truncated while the entry is still being read
+          return file->buffer(entryAddress, entrySize);
         });
     }
 
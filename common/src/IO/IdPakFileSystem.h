@@ -27,9 +27,9 @@
 
 namespace TrenchBroom::IO
 {
-class CFile;
+class MappedFile;
 
-class IdPakFileSystem : public ImageFileSystem<CFile>
+class IdPakFileSystem : public ImageFileSystem<MappedFile>
 {
 public:
   using ImageFileSystem::ImageFileSystem;
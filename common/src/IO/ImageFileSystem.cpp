@@ -29,6 +29,8 @@
 #include "kdl/overload.h"
 #include "kdl/path_utils.h"
 #include "kdl/result.h"
+#include "kdl/string_compare.h"
+#include "kdl/string_format.h"
 
 #include <cassert>
 #include <memory>
@@ -56,86 +58,12 @@ bool isDirectory(const ImageEntry& entry)
 template <typename I>
 auto findEntry(I begin, I end, const std::filesystem::path& name)
 {
-  const auto nameLc = kdl::path_to_lower(name);
+  const auto nameStr = name.string();
   return std::find_if(begin, end, [&](const auto& entry) {
-    return kdl::path_to_lower(getName(entry)) == nameLc;
+    return kdl::ci::str_is_equal(getName(entry).string(), nameStr);
   });
 }
 
-template <typename F>
-auto withEntry(
-  const std::filesystem::path& searchPath,
-  const ImageEntry& currentEntry,
-  const std::filesystem::path& currentPath,
-  const F& f,
-  decltype(f(
-    std::declval<const ImageEntry&>(),
-    std::declval<const std::filesystem::path&>())) defaultResult)
-{
-  if (searchPath.empty())
-  {
-    return f(currentEntry, currentPath);
-  }
-
-  return std::visit(
-    kdl::overload(
-      [&](const ImageDirectoryEntry& directoryEntry) {
-        const auto name = kdl::path_front(searchPath);
-        const auto entryIt =
-          findEntry(directoryEntry.entries.begin(), directoryEntry.entries.end(), name);
-
-        return entryIt != directoryEntry.entries.end() ? withEntry(
-                 kdl::path_pop_front(searchPath),
-                 *entryIt,
-                 currentPath / name,
-                 f,
-                 defaultResult)
-                                                       : defaultResult;
-      },
-      [&](const ImageFileEntry&) { return defaultResult; }),
-    currentEntry);
-}
-
-template <typename F>
-void withEntry(
-  const std::filesystem::path& searchPath,
-  const ImageEntry& currentEntry,
-  const std::filesystem::path& currentPath,
-  const F& f)
-{
-  if (searchPath.empty())
-  {
-    f(currentEntry, currentPath);
-  }
-  else
-  {
-    std::visit(
-      kdl::overload(
-        [&](const ImageDirectoryEntry& directoryEntry) {
-          const auto name = kdl::path_front(searchPath);
-          const auto entryIt =
-            findEntry(directoryEntry.entries.begin(), directoryEntry.entries.end(), name);
-
-          if (entryIt != directoryEntry.entries.end())
-          {
-            withEntry(kdl::path_pop_front(searchPath), *entryIt, currentPath / name, f);
-          }
-        },
-        [&](const ImageFileEntry&) {}),
-      currentEntry);
-  }
-}
-
-const ImageEntry* findEntry(const std::filesystem::path& path, const ImageEntry& parent)
-{
-  return withEntry(
-    path,
-    parent,
-    std::filesystem::path{},
-    [](const ImageEntry& entry, const std::filesystem::path&) { return &entry; },
-    nullptr);
-}
-
 ImageDirectoryEntry& findOrCreateDirectory(
   const std::filesystem::path& path, ImageDirectoryEntry& parent)
 {
@@ -168,10 +96,40 @@ ImageDirectoryEntry& findOrCreateDirectory(
         parent.entries.emplace_back(ImageDirectoryEntry{std::move(name), {}})));
   }
 }
+void buildIndex(const ImageEntry& entry, const std::string& key, ImagePathIndex& index)
+{
+  index[key] = &entry;
+  std::visit(
+    kdl::overload(
+      [&](const ImageDirectoryEntry& directoryEntry) {
+        for (const auto& childEntry : directoryEntry.entries)
+        {
+          const auto childName = kdl::str_to_lower(getName(childEntry).string());
+          buildIndex(childEntry, key.empty() ? childName : key + "/" + childName, index);
+        }
+      },
+      [](const ImageFileEntry&) {}),
+    entry);
+}
 } // namespace
 
+std::string makePathIndexKey(const std::filesystem::path& path)
+{
+  auto key = std::string{};
+  for (auto it = path.begin(); it != path.end(); ++it)
+  {
+    if (it != path.begin())
+    {
+      key += '/';
+    }
+    key += it->string();
+  }
+  return kdl::str_to_lower(key);
+}
+
 ImageFileSystemBase::ImageFileSystemBase()
   : m_root{ImageDirectoryEntry{{}, {}}}
+  , m_index{{std::string{}, &m_root}}
 {
 }
 
@@ -186,7 +144,21 @@ Result<std::filesystem::path> ImageFileSystemBase::makeAbsolute(
 Result<void> ImageFileSystemBase::reload()
 {
   m_root = ImageDirectoryEntry{{}, {}};
-  return doReadDirectory();
+  m_index = {{std::string{}, &m_root}};
+
+  auto result = doReadDirectory();
+
+  // the entries are stored in vectors, so they can only be indexed once all of them have
+  // been added
+  m_index.clear();
+  buildIndex(m_root, std::string{}, m_index);
+
+  return result;
+}
+
+const ImagePathIndex& ImageFileSystemBase::index() const
+{
+  return m_index;
 }
 
 void ImageFileSystemBase::addFile(const std::filesystem::path& path, GetImageFile getFile)
@@ -210,11 +182,18 @@ void ImageFileSystemBase::addFile(const std::filesystem::path& path, GetImageFil
 
 PathInfo ImageFileSystemBase::pathInfo(const std::filesystem::path& path) const
 {
-  const auto* entry = findEntry(path, m_root);
+  const auto* entry = findEntryByPath(path);
   return entry ? isDirectory(*entry) ? PathInfo::Directory : PathInfo::File
                : PathInfo::Unknown;
 }
 
+const ImageEntry* ImageFileSystemBase::findEntryByPath(
+  const std::filesystem::path& path) const
+{
+  const auto it = m_index.find(makePathIndexKey(path));
+  return it != m_index.end() ? it->second : nullptr;
+}
+
 namespace
 {
 void doFindImpl(
@@ -245,33 +224,30 @@ Result<std::vector<std::filesystem::path>> ImageFileSystemBase::doFind(
   const std::filesystem::path& path, const TraversalMode traversalMode) const
 {
   auto result = std::vector<std::filesystem::path>{};
-  withEntry(
-    path,
-    m_root,
-    {},
-    [&](const ImageEntry& entry, const std::filesystem::path& entryPath) {
-      doFindImpl(entry, entryPath, traversalMode, result);
-    });
+  if (const auto* entry = findEntryByPath(path))
+  {
+    doFindImpl(*entry, path, traversalMode, result);
+  }
   return result;
 }
 
 Result<std::shared_ptr<File>> ImageFileSystemBase::doOpenFile(
   const std::filesystem::path& path) const
 {
-  return withEntry(
-    path,
-    m_root,
-    std::filesystem::path{},
-    [&](const ImageEntry& entry, const std::filesystem::path&) {
-      return std::visit(
-        kdl::overload(
-          [&](const ImageDirectoryEntry&) {
-            return Result<std::shared_ptr<File>>{
-              Error{"Cannot open directory entry at '" + path.string() + "'"}};
-          },
-          [](const ImageFileEntry& fileEntry) { return fileEntry.getFile(); }),
-        entry);
-    },
-    Result<std::shared_ptr<File>>{Error{"'" + path.string() + "' not found"}});
+  const auto* entry = findEntryByPath(path);
+  if (!entry)
+  {
+    return Error{"'" + path.string() + "' not found"};
+  }
+
+  return std::visit(
+    kdl::overload(
+      [&](const ImageDirectoryEntry&) {
+        return Result<std::shared_ptr<File>>{
+          Error{"Cannot open directory entry at '" + path.string() + "'"}};
+      },
+      [](const ImageFileEntry& fileEntry) { return fileEntry.getFile(); }),
+    *entry);
 }
+
 } // namespace TrenchBroom::IO
@@ -22,6 +22,7 @@
 #include "Ensure.h"
 #include "Error.h"
 #include "IO/FileSystem.h"
+#include "IO/PathInfo.h"
 #include "Result.h"
 
 #include "kdl/result.h"
@@ -30,11 +31,12 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <variant>
 
 namespace TrenchBroom::IO
 {
-class CFile;
 class File;
 
 using GetImageFile = std::function<Result<std::shared_ptr<File>>()>;
@@ -54,11 +56,24 @@ struct ImageDirectoryEntry
   std::vector<ImageEntry> entries;
 };
 
+/**
+ * Returns the key under which the given path is stored in the path indices of the image
+ * and virtual file systems. The key is the lower case path with its components joined
+ * by '/'.
+ */
+std::string makePathIndexKey(const std::filesystem::path& path);
+
+using ImagePathIndex = std::unordered_map<std::string, const ImageEntry*>;
+
 class ImageFileSystemBase : public FileSystem
 {
 protected:
   ImageEntry m_root;
 
+private:
+  ImagePathIndex m_index;
+
+protected:
   ImageFileSystemBase();
 
 public:
@@ -72,17 +87,30 @@ public:
    */
   Result<void> reload();
 
+  /**
+   * Returns the index of all entries in this file system by their path index key. The
+   * index is rebuilt after each reload.
+   */
+  const ImagePathIndex& index() const;
+
 protected:
   void addFile(const std::filesystem::path& path, GetImageFile getFile);
 
   PathInfo pathInfo(const std::filesystem::path& path) const override;
 
 private:
+  const ImageEntry* findEntryByPath(const std::filesystem::path& path) const;
+
   Result<std::vector<std::filesystem::path>> doFind(
     const std::filesystem::path& path, TraversalMode traversalMode) const override;
   Result<std::shared_ptr<File>> doOpenFile(
     const std::filesystem::path& path) const override;
 
+  /**
+   * Adds the entries of this file system by calling addFile. The path index is only
+   * rebuilt once this function returns, so subclasses cannot use it to look up the files
+   * they have added so far.
+   */
   virtual Result<void> doReadDirectory() = 0;
 };
 
@@ -92,12 +120,35 @@ class ImageFileSystem : public ImageFileSystemBase
 protected:
   std::shared_ptr<FileType> m_file;
 
+private:
+  std::filesystem::path m_diskPath;
+
 public:
-  explicit ImageFileSystem(std::shared_ptr<FileType> file)
+  /**
+   * Creates a file system that reads the given file, which was loaded from the given path
+   * on the disk.
+   */
+  ImageFileSystem(std::shared_ptr<FileType> file, std::filesystem::path diskPath)
     : m_file{std::move(file)}
+    , m_diskPath{std::move(diskPath)}
   {
     ensure(m_file, "file must not be null");
   }
+
+  explicit ImageFileSystem(std::shared_ptr<FileType> file)
+    : ImageFileSystem{file, file ? file->path() : std::filesystem::path{}}
+  {
+  }
+
+  Result<std::filesystem::path> diskFilePath(
+    const std::filesystem::path& path) const override
+  {
+    if (pathInfo(path) != PathInfo::File)
+    {
+      return Error{"'" + path.string() + "' not found"};
+    }
+    return m_diskPath;
+  }
 };
 
 template <typename T, typename... Args>
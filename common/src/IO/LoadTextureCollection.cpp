@@ -35,6 +35,7 @@
 #include "IO/ReadQuake3ShaderTexture.h"
 #include "IO/ReadWalTexture.h"
 #include "IO/ResourceUtils.h"
+#include "IO/TextureMetadataCache.h"
 #include "IO/TextureUtils.h"
 #include "IO/TraversalMode.h"
 #include "Logger.h"
@@ -49,8 +50,10 @@
 #include "kdl/string_format.h"
 #include "kdl/vector_utils.h"
 
+#include <optional>
 #include <ostream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom::IO
@@ -151,6 +154,84 @@ Result<ReadTextureFunc> makeReadTextureFunc(
     });
 }
 
+std::vector<Assets::TextureBuffer> takeBuffers(
+  Result<Assets::Texture, ReadTextureError> texture)
+{
+  return std::move(texture)
+    .transform([](auto t) { return t.takeBuffers(); })
+    .value_or(std::vector<Assets::TextureBuffer>{});
+}
+
+/**
+ * Opens the texture file on the thread that calls the loader and decodes it in the
+ * returned decoder. A Quake 3 shader is resolved to its image file by the loader because
+ * locating the image requires the game file system.
+ */
+Assets::TextureLoader makeTextureLoader(
+  const FileSystem& gameFS, ReadTextureFunc readTexture, std::filesystem::path path)
+{
+  return [&gameFS, readTexture = std::move(readTexture), path = std::move(path)]() {
+    if (path.extension().empty())
+    {
+      return gameFS.openFile(path)
+        .and_then([&](auto file) { return findQuake3ShaderImagePath(*file, gameFS); })
+        .and_then([&](auto imagePath) { return gameFS.openFile(imagePath); })
+        .transform([](auto imageFile) -> Assets::TextureDecoder {
+          return [imageFile = std::move(imageFile)]() {
+            auto reader = imageFile->reader().buffer();
+            return takeBuffers(readFreeImageTexture("", reader));
+          };
+        })
+        .value_or(Assets::TextureDecoder{});
+    }
+
+    return gameFS.openFile(path)
+      .transform([&](auto file) -> Assets::TextureDecoder {
+        return [readTexture, path, file = std::move(file)]() {
+          return takeBuffers(readTexture(*file, path));
+        };
+      })
+      .value_or(Assets::TextureDecoder{});
+  };
+}
+
+/**
+ * Returns the stamp of the given palette file or "-" if the file is not backed by a file
+ * on the disk.
+ */
+std::string makePaletteStamp(const FileSystem& gameFS, const std::filesystem::path& path)
+{
+  return gameFS.diskFilePath(path)
+    .and_then([](const auto& diskPath) { return makeFileStamp(diskPath); })
+    .value_or("-");
+}
+
+/**
+ * Returns the key and the stamp of the metadata cache entry for the texture at the given
+ * path, or nothing if the texture cannot be cached.
+ */
+std::optional<std::tuple<std::string, std::string>> makeCacheEntryId(
+  const FileSystem& gameFS,
+  const std::filesystem::path& texturePath,
+  const std::string& paletteStamp)
+{
+  if (texturePath.extension().empty())
+  {
+    // shaders have properties that are not part of the cached metadata
+    return std::nullopt;
+  }
+
+  return gameFS.diskFilePath(texturePath)
+    .and_then([&](const auto& diskPath) {
+      return makeFileStamp(diskPath).transform([&](const auto& fileStamp) {
+        return std::optional{std::tuple{
+          diskPath.string() + "|" + texturePath.generic_string(),
+          fileStamp + "|" + paletteStamp}};
+      });
+    })
+    .value_or(std::nullopt);
+}
+
 } // namespace
 
 Result<std::vector<std::filesystem::path>> findTextureCollections(
@@ -171,7 +252,8 @@ Result<Assets::TextureCollection> loadTextureCollection(
   const std::filesystem::path& path,
   const FileSystem& gameFS,
   const Model::TextureConfig& textureConfig,
-  Logger&)
+  Logger&,
+  TextureMetadataCache* metadataCache)
 {
   if (gameFS.pathInfo(path) != PathInfo::Directory)
   {
@@ -192,25 +274,60 @@ Result<Assets::TextureCollection> loadTextureCollection(
     .join(makeReadTextureFunc(gameFS, textureConfig))
     .and_then([&](auto texturePaths, const auto& readTexture) {
       auto nullLogger = NullLogger{};
+      const auto paletteStamp = metadataCache && !textureConfig.palette.empty()
+                                  ? makePaletteStamp(gameFS, textureConfig.palette)
+                                  : std::string{"-"};
+      const auto prefixLength = kdl::path_length(textureConfig.root);
+
+      const auto finishTexture = [&](auto texture, const auto& texturePath) {
+        gameFS.makeAbsolute(texturePath)
+          .transform([&](auto absPath) { texture.setAbsolutePath(std::move(absPath)); })
+          .or_else([](auto) { return kdl::void_success; });
+        texture.setRelativePath(texturePath);
+
+        // the pixel data is loaded when the texture is used if it is not cached, or
+        // if it was released by the texture manager
+        texture.setLoader(makeTextureLoader(gameFS, readTexture, texturePath));
+        return texture;
+      };
+
       return kdl::fold_results(
                kdl::vec_parallel_transform(
                  std::move(texturePaths),
                  [&](const auto texturePath) {
+                   const auto cacheEntryId =
+                     metadataCache
+                       ? makeCacheEntryId(gameFS, texturePath, paletteStamp)
+                       : std::nullopt;
+
+                   if (cacheEntryId)
+                   {
+                     const auto& [key, stamp] = *cacheEntryId;
+                     if (const auto metadata = metadataCache->get(key, stamp))
+                     {
+                       return Result<Assets::Texture>{finishTexture(
+                         createTexture(
+                           getTextureNameFromPathSuffix(texturePath, prefixLength),
+                           *metadata),
+                         texturePath)};
+                     }
+                   }
+
                    return gameFS.openFile(texturePath)
                      .and_then([&](const auto& file) {
                        return readTexture(*file, texturePath)
                          .transform([&](auto texture) {
-                           gameFS.makeAbsolute(texturePath)
-                             .transform([&](auto absPath) {
-                               texture.setAbsolutePath(std::move(absPath));
-                             })
-                             .or_else([](auto) { return kdl::void_success; });
-                           texture.setRelativePath(texturePath);
-                           return texture;
+                           if (cacheEntryId)
+                           {
+                             const auto& [key, stamp] = *cacheEntryId;
+                             metadataCache->put(key, stamp, getTextureMetadata(texture));
+                           }
+                           return finishTexture(std::move(texture), texturePath);
                          });
                      })
                      .or_else(makeReadTextureErrorHandler(gameFS, nullLogger));
-                 }))
+                 },
+                 1))
         .transform([&](auto textures) {
           return Assets::TextureCollection{path, std::move(textures)};
         });
@@ -44,14 +44,21 @@ struct TextureConfig;
 namespace TrenchBroom::IO
 {
 class FileSystem;
+class TextureMetadataCache;
 
 Result<std::vector<std::filesystem::path>> findTextureCollections(
   const FileSystem& gameFS, const Model::TextureConfig& textureConfig);
 
+/**
+ * Loads the textures in the given directory. If a metadata cache is given, textures that
+ * were not modified since they were cached are created from their cached metadata
+ * without decoding them, and the metadata of all other textures is added to the cache.
+ */
 Result<Assets::TextureCollection> loadTextureCollection(
   const std::filesystem::path& path,
   const FileSystem& gameFS,
   const Model::TextureConfig& textureConfig,
-  Logger& logger);
+  Logger& logger,
+  TextureMetadataCache* metadataCache = nullptr);
 
 } // namespace TrenchBroom::IO
@@ -35,10 +35,14 @@
 #include "kdl/overload.h"
 #include "kdl/parallel.h"
 #include "kdl/string_format.h"
+#include "kdl/thread_pool.h"
 #include "kdl/vector_utils.h"
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <exception>
+#include <future>
 #include <iterator> // for std::ostreambuf_iterator
 #include <memory>
 #include <sstream>
@@ -276,27 +280,50 @@ private:
   }
 };
 
+namespace
+{
+/**
+ * Batches are serialized in the background using the virtual doWriteBrushFace, so the
+ * pending batch must be joined before the destructor of the concrete serializer runs.
+ * This also covers the case where endFile is never called, e.g. because writing failed.
+ */
+template <typename Serializer>
+class JoiningSerializer final : public Serializer
+{
+public:
+  using Serializer::Serializer;
+
+  ~JoiningSerializer() override { this->waitForPendingBatch(); }
+};
+
+template <typename Serializer>
+std::unique_ptr<NodeSerializer> makeSerializer(std::ostream& stream)
+{
+  return std::make_unique<JoiningSerializer<Serializer>>(stream);
+}
+} // namespace
+
 std::unique_ptr<NodeSerializer> MapFileSerializer::create(
   const Model::MapFormat format, std::ostream& stream)
 {
   switch (format)
   {
   case Model::MapFormat::Standard:
-    return std::make_unique<QuakeFileSerializer>(stream);
+    return makeSerializer<QuakeFileSerializer>(stream);
   case Model::MapFormat::Quake2:
     // TODO 2427: Implement Quake3 serializers and use them
   case Model::MapFormat::Quake3:
   case Model::MapFormat::Quake3_Legacy:
-    return std::make_unique<Quake2FileSerializer>(stream);
+    return makeSerializer<Quake2FileSerializer>(stream);
   case Model::MapFormat::Quake2_Valve:
   case Model::MapFormat::Quake3_Valve:
-    return std::make_unique<Quake2ValveFileSerializer>(stream);
+    return makeSerializer<Quake2ValveFileSerializer>(stream);
   case Model::MapFormat::Daikatana:
-    return std::make_unique<DaikatanaFileSerializer>(stream);
+    return makeSerializer<DaikatanaFileSerializer>(stream);
   case Model::MapFormat::Valve:
-    return std::make_unique<ValveFileSerializer>(stream);
+    return makeSerializer<ValveFileSerializer>(stream);
   case Model::MapFormat::Hexen2:
-    return std::make_unique<Hexen2FileSerializer>(stream);
+    return makeSerializer<Hexen2FileSerializer>(stream);
   case Model::MapFormat::Unknown:
     throw FileFormatException("Unknown map file format");
     switchDefault();
@@ -309,56 +336,48 @@ MapFileSerializer::MapFileSerializer(std::ostream& stream)
 {
 }
 
-void MapFileSerializer::doBeginFile(const std::vector<const Model::Node*>& rootNodes)
+MapFileSerializer::~MapFileSerializer() = default;
+
+void MapFileSerializer::waitForPendingBatch()
 {
-  ensure(m_nodeToPrecomputedString.empty(), "MapFileSerializer may not be reused");
-
-  // collect nodes
-  std::vector<std::variant<const Model::BrushNode*, const Model::PatchNode*>>
-    nodesToSerialize;
-  nodesToSerialize.reserve(rootNodes.size());
-
-  Model::Node::visitAll(
-    rootNodes,
-    kdl::overload(
-      [](auto&& thisLambda, const Model::WorldNode* world) {
-        world->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const Model::LayerNode* layer) {
-        layer->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const Model::GroupNode* group) {
-        group->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const Model::EntityNode* entity) {
-        entity->visitChildren(thisLambda);
-      },
-      [&](const Model::BrushNode* brush) { nodesToSerialize.push_back(brush); },
-      [&](const Model::PatchNode* patchNode) { nodesToSerialize.push_back(patchNode); }));
+  if (m_pendingBatch.valid())
+  {
+    m_pendingBatch.wait();
+  }
+}
 
-  // serialize brushes to strings in parallel
-  using Entry = std::pair<const Model::Node*, PrecomputedString>;
-  std::vector<Entry> result =
-    kdl::vec_parallel_transform(std::move(nodesToSerialize), [&](const auto& node) {
-      return std::visit(
-        kdl::overload(
-          [&](const Model::BrushNode* brushNode) {
-            return Entry{brushNode, writeBrushFaces(brushNode->brush())};
-          },
-          [&](const Model::PatchNode* patchNode) {
-            return Entry{patchNode, writePatch(patchNode->patch())};
-          }),
-        node);
-    });
+void MapFileSerializer::doBeginFile(const std::vector<const Model::Node*>& nodes)
+{
+  ensure(m_nodesToSerialize.empty(), "MapFileSerializer may not be reused");
+
+  m_nodesToSerialize.reserve(nodes.size());
+  for (const auto* node : nodes)
+  {
+    node->accept(kdl::overload(
+      [](const Model::WorldNode*) {},
+      [](const Model::LayerNode*) {},
+      [](const Model::GroupNode*) {},
+      [](const Model::EntityNode*) {},
+      [&](const Model::BrushNode* brush) { m_nodesToSerialize.push_back(brush); },
+      [&](const Model::PatchNode* patch) { m_nodesToSerialize.push_back(patch); }));
+  }
 
-  // move strings into a map
-  for (auto& entry : result)
+  m_nodeIndices.reserve(m_nodesToSerialize.size());
+  for (size_t i = 0; i < m_nodesToSerialize.size(); ++i)
   {
-    m_nodeToPrecomputedString.insert(std::move(entry));
+    std::visit(
+      [&](const auto* node) { m_nodeIndices.emplace(node, i); }, m_nodesToSerialize[i]);
   }
+
+  // the first batch is needed right away
+  m_currentBatch = writeBatch(0);
+  startPendingBatch(1);
 }
 
-void MapFileSerializer::doEndFile() {}
+void MapFileSerializer::doEndFile()
+{
+  waitForPendingBatch();
+}
 
 void MapFileSerializer::doBeginEntity(const Model::Node* /* node */)
 {
@@ -395,13 +414,9 @@ void MapFileSerializer::doBrush(const Model::BrushNode* brush)
   ++m_line;
 
   // write pre-serialized brush faces
-  auto it = m_nodeToPrecomputedString.find(brush);
-  ensure(
-    it != std::end(m_nodeToPrecomputedString),
-    "attempted to serialize a brush which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  const auto& brushString = precomputedString(brush);
+  m_stream << brushString.string;
+  m_line += brushString.lineCount;
 
   fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
   ++m_line;
@@ -423,13 +438,9 @@ void MapFileSerializer::doPatch(const Model::PatchNode* patchNode)
   m_startLineStack.push_back(m_line);
 
   // write pre-serialized patch
-  auto it = m_nodeToPrecomputedString.find(patchNode);
-  ensure(
-    it != std::end(m_nodeToPrecomputedString),
-    "attempted to serialize a patch which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  const auto& patchString = precomputedString(patchNode);
+  m_stream << patchString.string;
+  m_line += patchString.lineCount;
 
   setFilePosition(patchNode);
 }
@@ -448,6 +459,90 @@ size_t MapFileSerializer::startLine()
   return result;
 }
 
+const MapFileSerializer::PrecomputedString& MapFileSerializer::precomputedString(
+  const Model::Node* node)
+{
+  const auto it = m_nodeIndices.find(node);
+  ensure(
+    it != std::end(m_nodeIndices),
+    "attempted to serialize a node which was not passed to doBeginFile");
+
+  const auto index = it->second;
+  const auto batchIndex = index / BatchSize;
+  if (batchIndex != m_currentBatchIndex)
+  {
+    if (m_pendingBatch.valid() && m_pendingBatchIndex == batchIndex)
+    {
+      m_currentBatch = m_pendingBatch.get();
+    }
+    else
+    {
+      // the nodes are not written in the order in which they were collected
+      waitForPendingBatch();
+      m_currentBatch = writeBatch(batchIndex);
+    }
+
+    m_currentBatchIndex = batchIndex;
+    startPendingBatch(batchIndex + 1);
+  }
+
+  return m_currentBatch[index - batchIndex * BatchSize];
+}
+
+void MapFileSerializer::startPendingBatch(const size_t batchIndex)
+{
+  auto& threadPool = kdl::default_thread_pool();
+
+  // a worker thread must not wait for a task that may be queued behind it
+  if (batchIndex * BatchSize < m_nodesToSerialize.size() && !threadPool.is_worker_thread())
+  {
+    auto promise = std::make_shared<std::promise<Batch>>();
+    m_pendingBatch = promise->get_future();
+    m_pendingBatchIndex = batchIndex;
+
+    threadPool.submit([this, promise, batchIndex]() {
+      try
+      {
+        promise->set_value(writeBatch(batchIndex));
+      }
+      catch (...)
+      {
+        promise->set_exception(std::current_exception());
+      }
+    });
+  }
+  else
+  {
+    m_pendingBatch = {};
+  }
+}
+
+/**
+ * Threadsafe
+ */
+MapFileSerializer::Batch MapFileSerializer::writeBatch(const size_t batchIndex) const
+{
+  const auto first = std::min(batchIndex * BatchSize, m_nodesToSerialize.size());
+  const auto last = std::min(first + BatchSize, m_nodesToSerialize.size());
+
+  // serialize brushes to strings in parallel
+  return kdl::vec_parallel_transform(
+    std::vector<NodeToSerialize>(
+      std::next(m_nodesToSerialize.begin(), static_cast<std::ptrdiff_t>(first)),
+      std::next(m_nodesToSerialize.begin(), static_cast<std::ptrdiff_t>(last))),
+    [&](const auto& node) {
+      return std::visit(
+        kdl::overload(
+          [&](const Model::BrushNode* brushNode) {
+            return writeBrushFaces(brushNode->brush());
+          },
+          [&](const Model::PatchNode* patchNode) {
+            return writePatch(patchNode->patch());
+          }),
+        node);
+    });
+}
+
 /**
  * Threadsafe
  */
@@ -22,8 +22,11 @@
 #include "IO/NodeSerializer.h"
 #include "Model/MapFormat.h"
 
+#include <future>
 #include <iosfwd>
 #include <memory>
+#include <unordered_map>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom
@@ -54,17 +57,46 @@ private:
     std::string string;
     size_t lineCount;
   };
-  std::unordered_map<const Model::Node*, PrecomputedString> m_nodeToPrecomputedString;
+
+  /**
+   * Brushes and patches are serialized to strings in parallel, in batches of BatchSize
+   * nodes. While the nodes of one batch are written to the stream, the next batch is
+   * serialized in the background. This bounds the memory used for the precomputed
+   * strings by two batches.
+   */
+  static constexpr size_t BatchSize = 4096;
+
+  using NodeToSerialize =
+    std::variant<const Model::BrushNode*, const Model::PatchNode*>;
+  using Batch = std::vector<PrecomputedString>;
+
+  std::vector<NodeToSerialize> m_nodesToSerialize;
+  std::unordered_map<const Model::Node*, size_t> m_nodeIndices;
+
+  size_t m_currentBatchIndex = 0;
+  Batch m_currentBatch;
+  size_t m_pendingBatchIndex = 0;
+  std::future<Batch> m_pendingBatch;
 
 public:
   static std::unique_ptr<NodeSerializer> create(
     Model::MapFormat format, std::ostream& stream);
 
+  ~MapFileSerializer() override;
+
 protected:
   explicit MapFileSerializer(std::ostream& stream);
 
+  /**
+   * Waits until the batch that is being serialized in the background is done.
+   *
+   * Called by doEndFile, and by the serializers returned from create before any part of
+   * them is destroyed.
+   */
+  void waitForPendingBatch();
+
 private:
-  void doBeginFile(const std::vector<const Model::Node*>& rootNodes) override;
+  void doBeginFile(const std::vector<const Model::Node*>& nodes) override;
   void doEndFile() override;
 
   void doBeginEntity(const Model::Node* node) override;
@@ -79,9 +111,13 @@ private:
   void setFilePosition(const Model::Node* node);
   size_t startLine();
 
+  const PrecomputedString& precomputedString(const Model::Node* node);
+  void startPendingBatch(size_t batchIndex);
+
 private: // threadsafe
   virtual void doWriteBrushFace(
     std::ostream& stream, const Model::BrushFace& face) const = 0;
+  Batch writeBatch(size_t batchIndex) const;
   PrecomputedString writeBrushFaces(const Model::Brush& brush) const;
   PrecomputedString writePatch(const Model::BezierPatch& patch) const;
 };
@@ -58,7 +58,7 @@ protected: // subclassing interface for users of the parser
     const vm::vec3& point1,
     const vm::vec3& point2,
     const vm::vec3& point3,
-    const Model::BrushFaceAttributes& attribs,
+    Model::BrushFaceAttributes attribs,
     ParserStatus& status) = 0;
   virtual void onValveBrushFace(
     size_t line,
@@ -66,7 +66,7 @@ protected: // subclassing interface for users of the parser
     const vm::vec3& point1,
     const vm::vec3& point2,
     const vm::vec3& point3,
-    const Model::BrushFaceAttributes& attribs,
+    Model::BrushFaceAttributes attribs,
     const vm::vec3& texAxisX,
     const vm::vec3& texAxisY,
     ParserStatus& status) = 0;
@@ -20,6 +20,8 @@
 #include "MapReader.h"
 
 #include "Error.h"
+#include "Exceptions.h"
+#include "IO/BufferedParserStatus.h"
 #include "IO/ParserStatus.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
@@ -45,10 +47,12 @@
 #include "vm/mat.h"
 #include "vm/mat_io.h"
 
+#include <algorithm>
 #include <cassert>
 #include <optional>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -60,16 +64,28 @@ MapReader::MapReader(
   std::string_view str,
   const Model::MapFormat sourceMapFormat,
   const Model::MapFormat targetMapFormat,
-  Model::EntityPropertyConfig entityPropertyConfig)
-  : StandardMapParser{std::move(str), sourceMapFormat, targetMapFormat}
+  Model::EntityPropertyConfig entityPropertyConfig,
+  const size_t line,
+  const size_t column)
+  : StandardMapParser{str, sourceMapFormat, targetMapFormat, line, column}
+  , m_str{str}
   , m_entityPropertyConfig{std::move(entityPropertyConfig)}
 {
 }
 
+void MapReader::setParserChunkCount(const size_t parserChunkCount)
+{
+  assert(parserChunkCount > 0);
+  m_parserChunkCount = parserChunkCount;
+}
+
 void MapReader::readEntities(const vm::bbox3& worldBounds, ParserStatus& status)
 {
   m_worldBounds = worldBounds;
-  parseEntities(status);
+  if (!parseEntitiesInChunks(status))
+  {
+    parseEntities(status);
+  }
   createNodes(status);
 }
 
@@ -89,12 +105,12 @@ void MapReader::readBrushFaces(const vm::bbox3& worldBounds, ParserStatus& statu
 // implement MapParser interface
 
 void MapReader::onBeginEntity(
-  const size_t /* line */,
+  const size_t line,
   std::vector<Model::EntityProperty> properties,
   ParserStatus& /* status */)
 {
   m_currentEntityInfo = m_objectInfos.size();
-  m_objectInfos.emplace_back(EntityInfo{std::move(properties), 0, 0});
+  m_objectInfos.emplace_back(EntityInfo{std::move(properties), line, 0});
 }
 
 void MapReader::onEndEntity(
@@ -131,10 +147,11 @@ void MapReader::onStandardBrushFace(
   const vm::vec3& point1,
   const vm::vec3& point2,
   const vm::vec3& point3,
-  const Model::BrushFaceAttributes& attribs,
+  Model::BrushFaceAttributes attribs,
   ParserStatus& status)
 {
-  Model::BrushFace::createFromStandard(point1, point2, point3, attribs, targetMapFormat)
+  Model::BrushFace::createFromStandard(
+    point1, point2, point3, std::move(attribs), targetMapFormat)
     .transform([&](auto face) {
       face.setFilePosition(line, 1u);
       onBrushFace(std::move(face), status);
@@ -148,13 +165,13 @@ void MapReader::onValveBrushFace(
   const vm::vec3& point1,
   const vm::vec3& point2,
   const vm::vec3& point3,
-  const Model::BrushFaceAttributes& attribs,
+  Model::BrushFaceAttributes attribs,
   const vm::vec3& texAxisX,
   const vm::vec3& texAxisY,
   ParserStatus& status)
 {
   Model::BrushFace::createFromValve(
-    point1, point2, point3, attribs, texAxisX, texAxisY, targetMapFormat)
+    point1, point2, point3, std::move(attribs), texAxisX, texAxisY, targetMapFormat)
     .transform([&](Model::BrushFace&& face) {
       face.setFilePosition(line, 1u);
       onBrushFace(std::move(face), status);
@@ -184,6 +201,160 @@ void MapReader::onPatch(
 
 // helper methods
 
+namespace
+{
+/**
+ * Inputs smaller than this are parsed sequentially by default, since the overhead of
+ * parsing them in parallel would outweigh the gain.
+ */
+constexpr auto MinParserChunkSize = size_t(1) << 20;
+
+size_t defaultParserChunkSize(const size_t length)
+{
+  // use more chunks than threads to balance the load between the threads
+  const auto threadCount =
+    std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+  return std::max(length / (4 * threadCount), MinParserChunkSize);
+}
+
+/**
+ * The objects recorded when parsing a chunk. The parent indices of brush and patch infos
+ * refer to the entity infos of the chunk, except for those of brushes and patches that
+ * belong to an entity begun in a preceding chunk; these have no parent index.
+ */
+struct ChunkInfo
+{
+  std::vector<MapReader::ObjectInfo> objectInfos;
+  std::optional<size_t> inheritedEntityEndLine;
+};
+} // namespace
+
+/**
+ * Parses a single chunk on a worker thread. Only the MapParser callbacks of the reader
+ * are used; the node callbacks are never called because no nodes are created.
+ */
+class MapReader::ChunkReader : public MapReader
+{
+private:
+  bool m_beginsInsideEntity;
+
+public:
+  ChunkReader(
+    const MapChunk& chunk,
+    const Model::MapFormat sourceMapFormat,
+    const Model::MapFormat targetMapFormat)
+    : MapReader{chunk.str, sourceMapFormat, targetMapFormat, {}, chunk.line, chunk.column}
+    , m_beginsInsideEntity{chunk.beginsInsideEntity}
+  {
+  }
+
+  ChunkInfo read(ParserStatus& status)
+  {
+    auto inheritedEntityEndLine =
+      m_beginsInsideEntity ? parseEntityTail(status) : std::nullopt;
+    parseEntities(status);
+    return {std::move(m_objectInfos), inheritedEntityEndLine};
+  }
+
+private:
+  Model::Node* onWorldNode(std::unique_ptr<Model::WorldNode>, ParserStatus&) override
+  {
+    return nullptr;
+  }
+
+  void onLayerNode(std::unique_ptr<Model::Node>, ParserStatus&) override {}
+
+  void onNode(Model::Node*, std::unique_ptr<Model::Node>, ParserStatus&) override {}
+};
+
+/**
+ * The chunks are parsed into separate object info vectors, which are then concatenated.
+ * Since the parent indices of brush and patch infos are relative to their chunk, they are
+ * offset by the number of object infos of the preceding chunks. Brushes and patches that
+ * belong to an entity begun in a preceding chunk are assigned to the last entity info of
+ * the preceding chunks.
+ *
+ * The messages logged while parsing a chunk are buffered and reported in the order of
+ * the chunks, so the reported messages are the same as if the input was parsed
+ * sequentially. If parsing any chunk fails, all results are discarded and the input is
+ * parsed sequentially to report the error.
+ */
+bool MapReader::parseEntitiesInChunks(ParserStatus& status)
+{
+  const auto chunkSize = m_parserChunkCount ? m_str.size() / *m_parserChunkCount + 1
+                                            : defaultParserChunkSize(m_str.size());
+  const auto chunks = splitIntoChunks(m_str, chunkSize);
+  if (chunks.size() < 2)
+  {
+    return false;
+  }
+
+  auto chunkStatuses = std::vector<BufferedParserStatus>{};
+  chunkStatuses.reserve(chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    chunkStatuses.emplace_back(status);
+  }
+
+  auto chunkInfos = std::vector<std::optional<ChunkInfo>>(chunks.size());
+  // every chunk is a large unit of work, so schedule them individually
+  kdl::parallel_for(
+    chunks.size(),
+    [&](const size_t i) {
+      try
+      {
+        auto reader = ChunkReader{chunks[i], m_sourceMapFormat, m_targetMapFormat};
+        chunkInfos[i] = reader.read(chunkStatuses[i]);
+      }
+      catch (const ParserException&)
+      {
+        // the error is reported when the input is parsed sequentially
+      }
+    },
+    1);
+
+  if (!std::all_of(chunkInfos.begin(), chunkInfos.end(), [](const auto& chunkInfo) {
+        return chunkInfo.has_value();
+      }))
+  {
+    return false;
+  }
+
+  auto openEntityInfo = std::optional<size_t>{};
+  for (auto& chunkInfo : chunkInfos)
+  {
+    const auto offset = m_objectInfos.size();
+
+    if (chunkInfo->inheritedEntityEndLine)
+    {
+      assert(openEntityInfo != std::nullopt);
+      auto& entity = std::get<EntityInfo>(m_objectInfos[*openEntityInfo]);
+      entity.lineCount = *chunkInfo->inheritedEntityEndLine - entity.startLine;
+    }
+
+    for (auto& objectInfo : chunkInfo->objectInfos)
+    {
+      std::visit(
+        kdl::overload(
+          [&](EntityInfo&) { openEntityInfo = m_objectInfos.size(); },
+          [&](auto& brushOrPatchInfo) {
+            brushOrPatchInfo.parentIndex = brushOrPatchInfo.parentIndex
+                                             ? *brushOrPatchInfo.parentIndex + offset
+                                             : openEntityInfo;
+          }),
+        objectInfo);
+      m_objectInfos.push_back(std::move(objectInfo));
+    }
+  }
+
+  for (auto& chunkStatus : chunkStatuses)
+  {
+    chunkStatus.flush();
+  }
+
+  return true;
+}
+
 namespace
 {
 /** The type of a node's container. */
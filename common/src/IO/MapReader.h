@@ -65,7 +65,8 @@ class ParserStatus;
  * The flow of control is:
  *
  * 1. MapParser callbacks get called with the raw data, which we just store
- * (m_objectInfos).
+ * (m_objectInfos). Large inputs are split into chunks that are parsed in parallel
+ * (parseEntitiesInChunks).
  * 2. Convert the raw data to nodes in parallel (createNodes) and record any additional
  * information necessary to restore the parent / child relationships.
  * 3. Validate the created nodes.
@@ -104,8 +105,12 @@ public: // only public so that helper methods can see these declarations
   using ObjectInfo = std::variant<EntityInfo, BrushInfo, PatchInfo>;
 
 private:
+  class ChunkReader;
+
+  std::string_view m_str;
   Model::EntityPropertyConfig m_entityPropertyConfig;
   vm::bbox3 m_worldBounds;
+  std::optional<size_t> m_parserChunkCount;
 
 private: // data populated in response to MapParser callbacks
   std::vector<ObjectInfo> m_objectInfos;
@@ -121,13 +126,29 @@ protected:
    * @param targetMapFormat the format to convert the created objects to
    * @param entityPropertyConfig the entity property config to use
    * if orphaned
+   * @param line the line number of the first character of the given string
+   * @param column the column number of the first character of the given string
    */
   MapReader(
     std::string_view str,
     Model::MapFormat sourceMapFormat,
     Model::MapFormat targetMapFormat,
-    Model::EntityPropertyConfig entityPropertyConfig);
+    Model::EntityPropertyConfig entityPropertyConfig,
+    size_t line = 1,
+    size_t column = 1);
 
+public:
+  /**
+   * Sets the number of chunks that the input is split into when reading entities. The
+   * chunks are parsed in parallel, so this limits the number of threads used for parsing.
+   * Passing 1 disables parallel parsing.
+   *
+   * By default, the number of chunks depends on the number of hardware threads, and
+   * small inputs are not split at all.
+   */
+  void setParserChunkCount(size_t parserChunkCount);
+
+protected:
   /**
    * Attempts to parse as one or more entities.
    *
@@ -161,7 +182,7 @@ protected: // implement MapParser interface
     const vm::vec3& point1,
     const vm::vec3& point2,
     const vm::vec3& point3,
-    const Model::BrushFaceAttributes& attribs,
+    Model::BrushFaceAttributes attribs,
     ParserStatus& status) override;
   void onValveBrushFace(
     size_t line,
@@ -169,7 +190,7 @@ protected: // implement MapParser interface
     const vm::vec3& point1,
     const vm::vec3& point2,
     const vm::vec3& point3,
-    const Model::BrushFaceAttributes& attribs,
+    Model::BrushFaceAttributes attribs,
     const vm::vec3& texAxisX,
     const vm::vec3& texAxisY,
     ParserStatus& status) override;
@@ -184,6 +205,13 @@ protected: // implement MapParser interface
     ParserStatus& status) override;
 
 private: // helper methods
+  /**
+   * Splits the input into chunks and parses them in parallel.
+   *
+   * Returns false if the input was not split or if parsing any chunk failed. In that
+   * case, nothing was recorded and the caller must parse the input sequentially.
+   */
+  bool parseEntitiesInChunks(ParserStatus& status);
   void createNodes(ParserStatus& status);
 
 private: // subclassing interface - these will be called in the order that nodes should be
@@ -71,11 +71,11 @@ void NodeSerializer::setExporting(const bool exporting)
   m_exporting = exporting;
 }
 
-void NodeSerializer::beginFile(const std::vector<const Model::Node*>& rootNodes)
+void NodeSerializer::beginFile(const std::vector<const Model::Node*>& nodes)
 {
   m_entityNo = 0;
   m_brushNo = 0;
-  doBeginFile(rootNodes);
+  doBeginFile(nodes);
 }
 
 void NodeSerializer::endFile()
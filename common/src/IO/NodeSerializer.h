@@ -49,7 +49,7 @@ namespace IO
  *
  * - construct a NodeSerializer
  * - call setExporting() to configure whether to write "omit from export" layers
- * - call beginFile() with all of the nodes that will be later serialized
+ * - call beginFile() with all of the brushes and patches that will be later serialized
  *   so subclasses can parallelize precomputing the serialization
  * - call e.g defaultLayer() to write that layer to the output
  * - call endFile()
@@ -81,16 +81,17 @@ public:
 
 public:
   /**
-   * Prepares to serialize the given nodes and all of their children.
-   * The order is ignored.
+   * Prepares to serialize the given brushes and patches, which are given in the order in
+   * which they will be written. NodeWriter obtains this order by running its traversal
+   * once without writing anything.
    *
-   * The rootNodes parameter allows subclasses to optionally precompute the
-   * serializations of all nodes in parallel.
+   * The nodes parameter allows subclasses to optionally precompute the serializations of
+   * the brushes and patches in parallel.
    *
-   * Any nodes serialized after calling beginFile() must have either been
-   * in the rootNodes vector or be a descendant of one of these nodes.
+   * Any brushes or patches serialized after calling beginFile() must be in the nodes
+   * vector.
    */
-  void beginFile(const std::vector<const Model::Node*>& rootNodes);
+  void beginFile(const std::vector<const Model::Node*>& nodes);
   void endFile();
 
 public:
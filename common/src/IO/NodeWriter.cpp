@@ -35,6 +35,7 @@
 #include "kdl/string_utils.h"
 #include "kdl/vector_utils.h"
 
+#include <functional>
 #include <vector>
 
 namespace TrenchBroom
@@ -84,6 +85,32 @@ static void doWriteNodes(
   }
 }
 
+namespace
+{
+/**
+ * Records the brushes and patches in the order in which a NodeWriter passes them to its
+ * serializer, without writing anything.
+ */
+class NodeOrderCollector : public NodeSerializer
+{
+public:
+  std::vector<const Model::Node*> nodes;
+
+private:
+  void doBeginFile(const std::vector<const Model::Node*>& /* nodes */) override {}
+  void doEndFile() override {}
+
+  void doBeginEntity(const Model::Node* /* node */) override {}
+  void doEndEntity(const Model::Node* /* node */) override {}
+  void doEntityProperty(const Model::EntityProperty& /* property */) override {}
+
+  void doBrush(const Model::BrushNode* brushNode) override { nodes.push_back(brushNode); }
+  void doBrushFace(const Model::BrushFace& /* face */) override {}
+
+  void doPatch(const Model::PatchNode* patchNode) override { nodes.push_back(patchNode); }
+};
+} // namespace
+
 NodeWriter::NodeWriter(const Model::WorldNode& world, std::ostream& stream)
   : m_world(world)
   , m_serializer(MapFileSerializer::create(m_world.mapFormat(), stream))
@@ -104,46 +131,57 @@ void NodeWriter::setExporting(const bool exporting)
   m_serializer->setExporting(exporting);
 }
 
-void NodeWriter::writeMap()
+void NodeWriter::writeFile(const std::function<void(NodeSerializer&)>& writeContents)
 {
-  m_serializer->beginFile({&m_world});
-  writeDefaultLayer();
-  writeCustomLayers();
+  // run the traversal once to find the order in which the brushes and patches are written
+  auto collector = NodeOrderCollector{};
+  collector.setExporting(m_serializer->exporting());
+  writeContents(collector);
+
+  m_serializer->beginFile(collector.nodes);
+  writeContents(*m_serializer);
   m_serializer->endFile();
 }
 
-void NodeWriter::writeDefaultLayer()
+void NodeWriter::writeMap()
+{
+  writeFile([&](NodeSerializer& serializer) {
+    writeDefaultLayer(serializer);
+    writeCustomLayers(serializer);
+  });
+}
+
+void NodeWriter::writeDefaultLayer(NodeSerializer& serializer)
 {
-  m_serializer->defaultLayer(m_world);
+  serializer.defaultLayer(m_world);
 
-  if (!(m_serializer->exporting() && m_world.defaultLayer()->layer().omitFromExport()))
+  if (!(serializer.exporting() && m_world.defaultLayer()->layer().omitFromExport()))
   {
-    doWriteNodes(*m_serializer, m_world.defaultLayer()->children());
+    doWriteNodes(serializer, m_world.defaultLayer()->children());
   }
 }
 
-void NodeWriter::writeCustomLayers()
+void NodeWriter::writeCustomLayers(NodeSerializer& serializer)
 {
   const std::vector<const Model::LayerNode*> customLayers = m_world.customLayers();
   for (auto* layer : customLayers)
   {
-    writeCustomLayer(layer);
+    writeCustomLayer(serializer, layer);
   }
 }
 
-void NodeWriter::writeCustomLayer(const Model::LayerNode* layerNode)
+void NodeWriter::writeCustomLayer(
+  NodeSerializer& serializer, const Model::LayerNode* layerNode)
 {
-  if (!(m_serializer->exporting() && layerNode->layer().omitFromExport()))
+  if (!(serializer.exporting() && layerNode->layer().omitFromExport()))
   {
-    m_serializer->customLayer(layerNode);
-    doWriteNodes(*m_serializer, layerNode->children(), layerNode);
+    serializer.customLayer(layerNode);
+    doWriteNodes(serializer, layerNode->children(), layerNode);
   }
 }
 
 void NodeWriter::writeNodes(const std::vector<Model::Node*>& nodes)
 {
-  m_serializer->beginFile(kdl::vec_static_cast<const Model::Node*>(nodes));
-
   // Assort nodes according to their type and, in case of brushes, whether they are entity
   // or world brushes.
   std::vector<Model::Node*> groups;
@@ -171,28 +209,30 @@ void NodeWriter::writeNodes(const std::vector<Model::Node*>& nodes)
       [](Model::PatchNode*) {}));
   }
 
-  writeWorldBrushes(worldBrushes);
-  writeEntityBrushes(entityBrushes);
+  writeFile([&](NodeSerializer& serializer) {
+    writeWorldBrushes(serializer, worldBrushes);
+    writeEntityBrushes(serializer, entityBrushes);
 
-  doWriteNodes(*m_serializer, groups);
-  doWriteNodes(*m_serializer, entities);
-
-  m_serializer->endFile();
+    doWriteNodes(serializer, groups);
+    doWriteNodes(serializer, entities);
+  });
 }
 
-void NodeWriter::writeWorldBrushes(const std::vector<Model::BrushNode*>& brushes)
+void NodeWriter::writeWorldBrushes(
+  NodeSerializer& serializer, const std::vector<Model::BrushNode*>& brushes)
 {
   if (!brushes.empty())
   {
-    m_serializer->entity(&m_world, m_world.entity().properties(), {}, brushes);
+    serializer.entity(&m_world, m_world.entity().properties(), {}, brushes);
   }
 }
 
-void NodeWriter::writeEntityBrushes(const EntityBrushesMap& entityBrushes)
+void NodeWriter::writeEntityBrushes(
+  NodeSerializer& serializer, const EntityBrushesMap& entityBrushes)
 {
   for (const auto& [entityNode, brushes] : entityBrushes)
   {
-    m_serializer->entity(entityNode, entityNode->entity().properties(), {}, brushes);
+    serializer.entity(entityNode, entityNode->entity().properties(), {}, brushes);
   }
 }
 
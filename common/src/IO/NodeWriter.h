@@ -20,6 +20,7 @@
 #pragma once
 
 #include <cstdio> // FILE*
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
@@ -57,16 +58,24 @@ public:
   void writeMap();
 
 private:
-  void writeDefaultLayer();
-  void writeCustomLayers();
-  void writeCustomLayer(const Model::LayerNode* layer);
+  /**
+   * Passes the brushes and patches written by the given function to
+   * NodeSerializer::beginFile in the order in which they are written, then writes them.
+   */
+  void writeFile(const std::function<void(NodeSerializer&)>& writeContents);
+
+  void writeDefaultLayer(NodeSerializer& serializer);
+  void writeCustomLayers(NodeSerializer& serializer);
+  void writeCustomLayer(NodeSerializer& serializer, const Model::LayerNode* layer);
 
 public:
   void writeNodes(const std::vector<Model::Node*>& nodes);
 
 private:
-  void writeWorldBrushes(const std::vector<Model::BrushNode*>& brushes);
-  void writeEntityBrushes(const EntityBrushesMap& entityBrushes);
+  void writeWorldBrushes(
+    NodeSerializer& serializer, const std::vector<Model::BrushNode*>& brushes);
+  void writeEntityBrushes(
+    NodeSerializer& serializer, const EntityBrushesMap& entityBrushes);
 
 public:
   void writeBrushFaces(const std::vector<Model::BrushFace>& faces);
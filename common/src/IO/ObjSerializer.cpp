@@ -102,7 +102,7 @@ ObjSerializer::ObjSerializer(
   ensure(m_mtlStream.good(), "mtl stream is good");
 }
 
-void ObjSerializer::doBeginFile(const std::vector<const Model::Node*>& /* rootNodes */) {}
+void ObjSerializer::doBeginFile(const std::vector<const Model::Node*>& /* nodes */) {}
 
 static void writeMtlFile(
   std::ostream& str,
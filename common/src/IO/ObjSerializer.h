@@ -146,7 +146,7 @@ public:
     ObjExportOptions options);
 
 private:
-  void doBeginFile(const std::vector<const Model::Node*>& rootNodes) override;
+  void doBeginFile(const std::vector<const Model::Node*>& nodes) override;
   void doEndFile() override;
 
   void doBeginEntity(const Model::Node* node) override;
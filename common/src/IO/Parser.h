@@ -82,7 +82,7 @@ protected:
 
   void expect(const std::string& expected, const Token& token) const
   {
-    if (token.data() != expected)
+    if (token.view() != expected)
     {
       throw ParserException(
         token.line(),
@@ -95,7 +95,7 @@ protected:
   {
     for (const auto& str : expected)
     {
-      if (token.data() == str)
+      if (token.view() == str)
       {
         return;
       }
@@ -111,7 +111,7 @@ private:
   std::string expectString(const std::string& expected, const Token& token) const
   {
     return "Expected " + expected + ", but got " + tokenName(token.type())
-           + (!token.data().empty() ? " (raw data: '" + token.data() + "')" : "");
+           + (token.length() > 0 ? " (raw data: '" + token.data() + "')" : "");
   }
 
 protected:
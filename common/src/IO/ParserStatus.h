@@ -31,6 +31,8 @@ namespace IO
 class ParserStatus
 {
 private:
+  friend class BufferedParserStatus;
+
   Logger& m_logger;
   std::string m_prefix;
 
@@ -28,6 +28,7 @@
 #include "IO/TraversalMode.h"
 #include "Logger.h"
 
+#include "kdl/parallel.h"
 #include "kdl/path_utils.h"
 #include "kdl/result.h"
 #include "kdl/result_fold.h"
@@ -35,10 +36,24 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom::IO
 {
+namespace
+{
+struct PathHash
+{
+  size_t operator()(const std::filesystem::path& path) const
+  {
+    return std::filesystem::hash_value(path);
+  }
+};
+} // namespace
+
 Quake3ShaderFileSystem::Quake3ShaderFileSystem(
   const FileSystem& fs,
   std::filesystem::path shaderSearchPath,
@@ -63,27 +78,40 @@ Result<std::vector<Assets::Quake3Shader>> Quake3ShaderFileSystem::loadShaders()
     return std::vector<Assets::Quake3Shader>{};
   }
 
+  // the shader files are parsed in parallel, so the messages are buffered and logged
+  // once all files are parsed
   const auto loadShaderFile = [&](const auto& path) {
-    return m_fs.openFile(path).transform([&](auto file) {
+    auto logger = BufferedLogger{};
+    auto shaders = m_fs.openFile(path).transform([&](auto file) {
       auto bufferedReader = file->reader().buffer();
       try
       {
         auto parser = Quake3ShaderParser{bufferedReader.stringView()};
-        auto status = SimpleParserStatus{m_logger, path.string()};
+        auto status = SimpleParserStatus{logger, path.string()};
         return parser.parse(status);
       }
       catch (const ParserException& e)
       {
-        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
+        logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
         return std::vector<Assets::Quake3Shader>{};
       }
     });
+    return std::pair{std::move(shaders), std::move(logger.messages)};
+  };
+
+  const auto logMessages = [&](auto loadResult) {
+    for (const auto& [level, message] : loadResult.second)
+    {
+      m_logger.log(level, message);
+    }
+    return std::move(loadResult.first);
   };
 
   return m_fs
     .find(m_shaderSearchPath, TraversalMode::Flat, makeExtensionPathMatcher({".shader"}))
     .and_then([&](auto paths) {
-      return kdl::fold_results(kdl::vec_transform(paths, loadShaderFile));
+      return kdl::fold_results(kdl::vec_transform(
+        kdl::vec_parallel_transform(std::move(paths), loadShaderFile), logMessages));
     })
     .transform([&](auto nestedShaders) {
       auto allShaders = kdl::vec_flatten(std::move(nestedShaders));
@@ -122,34 +150,44 @@ void Quake3ShaderFileSystem::linkTextures(
   std::vector<Assets::Quake3Shader>& shaders)
 {
   m_logger.debug() << "Linking textures...";
+
+  // Maps each shader path to the first shader with that path.
+  auto shaderIndex = std::unordered_map<std::filesystem::path, size_t, PathHash>{};
+  shaderIndex.reserve(shaders.size());
+  for (size_t i = 0; i < shaders.size(); ++i)
+  {
+    shaderIndex.try_emplace(shaders[i].shaderPath, i);
+  }
+
+  // The path index is only built once all files have been added, so the linked paths
+  // are tracked here. The keys are case insensitive like the path index.
+  auto linkedPaths = std::unordered_set<std::string>{};
+  linkedPaths.reserve(textures.size());
+
+  auto linkedShaders = std::vector<bool>(shaders.size(), false);
   for (const auto& texture : textures)
   {
     const auto shaderPath = kdl::path_remove_extension(texture);
 
     // Only link a shader if it has not been linked yet.
-    if (pathInfo(shaderPath) != PathInfo::File)
+    if (linkedPaths.insert(makePathIndexKey(shaderPath)).second)
     {
-      const auto shaderIt =
-        std::find_if(shaders.begin(), shaders.end(), [&shaderPath](const auto& shader) {
-          return shaderPath == shader.shaderPath;
-        });
-
-      if (shaderIt != std::end(shaders))
+      const auto shaderIt = shaderIndex.find(shaderPath);
+      if (shaderIt != std::end(shaderIndex))
       {
         // Found a matching shader.
-        auto& shader = *shaderIt;
+        const auto index = shaderIt->second;
+        auto& shader = shaders[index];
 
         auto shaderFile = std::static_pointer_cast<File>(
-          std::make_shared<ObjectFile<Assets::Quake3Shader>>(shader));
+          std::make_shared<ObjectFile<Assets::Quake3Shader>>(std::move(shader)));
         addFile(
           shaderPath,
           [shaderFile = std::move(shaderFile)]() -> Result<std::shared_ptr<File>> {
             return shaderFile;
           });
 
-        // Remove the shader so that we don't revisit it when linking standalone
-        // shaders.
-        shaders.erase(shaderIt);
+        linkedShaders[index] = true;
       }
       else
       {
@@ -163,6 +201,19 @@ void Quake3ShaderFileSystem::linkTextures(
       }
     }
   }
+
+  // Remove the linked shaders so that we don't revisit them when linking standalone
+  // shaders.
+  auto unlinkedShaders = std::vector<Assets::Quake3Shader>{};
+  unlinkedShaders.reserve(shaders.size());
+  for (size_t i = 0; i < shaders.size(); ++i)
+  {
+    if (!linkedShaders[i])
+    {
+      unlinkedShaders.push_back(std::move(shaders[i]));
+    }
+  }
+  shaders = std::move(unlinkedShaders);
 }
 
 void Quake3ShaderFileSystem::linkStandaloneShaders(
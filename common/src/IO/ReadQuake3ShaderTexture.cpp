@@ -188,4 +188,23 @@ Result<Assets::Texture, ReadTextureError> readQuake3ShaderTexture(
     });
 }
 
+Result<std::filesystem::path> findQuake3ShaderImagePath(
+  const File& file, const FileSystem& fs)
+{
+  const auto* shaderFile = dynamic_cast<const ObjectFile<Assets::Quake3Shader>*>(&file);
+  if (!shaderFile)
+  {
+    return Error{"File does not contain a shader"};
+  }
+
+  const auto& shader = shaderFile->object();
+  if (auto imagePath = findImagePath(shader, fs))
+  {
+    return std::move(*imagePath);
+  }
+
+  return Error{
+    "Could not find texture path for shader '" + shader.shaderPath.string() + "'"};
+}
+
 } // namespace TrenchBroom::IO
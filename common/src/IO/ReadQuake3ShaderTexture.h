@@ -22,6 +22,7 @@
 #include "IO/TextureUtils.h"
 #include "Result.h"
 
+#include <filesystem>
 #include <string>
 
 namespace TrenchBroom::IO
@@ -37,4 +38,11 @@ class FileSystem;
 Result<Assets::Texture, ReadTextureError> readQuake3ShaderTexture(
   std::string shaderName, const File& file, const FileSystem& fs);
 
+/**
+ * Returns the path of the editor image of the Quake 3 shader in the given file. Uses the
+ * given file system to locate the image.
+ */
+Result<std::filesystem::path> findQuake3ShaderImagePath(
+  const File& file, const FileSystem& fs);
+
 } // namespace TrenchBroom::IO
@@ -29,6 +29,8 @@
 #include "vm/plane.h"
 #include "vm/vec.h"
 
+#include <fmt/format.h>
+
 #include <string>
 #include <vector>
 
@@ -42,8 +44,9 @@ const std::string& QuakeMapTokenizer::NumberDelim()
   return numberDelim;
 }
 
-QuakeMapTokenizer::QuakeMapTokenizer(std::string_view str)
-  : Tokenizer(std::move(str), "\"", '\\')
+QuakeMapTokenizer::QuakeMapTokenizer(
+  std::string_view str, const size_t line, const size_t column)
+  : Tokenizer(std::move(str), "\"", '\\', line, column)
   , m_skipEol(true)
 {
 }
@@ -160,8 +163,10 @@ const std::string StandardMapParser::PatchId = "patchDef2";
 StandardMapParser::StandardMapParser(
   std::string_view str,
   const Model::MapFormat sourceMapFormat,
-  const Model::MapFormat targetMapFormat)
-  : m_tokenizer(QuakeMapTokenizer(std::move(str)))
+  const Model::MapFormat targetMapFormat,
+  const size_t line,
+  const size_t column)
+  : m_tokenizer(QuakeMapTokenizer(std::move(str), line, column))
   , m_sourceMapFormat(sourceMapFormat)
   , m_targetMapFormat(targetMapFormat)
 {
@@ -182,6 +187,42 @@ void StandardMapParser::parseEntities(ParserStatus& status)
   }
 }
 
+std::optional<size_t> StandardMapParser::parseEntityTail(ParserStatus& status)
+{
+  // like in parseEntity, properties following the first brush are parsed, but discarded
+  auto properties = std::vector<Model::EntityProperty>();
+  auto propertyKeys = EntityPropertyKeys();
+
+  auto token = m_tokenizer.peekToken();
+  while (token.type() != QuakeMapToken::Eof)
+  {
+    switch (token.type())
+    {
+    case QuakeMapToken::Comment:
+      m_tokenizer.nextToken();
+      break;
+    case QuakeMapToken::String:
+      parseEntityProperty(properties, propertyKeys, status);
+      break;
+    case QuakeMapToken::OBrace:
+      parseBrushOrBrushPrimitiveOrPatch(status);
+      break;
+    case QuakeMapToken::CBrace:
+      m_tokenizer.nextToken();
+      return token.line();
+    default:
+      expect(
+        QuakeMapToken::Comment | QuakeMapToken::String | QuakeMapToken::OBrace
+          | QuakeMapToken::CBrace,
+        token);
+    }
+
+    token = m_tokenizer.peekToken();
+  }
+
+  return std::nullopt;
+}
+
 void StandardMapParser::parseBrushesOrPatches(ParserStatus& status)
 {
   auto token = m_tokenizer.peekToken();
@@ -272,22 +313,23 @@ void StandardMapParser::parseEntityProperty(
 {
   auto token = m_tokenizer.nextToken();
   assert(token.type() == QuakeMapToken::String);
-  const auto name = token.data();
+  const auto name = token.view();
 
   const auto line = token.line();
   const auto column = token.column();
 
   expect(QuakeMapToken::String, token = m_tokenizer.nextToken());
-  const auto value = token.data();
+  const auto value = token.view();
 
   if (keys.count(name) == 0)
   {
-    properties.push_back(Model::EntityProperty(name, value));
+    properties.emplace_back(std::string{name}, std::string{value});
     keys.insert(name);
   }
   else
   {
-    status.warn(line, column, "Ignoring duplicate entity property '" + name + "'");
+    status.warn(
+      line, column, fmt::format("Ignoring duplicate entity property '{}'", name));
   }
 }
 
@@ -313,7 +355,7 @@ void StandardMapParser::parseBrushOrBrushPrimitiveOrPatch(ParserStatus& status)
     if (token.hasType(QuakeMapToken::String))
     {
       expect(std::vector<std::string>({BrushPrimitiveId, PatchId}), token);
-      if (token.data() == BrushPrimitiveId)
+      if (token.view() == BrushPrimitiveId)
       {
         parseBrushPrimitive(status, startLine);
       }
@@ -463,7 +505,7 @@ void StandardMapParser::parseQuakeFace(ParserStatus& status)
   attribs.setXScale(parseFloat());
   attribs.setYScale(parseFloat());
 
-  onStandardBrushFace(line, m_targetMapFormat, p1, p2, p3, attribs, status);
+  onStandardBrushFace(line, m_targetMapFormat, p1, p2, p3, std::move(attribs), status);
 }
 
 void StandardMapParser::parseQuake2Face(ParserStatus& status)
@@ -490,7 +532,7 @@ void StandardMapParser::parseQuake2Face(ParserStatus& status)
     attribs.setSurfaceValue(parseFloat());
   }
 
-  onStandardBrushFace(line, m_targetMapFormat, p1, p2, p3, attribs, status);
+  onStandardBrushFace(line, m_targetMapFormat, p1, p2, p3, std::move(attribs), status);
 }
 
 void StandardMapParser::parseQuake2ValveFace(ParserStatus& status)
@@ -519,7 +561,8 @@ void StandardMapParser::parseQuake2ValveFace(ParserStatus& status)
     attribs.setSurfaceValue(parseFloat());
   }
 
-  onValveBrushFace(line, m_targetMapFormat, p1, p2, p3, attribs, texX, texY, status);
+  onValveBrushFace(
+    line, m_targetMapFormat, p1, p2, p3, std::move(attribs), texX, texY, status);
 }
 
 void StandardMapParser::parseHexen2Face(ParserStatus& status)
@@ -544,7 +587,7 @@ void StandardMapParser::parseHexen2Face(ParserStatus& status)
     m_tokenizer.nextToken(); // noone seems to know what the extra value does in Hexen 2
   }
 
-  onStandardBrushFace(line, m_targetMapFormat, p1, p2, p3, attribs, status);
+  onStandardBrushFace(line, m_targetMapFormat, p1, p2, p3, std::move(attribs), status);
 }
 
 void StandardMapParser::parseDaikatanaFace(ParserStatus& status)
@@ -576,7 +619,7 @@ void StandardMapParser::parseDaikatanaFace(ParserStatus& status)
     }
   }
 
-  onStandardBrushFace(line, m_targetMapFormat, p1, p2, p3, attribs, status);
+  onStandardBrushFace(line, m_targetMapFormat, p1, p2, p3, std::move(attribs), status);
 }
 
 void StandardMapParser::parseValveFace(ParserStatus& status)
@@ -595,7 +638,8 @@ void StandardMapParser::parseValveFace(ParserStatus& status)
   attribs.setXScale(parseFloat());
   attribs.setYScale(parseFloat());
 
-  onValveBrushFace(line, m_targetMapFormat, p1, p2, p3, attribs, texX, texY, status);
+  onValveBrushFace(
+    line, m_targetMapFormat, p1, p2, p3, std::move(attribs), texX, texY, status);
 }
 
 void StandardMapParser::parsePrimitiveFace(ParserStatus& status)
@@ -625,7 +669,7 @@ void StandardMapParser::parsePrimitiveFace(ParserStatus& status)
   }
 
   // TODO 2427: create a brush face
-  // brushFace(line, p1, p2, p3, attribs, texX, texY, status);
+  // brushFace(line, p1, p2, p3, std::move(attribs), texX, texY, status);
 }
 
 void StandardMapParser::parsePatch(ParserStatus& status, const size_t startLine)
@@ -634,7 +678,7 @@ void StandardMapParser::parsePatch(ParserStatus& status, const size_t startLine)
   expect(PatchId, token);
   expect(QuakeMapToken::OBrace, m_tokenizer.nextToken());
 
-  auto textureName = parseTextureName(status);
+  auto textureName = std::string{parseTextureName(status)};
   expect(QuakeMapToken::OParenthesis, m_tokenizer.nextToken());
 
   /*
@@ -717,11 +761,16 @@ std::tuple<vm::vec3, vm::vec3, vm::vec3> StandardMapParser::parseFacePoints(
   return std::make_tuple(p1, p2, p3);
 }
 
-std::string StandardMapParser::parseTextureName(ParserStatus& /* status */)
+std::string_view StandardMapParser::parseTextureName(ParserStatus& /* status */)
 {
   const auto [textureName, wasQuoted] =
     m_tokenizer.readAnyString(QuakeMapTokenizer::Whitespace());
-  return wasQuoted ? kdl::str_unescape(textureName, "\"\\") : std::string(textureName);
+  if (wasQuoted && textureName.find('\\') != std::string_view::npos)
+  {
+    m_unescapedTextureName = kdl::str_unescape(textureName, "\"\\");
+    return m_unescapedTextureName;
+  }
+  return textureName;
 }
 
 std::tuple<vm::vec3, float, vm::vec3, float> StandardMapParser::parseValveTextureAxes(
@@ -778,5 +827,202 @@ StandardMapParser::TokenNameMap StandardMapParser::tokenNames() const
   names[Eof] = "end of file";
   return names;
 }
+
+namespace
+{
+bool isWhitespace(const char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/**
+ * Returns whether a token can begin at the given position of the given string. This
+ * mimics the tokenizer, which reads words and numbers until it encounters whitespace.
+ */
+bool isTokenStart(const std::string_view str, const size_t i)
+{
+  return i == 0 || isWhitespace(str[i - 1])
+         || std::string_view{"{}()[]"}.find(str[i - 1]) != std::string_view::npos;
+}
+
+/**
+ * Returns whether a brace that ends just before the given position is a token by itself
+ * rather than a part of a word, e.g. a texture name such as "{water".
+ */
+bool isTokenEnd(const std::string_view str, const size_t i)
+{
+  return i == str.size() || isWhitespace(str[i])
+         || std::string_view{"{}()[]\"/;"}.find(str[i]) != std::string_view::npos;
+}
+} // namespace
+
+std::vector<MapChunk> splitIntoChunks(const std::string_view str, const size_t chunkSize)
+{
+  const auto wholeString = std::vector<MapChunk>{{str, 1, 1, false}};
+
+  auto result = std::vector<MapChunk>{};
+  auto chunkBegin = size_t(0);
+  auto chunk = MapChunk{{}, 1, 1, false};
+
+  auto i = size_t(0);
+  auto line = size_t(1);
+  auto column = size_t(1);
+  auto depth = size_t(0);
+
+  // the index of the first chunk that ends inside the current entity, if any
+  auto entityChunkIndex = std::optional<size_t>{};
+  auto entityIsSplittable = true;
+
+  // The parser of a chunk that begins inside an entity cannot detect duplicates of the
+  // properties parsed by the preceding chunks. If a property follows a split inside an
+  // entity, the chunks of that entity are joined again and it is not split anymore.
+  const auto joinEntityChunks = [&]() {
+    if (depth == 1 && entityChunkIndex)
+    {
+      chunk = result[*entityChunkIndex];
+      chunkBegin = size_t(chunk.str.data() - str.data());
+      result.resize(*entityChunkIndex);
+
+      entityChunkIndex = std::nullopt;
+      entityIsSplittable = false;
+    }
+  };
+
+  // keeps track of lines and columns exactly like TokenizerBase::advance
+  const auto advance = [&]() {
+    switch (str[i])
+    {
+    case '\r':
+      if (i + 1 < str.size() && str[i + 1] == '\n')
+      {
+        ++column;
+        break;
+      }
+      switchFallthrough();
+    case '\n':
+      ++line;
+      column = 1;
+      break;
+    default:
+      ++column;
+      break;
+    }
+    ++i;
+  };
+
+  const auto skipLine = [&]() {
+    while (i < str.size() && str[i] != '\n' && str[i] != '\r')
+    {
+      advance();
+    }
+  };
+
+  while (i < str.size())
+  {
+    if (!isTokenStart(str, i))
+    {
+      advance();
+      continue;
+    }
+
+    switch (str[i])
+    {
+    case '"': {
+      joinEntityChunks();
+
+      // mimics Tokenizer::readQuotedString including the hack for trailing backslashes
+      advance();
+      auto escaped = false;
+      while (i < str.size() && (str[i] != '"' || escaped))
+      {
+        if (
+          str[i] == '"' && i + 1 < str.size()
+          && (str[i + 1] == '\n' || str[i + 1] == '}'))
+        {
+          break;
+        }
+        escaped = str[i] == '\\' && !escaped;
+        advance();
+      }
+      if (i == str.size())
+      {
+        return wholeString;
+      }
+      advance();
+      break;
+    }
+    case '/':
+      advance();
+      if (i < str.size() && str[i] == '/')
+      {
+        skipLine();
+      }
+      else
+      {
+        joinEntityChunks();
+      }
+      break;
+    case ';':
+      skipLine();
+      break;
+    case '{':
+      advance();
+      if (isTokenEnd(str, i))
+      {
+        if (++depth == 1)
+        {
+          entityChunkIndex = std::nullopt;
+          entityIsSplittable = true;
+        }
+      }
+      break;
+    case '}':
+      advance();
+      if (isTokenEnd(str, i))
+      {
+        if (depth == 0)
+        {
+          return wholeString;
+        }
+
+        // only split after an entity, or after a brush or patch within an entity
+        if (
+          --depth <= 1 && i - chunkBegin >= chunkSize
+          && (depth == 0 || entityIsSplittable))
+        {
+          if (depth == 1 && !entityChunkIndex)
+          {
+            entityChunkIndex = result.size();
+          }
+
+          chunk.str = str.substr(chunkBegin, i - chunkBegin);
+          result.push_back(chunk);
+
+          chunkBegin = i;
+          chunk = MapChunk{{}, line, column, depth == 1};
+        }
+      }
+      break;
+    default:
+      // an unquoted property key
+      joinEntityChunks();
+      advance();
+      break;
+    }
+  }
+
+  if (depth != 0)
+  {
+    return wholeString;
+  }
+
+  if (chunkBegin < str.size())
+  {
+    chunk.str = str.substr(chunkBegin);
+    result.push_back(chunk);
+  }
+
+  return result;
+}
 } // namespace IO
 } // namespace TrenchBroom
@@ -29,6 +29,7 @@
 
 #include "vm/forward.h"
 
+#include <optional>
 #include <string_view>
 #include <tuple>
 #include <vector>
@@ -64,7 +65,7 @@ private:
   bool m_skipEol;
 
 public:
-  explicit QuakeMapTokenizer(std::string_view str);
+  explicit QuakeMapTokenizer(std::string_view str, size_t line = 1, size_t column = 1);
 
   void setSkipEol(bool skipEol);
 
@@ -76,13 +77,16 @@ class StandardMapParser : public MapParser, public Parser<QuakeMapToken::Type>
 {
 private:
   using Token = QuakeMapTokenizer::Token;
-  using EntityPropertyKeys = kdl::vector_set<std::string>;
+  using EntityPropertyKeys = kdl::vector_set<std::string_view>;
 
   static const std::string BrushPrimitiveId;
   static const std::string PatchId;
 
   QuakeMapTokenizer m_tokenizer;
 
+  /** Holds the most recently parsed texture name if it had to be unescaped. */
+  std::string m_unescapedTextureName;
+
 protected:
   Model::MapFormat m_sourceMapFormat;
   Model::MapFormat m_targetMapFormat;
@@ -95,16 +99,28 @@ public:
    * @param str the string to parse
    * @param sourceMapFormat the expected format of the given string
    * @param targetMapFormat the format to convert the created objects to
+   * @param line the line number of the first character of the given string
+   * @param column the column number of the first character of the given string
    */
   StandardMapParser(
     std::string_view str,
     Model::MapFormat sourceMapFormat,
-    Model::MapFormat targetMapFormat);
+    Model::MapFormat targetMapFormat,
+    size_t line = 1,
+    size_t column = 1);
 
   ~StandardMapParser() override;
 
 protected:
   void parseEntities(ParserStatus& status);
+  /**
+   * Parses the remaining brushes and patches of an entity whose properties were parsed by
+   * another parser, up to and including the closing brace of the entity.
+   *
+   * Returns the line number of the closing brace, or an empty optional if the end of the
+   * input was reached before the closing brace.
+   */
+  std::optional<size_t> parseEntityTail(ParserStatus& status);
   void parseBrushesOrPatches(ParserStatus& status);
   void parseBrushFaces(ParserStatus& status);
 
@@ -133,7 +149,12 @@ private:
   void parsePatch(ParserStatus& status, size_t startLine);
 
   std::tuple<vm::vec3, vm::vec3, vm::vec3> parseFacePoints(ParserStatus& status);
-  std::string parseTextureName(ParserStatus& status);
+  /**
+   * Parses a texture name and returns a view of it. The view refers to the parsed string
+   * or to an internal buffer if the name had to be unescaped, so it is only valid until
+   * the next texture name is parsed.
+   */
+  std::string_view parseTextureName(ParserStatus& status);
   std::tuple<vm::vec3, float, vm::vec3, float> parseValveTextureAxes(
     ParserStatus& status);
   std::tuple<vm::vec3, vm::vec3> parsePrimitiveTextureAxes(ParserStatus& status);
@@ -157,5 +178,31 @@ private:
 private: // implement Parser interface
   TokenNameMap tokenNames() const override;
 };
+
+/**
+ * A section of a map file that can be parsed independently of the other sections. A
+ * chunk consists of whole entities, but its first entity may have been started in a
+ * preceding chunk and its last entity may be continued in a succeeding chunk. Entities
+ * are only ever split between brushes or patches, and only if no property of the entity
+ * follows the split.
+ */
+struct MapChunk
+{
+  std::string_view str;
+  size_t line;
+  size_t column;
+  bool beginsInsideEntity;
+};
+
+/**
+ * Splits the given map file into chunks that contain at least the given number of
+ * characters (except for the last chunk).
+ *
+ * The boundaries of the chunks are found by counting braces while skipping quoted strings
+ * and comments, without actually tokenizing the input. If the braces in the given string
+ * are unbalanced, or if a quoted string is not terminated, the entire string is returned
+ * as a single chunk.
+ */
+std::vector<MapChunk> splitIntoChunks(std::string_view str, size_t chunkSize);
 } // namespace IO
 } // namespace TrenchBroom
@@ -0,0 +1,346 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureMetadataCache.h"
+
+#include "Error.h"
+#include "IO/DiskIO.h"
+
+#include "kdl/overload.h"
+#include "kdl/reflection_impl.h"
+#include "kdl/result.h"
+#include "kdl/string_utils.h"
+
+#include "vm/vec_io.h"
+
+#include <chrono>
+#include <iomanip>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+
+kdl_reflect_impl(TextureMetadata);
+
+namespace
+{
+const auto CacheHeader = std::string{"TrenchBroom texture metadata cache 2"};
+
+// the number of days after which unused entries are dropped
+const auto MaxEntryAge = size_t(90);
+
+size_t today()
+{
+  const auto hours = std::chrono::duration_cast<std::chrono::hours>(
+    std::chrono::system_clock::now().time_since_epoch());
+  return size_t(hours.count() / 24);
+}
+
+bool isValidField(const std::string& str)
+{
+  return !str.empty() && str.find_first_of("\t\n\r") == std::string::npos;
+}
+
+std::vector<std::string_view> splitFields(const std::string_view line)
+{
+  auto result = std::vector<std::string_view>{};
+  auto begin = size_t(0);
+  while (begin <= line.size())
+  {
+    const auto end = std::min(line.find('\t', begin), line.size());
+    result.push_back(line.substr(begin, end - begin));
+    begin = end + 1;
+  }
+  return result;
+}
+
+void writeEntry(
+  std::ostream& stream,
+  const std::string& key,
+  const std::string& stamp,
+  const size_t lastUsed,
+  const TextureMetadata& metadata)
+{
+  stream << key << '\t' << stamp << '\t' << lastUsed << '\t' << metadata.width << '\t'
+         << metadata.height;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    stream << '\t' << metadata.averageColor[i];
+  }
+  stream << '\t' << metadata.format << '\t'
+         << (metadata.type == Assets::TextureType::Masked ? 1 : 0);
+  std::visit(
+    kdl::overload(
+      [&](const std::monostate&) { stream << "\t-"; },
+      [&](const Assets::Q2Data& q2Data) {
+        stream << "\tq2\t" << q2Data.flags << '\t' << q2Data.contents << '\t'
+               << q2Data.value;
+      }),
+    metadata.gameData);
+  stream << '\n';
+}
+
+std::optional<Assets::GameData> parseGameData(
+  const std::vector<std::string_view>& fields, const size_t first)
+{
+  if (fields.size() == first + 1 && fields[first] == "-")
+  {
+    return Assets::GameData{std::monostate{}};
+  }
+
+  if (fields.size() == first + 4 && fields[first] == "q2")
+  {
+    const auto flags = kdl::str_to_int(fields[first + 1]);
+    const auto contents = kdl::str_to_int(fields[first + 2]);
+    const auto value = kdl::str_to_int(fields[first + 3]);
+    if (flags && contents && value)
+    {
+      return Assets::GameData{Assets::Q2Data{*flags, *contents, *value}};
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<TextureMetadata> parseMetadata(const std::vector<std::string_view>& fields)
+{
+  if (fields.size() < 12)
+  {
+    return std::nullopt;
+  }
+
+  const auto width = kdl::str_to_size(fields[3]);
+  const auto height = kdl::str_to_size(fields[4]);
+  const auto r = kdl::str_to_float(fields[5]);
+  const auto g = kdl::str_to_float(fields[6]);
+  const auto b = kdl::str_to_float(fields[7]);
+  const auto a = kdl::str_to_float(fields[8]);
+  const auto format = kdl::str_to_u_long(fields[9]);
+  const auto type = kdl::str_to_int(fields[10]);
+  const auto gameData = parseGameData(fields, 11);
+
+  if (
+    !width || *width == 0 || !height || *height == 0 || !r || !g || !b || !a || !format
+    || !type || (*type != 0 && *type != 1) || !gameData)
+  {
+    return std::nullopt;
+  }
+
+  return TextureMetadata{
+    *width,
+    *height,
+    Color{*r, *g, *b, *a},
+    GLenum(*format),
+    *type == 1 ? Assets::TextureType::Masked : Assets::TextureType::Opaque,
+    *gameData};
+}
+
+} // namespace
+
+TextureMetadata getTextureMetadata(const Assets::Texture& texture)
+{
+  return TextureMetadata{
+    texture.width(),
+    texture.height(),
+    texture.averageColor(),
+    texture.format(),
+    texture.type(),
+    texture.gameData()};
+}
+
+Assets::Texture createTexture(std::string name, const TextureMetadata& metadata)
+{
+  return Assets::Texture{
+    std::move(name),
+    metadata.width,
+    metadata.height,
+    metadata.averageColor,
+    std::vector<Assets::TextureBuffer>{},
+    metadata.format,
+    metadata.type,
+    metadata.gameData};
+}
+
+Result<std::string> makeFileStamp(const std::filesystem::path& path)
+{
+  auto error = std::error_code{};
+  const auto size = std::filesystem::file_size(path, error);
+  if (error)
+  {
+    return Error{"Failed to stat '" + path.string() + "': " + error.message()};
+  }
+
+  const auto modificationTime = std::filesystem::last_write_time(path, error);
+  if (error)
+  {
+    return Error{"Failed to stat '" + path.string() + "': " + error.message()};
+  }
+
+  return std::to_string(size) + ":"
+         + std::to_string(modificationTime.time_since_epoch().count());
+}
+
+std::optional<TextureMetadata> TextureMetadataCache::get(
+  const std::string& key, const std::string& stamp) const
+{
+  const auto lock = std::lock_guard{m_mutex};
+  if (const auto it = m_entries.find(key);
+      it != m_entries.end() && it->second.stamp == stamp)
+  {
+    if (const auto day = today(); it->second.lastUsed != day)
+    {
+      it->second.lastUsed = day;
+      m_modified = true;
+    }
+    return it->second.metadata;
+  }
+  return std::nullopt;
+}
+
+void TextureMetadataCache::put(
+  std::string key, std::string stamp, TextureMetadata metadata)
+{
+  const auto lock = std::lock_guard{m_mutex};
+  m_entries[std::move(key)] = Entry{std::move(stamp), std::move(metadata), today()};
+  m_modified = true;
+}
+
+size_t TextureMetadataCache::size() const
+{
+  const auto lock = std::lock_guard{m_mutex};
+  return m_entries.size();
+}
+
+bool TextureMetadataCache::modified() const
+{
+  const auto lock = std::lock_guard{m_mutex};
+  return m_modified;
+}
+
+Result<void> TextureMetadataCache::load(const std::filesystem::path& path)
+{
+  return readEntries(path).transform([&](auto entries) {
+    const auto lock = std::lock_guard{m_mutex};
+    m_entries = std::move(entries);
+    m_modified = false;
+  });
+}
+
+Result<void> TextureMetadataCache::save(const std::filesystem::path& path)
+{
+  const auto lock = std::lock_guard{m_mutex};
+
+  // other games and other instances may have stored entries since this cache was loaded
+  auto entries = readEntries(path).value_or(EntryMap{});
+  for (const auto& [key, entry] : m_entries)
+  {
+    const auto it = entries.find(key);
+    if (it == entries.end() || it->second.lastUsed <= entry.lastUsed)
+    {
+      entries[key] = entry;
+    }
+  }
+
+  const auto day = today();
+  for (auto it = entries.begin(); it != entries.end();)
+  {
+    const auto expired = it->second.lastUsed + MaxEntryAge < day;
+    it = expired ? entries.erase(it) : std::next(it);
+  }
+
+  // write to a temporary file first so that the file is replaced atomically
+  auto tempPath = path;
+  tempPath += ".tmp" + std::to_string(std::random_device{}());
+
+  return Disk::withOutputStream(
+           tempPath,
+           [&](auto& stream) -> Result<void> {
+             stream << std::setprecision(std::numeric_limits<float>::max_digits10)
+                    << CacheHeader << '\n';
+             for (const auto& [key, entry] : entries)
+             {
+               if (isValidField(key) && isValidField(entry.stamp))
+               {
+                 writeEntry(stream, key, entry.stamp, entry.lastUsed, entry.metadata);
+               }
+             }
+
+             stream.flush();
+             if (!stream)
+             {
+               return Error{"Failed to write '" + tempPath.string() + "'"};
+             }
+             return kdl::void_success;
+           })
+    .and_then([&]() { return Disk::moveFile(tempPath, path); })
+    .transform([&]() {
+      m_entries = std::move(entries);
+      m_modified = false;
+    })
+    .or_else([&](auto e) -> Result<void> {
+      auto error = std::error_code{};
+      std::filesystem::remove(tempPath, error);
+      return e;
+    });
+}
+
+void TextureMetadataCache::clear()
+{
+  const auto lock = std::lock_guard{m_mutex};
+  m_entries.clear();
+  m_modified = false;
+}
+
+Result<TextureMetadataCache::EntryMap> TextureMetadataCache::readEntries(
+  const std::filesystem::path& path)
+{
+  return Disk::withInputStream(path, [&](auto& stream) -> Result<EntryMap> {
+    auto line = std::string{};
+    if (!std::getline(stream, line) || line != CacheHeader)
+    {
+      return Error{"Unknown texture metadata cache format in '" + path.string() + "'"};
+    }
+
+    auto entries = EntryMap{};
+    while (std::getline(stream, line))
+    {
+      const auto fields = splitFields(line);
+      auto metadata = parseMetadata(fields);
+      const auto lastUsed = metadata ? kdl::str_to_size(fields[2]) : std::nullopt;
+      if (!metadata || !lastUsed)
+      {
+        return Error{"Malformed texture metadata cache entry in '" + path.string() + "'"};
+      }
+
+      entries[std::string{fields[0]}] =
+        Entry{std::string{fields[1]}, std::move(*metadata), *lastUsed};
+    }
+
+    return entries;
+  });
+}
+
+} // namespace TrenchBroom::IO
@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Assets/Texture.h"
+#include "Color.h"
+#include "Renderer/GL.h"
+#include "Result.h"
+
+#include "kdl/reflection_decl.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * The properties of a texture that can be restored without decoding its pixel data.
+ */
+struct TextureMetadata
+{
+  size_t width;
+  size_t height;
+  Color averageColor;
+  GLenum format;
+  Assets::TextureType type;
+  Assets::GameData gameData;
+
+  kdl_reflect_decl(TextureMetadata, width, height, averageColor, format, type, gameData);
+};
+
+/**
+ * Returns the metadata of the given texture.
+ */
+TextureMetadata getTextureMetadata(const Assets::Texture& texture);
+
+/**
+ * Creates a texture without pixel data from the given name and metadata.
+ */
+Assets::Texture createTexture(std::string name, const TextureMetadata& metadata);
+
+/**
+ * Returns a stamp that changes whenever the file at the given path on the disk is
+ * modified. The stamp consists of the size and the modification time of the file.
+ */
+Result<std::string> makeFileStamp(const std::filesystem::path& path);
+
+/**
+ * Caches texture metadata across sessions so that textures need not be decoded again
+ * when they are loaded.
+ *
+ * Every entry has a key that identifies the texture and a stamp that identifies the
+ * state of the files it was read from. An entry is only returned if its stamp matches
+ * the given stamp, so modified files are detected cheaply.
+ *
+ * Every entry also records the day on which it was last used. The cache file is shared
+ * by all games and all running instances, so entries are only removed from it once they
+ * have not been used for a while, see save().
+ *
+ * Entries can be looked up and added concurrently.
+ */
+class TextureMetadataCache
+{
+private:
+  struct Entry
+  {
+    std::string stamp;
+    TextureMetadata metadata;
+    size_t lastUsed;
+  };
+
+  using EntryMap = std::unordered_map<std::string, Entry>;
+
+  mutable std::mutex m_mutex;
+  mutable EntryMap m_entries;
+  mutable bool m_modified{false};
+
+public:
+  /**
+   * Returns the metadata stored for the given key if its stamp matches the given stamp.
+   */
+  std::optional<TextureMetadata> get(
+    const std::string& key, const std::string& stamp) const;
+
+  /**
+   * Stores the given metadata for the given key, replacing any previous entry.
+   */
+  void put(std::string key, std::string stamp, TextureMetadata metadata);
+
+  size_t size() const;
+
+  /**
+   * Indicates whether entries were added, or used for the first time on the current day,
+   * since this cache was loaded or saved.
+   */
+  bool modified() const;
+
+  /**
+   * Replaces the contents of this cache with the entries stored in the file at the given
+   * path.
+   */
+  Result<void> load(const std::filesystem::path& path);
+
+  /**
+   * Merges the entries of this cache with the entries stored in the file at the given
+   * path and writes them back to the file. If both contain an entry with the same key,
+   * the more recently used entry is kept. Entries that have not been used for more than
+   * 90 days are dropped.
+   *
+   * The file is replaced atomically, so a concurrent load never reads a partially
+   * written file.
+   */
+  Result<void> save(const std::filesystem::path& path);
+
+  void clear();
+
+private:
+  static Result<EntryMap> readEntries(const std::filesystem::path& path);
+};
+
+} // namespace TrenchBroom::IO
@@ -23,6 +23,7 @@
 
 #include <cassert>
 #include <string>
+#include <string_view>
 
 namespace TrenchBroom
 {
@@ -75,7 +76,14 @@ public:
 
   const char* end() const { return m_end; }
 
-  const std::string data() const { return std::string(m_begin, length()); }
+  std::string data() const { return std::string(m_begin, length()); }
+
+  /**
+   * Returns a view of this token's characters in the tokenized buffer. Unlike data(),
+   * this does not copy the characters, but the returned view is only valid for as long as
+   * the tokenized buffer is.
+   */
+  std::string_view view() const { return std::string_view(m_begin, length()); }
 
   size_t position() const { return m_position; }
 
@@ -88,13 +96,13 @@ public:
   template <typename T>
   T toFloat() const
   {
-    return static_cast<T>(kdl::str_to_double(std::string(m_begin, m_end)).value_or(0.0));
+    return static_cast<T>(kdl::str_to_double(view()).value_or(0.0));
   }
 
   template <typename T>
   T toInteger() const
   {
-    return static_cast<T>(kdl::str_to_long(std::string(m_begin, m_end)).value_or(0l));
+    return static_cast<T>(kdl::str_to_long(view()).value_or(0l));
   }
 };
 } // namespace IO
@@ -21,6 +21,7 @@
 
 #include "Error.h"
 #include "IO/File.h"
+#include "IO/ImageFileSystem.h"
 #include "IO/PathInfo.h"
 
 #include "kdl/path_utils.h"
@@ -97,18 +98,9 @@ Result<std::filesystem::path> VirtualFileSystem::makeAbsolute(
 
 PathInfo VirtualFileSystem::pathInfo(const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto [mountPoint, pathInfo] = findMountPoint(path); mountPoint)
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
-          pathInfo != PathInfo::Unknown)
-      {
-        return pathInfo;
-      }
-    }
+    return pathInfo;
   }
 
   return std::any_of(
@@ -122,12 +114,24 @@ PathInfo VirtualFileSystem::pathInfo(const std::filesystem::path& path) const
            : PathInfo::Unknown;
 }
 
+Result<std::filesystem::path> VirtualFileSystem::diskFilePath(
+  const std::filesystem::path& path) const
+{
+  if (const auto [mountPoint, pathInfo] = findMountPoint(path); mountPoint)
+  {
+    return mountPoint->mountedFileSystem->diskFilePath(suffix(*mountPoint, path));
+  }
+
+  return Error{"'" + path.string() + "' not found"};
+}
 
 VirtualMountPointId VirtualFileSystem::mount(
   const std::filesystem::path& path, std::unique_ptr<FileSystem> fs)
 {
   const auto id = VirtualMountPointId{};
-  m_mountPoints.push_back({id, path, std::move(fs)});
+  const auto indexed = dynamic_cast<const ImageFileSystemBase*>(fs.get()) != nullptr;
+  m_mountPoints.push_back({id, path, std::move(fs), indexed});
+  addToIndex(m_mountPoints.size() - 1);
   return id;
 }
 
@@ -140,6 +144,7 @@ bool VirtualFileSystem::unmount(const VirtualMountPointId& id)
       it != m_mountPoints.end())
   {
     m_mountPoints.erase(it);
+    updateIndex();
     return true;
   }
   return false;
@@ -148,6 +153,16 @@ bool VirtualFileSystem::unmount(const VirtualMountPointId& id)
 void VirtualFileSystem::unmountAll()
 {
   m_mountPoints.clear();
+  m_index.clear();
+}
+
+void VirtualFileSystem::updateIndex()
+{
+  m_index.clear();
+  for (size_t i = 0; i < m_mountPoints.size(); ++i)
+  {
+    addToIndex(i);
+  }
 }
 
 Result<std::vector<std::filesystem::path>> VirtualFileSystem::doFind(
@@ -228,20 +243,69 @@ Result<std::vector<std::filesystem::path>> VirtualFileSystem::doFind(
 Result<std::shared_ptr<File>> VirtualFileSystem::doOpenFile(
   const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto [mountPoint, pathInfo] = findMountPoint(path); mountPoint)
   {
-    const auto& mountPoint = *it;
+    return mountPoint->mountedFileSystem->openFile(suffix(*mountPoint, path));
+  }
+
+  return Error{"'" + path.string() + "' not found"};
+}
+
+void VirtualFileSystem::addToIndex(const size_t mountPointIndex)
+{
+  const auto& mountPoint = m_mountPoints[mountPointIndex];
+  if (!mountPoint.indexed)
+  {
+    return;
+  }
+
+  const auto& imageFileSystem =
+    static_cast<const ImageFileSystemBase&>(*mountPoint.mountedFileSystem);
+  const auto mountPointKey = makePathIndexKey(mountPoint.path);
+  for (const auto& [key, entry] : imageFileSystem.index())
+  {
+    const auto fullKey = mountPointKey.empty() ? key
+                         : key.empty()         ? mountPointKey
+                                               : mountPointKey + "/" + key;
+    m_index[fullKey] = mountPointIndex;
+  }
+}
+
+std::tuple<const VirtualMountPoint*, PathInfo> VirtualFileSystem::findMountPoint(
+  const std::filesystem::path& path) const
+{
+  const auto indexIt = m_index.find(makePathIndexKey(path));
+  const auto indexedMountPointIndex =
+    indexIt != m_index.end() ? std::optional{indexIt->second} : std::nullopt;
+
+  // Only the indexed mount point with the highest priority that contains the path needs
+  // to be checked, but mount points that are not indexed must be checked individually.
+  auto checkAllMountPoints = false;
+  for (size_t i = m_mountPoints.size(); i > 0; --i)
+  {
+    const auto& mountPoint = m_mountPoints[i - 1];
+    const auto isIndexedMountPoint = indexedMountPointIndex == i - 1;
+    if (mountPoint.indexed && !isIndexedMountPoint && !checkAllMountPoints)
+    {
+      continue;
+    }
+
     if (matches(mountPoint, path))
     {
       const auto pathSuffix = suffix(mountPoint, path);
-      if (mountPoint.mountedFileSystem->pathInfo(pathSuffix) != PathInfo::Unknown)
+      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
+          pathInfo != PathInfo::Unknown)
       {
-        return mountPoint.mountedFileSystem->openFile(pathSuffix);
+        return {&mountPoint, pathInfo};
       }
     }
+
+    // if the indexed mount point does not contain the path, then the index is outdated
+    // because the image file system is being reloaded
+    checkAllMountPoints = checkAllMountPoints || isIndexedMountPoint;
   }
 
-  return Error{"'" + path.string() + "' not found"};
+  return {nullptr, PathInfo::Unknown};
 }
 
 WritableVirtualFileSystem::WritableVirtualFileSystem(
@@ -263,6 +327,12 @@ PathInfo WritableVirtualFileSystem::pathInfo(const std::filesystem::path& path)
   return m_virtualFs.pathInfo(path);
 }
 
+Result<std::filesystem::path> WritableVirtualFileSystem::diskFilePath(
+  const std::filesystem::path& path) const
+{
+  return m_virtualFs.diskFilePath(path);
+}
+
 Result<std::vector<std::filesystem::path>> WritableVirtualFileSystem::doFind(
   const std::filesystem::path& path, const TraversalMode traversalMode) const
 {
@@ -24,6 +24,9 @@
 
 #include <filesystem>
 #include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom::IO
@@ -48,6 +51,7 @@ struct VirtualMountPoint
   VirtualMountPointId id;
   std::filesystem::path path;
   std::unique_ptr<FileSystem> mountedFileSystem;
+  bool indexed = false;
 };
 
 class VirtualFileSystem : public FileSystem
@@ -55,21 +59,46 @@ class VirtualFileSystem : public FileSystem
 private:
   std::vector<VirtualMountPoint> m_mountPoints;
 
+  /**
+   * Maps the path index keys of the entries of all mounted image file systems to the
+   * position of the mount point with the highest priority that contains the entry.
+   */
+  std::unordered_map<std::string, size_t> m_index;
+
 public:
   Result<std::filesystem::path> makeAbsolute(
     const std::filesystem::path& path) const override;
   PathInfo pathInfo(const std::filesystem::path& path) const override;
+  Result<std::filesystem::path> diskFilePath(
+    const std::filesystem::path& path) const override;
 
   VirtualMountPointId mount(
     const std::filesystem::path& path, std::unique_ptr<FileSystem> fs);
   bool unmount(const VirtualMountPointId& id);
   void unmountAll();
 
+  /**
+   * Rebuilds the index of the mounted image file systems. Must be called when a mounted
+   * image file system was reloaded.
+   */
+  void updateIndex();
+
 protected:
   Result<std::vector<std::filesystem::path>> doFind(
     const std::filesystem::path& path, TraversalMode traversalMode) const override;
   Result<std::shared_ptr<File>> doOpenFile(
     const std::filesystem::path& path) const override;
+
+private:
+  void addToIndex(size_t mountPointIndex);
+
+  /**
+   * Returns the mount point with the highest priority that contains the given path
+   * together with the info of the path in that mount point. If no mount point contains
+   * the given path, null and PathInfo::Unknown are returned.
+   */
+  std::tuple<const VirtualMountPoint*, PathInfo> findMountPoint(
+    const std::filesystem::path& path) const;
 };
 
 class WritableVirtualFileSystem : public WritableFileSystem
@@ -87,6 +116,8 @@ public:
   Result<std::filesystem::path> makeAbsolute(
     const std::filesystem::path& path) const override;
   PathInfo pathInfo(const std::filesystem::path& path) const override;
+  Result<std::filesystem::path> diskFilePath(
+    const std::filesystem::path& path) const override;
 
 private:
   Result<std::vector<std::filesystem::path>> doFind(
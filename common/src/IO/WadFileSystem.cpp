@@ -28,6 +28,8 @@
 #include "kdl/string_format.h"
 #include "kdl/string_utils.h"
 
+#include <algorithm>
+
 namespace TrenchBroom::IO
 {
 namespace WadLayout
@@ -55,8 +57,18 @@ namespace WadEntryType
 // static const char WEPalette   = '@';
 }
 
-WadFileSystem::WadFileSystem(std::shared_ptr<CFile> file)
-  : ImageFileSystem{file->buffer()}
+namespace
+{
+std::shared_ptr<OwningBufferFile> bufferFile(const MappedFile& file)
+{
+  auto buffer = std::make_unique<char[]>(file.size());
+  std::copy(file.begin(), file.end(), buffer.get());
+  return std::make_shared<OwningBufferFile>(std::move(buffer), file.size());
+}
+} // namespace
+
+WadFileSystem::WadFileSystem(std::shared_ptr<MappedFile> file)
+  : ImageFileSystem{bufferFile(*file), file->path()}
 {
 }
 
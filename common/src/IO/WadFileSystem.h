@@ -27,12 +27,17 @@
 namespace TrenchBroom::IO
 {
 class FileSystem;
+class MappedFile;
 class OwningBufferFile;
 
 class WadFileSystem : public ImageFileSystem<OwningBufferFile>
 {
 public:
-  explicit WadFileSystem(std::shared_ptr<CFile> file);
+  /**
+   * Copies the given file into memory. Wad files are often edited while they are in use,
+   * so they must not remain mapped.
+   */
+  explicit WadFileSystem(std::shared_ptr<MappedFile> file);
 
 private:
   Result<void> doReadDirectory() override;
@@ -78,6 +78,7 @@ WorldReader::WorldReader(
       entityPropertyConfig, Model::Entity{}, sourceAndTargetMapFormat)}
 {
   m_worldNode->disableNodeTreeUpdates();
+  m_worldNode->disableEntityNodeIndexUpdates();
 }
 
 std::unique_ptr<Model::WorldNode> WorldReader::tryRead(
@@ -189,6 +190,8 @@ std::unique_ptr<Model::WorldNode> WorldReader::read(
   setLinkIds(*m_worldNode, status);
   m_worldNode->rebuildNodeTree();
   m_worldNode->enableNodeTreeUpdates();
+  m_worldNode->rebuildEntityNodeIndex();
+  m_worldNode->enableEntityNodeIndexUpdates();
   return std::move(m_worldNode);
 }
 
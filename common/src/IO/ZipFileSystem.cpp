@@ -66,9 +66,9 @@ Result<void> ZipFileSystem::doReadDirectory()
 {
   mz_zip_zero_struct(&m_archive);
 
-  if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE)
+  if (mz_zip_reader_init_mem(&m_archive, m_file->begin(), m_file->size(), 0) != MZ_TRUE)
   {
-    return Error{"Error calling mz_zip_reader_init_cfile"};
+    return Error{"Error calling mz_zip_reader_init_mem"};
   }
 
   const auto numFiles = mz_zip_reader_get_num_files(&m_archive);
@@ -78,25 +78,30 @@ Result<void> ZipFileSystem::doReadDirectory()
     {
       const auto path = std::filesystem::path{filename(m_archive, i)};
       addFile(path, [&, i, path]() -> Result<std::shared_ptr<File>> {
+        // miniz updates the archive state when extracting, so extraction must be
+        // serialized even though the archive is read from memory
         auto loadFileGoard = std::lock_guard{m_mutex};
 
-        auto stat = mz_zip_archive_file_stat{};
-        if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
-        {
-          return Error{"mz_zip_reader_file_stat failed for " + path.string()};
-        }
-
-        const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-        auto data = std::make_unique<char[]>(uncompressedSize);
-        auto* begin = data.get();
-
-        if (!mz_zip_reader_extract_to_mem(&m_archive, i, begin, uncompressedSize, 0))
-        {
-          return Error{"mz_zip_reader_extract_to_mem failed for " + path.string()};
-        }
-
-        return std::static_pointer_cast<File>(
-          std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+        // the zip file remains mapped, so it must not be read if it was truncated
+        return m_file->checkUnchanged().and_then([&]() -> Result<std::shared_ptr<File>> {
+          auto stat = mz_zip_archive_file_stat{};
+          if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
+          {
+            return Error{"mz_zip_reader_file_stat failed for " + path.string()};
+          }
+
+          const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
+          auto data = std::make_unique<char[]>(uncompressedSize);
+          auto* begin = data.get();
+
+          if (!mz_zip_reader_extract_to_mem(&m_archive, i, begin, uncompressedSize, 0))
+          {
+            return Error{"mz_zip_reader_extract_to_mem failed for " + path.string()};
+          }
+
+          return std::static_pointer_cast<File>(
+            std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+        });
       });
     }
   }
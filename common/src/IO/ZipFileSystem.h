@@ -28,9 +28,9 @@
 
 namespace TrenchBroom::IO
 {
-class CFile;
+class MappedFile;
 
-class ZipFileSystem : public ImageFileSystem<CFile>
+class ZipFileSystem : public ImageFileSystem<MappedFile>
 {
 private:
   mz_zip_archive m_archive;
@@ -142,4 +142,14 @@ void Logger::log(const LogLevel level, const QString& message)
 
 void NullLogger::doLog(const LogLevel /* level */, const std::string& /* message */) {}
 void NullLogger::doLog(const LogLevel /* level */, const QString& /* message */) {}
+
+void BufferedLogger::doLog(const LogLevel level, const std::string& message)
+{
+  messages.emplace_back(level, message);
+}
+
+void BufferedLogger::doLog(const LogLevel level, const QString& message)
+{
+  messages.emplace_back(level, message.toStdString());
+}
 } // namespace TrenchBroom
@@ -21,6 +21,8 @@
 
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 class QString;
 
@@ -94,4 +96,18 @@ private:
   void doLog(LogLevel level, const std::string& message) override;
   void doLog(LogLevel level, const QString& message) override;
 };
+
+/**
+ * Collects the messages logged by a worker thread so that they can be passed on to the
+ * actual logger on the main thread.
+ */
+class BufferedLogger : public Logger
+{
+public:
+  std::vector<std::pair<LogLevel, std::string>> messages;
+
+private:
+  void doLog(LogLevel level, const std::string& message) override;
+  void doLog(LogLevel level, const QString& message) override;
+};
 } // namespace TrenchBroom
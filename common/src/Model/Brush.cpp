@@ -44,7 +44,9 @@
 #include "vm/vec.h"
 #include "vm/vec_ext.h"
 
+#include <array>
 #include <iterator>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -73,6 +75,7 @@ Brush::Brush(const Brush& other)
       other.m_geometry
         ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback())
         : nullptr}
+  , m_canRebuildGeometryExactly{other.m_canRebuildGeometryExactly}
 {
   if (m_geometry)
   {
@@ -161,6 +164,7 @@ Result<void> Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds)
 
   m_faces = std::move(remainingFaces);
   m_geometry = std::move(geometry);
+  m_canRebuildGeometryExactly = true;
 
   assert(checkFaceLinks());
 
@@ -261,6 +265,11 @@ bool Brush::fullySpecified() const
   return true;
 }
 
+bool Brush::canRebuildGeometryExactly() const
+{
+  return m_canRebuildGeometryExactly;
+}
+
 void Brush::cloneFaceAttributesFrom(const Brush& brush)
 {
   for (auto& destination : m_faces)
@@ -1141,12 +1150,29 @@ std::vector<Result<Brush>> Brush::subtract(
 
   for (const auto* subtrahend : subtrahends)
   {
+    // every fragment is contained in this brush, so a subtrahend that does not touch
+    // this brush cannot touch any fragment
+    if (!bounds().intersects(subtrahend->bounds()))
+    {
+      continue;
+    }
+
     auto nextResults = std::vector<BrushGeometry>{};
+    nextResults.reserve(result.size());
 
-    for (const BrushGeometry& fragment : result)
+    for (auto& fragment : result)
     {
-      auto subFragments = fragment.subtract(*subtrahend->m_geometry);
-      nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
+      if (!fragment.bounds().intersects(subtrahend->bounds()))
+      {
+        // the fragment is not affected by this subtrahend, so we can skip the expensive
+        // polyhedron subtraction
+        nextResults.push_back(std::move(fragment));
+      }
+      else
+      {
+        auto subFragments = fragment.subtract(*subtrahend->m_geometry);
+        nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
+      }
     }
 
     result = std::move(nextResults);
@@ -1173,17 +1199,112 @@ Result<void> Brush::intersect(const vm::bbox3& worldBounds, const Brush& brush)
   return updateGeometryFromFaces(worldBounds);
 }
 
+/**
+ * If the given transformation is a translation combined with a rotation by multiples of
+ * 90 degrees about the coordinate axes, returns the transformation with the rotational
+ * part snapped to exact values. Otherwise, returns nullopt.
+ *
+ * Such transformations map a brush onto a congruent brush with the same topology, and
+ * the snapped values ensure that no rounding errors are introduced into the vertices.
+ */
+static std::optional<vm::mat4x4> snapRightAngleTransformation(
+  const vm::mat4x4& transformation)
+{
+  constexpr auto epsilon = vm::constants<FloatType>::almost_zero();
+
+  if (
+    transformation[0][3] != 0.0 || transformation[1][3] != 0.0
+    || transformation[2][3] != 0.0 || transformation[3][3] != 1.0)
+  {
+    return std::nullopt;
+  }
+
+  auto result = transformation;
+  auto columns = std::array<vm::vec3, 3>{};
+  for (size_t c = 0; c < 3; ++c)
+  {
+    for (size_t r = 0; r < 3; ++r)
+    {
+      const auto value = transformation[c][r];
+      if (vm::abs(value) < epsilon)
+      {
+        result[c][r] = 0.0;
+      }
+      else if (vm::abs(vm::abs(value) - 1.0) < epsilon)
+      {
+        result[c][r] = value > 0.0 ? 1.0 : -1.0;
+      }
+      else
+      {
+        return std::nullopt;
+      }
+      columns[c][r] = result[c][r];
+    }
+  }
+
+  // the columns must be an orthonormal, right handed basis
+  if (
+    vm::squared_length(columns[0]) != 1.0 || vm::squared_length(columns[1]) != 1.0
+    || vm::squared_length(columns[2]) != 1.0
+    || vm::dot(vm::cross(columns[0], columns[1]), columns[2]) != 1.0)
+  {
+    return std::nullopt;
+  }
+
+  return result;
+}
+
 Result<void> Brush::transform(
   const vm::bbox3& worldBounds, const vm::mat4x4& transformation, const bool lockTextures)
 {
+  const auto rightAngleTransformation = snapRightAngleTransformation(transformation);
+  const auto& faceTransformation =
+    rightAngleTransformation ? *rightAngleTransformation : transformation;
+
   for (auto& face : m_faces)
   {
-    if (!face.transform(transformation, lockTextures).is_success())
+    if (!face.transform(faceTransformation, lockTextures).is_success())
     {
       return Error{"Brush has invalid face"};
     }
   }
 
+  if (rightAngleTransformation && m_geometry)
+  {
+    // The transformation cannot change the topology of the geometry, so we can transform
+    // it directly instead of rebuilding it from the faces. We only have to rebuild if the
+    // brush leaves the world bounds, because then it must be clipped.
+    m_geometry->transform(*rightAngleTransformation);
+    if (worldBounds.contains(m_geometry->bounds()))
+    {
+      for (auto* faceGeometry : m_geometry->faces())
+      {
+        const auto faceIndex = faceGeometry->payload();
+        ensure(faceIndex, "face geometry has a payload");
+        faceGeometry->setPlane(m_faces[*faceIndex].boundary());
+      }
+      m_geometry->correctVertexPositions();
+
+      // keep the faces in the same order as if the geometry had been rebuilt
+      BrushFace::sortFaces(m_faces);
+      for (size_t i = 0u; i < m_faces.size(); ++i)
+      {
+        m_faces[i].geometry()->setPayload(i);
+      }
+
+      // clipping the face planes and correcting the vertex positions reproduces integer
+      // vertices, but not necessarily the directly transformed off grid vertices
+      for (const auto* vertex : m_geometry->vertices())
+      {
+        m_canRebuildGeometryExactly =
+          m_canRebuildGeometryExactly && vm::is_integral(vertex->position());
+      }
+
+      assert(checkFaceLinks());
+      return kdl::void_success;
+    }
+  }
+
   return updateGeometryFromFaces(worldBounds);
 }
 
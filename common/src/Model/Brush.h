@@ -58,6 +58,11 @@ private:
   std::vector<BrushFace> m_faces;
   std::unique_ptr<BrushGeometry> m_geometry;
 
+  /**
+   * Whether rebuilding the geometry from the faces yields the same vertex positions.
+   */
+  bool m_canRebuildGeometryExactly = false;
+
   kdl_reflect_decl(Brush, m_faces);
 
 public:
@@ -100,6 +105,14 @@ public: // face management:
   bool closed() const;
   bool fullySpecified() const;
 
+  /**
+   * Indicates whether rebuilding this brush's geometry from its faces yields the same
+   * vertex positions. This holds if the geometry was built from the faces, or if it was
+   * transformed directly and all of its vertices have integer coordinates. It does not
+   * hold for e.g. an off grid brush whose geometry was transformed directly.
+   */
+  bool canRebuildGeometryExactly() const;
+
 public: // clone face attributes from matching faces of other brushes
   void cloneFaceAttributesFrom(const Brush& brush);
   void cloneFaceAttributesFrom(const std::vector<const Brush*>& brushes);
@@ -0,0 +1,173 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BrushDelta.h"
+
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/ParallelTexCoordSystem.h"
+#include "Model/ParaxialTexCoordSystem.h"
+#include "Model/TexCoordSystem.h"
+
+#include "kdl/result.h"
+
+#include <algorithm>
+#include <typeinfo>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+
+bool canShareTexCoordSystem(const BrushFace& face, const BrushFace& referenceFace)
+{
+  // paraxial texture coordinate systems derive part of their state from the face normal,
+  // so only share systems of the same type between faces with the same normal
+  const auto& texCoordSystem = face.texCoordSystem();
+  const auto& referenceTexCoordSystem = referenceFace.texCoordSystem();
+  return typeid(texCoordSystem) == typeid(referenceTexCoordSystem)
+         && face.boundary().normal == referenceFace.boundary().normal
+         && texCoordSystem == referenceTexCoordSystem;
+}
+
+} // namespace
+
+BrushDelta::BrushDelta() = default;
+
+BrushDelta::BrushDelta(
+  const std::vector<BrushFace>& faces, const std::vector<BrushFace>& referenceFaces)
+{
+  m_faces.reserve(faces.size());
+  for (size_t i = 0; i < faces.size(); ++i)
+  {
+    const auto& face = faces[i];
+    const auto* referenceFace = i < referenceFaces.size() ? &referenceFaces[i] : nullptr;
+
+    auto attributes =
+      referenceFace && face.attributes() == referenceFace->attributes()
+        ? nullptr
+        : std::make_unique<BrushFaceAttributes>(face.attributes());
+    auto texCoordSystem =
+      referenceFace && canShareTexCoordSystem(face, *referenceFace)
+        ? nullptr
+        : face.texCoordSystem().clone();
+
+    m_faces.push_back(FaceDelta{
+      face.points(),
+      face.boundary(),
+      std::move(attributes),
+      std::move(texCoordSystem),
+      face.selected()});
+  }
+}
+
+BrushDelta::BrushDelta(BrushDelta&& other) noexcept = default;
+BrushDelta& BrushDelta::operator=(BrushDelta&& other) noexcept = default;
+
+BrushDelta::~BrushDelta() = default;
+
+std::vector<BrushFace> BrushDelta::restoreFaces(
+  const std::vector<BrushFace>& referenceFaces) const
+{
+  auto faces = std::vector<BrushFace>{};
+  faces.reserve(m_faces.size());
+
+  for (size_t i = 0; i < m_faces.size(); ++i)
+  {
+    const auto& faceDelta = m_faces[i];
+    const auto* referenceFace = i < referenceFaces.size() ? &referenceFaces[i] : nullptr;
+    assert(faceDelta.attributes || referenceFace);
+    assert(faceDelta.texCoordSystem || referenceFace);
+
+    auto& face = faces.emplace_back(
+      faceDelta.points,
+      faceDelta.boundary,
+      faceDelta.attributes ? *faceDelta.attributes : referenceFace->attributes(),
+      faceDelta.texCoordSystem ? faceDelta.texCoordSystem->clone()
+                               : referenceFace->texCoordSystem().clone());
+    if (faceDelta.selected)
+    {
+      face.select();
+    }
+  }
+
+  return faces;
+}
+
+Result<Brush> BrushDelta::restore(
+  const vm::bbox3& worldBounds, const std::vector<BrushFace>& referenceFaces) const
+{
+  return Brush::create(worldBounds, restoreFaces(referenceFaces));
+}
+
+BrushDelta BrushDelta::rebase(const BrushDelta& referenceDelta) const
+{
+  auto result = BrushDelta{};
+  result.m_faces.reserve(m_faces.size());
+
+  for (size_t i = 0; i < m_faces.size(); ++i)
+  {
+    const auto& faceDelta = m_faces[i];
+    const auto* referenceFaceDelta =
+      i < referenceDelta.m_faces.size() ? &referenceDelta.m_faces[i] : nullptr;
+    assert(faceDelta.attributes || referenceFaceDelta);
+    assert(faceDelta.texCoordSystem || referenceFaceDelta);
+
+    // if neither delta stores a value, then it is shared with the reference face of the
+    // given delta
+    const auto* attributes = faceDelta.attributes ? faceDelta.attributes.get()
+                                                  : referenceFaceDelta->attributes.get();
+    const auto* texCoordSystem = faceDelta.texCoordSystem
+                                   ? faceDelta.texCoordSystem.get()
+                                   : referenceFaceDelta->texCoordSystem.get();
+
+    result.m_faces.push_back(FaceDelta{
+      faceDelta.points,
+      faceDelta.boundary,
+      attributes ? std::make_unique<BrushFaceAttributes>(*attributes) : nullptr,
+      texCoordSystem ? texCoordSystem->clone() : nullptr,
+      faceDelta.selected});
+  }
+
+  return result;
+}
+
+size_t BrushDelta::memoryUsage() const
+{
+  static constexpr auto texCoordSystemSize =
+    std::max(sizeof(ParallelTexCoordSystem), sizeof(ParaxialTexCoordSystem));
+
+  auto result = m_faces.capacity() * sizeof(FaceDelta);
+  for (const auto& faceDelta : m_faces)
+  {
+    if (faceDelta.attributes)
+    {
+      // the texture name is interned and not owned by the attributes
+      result += sizeof(BrushFaceAttributes);
+    }
+    if (faceDelta.texCoordSystem)
+    {
+      result += texCoordSystemSize;
+    }
+  }
+  return result;
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,108 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Model/BrushFace.h"
+#include "Result.h"
+
+#include "vm/bbox.h"
+#include "vm/plane.h"
+
+#include <memory>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+class Brush;
+class TexCoordSystem;
+
+/**
+ * Stores the faces of a brush compactly as a difference to the faces of a reference
+ * brush, e.g. the brush that replaced it in a brush node.
+ *
+ * The plane points of every face are stored, but face attributes and texture coordinate
+ * systems are only stored if they differ from those of the reference face at the same
+ * index. No brush geometry is stored, it is rebuilt from the faces when the brush is
+ * restored. This is lossy for brushes whose geometry cannot be recovered exactly from
+ * their face planes. Use Brush::canRebuildGeometryExactly to check whether a brush can be
+ * stored as a delta.
+ */
+class BrushDelta
+{
+private:
+  struct FaceDelta
+  {
+    BrushFace::Points points;
+    vm::plane3 boundary;
+    std::unique_ptr<BrushFaceAttributes> attributes;
+    std::unique_ptr<TexCoordSystem> texCoordSystem;
+    bool selected;
+  };
+
+  std::vector<FaceDelta> m_faces;
+
+  BrushDelta();
+
+public:
+  /**
+   * Creates a delta that stores the given faces relative to the given reference faces.
+   */
+  BrushDelta(
+    const std::vector<BrushFace>& faces, const std::vector<BrushFace>& referenceFaces);
+
+  BrushDelta(BrushDelta&& other) noexcept;
+  BrushDelta& operator=(BrushDelta&& other) noexcept;
+
+  ~BrushDelta();
+
+  /**
+   * Restores the faces stored in this delta. The given reference faces must be equal to
+   * the faces that this delta was created with.
+   *
+   * The returned faces are not attached to any brush geometry, and their textures are
+   * not set.
+   */
+  std::vector<BrushFace> restoreFaces(const std::vector<BrushFace>& referenceFaces) const;
+
+  /**
+   * Restores the brush stored in this delta and rebuilds its geometry. The given
+   * reference faces must be equal to the faces that this delta was created with.
+   */
+  Result<Brush> restore(
+    const vm::bbox3& worldBounds, const std::vector<BrushFace>& referenceFaces) const;
+
+  /**
+   * Returns a delta that stores the same faces as this delta, but relative to the
+   * reference faces of the given delta. The given delta must store the reference faces
+   * of this delta.
+   *
+   * This allows to combine the deltas of successive brush changes without knowing the
+   * reference faces.
+   */
+  BrushDelta rebase(const BrushDelta& referenceDelta) const;
+
+  /**
+   * Returns an estimate of the number of bytes allocated by this delta.
+   */
+  size_t memoryUsage() const;
+};
+
+} // namespace TrenchBroom::Model
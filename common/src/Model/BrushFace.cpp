@@ -149,7 +149,7 @@ Result<BrushFace> BrushFace::createFromStandard(
   const vm::vec3& point0,
   const vm::vec3& point1,
   const vm::vec3& point2,
-  const BrushFaceAttributes& inputAttribs,
+  BrushFaceAttributes inputAttribs,
   const MapFormat mapFormat)
 {
   assert(mapFormat != MapFormat::Unknown);
@@ -168,17 +168,18 @@ Result<BrushFace> BrushFace::createFromStandard(
     // Pass through paraxial
     texCoordSystem =
       std::make_unique<ParaxialTexCoordSystem>(point0, point1, point2, inputAttribs);
-    attribs = inputAttribs;
+    attribs = std::move(inputAttribs);
   }
 
-  return BrushFace::create(point0, point1, point2, attribs, std::move(texCoordSystem));
+  return BrushFace::create(
+    point0, point1, point2, std::move(attribs), std::move(texCoordSystem));
 }
 
 Result<BrushFace> BrushFace::createFromValve(
   const vm::vec3& point1,
   const vm::vec3& point2,
   const vm::vec3& point3,
-  const BrushFaceAttributes& inputAttribs,
+  BrushFaceAttributes inputAttribs,
   const vm::vec3& texAxisX,
   const vm::vec3& texAxisY,
   MapFormat mapFormat)
@@ -192,7 +193,7 @@ Result<BrushFace> BrushFace::createFromValve(
   {
     // Pass through parallel
     texCoordSystem = std::make_unique<ParallelTexCoordSystem>(texAxisX, texAxisY);
-    attribs = inputAttribs;
+    attribs = std::move(inputAttribs);
   }
   else
   {
@@ -201,20 +202,21 @@ Result<BrushFace> BrushFace::createFromValve(
       point1, point2, point3, inputAttribs, texAxisX, texAxisY);
   }
 
-  return BrushFace::create(point1, point2, point3, attribs, std::move(texCoordSystem));
+  return BrushFace::create(
+    point1, point2, point3, std::move(attribs), std::move(texCoordSystem));
 }
 
 Result<BrushFace> BrushFace::create(
   const vm::vec3& point0,
   const vm::vec3& point1,
   const vm::vec3& point2,
-  const BrushFaceAttributes& attributes,
+  BrushFaceAttributes attributes,
   std::unique_ptr<TexCoordSystem> texCoordSystem)
 {
   Points points = {{vm::correct(point0), vm::correct(point1), vm::correct(point2)}};
   if (const auto plane = vm::from_points(points[0], points[1], points[2]))
   {
-    return BrushFace{points, *plane, attributes, std::move(texCoordSystem)};
+    return BrushFace{points, *plane, std::move(attributes), std::move(texCoordSystem)};
   }
   return Error{"Brush has invalid face"};
 }
@@ -222,11 +224,11 @@ Result<BrushFace> BrushFace::create(
 BrushFace::BrushFace(
   const BrushFace::Points& points,
   const vm::plane3& boundary,
-  const BrushFaceAttributes& attributes,
+  BrushFaceAttributes attributes,
   std::unique_ptr<TexCoordSystem> texCoordSystem)
   : m_points(points)
   , m_boundary(boundary)
-  , m_attributes(attributes)
+  , m_attributes(std::move(attributes))
   , m_texCoordSystem(std::move(texCoordSystem))
   , m_geometry(nullptr)
   , m_lineNumber(0)
@@ -145,7 +145,7 @@ public:
     const vm::vec3& point0,
     const vm::vec3& point1,
     const vm::vec3& point2,
-    const BrushFaceAttributes& attributes,
+    BrushFaceAttributes attributes,
     MapFormat mapFormat);
 
   /**
@@ -160,7 +160,7 @@ public:
     const vm::vec3& point1,
     const vm::vec3& point2,
     const vm::vec3& point3,
-    const BrushFaceAttributes& attributes,
+    BrushFaceAttributes attributes,
     const vm::vec3& texAxisX,
     const vm::vec3& texAxisY,
     MapFormat mapFormat);
@@ -169,13 +169,13 @@ public:
     const vm::vec3& point0,
     const vm::vec3& point1,
     const vm::vec3& point2,
-    const BrushFaceAttributes& attributes,
+    BrushFaceAttributes attributes,
     std::unique_ptr<TexCoordSystem> texCoordSystem);
 
   BrushFace(
     const BrushFace::Points& points,
     const vm::plane3& boundary,
-    const BrushFaceAttributes& attributes,
+    BrushFaceAttributes attributes,
     std::unique_ptr<TexCoordSystem> texCoordSystem);
 
   static void sortFaces(std::vector<BrushFace>& faces);
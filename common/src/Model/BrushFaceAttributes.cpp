@@ -54,6 +54,8 @@ BrushFaceAttributes::BrushFaceAttributes(const BrushFaceAttributes& other)
 {
 }
 
+BrushFaceAttributes::BrushFaceAttributes(BrushFaceAttributes&& other) noexcept = default;
+
 BrushFaceAttributes::BrushFaceAttributes(
   std::string_view textureName, const BrushFaceAttributes& other)
   : m_textureName(textureName)
@@ -90,6 +92,11 @@ void swap(BrushFaceAttributes& lhs, BrushFaceAttributes& rhs)
 }
 
 const std::string& BrushFaceAttributes::textureName() const
+{
+  return m_textureName.name();
+}
+
+const Assets::TextureName& BrushFaceAttributes::internedTextureName() const
 {
   return m_textureName;
 }
@@ -173,13 +180,13 @@ bool BrushFaceAttributes::valid() const
 
 bool BrushFaceAttributes::setTextureName(const std::string& textureName)
 {
-  if (textureName == m_textureName)
+  if (textureName == m_textureName.name())
   {
     return false;
   }
   else
   {
-    m_textureName = textureName;
+    m_textureName = Assets::TextureName{textureName};
     return true;
   }
 }
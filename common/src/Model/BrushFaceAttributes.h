@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "Assets/TextureName.h"
 #include "Color.h"
 
 #include "kdl/reflection_decl.h"
@@ -45,7 +46,7 @@ public:
   static const std::string NoTextureName;
 
 private:
-  std::string m_textureName;
+  Assets::TextureName m_textureName;
 
   vm::vec2f m_offset;
   vm::vec2f m_scale;
@@ -60,6 +61,7 @@ private:
 public:
   explicit BrushFaceAttributes(std::string_view textureName);
   BrushFaceAttributes(const BrushFaceAttributes& other);
+  BrushFaceAttributes(BrushFaceAttributes&& other) noexcept;
   BrushFaceAttributes(std::string_view textureName, const BrushFaceAttributes& other);
 
   BrushFaceAttributes& operator=(BrushFaceAttributes other);
@@ -78,6 +80,7 @@ public:
   friend void swap(BrushFaceAttributes& lhs, BrushFaceAttributes& rhs);
 
   const std::string& textureName() const;
+  const Assets::TextureName& internedTextureName() const;
 
   const vm::vec2f& offset() const;
   float xOffset() const;
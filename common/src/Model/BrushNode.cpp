@@ -414,6 +414,12 @@ GroupNode* BrushNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void BrushNode::doLinkIdDidChange(const std::string& oldLinkId)
+{
+  removeFromLinkIdIndex(this, oldLinkId);
+  addToLinkIdIndex(this, linkId());
+}
+
 void BrushNode::invalidateVertexCache()
 {
   m_brushRendererBrushCache->invalidateVertexCache();
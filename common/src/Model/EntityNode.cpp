@@ -276,6 +276,12 @@ GroupNode* EntityNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void EntityNode::doLinkIdDidChange(const std::string& oldLinkId)
+{
+  removeFromLinkIdIndex(this, oldLinkId);
+  addToLinkIdIndex(this, linkId());
+}
+
 void EntityNode::invalidateBounds()
 {
   m_cachedBounds = std::nullopt;
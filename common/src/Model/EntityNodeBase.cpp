@@ -623,10 +623,15 @@ void EntityNodeBase::removeAllLinks()
   removeAllKillTargets();
 }
 
-void EntityNodeBase::addAllLinks()
+void EntityNodeBase::addAllLinkAndKillTargets()
 {
   addAllLinkTargets();
   addAllKillTargets();
+}
+
+void EntityNodeBase::addAllLinks()
+{
+  addAllLinkAndKillTargets();
 
   const auto* targetname = m_entity.property(EntityPropertyKeys::Targetname);
   if (targetname && !targetname->empty())
@@ -118,6 +118,12 @@ public: // link management
   std::vector<std::string> findMissingLinkTargets() const;
   std::vector<std::string> findMissingKillTargets() const;
 
+  /**
+   * Links this node to all nodes that it targets or killtargets. This is used to create
+   * the links between entity nodes after the entity node index was built in bulk.
+   */
+  void addAllLinkAndKillTargets();
+
 private: // link management internals
   void findMissingTargets(
     const std::string& prefix, std::vector<std::string>& result) const;
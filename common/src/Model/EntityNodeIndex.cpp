@@ -30,6 +30,8 @@
 #include <iterator>
 #include <list>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -139,6 +141,30 @@ void EntityNodeIndex::removeEntityNode(EntityNodeBase* node)
     removeProperty(node, property.key(), property.value());
 }
 
+void EntityNodeIndex::rebuild(const std::vector<EntityNodeBase*>& nodes)
+{
+  auto keys = std::vector<std::pair<std::string_view, EntityNodeBase*>>{};
+  auto values = std::vector<std::pair<std::string_view, EntityNodeBase*>>{};
+
+  for (auto* node : nodes)
+  {
+    for (const auto& property : node->entity().properties())
+    {
+      keys.emplace_back(property.key(), node);
+      values.emplace_back(property.value(), node);
+    }
+  }
+
+  *m_keyIndex = EntityNodeStringIndex::build(keys);
+  *m_valueIndex = EntityNodeStringIndex::build(values);
+}
+
+void EntityNodeIndex::clear()
+{
+  m_keyIndex->clear();
+  m_valueIndex->clear();
+}
+
 void EntityNodeIndex::addProperty(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
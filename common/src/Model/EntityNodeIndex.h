@@ -77,6 +77,13 @@ public:
   void addEntityNode(EntityNodeBase* node);
   void removeEntityNode(EntityNodeBase* node);
 
+  /**
+   * Replaces the contents of this index with the properties of the given nodes. This is
+   * much faster than adding the nodes one by one, e.g. when a map is loaded.
+   */
+  void rebuild(const std::vector<EntityNodeBase*>& nodes);
+  void clear();
+
   void addProperty(
     EntityNodeBase* node, const std::string& key, const std::string& value);
   void removeProperty(
@@ -111,6 +111,11 @@ Result<void> Game::writeMap(WorldNode& world, const std::filesystem::path& path)
   return doWriteMap(world, path);
 }
 
+void Game::writeMapToStream(WorldNode& world, std::ostream& stream) const
+{
+  doWriteMapToStream(world, stream);
+}
+
 Result<void> Game::exportMap(WorldNode& world, const IO::ExportOptions& options) const
 {
   return doExportMap(world, options);
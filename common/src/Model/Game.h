@@ -114,6 +114,7 @@ public: // loading and writing map files
     const std::filesystem::path& path,
     Logger& logger) const;
   Result<void> writeMap(WorldNode& world, const std::filesystem::path& path) const;
+  void writeMapToStream(WorldNode& world, std::ostream& stream) const;
   Result<void> exportMap(WorldNode& world, const IO::ExportOptions& options) const;
 
 public: // parsing and serializing objects
@@ -190,6 +191,7 @@ private: // subclassing interface
     Logger& logger) const = 0;
   virtual Result<void> doWriteMap(
     WorldNode& world, const std::filesystem::path& path) const = 0;
+  virtual void doWriteMapToStream(WorldNode& world, std::ostream& stream) const = 0;
   virtual Result<void> doExportMap(
     WorldNode& world, const IO::ExportOptions& options) const = 0;
 
@@ -63,7 +63,14 @@ void GameFileSystem::initialize(
 
 Result<void> GameFileSystem::reloadShaders()
 {
-  return m_shaderFS ? m_shaderFS->reload() : Result<void>{};
+  if (!m_shaderFS)
+  {
+    return Result<void>{};
+  }
+
+  auto result = m_shaderFS->reload();
+  updateIndex();
+  return result;
 }
 
 void GameFileSystem::reloadWads(
@@ -129,7 +136,7 @@ Result<std::unique_ptr<IO::FileSystem>> createImageFileSystem(
 {
   if (kdl::ci::str_is_equal(packageFormat, "idpak"))
   {
-    return IO::Disk::openFile(path)
+    return IO::Disk::mapFile(path)
       .and_then([](auto file) {
         return IO::createImageFileSystem<IO::IdPakFileSystem>(std::move(file));
       })
@@ -137,7 +144,7 @@ Result<std::unique_ptr<IO::FileSystem>> createImageFileSystem(
   }
   else if (kdl::ci::str_is_equal(packageFormat, "dkpak"))
   {
-    return IO::Disk::openFile(path)
+    return IO::Disk::mapFile(path)
       .and_then([](auto file) {
         return IO::createImageFileSystem<IO::DkPakFileSystem>(std::move(file));
       })
@@ -145,7 +152,7 @@ Result<std::unique_ptr<IO::FileSystem>> createImageFileSystem(
   }
   else if (kdl::ci::str_is_equal(packageFormat, "zip"))
   {
-    return IO::Disk::openFile(path)
+    return IO::Disk::mapFile(path)
       .and_then([](auto file) {
         return IO::createImageFileSystem<IO::ZipFileSystem>(std::move(file));
       })
@@ -221,7 +228,7 @@ void GameFileSystem::mountWads(
   for (const auto& wadPath : wadPaths)
   {
     const auto resolvedWadPath = IO::Disk::resolvePath(wadSearchPaths, wadPath);
-    IO::Disk::openFile(resolvedWadPath)
+    IO::Disk::mapFile(resolvedWadPath)
       .and_then([](auto file) {
         return IO::createImageFileSystem<IO::WadFileSystem>(std::move(file));
       })
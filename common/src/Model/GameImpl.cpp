@@ -218,7 +218,7 @@ Result<std::unique_ptr<WorldNode>> GameImpl::doLoadMap(
   Logger& logger) const
 {
   auto parserStatus = IO::SimpleParserStatus{logger};
-  return IO::Disk::openFile(path).transform([&](auto file) {
+  return IO::Disk::mapFile(path).transform([&](auto file) {
     auto fileReader = file->reader().buffer();
     if (format == MapFormat::Unknown)
     {
@@ -245,13 +245,7 @@ Result<void> GameImpl::doWriteMap(
   WorldNode& world, const std::filesystem::path& path, const bool exporting) const
 {
   return IO::Disk::withOutputStream(path, [&](auto& stream) {
-    const auto mapFormatName = formatName(world.mapFormat());
-    stream << "// Game: " << gameName() << "\n"
-           << "// Format: " << mapFormatName << "\n";
-
-    auto writer = IO::NodeWriter{world, stream};
-    writer.setExporting(exporting);
-    writer.writeMap();
+    doWriteMapToStream(world, stream, exporting);
   });
 }
 
@@ -261,6 +255,23 @@ Result<void> GameImpl::doWriteMap(
   return doWriteMap(world, path, false);
 }
 
+void GameImpl::doWriteMapToStream(
+  WorldNode& world, std::ostream& stream, const bool exporting) const
+{
+  const auto mapFormatName = formatName(world.mapFormat());
+  stream << "// Game: " << gameName() << "\n"
+         << "// Format: " << mapFormatName << "\n";
+
+  auto writer = IO::NodeWriter{world, stream};
+  writer.setExporting(exporting);
+  writer.writeMap();
+}
+
+void GameImpl::doWriteMapToStream(WorldNode& world, std::ostream& stream) const
+{
+  doWriteMapToStream(world, stream, false);
+}
+
 Result<void> GameImpl::doExportMap(
   WorldNode& world, const IO::ExportOptions& options) const
 {
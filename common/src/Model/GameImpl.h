@@ -87,6 +87,8 @@ private:
     WorldNode& world, const std::filesystem::path& path, bool exporting) const;
   Result<void> doWriteMap(
     WorldNode& world, const std::filesystem::path& path) const override;
+  void doWriteMapToStream(WorldNode& world, std::ostream& stream, bool exporting) const;
+  void doWriteMapToStream(WorldNode& world, std::ostream& stream) const override;
   Result<void> doExportMap(
     WorldNode& world, const IO::ExportOptions& options) const override;
 
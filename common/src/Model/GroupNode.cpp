@@ -309,6 +309,12 @@ GroupNode* GroupNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void GroupNode::doLinkIdDidChange(const std::string& oldLinkId)
+{
+  removeFromLinkIdIndex(this, oldLinkId);
+  addToLinkIdIndex(this, linkId());
+}
+
 void GroupNode::invalidateBounds()
 {
   m_boundsValid = false;
@@ -32,6 +32,7 @@
 #include "kdl/overload.h"
 #include "kdl/vector_utils.h"
 
+#include <atomic>
 #include <string>
 
 namespace TrenchBroom
@@ -107,7 +108,8 @@ bool Issue::hidden() const
 
 size_t Issue::nextSeqId()
 {
-  static size_t seqId = 0;
+  // issues are created concurrently when nodes are validated in parallel
+  static auto seqId = std::atomic<size_t>{0};
   return seqId++;
 }
 
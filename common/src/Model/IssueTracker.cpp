@@ -0,0 +1,132 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IssueTracker.h"
+
+#include "Model/Issue.h"
+#include "Model/Node.h"
+
+#include "kdl/parallel.h"
+#include "kdl/vector_utils.h"
+
+#include <algorithm>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+
+std::vector<const Issue*> sortBySeqId(std::vector<const Issue*> issues)
+{
+  return kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) {
+    return lhs->seqId() > rhs->seqId();
+  });
+}
+
+} // namespace
+
+void IssueTracker::addNode(Node& node)
+{
+  m_nodes.insert(&node);
+  m_dirtyNodes.insert(&node);
+}
+
+void IssueTracker::removeNode(Node& node)
+{
+  if (m_nodes.erase(&node) > 0)
+  {
+    m_dirtyNodes.erase(&node);
+    if (m_nodesWithIssues.erase(&node) > 0)
+    {
+      m_invalidatedNodes.push_back(&node);
+    }
+  }
+}
+
+void IssueTracker::nodeWasInvalidated(const Node& node)
+{
+  // the node is only used as a key here
+  auto* key = const_cast<Node*>(&node);
+  if (m_nodes.count(key) > 0)
+  {
+    m_dirtyNodes.insert(key);
+    if (m_nodesWithIssues.erase(key) > 0)
+    {
+      m_invalidatedNodes.push_back(&node);
+    }
+  }
+}
+
+std::vector<const Node*> IssueTracker::takeInvalidatedNodes()
+{
+  auto result = std::vector<const Node*>{};
+  std::swap(result, m_invalidatedNodes);
+  return result;
+}
+
+bool IssueTracker::hasDirtyNodes() const
+{
+  return !m_dirtyNodes.empty();
+}
+
+std::vector<const Issue*> IssueTracker::validate(
+  const std::vector<const Validator*>& validators)
+{
+  const auto nodes = std::vector<Node*>{m_dirtyNodes.begin(), m_dirtyNodes.end()};
+  m_dirtyNodes.clear();
+
+  // Groups and entities compute their bounds lazily from their children, and some
+  // validators check the bounds. Computing them here avoids that two threads update the
+  // same cache.
+  for (const auto* node : nodes)
+  {
+    node->logicalBounds();
+  }
+
+  auto issuesPerNode = std::vector<std::vector<const Issue*>>(nodes.size());
+  kdl::parallel_for(nodes.size(), [&](const size_t i) {
+    issuesPerNode[i] = nodes[i]->issues(validators);
+  });
+
+  auto result = std::vector<const Issue*>{};
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    if (!issuesPerNode[i].empty())
+    {
+      m_nodesWithIssues.insert(nodes[i]);
+      result.insert(result.end(), issuesPerNode[i].begin(), issuesPerNode[i].end());
+    }
+  }
+
+  return sortBySeqId(std::move(result));
+}
+
+std::vector<const Issue*> IssueTracker::issues() const
+{
+  auto result = std::vector<const Issue*>{};
+  for (auto* node : m_nodesWithIssues)
+  {
+    // the node is valid, so this does not run any validators
+    const auto nodeIssues = node->issues({});
+    result.insert(result.end(), nodeIssues.begin(), nodeIssues.end());
+  }
+  return sortBySeqId(std::move(result));
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <unordered_set>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+class Issue;
+class Node;
+class Validator;
+
+/**
+ * Keeps track of which nodes of a world need to be validated and which nodes have
+ * published issues.
+ *
+ * Nodes are queued for validation when they are added to the world and whenever their
+ * issues are invalidated. Calling validate() validates all queued nodes in parallel and
+ * returns the new issues, so that observers can update their state incrementally instead
+ * of collecting the issues of every node in the world.
+ *
+ * Invalidating a node destroys its issues immediately. Observers that hold on to issues
+ * must therefore call takeInvalidatedNodes() before they access any of their issues
+ * after the world has changed, and drop every issue belonging to a returned node.
+ */
+class IssueTracker
+{
+private:
+  std::unordered_set<Node*> m_nodes;
+  std::unordered_set<Node*> m_dirtyNodes;
+  std::unordered_set<Node*> m_nodesWithIssues;
+  std::vector<const Node*> m_invalidatedNodes;
+
+public:
+  /**
+   * Starts tracking the given node and queues it for validation. The node's descendants
+   * are not added.
+   */
+  void addNode(Node& node);
+
+  /**
+   * Stops tracking the given node. If the node had published issues, it is reported by
+   * the next call to takeInvalidatedNodes(). The node's descendants are not removed.
+   */
+  void removeNode(Node& node);
+
+  /**
+   * Queues the given node for validation if it is tracked. If the node had published
+   * issues, it is reported by the next call to takeInvalidatedNodes().
+   */
+  void nodeWasInvalidated(const Node& node);
+
+  /**
+   * Returns the nodes whose published issues were destroyed since the last call.
+   */
+  std::vector<const Node*> takeInvalidatedNodes();
+
+  /**
+   * Indicates whether there are nodes waiting to be validated.
+   */
+  bool hasDirtyNodes() const;
+
+  /**
+   * Validates all queued nodes using the given validators and returns their issues,
+   * sorted by descending sequence ID.
+   *
+   * The nodes are validated in parallel. This is safe because validating a node only
+   * modifies that node's issues, and because the calling thread computes the lazily
+   * cached bounds of the queued nodes before the validation starts. The world must not
+   * be modified until this function returns.
+   */
+  std::vector<const Issue*> validate(const std::vector<const Validator*>& validators);
+
+  /**
+   * Returns all published issues, sorted by descending sequence ID. This does not
+   * validate any nodes.
+   */
+  std::vector<const Issue*> issues() const;
+};
+
+} // namespace TrenchBroom::Model
@@ -51,6 +51,12 @@ std::vector<Node*> collectNodesWithLinkId(
       [&](const PatchNode* patchNode) { return patchNode->linkId() == linkId; }));
 }
 
+std::vector<Node*> collectNodesWithLinkId(
+  const WorldNode& worldNode, const std::string& linkId)
+{
+  return worldNode.findNodesWithLinkId(linkId);
+}
+
 std::vector<GroupNode*> collectGroupsWithLinkId(
   const std::vector<Node*>& nodes, const std::string& linkId)
 {
@@ -60,6 +66,20 @@ std::vector<GroupNode*> collectGroupsWithLinkId(
                                })));
 }
 
+std::vector<GroupNode*> collectGroupsWithLinkId(
+  const WorldNode& worldNode, const std::string& linkId)
+{
+  auto result = std::vector<GroupNode*>{};
+  for (auto* node : worldNode.findNodesWithLinkId(linkId))
+  {
+    if (auto* groupNode = dynamic_cast<GroupNode*>(node))
+    {
+      result.push_back(groupNode);
+    }
+  }
+  return result;
+}
+
 std::vector<std::string> collectLinkedGroupIds(const std::vector<Node*>& nodes)
 {
   auto result = std::vector<std::string>{};
@@ -160,7 +180,7 @@ SelectionResult nodeSelectionWithLinkedGroupConstraints(
       for (auto* groupNode : containingGroupNodes)
       {
         // find the others and add them to the lock list
-        for (auto* otherGroup : collectGroupsWithLinkId({&world}, groupNode->linkId()))
+        for (auto* otherGroup : collectGroupsWithLinkId(world, groupNode->linkId()))
         {
           if (otherGroup == groupNode)
           {
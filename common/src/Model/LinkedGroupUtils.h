@@ -45,6 +45,13 @@ namespace TrenchBroom::Model
 std::vector<Node*> collectNodesWithLinkId(
   const std::vector<Node*>& nodes, const std::string& linkId);
 
+/**
+ * Returns the nodes in the given world that have the given link ID. Uses the link ID
+ * index of the world, so unlike the overload above, this does not visit every node.
+ */
+std::vector<Node*> collectNodesWithLinkId(
+  const WorldNode& worldNode, const std::string& linkId);
+
 template <typename N>
 std::vector<N*> collectLinkedNodes(const std::vector<Node*>& nodes, const N& node)
 {
@@ -56,8 +63,21 @@ std::vector<N*> collectLinkedNodes(const std::vector<Node*>& nodes, const N& nod
     })));
 }
 
+template <typename N>
+std::vector<N*> collectLinkedNodes(const WorldNode& worldNode, const N& node)
+{
+  return kdl::vec_static_cast<N*>(node.accept(kdl::overload(
+    [](const WorldNode*) { return std::vector<Node*>{}; },
+    [](const LayerNode*) { return std::vector<Node*>{}; },
+    [&](const Object* object) {
+      return collectNodesWithLinkId(worldNode, object->linkId());
+    })));
+}
+
 std::vector<GroupNode*> collectGroupsWithLinkId(
   const std::vector<Node*>& nodes, const std::string& linkId);
+std::vector<GroupNode*> collectGroupsWithLinkId(
+  const WorldNode& worldNode, const std::string& linkId);
 
 std::vector<std::string> collectLinkedGroupIds(const std::vector<Node*>& nodes);
 std::vector<std::string> collectLinkedGroupIds(const Node& node);
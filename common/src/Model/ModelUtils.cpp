@@ -25,10 +25,13 @@
 #include "Model/BrushFaceHandle.h"
 #include "Model/EditorContext.h"
 #include "Model/NodeQueries.h"
+#include "Model/WorldNode.h"
 #include "Polyhedron.h"
+#include "octree.h"
 
 #include "kdl/vector_utils.h"
 
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom::Model
@@ -163,6 +166,97 @@ std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>&
   return result;
 }
 
+/**
+ * Collects the nodes of the given world that match the given predicate. Instead of
+ * traversing the world, the candidates for every query brush are taken from the world's
+ * node tree, so the cost of this function depends on the number of nodes near the
+ * query brushes rather than on the size of the world.
+ *
+ * Closed groups are matched as a whole against their logical bounds, which may intersect
+ * a query brush even if none of their descendants does. Therefore, closed groups are
+ * collected by walking the group hierarchy without visiting any other nodes.
+ */
+template <typename P>
+static void collectMatchingNodes(
+  WorldNode& world,
+  const std::vector<BrushNode*>& brushes,
+  const std::unordered_set<const BrushNode*>& brushSet,
+  const P& predicate,
+  std::vector<Node*>& result)
+{
+  auto closedGroups = std::vector<GroupNode*>{};
+  world.accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode* worldNode) { worldNode->visitChildren(thisLambda); },
+    [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, GroupNode* group) {
+      if (group->opened() || group->hasOpenedDescendant())
+      {
+        group->visitChildren(thisLambda);
+      }
+      else
+      {
+        closedGroups.push_back(group);
+      }
+    },
+    [](EntityNode*) {},
+    [](BrushNode*) {},
+    [](PatchNode*) {}));
+
+  for (auto* group : closedGroups)
+  {
+    for (const auto* brush : brushes)
+    {
+      if (
+        brush->logicalBounds().intersects(group->logicalBounds())
+        && predicate(group, brush))
+      {
+        result.push_back(group);
+        break;
+      }
+    }
+  }
+
+  auto matchedNodes = std::unordered_set<const Node*>{};
+  const auto collectIfMatching = [&](auto* node, const auto* brush) {
+    if (!matchedNodes.count(node) && predicate(node, brush))
+    {
+      matchedNodes.insert(node);
+      result.push_back(node);
+    }
+  };
+
+  for (const auto* brush : brushes)
+  {
+    world.nodeTree().visit_intersectors(brush->logicalBounds(), [&](Node* node) {
+      if (findOutermostClosedGroup(node))
+      {
+        // already handled above
+        return;
+      }
+
+      node->accept(kdl::overload(
+        [](WorldNode*) {},
+        [](LayerNode*) {},
+        [](GroupNode*) {},
+        [&](EntityNode* entity) {
+          // the children of an entity are contained in the node tree themselves
+          if (!entity->hasChildren())
+          {
+            collectIfMatching(entity, brush);
+          }
+        },
+        [&](BrushNode* brushNode) {
+          // if `brushNode` is one of the search query nodes, don't count it as touching
+          if (!brushSet.count(brushNode))
+          {
+            collectIfMatching(brushNode, brush);
+          }
+        },
+        [&](PatchNode* patch) { collectIfMatching(patch, brush); }));
+    });
+  }
+}
+
 /**
  * Recursively collect brushes and entities from the given vector of node trees such that
  * the returned nodes match the given predicate. A matching brush is only returned if it
@@ -171,6 +265,8 @@ std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>&
  * pair of node and brush.
  *
  * The given predicate must be a function that maps a node and a brush to true or false.
+ * Since world nodes are searched using their node tree, the predicate must only return
+ * true if the bounds of the given node and brush intersect.
  */
 template <typename P>
 static std::vector<Node*> collectMatchingNodes(
@@ -180,6 +276,9 @@ static std::vector<Node*> collectMatchingNodes(
 {
   auto result = std::vector<Node*>{};
 
+  const auto brushSet =
+    std::unordered_set<const BrushNode*>{brushes.begin(), brushes.end()};
+
   const auto collectIfMatching = [&](auto* node) {
     for (const auto* brush : brushes)
     {
@@ -194,7 +293,9 @@ static std::vector<Node*> collectMatchingNodes(
   for (auto* node : nodes)
   {
     node->accept(kdl::overload(
-      [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+      [&](WorldNode* world) {
+        collectMatchingNodes(*world, brushes, brushSet, predicate, result);
+      },
       [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
       [&](auto&& thisLambda, GroupNode* group) {
         if (group->opened() || group->hasOpenedDescendant())
@@ -218,7 +319,7 @@ static std::vector<Node*> collectMatchingNodes(
       },
       [&](BrushNode* brush) {
         // if `brush` is one of the search query nodes, don't count it as touching
-        if (!kdl::vec_contains(brushes, brush))
+        if (!brushSet.count(brush))
         {
           collectIfMatching(brush);
         }
@@ -858,8 +858,23 @@ void Node::validateIssues(const std::vector<const Validator*>& validators)
 
 void Node::invalidateIssues() const
 {
+  const auto wasValid = m_issuesValid;
   m_issues.clear();
   m_issuesValid = false;
+
+  if (wasValid)
+  {
+    issuesWereInvalidated(*this);
+  }
+}
+
+void Node::issuesWereInvalidated(const Node& node) const
+{
+  doIssuesWereInvalidated(node);
+  if (m_parent)
+  {
+    m_parent->issuesWereInvalidated(node);
+  }
 }
 
 const EntityPropertyConfig& Node::entityPropertyConfig() const
@@ -895,6 +910,16 @@ void Node::removeFromIndex(
   doRemoveFromIndex(node, key, value);
 }
 
+void Node::addToLinkIdIndex(Node* node, const std::string& linkId)
+{
+  doAddToLinkIdIndex(node, linkId);
+}
+
+void Node::removeFromLinkIdIndex(Node* node, const std::string& linkId)
+{
+  doRemoveFromLinkIdIndex(node, linkId);
+}
+
 Node* Node::doCloneRecursively(
   const vm::bbox3& worldBounds, const SetLinkId setLinkIds) const
 {
@@ -928,6 +953,8 @@ void Node::doNodePhysicalBoundsDidChange() {}
 void Node::doChildPhysicalBoundsDidChange() {}
 void Node::doDescendantPhysicalBoundsDidChange(Node* /* node */) {}
 
+void Node::doIssuesWereInvalidated(const Node& /* node */) const {}
+
 void Node::doChildWillChange(Node* /* node */) {}
 void Node::doChildDidChange(Node* /* node */) {}
 void Node::doDescendantWillChange(Node* /* node */) {}
@@ -984,4 +1011,20 @@ void Node::doRemoveFromIndex(
   }
 }
 
+void Node::doAddToLinkIdIndex(Node* node, const std::string& linkId)
+{
+  if (m_parent)
+  {
+    m_parent->addToLinkIdIndex(node, linkId);
+  }
+}
+
+void Node::doRemoveFromLinkIdIndex(Node* node, const std::string& linkId)
+{
+  if (m_parent)
+  {
+    m_parent->removeFromLinkIdIndex(node, linkId);
+  }
+}
+
 } // namespace TrenchBroom::Model
@@ -370,6 +370,7 @@ public: // should only be called from this and from the world
 
 private:
   void validateIssues(const std::vector<const Validator*>& validators);
+  void issuesWereInvalidated(const Node& node) const;
 
 public: // visitors
   /**
@@ -513,6 +514,9 @@ protected: // index management
   void removeFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value);
 
+  void addToLinkIdIndex(Node* node, const std::string& linkId);
+  void removeFromLinkIdIndex(Node* node, const std::string& linkId);
+
 private: // subclassing interface
   virtual const std::string& doGetName() const = 0;
   virtual const vm::bbox3& doGetLogicalBounds() const = 0;
@@ -549,6 +553,8 @@ private: // subclassing interface
   virtual void doChildPhysicalBoundsDidChange();
   virtual void doDescendantPhysicalBoundsDidChange(Node* node);
 
+  virtual void doIssuesWereInvalidated(const Node& node) const;
+
   virtual void doChildWillChange(Node* node);
   virtual void doChildDidChange(Node* node);
   virtual void doDescendantWillChange(Node* node);
@@ -579,6 +585,9 @@ private: // subclassing interface
     EntityNodeBase* node, const std::string& key, const std::string& value);
   virtual void doRemoveFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value);
+
+  virtual void doAddToLinkIdIndex(Node* node, const std::string& linkId);
+  virtual void doRemoveFromLinkIdIndex(Node* node, const std::string& linkId);
 };
 
 } // namespace TrenchBroom::Model
@@ -61,6 +61,7 @@ private: // subclassing interface
   virtual Node* doGetContainer() = 0;
   virtual LayerNode* doGetContainingLayer() = 0;
   virtual GroupNode* doGetContainingGroup() = 0;
+  virtual void doLinkIdDidChange(const std::string& oldLinkId) = 0;
 };
 
 } // namespace TrenchBroom::Model
@@ -479,6 +479,12 @@ GroupNode* PatchNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void PatchNode::doLinkIdDidChange(const std::string& oldLinkId)
+{
+  removeFromLinkIdIndex(this, oldLinkId);
+  addToLinkIdIndex(this, linkId());
+}
+
 void PatchNode::doAcceptTagVisitor(TagVisitor& visitor)
 {
   visitor.visit(*this);
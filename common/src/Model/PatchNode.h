@@ -127,6 +127,7 @@ private: // implement Object interface
   Node* doGetContainer() override;
   LayerNode* doGetContainingLayer() override;
   GroupNode* doGetContainingGroup() override;
+  void doLinkIdDidChange(const std::string& oldLinkId) override;
 
 private: // implement Taggable interface
   void doAcceptTagVisitor(TagVisitor& visitor) override;
@@ -22,6 +22,7 @@
 #include "Polyhedron_Forward.h"
 
 #include "kdl/intrusive_circular_list.h"
+#include "kdl/object_pool.h"
 
 #include "vm/bbox.h"
 #include "vm/forward.h"
@@ -70,6 +71,7 @@ struct Polyhedron_GetVertexLink
  */
 template <typename T, typename FP, typename VP>
 class Polyhedron_Vertex
+  : public kdl::pool_allocated<Polyhedron_Vertex<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -220,6 +222,7 @@ struct Polyhedron_GetEdgeLink
  */
 template <typename T, typename FP, typename VP>
 class Polyhedron_Edge
+  : public kdl::pool_allocated<Polyhedron_Edge<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -532,6 +535,7 @@ struct Polyhedron_GetHalfEdgeLink
  */
 template <typename T, typename FP, typename VP>
 class Polyhedron_HalfEdge
+  : public kdl::pool_allocated<Polyhedron_HalfEdge<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -752,6 +756,7 @@ struct Polyhedron_GetFaceLink
  */
 template <typename T, typename FP, typename VP>
 class Polyhedron_Face
+  : public kdl::pool_allocated<Polyhedron_Face<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -1554,6 +1559,21 @@ private:
    */
   void updateBounds();
 
+public: // Transformation
+  /**
+   * Applies the given transformation to the positions of all vertices and to the planes
+   * of all faces of this polyhedron. The topology of this polyhedron is not changed.
+   *
+   * The transformation must be an affine transformation that preserves angles and
+   * orientation, i.e., a combination of a rotation and a translation. Otherwise, the
+   * faces may end up non-planar or with an incorrect winding order.
+   *
+   * Updates the bounds of this polyhedron afterwards.
+   *
+   * @param transformation the transformation to apply
+   */
+  void transform(const vm::mat<T, 4, 4>& transformation);
+
 public: // Vertex correction and edge healing
   /**
    * Rounds each component of position of every vertex to the nearest integer if the
@@ -24,6 +24,7 @@
 #include "kdl/vector_utils.h"
 
 #include "vm/bbox.h"
+#include "vm/mat.h"
 #include "vm/plane.h"
 #include "vm/ray.h"
 #include "vm/scalar.h"
@@ -801,6 +802,20 @@ void Polyhedron<T, FP, VP>::updateBounds()
   }
 }
 
+template <typename T, typename FP, typename VP>
+void Polyhedron<T, FP, VP>::transform(const vm::mat<T, 4, 4>& transformation)
+{
+  for (auto* vertex : m_vertices)
+  {
+    vertex->setPosition(transformation * vertex->position());
+  }
+  for (auto* face : m_faces)
+  {
+    face->setPlane(face->plane().transform(transformation));
+  }
+  updateBounds();
+}
+
 template <typename T, typename FP, typename VP>
 void Polyhedron<T, FP, VP>::correctVertexPositions(const size_t decimals, const T epsilon)
 {
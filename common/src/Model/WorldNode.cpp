@@ -25,8 +25,10 @@
 #include "Model/EntityNode.h"
 #include "Model/EntityNodeIndex.h"
 #include "Model/GroupNode.h"
+#include "Model/IssueTracker.h"
 #include "Model/LayerNode.h"
 #include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
 #include "Model/Validator.h"
 #include "Model/ValidatorRegistry.h"
@@ -38,6 +40,8 @@
 
 #include "vm/bbox_io.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -52,7 +56,9 @@ WorldNode::WorldNode(
   , m_mapFormat{mapFormat}
   , m_defaultLayer{nullptr}
   , m_entityNodeIndex{std::make_unique<EntityNodeIndex>()}
+  , m_updateEntityNodeIndex{true}
   , m_validatorRegistry{std::make_unique<ValidatorRegistry>()}
+  , m_issueTracker{std::make_unique<IssueTracker>()}
   , m_nodeTree{std::make_unique<NodeTree>(256.0)}
   , m_updateNodeTree{true}
 {
@@ -62,6 +68,7 @@ WorldNode::WorldNode(
     EntityPropertyValues::WorldspawnClassname);
   entity.setPointEntity(m_entityPropertyConfig, false);
   setEntity(std::move(entity));
+  m_issueTracker->addNode(*this);
   createDefaultLayer();
 }
 
@@ -186,6 +193,12 @@ const EntityNodeIndex& WorldNode::entityNodeIndex() const
   return *m_entityNodeIndex;
 }
 
+std::vector<Node*> WorldNode::findNodesWithLinkId(const std::string& linkId) const
+{
+  const auto it = m_linkIdIndex.find(linkId);
+  return it != m_linkIdIndex.end() ? it->second : std::vector<Node*>{};
+}
+
 std::vector<const Validator*> WorldNode::registeredValidators() const
 {
   return m_validatorRegistry->registeredValidators();
@@ -208,6 +221,38 @@ void WorldNode::unregisterAllValidators()
   invalidateAllIssues();
 }
 
+IssueTracker& WorldNode::issueTracker()
+{
+  return *m_issueTracker;
+}
+
+void WorldNode::pickFirst(
+  const EditorContext& editorContext,
+  const vm::ray3& ray,
+  const HitFilter& filter,
+  PickResult& pickResult)
+{
+  // pick each node into a separate result so that its matching hits can be found
+  auto nodePickResult = PickResult::byDistance();
+  auto closestMatchDistance = std::numeric_limits<FloatType>::max();
+
+  m_nodeTree->visit_intersectors_in_order(
+    ray,
+    [&](Node* node) {
+      node->pick(editorContext, ray, nodePickResult);
+      for (const auto& hit : nodePickResult.all())
+      {
+        if (filter(hit))
+        {
+          closestMatchDistance = std::min(closestMatchDistance, hit.distance());
+        }
+        pickResult.addHit(hit);
+      }
+      nodePickResult.clear();
+    },
+    [&](const FloatType distance) { return distance <= closestMatchDistance; });
+}
+
 void WorldNode::disableNodeTreeUpdates()
 {
   m_updateNodeTree = false;
@@ -255,6 +300,42 @@ void WorldNode::rebuildNodeTree()
   }
 }
 
+void WorldNode::disableEntityNodeIndexUpdates()
+{
+  m_updateEntityNodeIndex = false;
+  m_entityNodeIndex->clear();
+}
+
+void WorldNode::enableEntityNodeIndexUpdates()
+{
+  m_updateEntityNodeIndex = true;
+}
+
+void WorldNode::rebuildEntityNodeIndex()
+{
+  assert(!m_updateEntityNodeIndex);
+
+  auto nodes = std::vector<EntityNodeBase*>{};
+  accept(kdl::overload(
+    [&](auto&& thisLambda, WorldNode* world) {
+      nodes.push_back(world);
+      world->visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
+    [&](EntityNode* entity) { nodes.push_back(entity); },
+    [](BrushNode*) {},
+    [](PatchNode*) {}));
+
+  m_entityNodeIndex->rebuild(nodes);
+
+  // every link has a source, so it suffices to create the links from the source side
+  for (auto* node : nodes)
+  {
+    node->addAllLinkAndKillTargets();
+  }
+}
+
 void WorldNode::invalidateAllIssues()
 {
   accept([](auto&& thisLambda, Node* node) {
@@ -390,14 +471,27 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
       {
         updatePersistentId(layer);
       }
+      m_issueTracker->addNode(*layer);
     },
     [&](auto&& thisLambda, GroupNode* group) {
       group->visitChildren(thisLambda);
       updatePersistentId(group);
+      addToLinkIdIndex(group, group->linkId());
+      m_issueTracker->addNode(*group);
     },
-    [&](EntityNode*) {},
-    [&](BrushNode*) {},
-    [&](PatchNode*) {}));
+    [&](auto&& thisLambda, EntityNode* entity) {
+      entity->visitChildren(thisLambda);
+      addToLinkIdIndex(entity, entity->linkId());
+      m_issueTracker->addNode(*entity);
+    },
+    [&](BrushNode* brush) {
+      addToLinkIdIndex(brush, brush->linkId());
+      m_issueTracker->addNode(*brush);
+    },
+    [&](PatchNode* patch) {
+      addToLinkIdIndex(patch, patch->linkId());
+      m_issueTracker->addNode(*patch);
+    }));
 }
 
 void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
@@ -425,6 +519,31 @@ void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
       [&](BrushNode* brush) { doRemove(brush); },
       [&](PatchNode* patch) { doRemove(patch); }));
   }
+
+  node->accept(kdl::overload(
+    [&](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, LayerNode* layer) {
+      layer->visitChildren(thisLambda);
+      m_issueTracker->removeNode(*layer);
+    },
+    [&](auto&& thisLambda, GroupNode* group) {
+      group->visitChildren(thisLambda);
+      removeFromLinkIdIndex(group, group->linkId());
+      m_issueTracker->removeNode(*group);
+    },
+    [&](auto&& thisLambda, EntityNode* entity) {
+      entity->visitChildren(thisLambda);
+      removeFromLinkIdIndex(entity, entity->linkId());
+      m_issueTracker->removeNode(*entity);
+    },
+    [&](BrushNode* brush) {
+      removeFromLinkIdIndex(brush, brush->linkId());
+      m_issueTracker->removeNode(*brush);
+    },
+    [&](PatchNode* patch) {
+      removeFromLinkIdIndex(patch, patch->linkId());
+      m_issueTracker->removeNode(*patch);
+    }));
 }
 
 void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node)
@@ -441,6 +560,11 @@ void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node)
   }
 }
 
+void WorldNode::doIssuesWereInvalidated(const Node& node) const
+{
+  m_issueTracker->nodeWasInvalidated(node);
+}
+
 bool WorldNode::doSelectable() const
 {
   return false;
@@ -501,13 +625,36 @@ void WorldNode::doFindEntityNodesWithNumberedProperty(
 void WorldNode::doAddToIndex(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
-  m_entityNodeIndex->addProperty(node, key, value);
+  if (m_updateEntityNodeIndex)
+  {
+    m_entityNodeIndex->addProperty(node, key, value);
+  }
 }
 
 void WorldNode::doRemoveFromIndex(
   EntityNodeBase* node, const std::string& key, const std::string& value)
 {
-  m_entityNodeIndex->removeProperty(node, key, value);
+  if (m_updateEntityNodeIndex)
+  {
+    m_entityNodeIndex->removeProperty(node, key, value);
+  }
+}
+
+void WorldNode::doAddToLinkIdIndex(Node* node, const std::string& linkId)
+{
+  m_linkIdIndex[linkId].push_back(node);
+}
+
+void WorldNode::doRemoveFromLinkIdIndex(Node* node, const std::string& linkId)
+{
+  if (const auto it = m_linkIdIndex.find(linkId); it != m_linkIdIndex.end())
+  {
+    it->second = kdl::vec_erase(std::move(it->second), node);
+    if (it->second.empty())
+    {
+      m_linkIdIndex.erase(it);
+    }
+  }
 }
 
 void WorldNode::doPropertiesDidChange(const vm::bbox3& /* oldBounds */) {}
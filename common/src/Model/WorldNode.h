@@ -23,6 +23,7 @@
 #include "Macros.h"
 #include "Model/EntityNodeBase.h"
 #include "Model/EntityProperties.h"
+#include "Model/HitFilter.h"
 #include "Model/IdType.h"
 #include "Model/MapFormat.h"
 #include "Model/Node.h"
@@ -31,6 +32,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -42,6 +44,7 @@ namespace Model
 {
 class EntityNodeIndex;
 class IssueQuickFix;
+class IssueTracker;
 enum class MapFormat;
 class PickResult;
 class Validator;
@@ -54,7 +57,10 @@ private:
   MapFormat m_mapFormat;
   LayerNode* m_defaultLayer;
   std::unique_ptr<EntityNodeIndex> m_entityNodeIndex;
+  bool m_updateEntityNodeIndex;
+  std::unordered_map<std::string, std::vector<Node*>> m_linkIdIndex;
   std::unique_ptr<ValidatorRegistry> m_validatorRegistry;
+  std::unique_ptr<IssueTracker> m_issueTracker;
 
   using NodeTree = octree<FloatType, Node*>;
   std::unique_ptr<NodeTree> m_nodeTree;
@@ -131,17 +137,62 @@ private:
 public: // index
   const EntityNodeIndex& entityNodeIndex() const;
 
+  /**
+   * Returns all nodes in this world that have the given link ID. This does not traverse
+   * the node tree, so it is much cheaper than collecting the nodes with a visitor.
+   */
+  std::vector<Node*> findNodesWithLinkId(const std::string& linkId) const;
+
 public: // validator registration
   std::vector<const Validator*> registeredValidators() const;
   std::vector<const IssueQuickFix*> quickFixes(IssueType issueTypes) const;
   void registerValidator(std::unique_ptr<Validator> validator);
   void unregisterAllValidators();
 
+public: // issue tracking
+  /**
+   * Returns the issue tracker that queues the nodes of this world for validation.
+   */
+  IssueTracker& issueTracker();
+
+public: // picking
+  /**
+   * Picks the nodes of this world like pick(), but only ensures that the given pick
+   * result contains the closest hit that matches the given filter.
+   *
+   * The nodes are picked in front-to-back order along the given ray, and picking stops
+   * as soon as no remaining node can yield a hit that is closer than the closest matching
+   * hit found so far. This is much cheaper than picking all nodes if the caller only
+   * queries the pick result for the first hit matching the given filter.
+   */
+  void pickFirst(
+    const EditorContext& editorContext,
+    const vm::ray3& ray,
+    const HitFilter& filter,
+    PickResult& pickResult);
+
 public: // node tree bulk updating
   void disableNodeTreeUpdates();
   void enableNodeTreeUpdates();
   void rebuildNodeTree();
 
+public: // entity node index bulk updating
+  /**
+   * Clears the entity node index and stops updating it when entity nodes are added,
+   * removed or changed. While the index is disabled, no links between entity nodes are
+   * created.
+   */
+  void disableEntityNodeIndexUpdates();
+  void enableEntityNodeIndexUpdates();
+
+  /**
+   * Builds the entity node index from all entity nodes in this world in one go and then
+   * creates the links between them.
+   *
+   * Precondition: entity node index updates are disabled
+   */
+  void rebuildEntityNodeIndex();
+
 private:
   void invalidateAllIssues();
 
@@ -160,6 +211,7 @@ private: // implement Node interface
   void doDescendantWasAdded(Node* node, size_t depth) override;
   void doDescendantWillBeRemoved(Node* node, size_t depth) override;
   void doDescendantPhysicalBoundsDidChange(Node* node) override;
+  void doIssuesWereInvalidated(const Node& node) const override;
 
   bool doSelectable() const override;
   void doPick(
@@ -182,6 +234,8 @@ private: // implement Node interface
     EntityNodeBase* node, const std::string& key, const std::string& value) override;
   void doRemoveFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value) override;
+  void doAddToLinkIdIndex(Node* node, const std::string& linkId) override;
+  void doRemoveFromLinkIdIndex(Node* node, const std::string& linkId) override;
 
 private: // implement EntityNodeBase interface
   void doPropertiesDidChange(const vm::bbox3& oldBounds) override;
@@ -129,9 +129,21 @@ extern Preference<int> TextureMinFilter;
 extern Preference<int> TextureMagFilter;
 extern Preference<bool> EnableMSAA;
 
+/**
+ * The memory budget in MiB for the pixel data that textures hold until they are uploaded.
+ * 0 means that the pixel data is not limited.
+ */
+extern Preference<int> TextureMemoryBudget;
+
 extern Preference<bool> TextureLock;
 extern Preference<bool> UVLock;
 
+/**
+ * The memory budget of the undo history in MiB. 0 means that the undo history is not
+ * limited.
+ */
+extern Preference<int> UndoMemoryBudget;
+
 Preference<std::filesystem::path>& RendererFontPath();
 extern Preference<int> RendererFontSize;
 
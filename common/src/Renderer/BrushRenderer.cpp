@@ -29,10 +29,21 @@
 #include "Preferences.h"
 #include "Renderer/BrushRendererArrays.h"
 #include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/Camera.h"
 #include "Renderer/RenderContext.h"
 
+#include "kdl/parallel.h"
+
+#include "vm/bbox.h"
+#include "vm/plane.h"
+
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstring>
+#include <functional>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom
@@ -165,8 +176,7 @@ void BrushRenderer::invalidate()
   m_invalidBrushes = m_allBrushes;
 
   assert(m_brushInfo.empty());
-  assert(m_transparentFaces->empty());
-  assert(m_opaqueFaces->empty());
+  assert(m_buckets.empty());
 }
 
 void BrushRenderer::invalidateBrush(const Model::BrushNode* brushNode)
@@ -196,15 +206,9 @@ void BrushRenderer::clear()
   m_allBrushes.clear();
   m_invalidBrushes.clear();
 
-  m_vertexArray = std::make_shared<BrushVertexArray>();
-  m_edgeIndices = std::make_shared<BrushIndexArray>();
-  m_transparentFaces = std::make_shared<TextureToBrushIndicesMap>();
-  m_opaqueFaces = std::make_shared<TextureToBrushIndicesMap>();
+  m_buckets.clear();
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
-  m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
-  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  m_vertexArray = std::make_shared<BrushVertexArray>();
 }
 
 void BrushRenderer::setFaceColor(const Color& faceColor)
@@ -288,13 +292,16 @@ void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& rend
     {
       validate();
     }
-    if (renderContext.showFaces())
+    for (auto* bucket : collectVisibleBuckets(renderContext.camera()))
     {
-      renderOpaqueFaces(renderBatch);
-    }
-    if (renderContext.showEdges() || m_showEdges)
-    {
-      renderEdges(renderBatch);
+      if (renderContext.showFaces())
+      {
+        renderOpaqueFaces(*bucket, renderBatch);
+      }
+      if (renderContext.showEdges() || m_showEdges)
+      {
+        renderEdges(*bucket, renderBatch);
+      }
     }
   }
 }
@@ -310,35 +317,133 @@ void BrushRenderer::renderTransparent(
     }
     if (renderContext.showFaces())
     {
-      renderTransparentFaces(renderBatch);
+      for (auto* bucket : collectVisibleBuckets(renderContext.camera()))
+      {
+        renderTransparentFaces(*bucket, renderBatch);
+      }
     }
   }
 }
 
-void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch)
+size_t BrushRenderer::BucketKeyHash::operator()(const BucketKey& key) const
 {
-  m_opaqueFaceRenderer.setGrayscale(m_grayscale);
-  m_opaqueFaceRenderer.setTint(m_tint);
-  m_opaqueFaceRenderer.setTintColor(m_tintColor);
-  m_opaqueFaceRenderer.render(renderBatch);
+  auto result = size_t(0);
+  for (const auto c : {size_t(uint16_t(key.x)), size_t(uint16_t(key.y)),
+                       size_t(uint16_t(key.z)), size_t(key.size)})
+  {
+    result = (result << 16) ^ (result >> 48) ^ c;
+  }
+  return std::hash<size_t>{}(result);
 }
 
-void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch)
+namespace
+{
+constexpr size_t MinBrushCountForParallelValidation = 1024;
+
+using FrustumPlanes = std::array<vm::plane3f, 4>;
+
+FrustumPlanes frustumPlanes(const Camera& camera)
 {
-  m_transparentFaceRenderer.setGrayscale(m_grayscale);
-  m_transparentFaceRenderer.setTint(m_tint);
-  m_transparentFaceRenderer.setTintColor(m_tintColor);
-  m_transparentFaceRenderer.setAlpha(m_transparencyAlpha);
-  m_transparentFaceRenderer.render(renderBatch);
+  auto result = FrustumPlanes{};
+  camera.frustumPlanes(result[0], result[1], result[2], result[3]);
+  return result;
 }
 
-void BrushRenderer::renderEdges(RenderBatch& renderBatch)
+/**
+ * Returns false if the given box lies entirely on the outer side of one of the given
+ * planes, whose normals point out of the frustum. Boxes which intersect the frustum
+ * are never rejected, but some boxes outside of the frustum may not be rejected either.
+ */
+bool intersectsFrustum(const vm::bbox3f& bounds, const FrustumPlanes& planes)
+{
+  for (const auto& plane : planes)
+  {
+    // the corner of the box that is farthest inside of the plane
+    const auto corner = vm::vec3f{
+      plane.normal.x() >= 0.0f ? bounds.min.x() : bounds.max.x(),
+      plane.normal.y() >= 0.0f ? bounds.min.y() : bounds.max.y(),
+      plane.normal.z() >= 0.0f ? bounds.min.z() : bounds.max.z()};
+    if (plane.point_distance(corner) > 0.0f)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+vm::bbox3f bucketBounds(const BrushRenderer::BucketKey& bucketKey)
+{
+  return vm::bbox3f{bucketKey.to_bounds(BrushRenderer::BucketSize)};
+}
+} // namespace
+
+std::vector<BrushRenderer::BucketKey> BrushRenderer::visibleBuckets(
+  const Camera& camera) const
+{
+  const auto planes = frustumPlanes(camera);
+
+  auto result = std::vector<BucketKey>{};
+  for (const auto& [bucketKey, bucket] : m_buckets)
+  {
+    if (intersectsFrustum(bucketBounds(bucketKey), planes))
+    {
+      result.push_back(bucketKey);
+    }
+  }
+  return result;
+}
+
+std::vector<BrushRenderer::BucketKey> BrushRenderer::buckets() const
+{
+  auto result = std::vector<BucketKey>{};
+  result.reserve(m_buckets.size());
+  for (const auto& [bucketKey, bucket] : m_buckets)
+  {
+    result.push_back(bucketKey);
+  }
+  return result;
+}
+
+std::vector<BrushRenderer::Bucket*> BrushRenderer::collectVisibleBuckets(
+  const Camera& camera)
+{
+  const auto planes = frustumPlanes(camera);
+
+  auto result = std::vector<Bucket*>{};
+  for (auto& [bucketKey, bucket] : m_buckets)
+  {
+    if (intersectsFrustum(bucketBounds(bucketKey), planes))
+    {
+      result.push_back(&bucket);
+    }
+  }
+  return result;
+}
+
+void BrushRenderer::renderOpaqueFaces(Bucket& bucket, RenderBatch& renderBatch)
+{
+  bucket.opaqueFaceRenderer.setGrayscale(m_grayscale);
+  bucket.opaqueFaceRenderer.setTint(m_tint);
+  bucket.opaqueFaceRenderer.setTintColor(m_tintColor);
+  bucket.opaqueFaceRenderer.render(renderBatch);
+}
+
+void BrushRenderer::renderTransparentFaces(Bucket& bucket, RenderBatch& renderBatch)
+{
+  bucket.transparentFaceRenderer.setGrayscale(m_grayscale);
+  bucket.transparentFaceRenderer.setTint(m_tint);
+  bucket.transparentFaceRenderer.setTintColor(m_tintColor);
+  bucket.transparentFaceRenderer.setAlpha(m_transparencyAlpha);
+  bucket.transparentFaceRenderer.render(renderBatch);
+}
+
+void BrushRenderer::renderEdges(Bucket& bucket, RenderBatch& renderBatch)
 {
   if (m_showOccludedEdges)
   {
-    m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+    bucket.edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
   }
-  m_edgeRenderer.render(renderBatch, m_edgeColor);
+  bucket.edgeRenderer.render(renderBatch, m_edgeColor);
 }
 
 class BrushRenderer::FilterWrapper : public BrushRenderer::Filter
@@ -373,21 +478,90 @@ public:
   }
 };
 
+/**
+ * The index data of a brush. The indices are relative to the first vertex of the brush.
+ * The edge indices come first, followed by the transparent and the opaque face indices
+ * for each texture.
+ */
+struct BrushRenderer::BrushPayload
+{
+  struct TextureIndices
+  {
+    const Assets::Texture* texture;
+    size_t transparentIndexCount;
+    size_t opaqueIndexCount;
+  };
+
+  const Model::BrushNode* brushNode = nullptr;
+  size_t edgeIndexCount = 0;
+  std::vector<TextureIndices> textureIndices;
+  std::vector<GLuint> indices;
+};
+
 void BrushRenderer::validate()
 {
   assert(!valid());
 
+  // evaluate filter. only evaluate the filter once per brush. The filter may access the
+  // preferences, so this must happen on the main thread.
+  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
+
+  auto brushesToRender =
+    std::vector<std::tuple<const Model::BrushNode*, Filter::EdgeRenderPolicy>>{};
+  brushesToRender.reserve(m_invalidBrushes.size());
+
   for (auto* brushNode : m_invalidBrushes)
   {
-    validateBrush(*brushNode);
+    assert(m_allBrushes.find(brushNode) != std::end(m_allBrushes));
+    assert(m_brushInfo.find(brushNode) == std::end(m_brushInfo));
+
+    const auto [facePolicy, edgePolicy] = wrapper.markFaces(*brushNode);
+    if (
+      facePolicy != Filter::FaceRenderPolicy::RenderNone
+      || edgePolicy != Filter::EdgeRenderPolicy::RenderNone)
+    {
+      brushesToRender.emplace_back(brushNode, edgePolicy);
+    }
   }
   m_invalidBrushes.clear();
   assert(valid());
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
-  m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
-  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  // computing the payloads in parallel only pays off if there are several hardware
+  // threads and enough brushes to amortize the scheduling overhead
+  const auto computePayload = [&](const size_t i) {
+    const auto& [brushNode, edgePolicy] = brushesToRender[i];
+    return computeBrushPayload(*brushNode, edgePolicy);
+  };
+
+  auto payloads = std::vector<BrushPayload>(brushesToRender.size());
+  if (
+    std::thread::hardware_concurrency() > 1
+    && brushesToRender.size() >= MinBrushCountForParallelValidation)
+  {
+    kdl::parallel_for(
+      brushesToRender.size(), [&](const size_t i) { payloads[i] = computePayload(i); });
+  }
+  else
+  {
+    for (size_t i = 0; i < brushesToRender.size(); ++i)
+    {
+      payloads[i] = computePayload(i);
+    }
+  }
+
+  for (const auto& payload : payloads)
+  {
+    insertBrushPayload(payload);
+  }
+
+  for (auto& [bucketKey, bucket] : m_buckets)
+  {
+    bucket.opaqueFaceRenderer =
+      FaceRenderer{m_vertexArray, bucket.opaqueFaces, m_faceColor};
+    bucket.transparentFaceRenderer =
+      FaceRenderer{m_vertexArray, bucket.transparentFaces, m_faceColor};
+    bucket.edgeRenderer = IndexedEdgeRenderer{m_vertexArray, bucket.edgeIndices};
+  }
 }
 
 static size_t triIndicesCountForPolygon(const size_t vertexCount)
@@ -503,168 +677,177 @@ bool BrushRenderer::shouldDrawFaceInTransparentPass(
   return false;
 }
 
-void BrushRenderer::validateBrush(const Model::BrushNode& brushNode)
+static AllocationTracker::Block* insertIndices(
+  BrushIndexArray& indexArray,
+  const GLuint* indices,
+  const size_t indexCount,
+  const GLuint baseIndex)
 {
-  assert(m_allBrushes.find(&brushNode) != std::end(m_allBrushes));
-  assert(m_invalidBrushes.find(&brushNode) != std::end(m_invalidBrushes));
-  assert(m_brushInfo.find(&brushNode) == std::end(m_brushInfo));
-
-  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
-
-  // evaluate filter. only evaluate the filter once per brush.
-  const auto settings = wrapper.markFaces(brushNode);
-  const auto [facePolicy, edgePolicy] = settings;
+  auto [key, insertDest] = indexArray.getPointerToInsertElementsAt(indexCount);
+  std::transform(indices, indices + indexCount, insertDest, [&](const auto index) {
+    return baseIndex + index;
+  });
+  return key;
+}
 
-  if (
-    facePolicy == Filter::FaceRenderPolicy::RenderNone
-    && edgePolicy == Filter::EdgeRenderPolicy::RenderNone)
+static AllocationTracker::Block* insertFaceIndices(
+  std::shared_ptr<BrushIndexArray>& holderPtr,
+  const GLuint* indices,
+  const size_t indexCount,
+  const GLuint baseIndex)
+{
+  if (holderPtr == nullptr)
   {
-    // NOTE: this skips inserting the brush into m_brushInfo
-    return;
+    holderPtr = std::make_shared<BrushIndexArray>();
   }
+  return insertIndices(*holderPtr, indices, indexCount, baseIndex);
+}
 
-  BrushInfo& info = m_brushInfo[&brushNode];
-
-  // collect vertices
+BrushRenderer::BrushPayload BrushRenderer::computeBrushPayload(
+  const Model::BrushNode& brushNode, const Filter::EdgeRenderPolicy edgePolicy) const
+{
   auto& brushCache = brushNode.brushRendererBrushCache();
   brushCache.validateVertexCache(brushNode);
-  const auto& cachedVertices = brushCache.cachedVertices();
-  ensure(!cachedVertices.empty(), "Brush must have cached vertices");
-
-  assert(m_vertexArray != nullptr);
-  auto [vertBlock, dest] =
-    m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
-  std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
-  info.vertexHolderKey = vertBlock;
+  ensure(!brushCache.cachedVertices().empty(), "Brush must have cached vertices");
 
-  const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
+  auto payload = BrushPayload{};
+  payload.brushNode = &brushNode;
+  payload.edgeIndexCount = countMarkedEdgeIndices(brushNode, edgePolicy);
 
-  // insert edge indices into VBO
-  {
-    const size_t edgeIndexCount = countMarkedEdgeIndices(brushNode, edgePolicy);
-    if (edgeIndexCount > 0)
-    {
-      auto [key, insertDest] =
-        m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
-      info.edgeIndicesKey = key;
-      getMarkedEdgeIndices(brushNode, edgePolicy, brushVerticesStartIndex, insertDest);
-    }
-    else
-    {
-      // it's possible to have no edges to render
-      // e.g. select all faces of a brush, and the unselected brush renderer
-      // will hit this branch.
-      ensure(info.edgeIndicesKey == nullptr, "BrushInfo not initialized");
-    }
-  }
-
-  // insert face indices
-
-  auto& facesSortedByTex = brushCache.cachedFacesSortedByTexture();
+  // count face indices
+  const auto& facesSortedByTex = brushCache.cachedFacesSortedByTexture();
   const size_t facesSortedByTexSize = facesSortedByTex.size();
 
-  size_t nextI;
-  for (size_t i = 0; i < facesSortedByTexSize; i = nextI)
+  auto indexCount = payload.edgeIndexCount;
+  for (size_t i = 0; i < facesSortedByTexSize;)
   {
     const auto* texture = facesSortedByTex[i].texture;
-
-    size_t opaqueIndexCount = 0;
-    size_t transparentIndexCount = 0;
-
-    // find the i value for the next texture
-    for (nextI = i + 1;
-         nextI < facesSortedByTexSize && facesSortedByTex[nextI].texture == texture;
-         ++nextI)
-    {
-    }
+    auto textureIndices = BrushPayload::TextureIndices{texture, 0, 0};
 
     // process all faces with this texture (they'll be consecutive)
-    for (size_t j = i; j < nextI; ++j)
+    for (; i < facesSortedByTexSize && facesSortedByTex[i].texture == texture; ++i)
     {
-      const auto& cache = facesSortedByTex[j];
+      const auto& cache = facesSortedByTex[i];
       if (cache.face->isMarked())
       {
-        assert(cache.texture == texture);
-        if (shouldDrawFaceInTransparentPass(brushNode, *cache.face))
-        {
-          transparentIndexCount += triIndicesCountForPolygon(cache.vertexCount);
-        }
-        else
-        {
-          opaqueIndexCount += triIndicesCountForPolygon(cache.vertexCount);
-        }
+        auto& textureIndexCount = shouldDrawFaceInTransparentPass(brushNode, *cache.face)
+                                    ? textureIndices.transparentIndexCount
+                                    : textureIndices.opaqueIndexCount;
+        textureIndexCount += triIndicesCountForPolygon(cache.vertexCount);
       }
     }
 
-    if (transparentIndexCount > 0)
+    indexCount += textureIndices.transparentIndexCount + textureIndices.opaqueIndexCount;
+    payload.textureIndices.push_back(textureIndices);
+  }
+
+  payload.indices.resize(indexCount);
+
+  // collect edge indices
+  getMarkedEdgeIndices(brushNode, edgePolicy, 0, payload.indices.data());
+
+  // collect face indices, the faces of each texture are consecutive
+  auto* transparentDest = payload.indices.data() + payload.edgeIndexCount;
+  size_t i = 0;
+  for (const auto& textureIndices : payload.textureIndices)
+  {
+    auto* opaqueDest = transparentDest + textureIndices.transparentIndexCount;
+    for (; i < facesSortedByTexSize
+           && facesSortedByTex[i].texture == textureIndices.texture;
+         ++i)
     {
-      auto& faceVboMap = *m_transparentFaces;
-      auto& holderPtr = faceVboMap[texture];
-      if (holderPtr == nullptr)
+      const auto& cache = facesSortedByTex[i];
+      if (cache.face->isMarked())
       {
-        // inserts into map!
-        holderPtr = std::make_shared<BrushIndexArray>();
+        auto*& dest = shouldDrawFaceInTransparentPass(brushNode, *cache.face)
+                        ? transparentDest
+                        : opaqueDest;
+        addTriIndicesForPolygon(
+          dest,
+          static_cast<GLuint>(cache.indexOfFirstVertexRelativeToBrush),
+          cache.vertexCount);
+        dest += triIndicesCountForPolygon(cache.vertexCount);
       }
+    }
+    transparentDest = opaqueDest;
+  }
+  assert(transparentDest == payload.indices.data() + payload.indices.size());
 
-      auto [key, insertDest] =
-        holderPtr->getPointerToInsertElementsAt(transparentIndexCount);
-      info.transparentFaceIndicesKeys.emplace_back(texture, key);
+  return payload;
+}
 
-      // process all faces with this texture (they'll be consecutive)
-      auto* currentDest = insertDest;
-      for (size_t j = i; j < nextI; ++j)
-      {
-        const auto& cache = facesSortedByTex[j];
-        if (
-          cache.face->isMarked()
-          && shouldDrawFaceInTransparentPass(brushNode, *cache.face))
-        {
-          addTriIndicesForPolygon(
-            currentDest,
-            static_cast<GLuint>(
-              brushVerticesStartIndex + cache.indexOfFirstVertexRelativeToBrush),
-            cache.vertexCount);
-
-          currentDest += triIndicesCountForPolygon(cache.vertexCount);
-        }
-      }
-      assert(currentDest == (insertDest + transparentIndexCount));
+void BrushRenderer::insertBrushPayload(const BrushPayload& payload)
+{
+  const auto& brushNode = *payload.brushNode;
+  const auto bucketKey = detail::get_container(brushNode.logicalBounds(), BucketSize);
+
+  auto& bucket = findOrCreateBucket(bucketKey);
+  ++bucket.brushCount;
+
+  BrushInfo& info =
+    m_brushInfo.emplace(&brushNode, BrushInfo{bucketKey, nullptr, nullptr, {}, {}})
+      .first->second;
+
+  // insert vertices into VBO
+  const auto& cachedVertices = brushNode.brushRendererBrushCache().cachedVertices();
+
+  assert(m_vertexArray != nullptr);
+  auto [vertBlock, dest] =
+    m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
+  std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
+  info.vertexHolderKey = vertBlock;
+
+  const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
+
+  // insert edge indices into VBO
+  // it's possible to have no edges to render, e.g. select all faces of a brush, and the
+  // unselected brush renderer will skip this.
+  const auto* indices = payload.indices.data();
+  if (payload.edgeIndexCount > 0)
+  {
+    info.edgeIndicesKey = insertIndices(
+      *bucket.edgeIndices, indices, payload.edgeIndexCount, brushVerticesStartIndex);
+    indices += payload.edgeIndexCount;
+  }
+
+  // insert face indices into VBO, operator[] inserts into the maps!
+  for (const auto& [texture, transparentIndexCount, opaqueIndexCount] :
+       payload.textureIndices)
+  {
+    if (transparentIndexCount > 0)
+    {
+      auto& holderPtr = (*bucket.transparentFaces)[texture];
+      info.transparentFaceIndicesKeys.emplace_back(
+        texture,
+        insertFaceIndices(
+          holderPtr, indices, transparentIndexCount, brushVerticesStartIndex));
+      indices += transparentIndexCount;
     }
 
     if (opaqueIndexCount > 0)
     {
-      auto& faceVboMap = *m_opaqueFaces;
-      auto& holderPtr = faceVboMap[texture];
-      if (holderPtr == nullptr)
-      {
-        // inserts into map!
-        holderPtr = std::make_shared<BrushIndexArray>();
-      }
-
-      auto [key, insertDest] = holderPtr->getPointerToInsertElementsAt(opaqueIndexCount);
-      info.opaqueFaceIndicesKeys.emplace_back(texture, key);
-
-      // process all faces with this texture (they'll be consecutive)
-      auto* currentDest = insertDest;
-      for (size_t j = i; j < nextI; ++j)
-      {
-        const auto& cache = facesSortedByTex[j];
-        if (
-          cache.face->isMarked()
-          && !shouldDrawFaceInTransparentPass(brushNode, *cache.face))
-        {
-          addTriIndicesForPolygon(
-            currentDest,
-            static_cast<GLuint>(
-              brushVerticesStartIndex + cache.indexOfFirstVertexRelativeToBrush),
-            cache.vertexCount);
-
-          currentDest += triIndicesCountForPolygon(cache.vertexCount);
-        }
-      }
-      assert(currentDest == (insertDest + opaqueIndexCount));
+      auto& holderPtr = (*bucket.opaqueFaces)[texture];
+      info.opaqueFaceIndicesKeys.emplace_back(
+        texture,
+        insertFaceIndices(holderPtr, indices, opaqueIndexCount, brushVerticesStartIndex));
+      indices += opaqueIndexCount;
     }
   }
+  assert(indices == payload.indices.data() + payload.indices.size());
+}
+
+BrushRenderer::Bucket& BrushRenderer::findOrCreateBucket(const BucketKey& bucketKey)
+{
+  auto it = m_buckets.find(bucketKey);
+  if (it == m_buckets.end())
+  {
+    auto bucket = Bucket{};
+    bucket.edgeIndices = std::make_shared<BrushIndexArray>();
+    bucket.transparentFaces = std::make_shared<TextureToBrushIndicesMap>();
+    bucket.opaqueFaces = std::make_shared<TextureToBrushIndicesMap>();
+    it = m_buckets.emplace(bucketKey, std::move(bucket)).first;
+  }
+  return it->second;
 }
 
 void BrushRenderer::addBrush(const Model::BrushNode* brushNode)
@@ -699,45 +882,55 @@ void BrushRenderer::removeBrushFromVbo(const Model::BrushNode& brushNode)
 
   if (it == std::end(m_brushInfo))
   {
-    // This means BrushRenderer::validateBrush skipped rendering the brush, so it was
+    // This means BrushRenderer::validate skipped rendering the brush, so it was
     // never uploaded to the VBO's
     return;
   }
 
   const BrushInfo& info = it->second;
 
+  auto bucketIt = m_buckets.find(info.bucketKey);
+  ensure(bucketIt != m_buckets.end(), "Brush must be in a bucket");
+  auto& bucket = bucketIt->second;
+
   // update Vbo's
   m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
   if (info.edgeIndicesKey != nullptr)
   {
-    m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
+    bucket.edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
   }
 
   for (const auto& [texture, opaqueKey] : info.opaqueFaceIndicesKeys)
   {
-    std::shared_ptr<BrushIndexArray> faceIndexHolder = m_opaqueFaces->at(texture);
+    std::shared_ptr<BrushIndexArray> faceIndexHolder = bucket.opaqueFaces->at(texture);
     faceIndexHolder->zeroElementsWithKey(opaqueKey);
 
     if (!faceIndexHolder->hasValidIndices())
     {
       // There are no indices left to render for this texture, so delete the <Texture,
       // BrushIndexArray> entry from the map
-      m_opaqueFaces->erase(texture);
+      bucket.opaqueFaces->erase(texture);
     }
   }
   for (const auto& [texture, transparentKey] : info.transparentFaceIndicesKeys)
   {
-    std::shared_ptr<BrushIndexArray> faceIndexHolder = m_transparentFaces->at(texture);
+    std::shared_ptr<BrushIndexArray> faceIndexHolder =
+      bucket.transparentFaces->at(texture);
     faceIndexHolder->zeroElementsWithKey(transparentKey);
 
     if (!faceIndexHolder->hasValidIndices())
     {
       // There are no indices left to render for this texture, so delete the <Texture,
       // BrushIndexArray> entry from the map
-      m_transparentFaces->erase(texture);
+      bucket.transparentFaces->erase(texture);
     }
   }
 
+  if (--bucket.brushCount == 0)
+  {
+    m_buckets.erase(bucketIt);
+  }
+
   m_brushInfo.erase(it);
 }
 } // namespace Renderer
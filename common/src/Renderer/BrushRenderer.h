@@ -25,6 +25,7 @@
 #include "Renderer/AllocationTracker.h"
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/FaceRenderer.h"
+#include "octree.h"
 
 #include <memory>
 #include <tuple>
@@ -43,9 +44,30 @@ class EditorContext;
 
 namespace Renderer
 {
+class Camera;
+
 class BrushRenderer
 {
 public:
+  /**
+   * Brushes are sorted into spatial buckets so that buckets outside of the view frustum
+   * can be skipped when rendering. A bucket corresponds to a cell of an octree using the
+   * same addressing scheme as the world's node tree, but with a coarser minimum cell
+   * size. A brush goes into the smallest cell that contains its bounds.
+   */
+  using BucketKey = detail::node_address;
+
+  /**
+   * The size of the smallest cells used for bucketing. Smaller cells allow for finer
+   * grained culling, but increase the number of draw calls.
+   */
+  static constexpr double BucketSize = 1024.0;
+
+  struct BucketKeyHash
+  {
+    size_t operator()(const BucketKey& key) const;
+  };
+
   class Filter
   {
   public:
@@ -125,6 +147,7 @@ private:
 
   struct BrushInfo
   {
+    BucketKey bucketKey;
     AllocationTracker::Block* vertexHolderKey;
     AllocationTracker::Block* edgeIndicesKey;
     std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>>
@@ -148,16 +171,31 @@ private:
   std::unordered_set<const Model::BrushNode*> m_invalidBrushes;
 
   std::shared_ptr<BrushVertexArray> m_vertexArray;
-  std::shared_ptr<BrushIndexArray> m_edgeIndices;
 
   using TextureToBrushIndicesMap =
     std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
-  std::shared_ptr<TextureToBrushIndicesMap> m_transparentFaces;
-  std::shared_ptr<TextureToBrushIndicesMap> m_opaqueFaces;
 
-  FaceRenderer m_opaqueFaceRenderer;
-  FaceRenderer m_transparentFaceRenderer;
-  IndexedEdgeRenderer m_edgeRenderer;
+  /**
+   * The index arrays and renderers for the brushes in one spatial bucket. All buckets
+   * share the vertex array.
+   */
+  struct Bucket
+  {
+    size_t brushCount = 0;
+    std::shared_ptr<BrushIndexArray> edgeIndices;
+    std::shared_ptr<TextureToBrushIndicesMap> transparentFaces;
+    std::shared_ptr<TextureToBrushIndicesMap> opaqueFaces;
+
+    FaceRenderer opaqueFaceRenderer;
+    FaceRenderer transparentFaceRenderer;
+    IndexedEdgeRenderer edgeRenderer;
+  };
+
+  /**
+   * Buckets are created when the first brush is added to them and removed when their
+   * last brush is removed from the VBO.
+   */
+  std::unordered_map<BucketKey, Bucket, BucketKeyHash> m_buckets;
 
   Color m_faceColor;
   bool m_showEdges;
@@ -204,9 +242,8 @@ public:
    * Until a brush is invalidated, we don't re-evaluate the Filter, and don't check the
    * Brush object for modification.
    *
-   * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces,
-   * and m_opaqueFaces maps will be empty, so the BrushRenderer will not have any
-   * lingering Texture* pointers.
+   * Additionally, calling `invalidate()` guarantees the m_brushInfo and m_buckets maps
+   * will be empty, so the BrushRenderer will not have any lingering Texture* pointers.
    */
   void invalidate();
   void invalidateBrush(const Model::BrushNode* brush);
@@ -284,21 +321,53 @@ public: // rendering
   void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
 
+  /**
+   * Returns the keys of the buckets whose cells intersect the view frustum of the given
+   * camera. Only the brushes in these buckets are rendered.
+   *
+   * Brushes that have not been validated yet are not in any bucket.
+   */
+  std::vector<BucketKey> visibleBuckets(const Camera& camera) const;
+
+  /**
+   * Returns the keys of all buckets, including those that are not visible.
+   */
+  std::vector<BucketKey> buckets() const;
+
 private:
-  void renderOpaqueFaces(RenderBatch& renderBatch);
-  void renderTransparentFaces(RenderBatch& renderBatch);
-  void renderEdges(RenderBatch& renderBatch);
+  std::vector<Bucket*> collectVisibleBuckets(const Camera& camera);
+
+  void renderOpaqueFaces(Bucket& bucket, RenderBatch& renderBatch);
+  void renderTransparentFaces(Bucket& bucket, RenderBatch& renderBatch);
+  void renderEdges(Bucket& bucket, RenderBatch& renderBatch);
 
 public:
   /**
-   * Only exposed for benchmarking.
+   * Validates all invalid brushes. Only exposed for benchmarking.
+   *
+   * First, the filter is evaluated for every invalid brush. Then the vertex caches and
+   * the index data of the brushes to render are computed in parallel. Finally, the
+   * vertices and indices are copied into the vertex and index arrays.
    */
   void validate();
 
 private:
+  struct BrushPayload;
+
   bool shouldDrawFaceInTransparentPass(
     const Model::BrushNode& brushNode, const Model::BrushFace& face) const;
-  void validateBrush(const Model::BrushNode& brushNode);
+
+  /**
+   * Computes the index data of the given brush. Must only be called after the filter has
+   * marked the faces of the given brush.
+   *
+   * Does not modify the state of this renderer, so it can be called in parallel for
+   * different brushes.
+   */
+  BrushPayload computeBrushPayload(
+    const Model::BrushNode& brushNode, Filter::EdgeRenderPolicy edgePolicy) const;
+  void insertBrushPayload(const BrushPayload& payload);
+  Bucket& findOrCreateBucket(const BucketKey& bucketKey);
 
 public:
   /**
@@ -54,8 +54,9 @@ struct FaceRenderer::RenderFunc : public TextureRenderFunc
   {
     if (texture != nullptr)
     {
+      // the texture is not bound while its pixel data is being decoded in the background
       texture->activate();
-      shader.set("ApplyTexture", applyTexture);
+      shader.set("ApplyTexture", applyTexture && texture->isUploaded());
       shader.set("Color", texture->averageColor());
     }
     else
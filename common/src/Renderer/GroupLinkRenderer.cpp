@@ -60,7 +60,7 @@ std::vector<LinkRenderer::LineVertex> GroupLinkRenderer::getLinks()
   {
     const auto& linkId = groupNode->linkId();
     const auto linkedGroupNodes =
-      Model::collectGroupsWithLinkId({document->world()}, linkId);
+      Model::collectGroupsWithLinkId(*document->world(), linkId);
 
     const auto linkColor = pref(Preferences::LinkedGroupColor);
     const auto sourcePosition = getLinkAnchorPosition(*groupNode);
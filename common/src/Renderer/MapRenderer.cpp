@@ -684,6 +684,8 @@ void MapRenderer::connectObservers()
     this, &MapRenderer::entityDefinitionsDidChange);
   m_notifierConnection +=
     document->modsDidChangeNotifier.connect(this, &MapRenderer::modsDidChange);
+  m_notifierConnection += document->entityModelsWereLoadedNotifier.connect(
+    this, &MapRenderer::entityModelsWereLoaded);
   m_notifierConnection += document->editorContextDidChangeNotifier.connect(
     this, &MapRenderer::editorContextDidChange);
 
@@ -823,6 +825,15 @@ void MapRenderer::modsDidChange()
   invalidateEntityLinkRenderer();
 }
 
+void MapRenderer::entityModelsWereLoaded(
+  const std::vector<std::filesystem::path>&, const std::vector<Model::Node*>& nodes)
+{
+  for (auto* node : nodes)
+  {
+    updateAndInvalidateNode(node);
+  }
+}
+
 void MapRenderer::editorContextDidChange()
 {
   invalidateRenderers(Renderer::All);
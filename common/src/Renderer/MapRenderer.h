@@ -158,6 +158,9 @@ private: // notification
   void textureCollectionsWillChange();
   void entityDefinitionsDidChange();
   void modsDidChange();
+  void entityModelsWereLoaded(
+    const std::vector<std::filesystem::path>& paths,
+    const std::vector<Model::Node*>& nodes);
 
   void editorContextDidChange();
 
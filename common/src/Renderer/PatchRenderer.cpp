@@ -339,8 +339,9 @@ struct RenderFunc : public TextureRenderFunc
     shader.set("GridColor", gridColorForTexture(texture));
     if (texture != nullptr)
     {
+      // the texture is not bound while its pixel data is being decoded in the background
       texture->activate();
-      shader.set("ApplyTexture", applyTexture);
+      shader.set("ApplyTexture", applyTexture && texture->isUploaded());
       shader.set("Color", texture->averageColor());
     }
     else
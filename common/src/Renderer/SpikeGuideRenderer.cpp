@@ -57,12 +57,13 @@ void SpikeGuideRenderer::add(
   const FloatType length,
   std::shared_ptr<View::MapDocument> document)
 {
+  using namespace Model::HitFilters;
+  const auto filter = type(Model::BrushNode::BrushHitType) && minDistance(1.0);
+
   Model::PickResult pickResult = Model::PickResult::byDistance();
-  document->pick(ray, pickResult);
+  document->pickFirst(ray, filter, pickResult);
 
-  using namespace Model::HitFilters;
-  const auto& hit =
-    pickResult.first(type(Model::BrushNode::BrushHitType) && minDistance(1.0));
+  const auto& hit = pickResult.first(filter);
   if (hit.isMatch())
   {
     if (hit.distance() <= length)
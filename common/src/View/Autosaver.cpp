@@ -38,6 +38,7 @@
 
 #include <algorithm> // for std::sort
 #include <cassert>
+#include <string>
 
 namespace TrenchBroom::View
 {
@@ -69,8 +70,27 @@ Autosaver::Autosaver(
 {
 }
 
+Autosaver::~Autosaver()
+{
+  // the backup must not be left half written
+  if (m_pendingBackup)
+  {
+    m_pendingBackup->backup.wait();
+  }
+}
+
 void Autosaver::triggerAutosave(Logger& logger)
 {
+  if (m_pendingBackup)
+  {
+    using namespace std::chrono_literals;
+    if (m_pendingBackup->backup.wait_for(0s) != std::future_status::ready)
+    {
+      return;
+    }
+    finishPendingBackup(logger);
+  }
+
   if (!kdl::mem_expired(m_document))
   {
     auto document = kdl::mem_lock(m_document);
@@ -105,10 +125,10 @@ Result<std::vector<std::filesystem::path>> collectBackups(
 }
 
 Result<std::vector<std::filesystem::path>> thinBackups(
-  Logger& logger,
   IO::WritableDiskFileSystem& fs,
   const std::vector<std::filesystem::path>& backups,
-  const size_t maxBackups)
+  const size_t maxBackups,
+  std::vector<std::filesystem::path>& deletedBackups)
 {
   if (backups.size() < maxBackups)
   {
@@ -123,7 +143,7 @@ Result<std::vector<std::filesystem::path>> thinBackups(
                return fs.deleteFile(filename).transform([&](const auto deleted) {
                  if (deleted)
                  {
-                   logger.debug() << "Deleted autosave backup " << filename;
+                   deletedBackups.push_back(filename);
                  }
                });
              }))
@@ -157,28 +177,80 @@ void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document)
   const auto& mapPath = document->path();
   assert(IO::Disk::pathInfo(mapPath) == IO::PathInfo::File);
 
-  const auto mapFilename = mapPath.filename();
+  const auto snapshotStart = std::chrono::steady_clock::now();
+  auto snapshot = document->serializeDocument();
+  const auto snapshotDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - snapshotStart);
+  logger.debug() << "Took autosave snapshot in " << snapshotDuration.count() << "ms";
+
+  m_pendingBackup = PendingBackup{
+    std::async(
+      std::launch::async,
+      [mapPath, snapshot = std::move(snapshot), maxBackups = m_maxBackups]() {
+        return writeBackup(mapPath, snapshot, maxBackups);
+      }),
+    Clock::now(),
+    document->modificationCount(),
+  };
+}
+
+Result<Autosaver::Backup> Autosaver::writeBackup(
+  const std::filesystem::path& mapPath,
+  const std::string& snapshot,
+  const size_t maxBackups)
+{
   const auto mapBasename = mapPath.stem();
+  auto deletedBackups = std::vector<std::filesystem::path>{};
 
-  createBackupFileSystem(mapPath)
+  return createBackupFileSystem(mapPath)
     .and_then([&](auto fs) {
       return collectBackups(fs, mapBasename)
-        .and_then(
-          [&](auto backups) { return thinBackups(logger, fs, backups, m_maxBackups); })
+        .and_then([&](auto backups) {
+          return thinBackups(fs, backups, maxBackups, deletedBackups);
+        })
         .and_then([&](auto remainingBackups) {
           return cleanBackups(fs, remainingBackups, mapBasename).and_then([&]() {
-            assert(remainingBackups.size() < m_maxBackups);
+            assert(remainingBackups.size() < maxBackups);
             const auto backupNo = remainingBackups.size() + 1;
             return fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
           });
         });
     })
-    .transform([&](const auto& backupFilePath) {
-      m_lastSaveTime = Clock::now();
-      m_lastModificationCount = document->modificationCount();
-      document->saveDocumentTo(backupFilePath);
+    .and_then([&](auto backupFilePath) {
+      return IO::Disk::withOutputStream(
+               backupFilePath, [&](auto& stream) { stream << snapshot; })
+        .transform([&]() {
+          return Backup{std::move(backupFilePath), std::move(deletedBackups)};
+        });
+    });
+}
+
+void Autosaver::waitForPendingBackup(Logger& logger)
+{
+  if (m_pendingBackup)
+  {
+    finishPendingBackup(logger);
+  }
+}
+
+void Autosaver::finishPendingBackup(Logger& logger)
+{
+  assert(m_pendingBackup);
+
+  auto pendingBackup = std::move(*m_pendingBackup);
+  m_pendingBackup = std::nullopt;
+
+  pendingBackup.backup.get()
+    .transform([&](const auto& backup) {
+      for (const auto& deletedBackup : backup.deletedBackups)
+      {
+        logger.debug() << "Deleted autosave backup " << deletedBackup;
+      }
+
+      m_lastSaveTime = pendingBackup.saveTime;
+      m_lastModificationCount = pendingBackup.modificationCount;
 
-      logger.info() << "Created autosave backup at " << backupFilePath;
+      logger.info() << "Created autosave backup at " << backup.path;
     })
     .transform_error([&](auto e) { logger.error() << "Aborting autosave: " << e.msg; });
 }
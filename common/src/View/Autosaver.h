@@ -19,11 +19,19 @@
 
 #pragma once
 
+#include "Error.h"
 #include "IO/PathMatcher.h"
+#include "Result.h"
+
+#include "kdl/result.h"
 
 #include <chrono>
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -65,15 +73,55 @@ private:
    */
   size_t m_lastModificationCount;
 
+  struct Backup
+  {
+    std::filesystem::path path;
+    std::vector<std::filesystem::path> deletedBackups;
+  };
+
+  /**
+   * A backup that is being written by a worker thread.
+   */
+  struct PendingBackup
+  {
+    std::future<Result<Backup>> backup;
+    std::chrono::time_point<Clock> saveTime;
+    size_t modificationCount;
+  };
+
+  std::optional<PendingBackup> m_pendingBackup;
+
 public:
   explicit Autosaver(
     std::weak_ptr<MapDocument> document,
     std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000),
     size_t maxBackups = 50);
+  ~Autosaver();
 
+  /**
+   * Creates a backup if the document was modified and the save interval has elapsed.
+   *
+   * Only a snapshot of the map is taken on the calling thread. The snapshot is written to
+   * the backup file by a worker thread, so that the document can be edited while the
+   * backup is written. While a backup is being written, further triggers are ignored,
+   * and the changes made in the meantime go into the next backup.
+   */
   void triggerAutosave(Logger& logger);
 
+  /**
+   * Blocks until the backup that is currently being written, if any, is done.
+   */
+  void waitForPendingBackup(Logger& logger);
+
 private:
   void autosave(Logger& logger, std::shared_ptr<View::MapDocument> document);
+  void finishPendingBackup(Logger& logger);
+
+  /**
+   * Rotates the existing backups of the given map and writes the given snapshot to a new
+   * backup file. This is called on a worker thread, so it must not access the document.
+   */
+  static Result<Backup> writeBackup(
+    const std::filesystem::path& mapPath, const std::string& snapshot, size_t maxBackups);
 };
 } // namespace TrenchBroom::View
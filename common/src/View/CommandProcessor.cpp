@@ -32,6 +32,7 @@
 #include "kdl/vector_utils.h"
 
 #include <algorithm>
+#include <numeric>
 
 namespace TrenchBroom
 {
@@ -109,6 +110,8 @@ private:
       {
         throw CommandProcessorException("Partial failure while executing transaction");
       }
+      // compress before the next command changes the nodes that this one has changed
+      command->compress(document);
       notifyCommandIfNotType<TransactionCommand>(m_commandDoneNotifier, *command);
     }
     return std::make_unique<CommandResult>(true);
@@ -130,6 +133,16 @@ private:
     return std::make_unique<CommandResult>(true);
   }
 
+  size_t doGetMemoryUsage() const override
+  {
+    auto result = size_t(0);
+    for (const auto& command : m_commands)
+    {
+      result += command->memoryUsage();
+    }
+    return result;
+  }
+
   bool doCollateWith(UndoableCommand& other) override
   {
     if (auto* transactionCommand = dynamic_cast<TransactionCommand*>(&other))
@@ -203,6 +216,25 @@ const std::string& CommandProcessor::redoCommandName() const
   }
 }
 
+void CommandProcessor::setMemoryBudget(const std::optional<size_t> memoryBudget)
+{
+  m_memoryBudget = memoryBudget;
+  enforceMemoryBudget();
+}
+
+size_t CommandProcessor::memoryUsage() const
+{
+  const auto addMemoryUsage = [](const size_t total, const auto& command) {
+    return total + command->memoryUsage();
+  };
+
+  return std::accumulate(
+    m_redoStack.begin(),
+    m_redoStack.end(),
+    std::accumulate(m_undoStack.begin(), m_undoStack.end(), size_t(0), addMemoryUsage),
+    addMemoryUsage);
+}
+
 void CommandProcessor::startTransaction(std::string name, const TransactionScope scope)
 {
   m_transactionStack.emplace_back(std::move(name), scope);
@@ -381,6 +413,7 @@ bool CommandProcessor::pushTransactionCommand(
   std::unique_ptr<UndoableCommand> command, const bool collate)
 {
   assert(!m_transactionStack.empty());
+
   auto& transaction = m_transactionStack.back();
   if (!transaction.commands.empty())
   {
@@ -391,6 +424,7 @@ bool CommandProcessor::pushTransactionCommand(
       return false;
     }
   }
+  command->compress(m_document);
   transaction.commands.push_back(std::move(command));
   return true;
 }
@@ -445,14 +479,40 @@ bool CommandProcessor::pushToUndoStack(
     auto& lastCommand = m_undoStack.back();
     if (lastCommand->collateWith(*command))
     {
+      enforceMemoryBudget();
       return false;
     }
   }
 
+  command->compress(m_document);
   m_undoStack.push_back(std::move(command));
+  enforceMemoryBudget();
   return true;
 }
 
+void CommandProcessor::enforceMemoryBudget()
+{
+  if (!m_memoryBudget || m_undoStack.size() < 2)
+  {
+    return;
+  }
+
+  auto undoStackMemoryUsage = size_t(0);
+  for (const auto& command : m_undoStack)
+  {
+    undoStackMemoryUsage += command->memoryUsage();
+  }
+
+  auto it = m_undoStack.begin();
+  while (undoStackMemoryUsage > *m_memoryBudget && std::next(it) != m_undoStack.end())
+  {
+    undoStackMemoryUsage -= (*it)->memoryUsage();
+    ++it;
+  }
+
+  m_undoStack.erase(m_undoStack.begin(), it);
+}
+
 std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
 {
   assert(m_transactionStack.empty());
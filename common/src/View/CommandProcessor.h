@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -53,6 +54,10 @@ enum class TransactionScope;
  * The command processor supports nested transactions. Each transaction can be committed
  * or rolled back individually. Committing a nested transaction adds it as a command to
  * the containing transaction.
+ *
+ * The memory used by the commands on the undo stack can be limited by a memory budget.
+ * If the budget is exceeded, the oldest commands are removed from the undo stack, but
+ * the most recently executed command is always kept.
  */
 class CommandProcessor
 {
@@ -67,6 +72,11 @@ private:
    */
   std::chrono::milliseconds m_collationInterval;
 
+  /**
+   * Limits the number of bytes used by the commands on the undo stack, if set.
+   */
+  std::optional<size_t> m_memoryBudget;
+
   /**
    * Holds the commands that were executed so far, with the most recently executed command
    * at the end of the vector.
@@ -168,6 +178,21 @@ public:
    */
   const std::string& redoCommandName() const;
 
+  /**
+   * Sets the maximum number of bytes that the commands on the undo stack may use, or
+   * removes the limit if the given value is empty. If the undo stack exceeds the given
+   * budget, its oldest commands are removed immediately.
+   *
+   * @param memoryBudget the memory budget in bytes
+   */
+  void setMemoryBudget(std::optional<size_t> memoryBudget);
+
+  /**
+   * Returns an estimate of the number of bytes used by the commands on the undo and the
+   * redo stack.
+   */
+  size_t memoryUsage() const;
+
   /**
    * Starts a new transaction. If a transaction is currently executing, then the newly
    * started transaction becomes a nested transaction and will be added as a command to
@@ -321,7 +346,7 @@ private:
    * Pushes the given command to the back of the list of commands belonging to the
    * currently executing transaction. If `collate` is `true`, then it is attempted to
    * collate the given command with the last command executed in the currently executing
-   * transaction.
+   * transaction. The given command is compressed only if it is stored.
    *
    * Precondition: a transaction is currently executing
    *
@@ -356,7 +381,8 @@ private:
   /**
    * Pushes the given command onto the undo stack, unless it can be collated with the
    * topmost command on the undo stack. Takes ownership of the given command, so if it
-   * isn't stored on the undo stack, the command is deleted.
+   * isn't stored on the undo stack, the command is deleted. The given command is
+   * compressed only if it is stored.
    *
    * @param command the command to push
    * @param collate whether or not it should be attempted to collate the given command
@@ -365,6 +391,12 @@ private:
    */
   bool pushToUndoStack(std::unique_ptr<UndoableCommand> command, bool collate);
 
+  /**
+   * Removes the oldest commands from the undo stack until the commands on the undo stack
+   * fit into the memory budget, or until only one command remains.
+   */
+  void enforceMemoryBudget();
+
   /**
    * Pops the topmost command from the undo stack and returns it.
    *
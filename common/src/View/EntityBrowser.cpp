@@ -162,6 +162,8 @@ void EntityBrowser::connectObservers()
     this, &EntityBrowser::entityDefinitionsDidChange);
   m_notifierConnection +=
     document->nodesDidChangeNotifier.connect(this, &EntityBrowser::nodesDidChange);
+  m_notifierConnection += document->entityModelsWereLoadedNotifier.connect(
+    this, &EntityBrowser::entityModelsWereLoaded);
 
   PreferenceManager& prefs = PreferenceManager::instance();
   m_notifierConnection +=
@@ -194,6 +196,15 @@ void EntityBrowser::entityDefinitionsDidChange()
   reload();
 }
 
+void EntityBrowser::entityModelsWereLoaded(
+  const std::vector<std::filesystem::path>& paths, const std::vector<Model::Node*>&)
+{
+  if (m_view != nullptr && m_view->isAwaitingAnyModel(paths))
+  {
+    reload();
+  }
+}
+
 void EntityBrowser::preferenceDidChange(const std::filesystem::path& path)
 {
   auto document = kdl::mem_lock(m_document);
@@ -78,6 +78,9 @@ private:
   void modsDidChange();
   void nodesDidChange(const std::vector<Model::Node*>& nodes);
   void entityDefinitionsDidChange();
+  void entityModelsWereLoaded(
+    const std::vector<std::filesystem::path>& paths,
+    const std::vector<Model::Node*>& nodes);
   void preferenceDidChange(const std::filesystem::path& path);
 };
 } // namespace View
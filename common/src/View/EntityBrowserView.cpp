@@ -131,6 +131,13 @@ void EntityBrowserView::setFilterText(const std::string& filterText)
   }
 }
 
+bool EntityBrowserView::isAwaitingAnyModel(
+  const std::vector<std::filesystem::path>& paths) const
+{
+  return kdl::any_of(
+    paths, [&](const auto& path) { return m_awaitedModels.count(path) > 0; });
+}
+
 void EntityBrowserView::doInitLayout(Layout& layout)
 {
   layout.setOuterMargin(5.0f);
@@ -144,6 +151,8 @@ void EntityBrowserView::doInitLayout(Layout& layout)
 
 void EntityBrowserView::doReloadLayout(Layout& layout)
 {
+  m_awaitedModels.clear();
+
   const auto& fontPath = pref(Preferences::RendererFontPath());
   const auto fontSize = pref(Preferences::BrowserFontSize);
   assert(fontSize > 0);
@@ -231,6 +240,11 @@ void EntityBrowserView::addEntityToLayout(
       });
 
     const auto* frame = m_entityModelManager.frame(spec);
+    if (frame == nullptr && m_entityModelManager.isLoading(spec.path))
+    {
+      m_awaitedModels.insert(spec.path);
+    }
+
     const auto modelScale = vm::vec3f{Assets::safeGetModelScale(
       definition->modelDefinition(),
       EL::NullVariableStore{},
@@ -25,10 +25,13 @@
 #include "Renderer/GLVertexType.h"
 #include "View/CellView.h"
 
+#include "kdl/vector_set.h"
+
 #include "vm/bbox.h"
 #include "vm/forward.h"
 #include "vm/quat.h"
 
+#include <filesystem>
 #include <optional>
 #include <string>
 #include <vector>
@@ -95,6 +98,11 @@ private:
   Assets::EntityDefinitionSortOrder m_sortOrder;
   std::string m_filterText;
 
+  /**
+   * The paths of the models that were still being loaded when the layout was built.
+   */
+  kdl::vector_set<std::filesystem::path> m_awaitedModels;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -115,6 +123,12 @@ public:
   void setHideUnused(bool hideUnused);
   void setFilterText(const std::string& filterText);
 
+  /**
+   * Indicates whether any of the given model paths is shown as a placeholder because the
+   * model was still being loaded when the layout was built.
+   */
+  bool isAwaitingAnyModel(const std::vector<std::filesystem::path>& paths) const;
+
 private:
   void doInitLayout(Layout& layout) override;
   void doReloadLayout(Layout& layout) override;
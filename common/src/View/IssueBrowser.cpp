@@ -108,22 +108,22 @@ void IssueBrowser::documentWasSaved(MapDocument*)
 
 void IssueBrowser::nodesWereAdded(const std::vector<Model::Node*>&)
 {
-  m_view->reload();
+  m_view->invalidate();
 }
 
 void IssueBrowser::nodesWereRemoved(const std::vector<Model::Node*>&)
 {
-  m_view->reload();
+  m_view->invalidate();
 }
 
 void IssueBrowser::nodesDidChange(const std::vector<Model::Node*>&)
 {
-  m_view->reload();
+  m_view->invalidate();
 }
 
 void IssueBrowser::brushFacesDidChange(const std::vector<Model::BrushFaceHandle>&)
 {
-  m_view->reload();
+  m_view->invalidate();
 }
 
 void IssueBrowser::issueIgnoreChanged(Model::Issue*)
@@ -26,22 +26,20 @@
 #include <QTableView>
 
 #include "Ensure.h"
-#include "Model/BrushNode.h"
-#include "Model/EntityNode.h"
-#include "Model/GroupNode.h"
 #include "Model/Issue.h"
 #include "Model/IssueQuickFix.h"
-#include "Model/LayerNode.h"
-#include "Model/PatchNode.h"
+#include "Model/IssueTracker.h"
 #include "Model/WorldNode.h"
 #include "View/MapDocument.h"
 #include "View/QtUtils.h"
 
 #include "kdl/memory_utils.h"
-#include "kdl/overload.h"
 #include "kdl/vector_set.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <vector>
 
 namespace TrenchBroom
@@ -54,6 +52,7 @@ IssueBrowserView::IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget*
   , m_hiddenIssueTypes{0}
   , m_showHiddenIssues{false}
   , m_valid{false}
+  , m_reload{false}
 {
   createGui();
   bindEvents();
@@ -89,21 +88,37 @@ void IssueBrowserView::setHiddenIssueTypes(const int hiddenIssueTypes)
   if (hiddenIssueTypes != m_hiddenIssueTypes)
   {
     m_hiddenIssueTypes = hiddenIssueTypes;
-    invalidate();
+    reload();
   }
 }
 
 void IssueBrowserView::setShowHiddenIssues(const bool show)
 {
   m_showHiddenIssues = show;
-  invalidate();
+  reload();
 }
 
 void IssueBrowserView::reload()
 {
+  m_reload = true;
+  m_tableModel->setIssues({});
   invalidate();
 }
 
+void IssueBrowserView::invalidate()
+{
+  auto document = kdl::mem_lock(m_document);
+  if (auto* world = document->world())
+  {
+    // the issues of these nodes have been destroyed, so they must be removed before the
+    // table accesses them again
+    m_tableModel->removeIssues(world->issueTracker().takeInvalidatedNodes());
+  }
+
+  m_valid = false;
+  QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
+}
+
 void IssueBrowserView::deselectAll()
 {
   m_tableView->clearSelection();
@@ -133,50 +148,32 @@ void IssueBrowserView::updateSelection()
 void IssueBrowserView::updateIssues()
 {
   auto document = kdl::mem_lock(m_document);
-  if (document->world() != nullptr)
+  if (auto* world = document->world())
   {
-    const auto validators = document->world()->registeredValidators();
+    auto& issueTracker = world->issueTracker();
+    auto newIssues = issueTracker.validate(world->registeredValidators());
 
-    auto issues = std::vector<const Model::Issue*>{};
-    const auto collectIssues = [&](auto* node) {
-      for (auto* issue : node->issues(validators))
-      {
-        if (
-          m_showHiddenIssues
-          || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
-        {
-          issues.push_back(issue);
-        }
-      }
-    };
-
-    document->world()->accept(kdl::overload(
-      [&](auto&& thisLambda, Model::WorldNode* world) {
-        collectIssues(world);
-        world->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, Model::LayerNode* layer) {
-        collectIssues(layer);
-        layer->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, Model::GroupNode* group) {
-        collectIssues(group);
-        group->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, Model::EntityNode* entity) {
-        collectIssues(entity);
-        entity->visitChildren(thisLambda);
-      },
-      [&](Model::BrushNode* brush) { collectIssues(brush); },
-      [&](Model::PatchNode* patch) { collectIssues(patch); }));
-
-    issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) {
-      return lhs->seqId() > rhs->seqId();
-    });
-    m_tableModel->setIssues(std::move(issues));
+    if (m_reload)
+    {
+      m_tableModel->setIssues(filterIssues(issueTracker.issues()));
+      m_reload = false;
+    }
+    else
+    {
+      m_tableModel->addIssues(filterIssues(std::move(newIssues)));
+    }
   }
 }
 
+std::vector<const Model::Issue*> IssueBrowserView::filterIssues(
+  std::vector<const Model::Issue*> issues) const
+{
+  return kdl::vec_filter(std::move(issues), [&](const auto* issue) {
+    return m_showHiddenIssues
+           || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0);
+  });
+}
+
 void IssueBrowserView::applyQuickFix(const Model::IssueQuickFix& quickFix)
 {
   auto document = kdl::mem_lock(m_document);
@@ -250,7 +247,7 @@ void IssueBrowserView::setIssueVisibility(const bool show)
     document->setIssueHidden(*issue, !show);
   }
 
-  invalidate();
+  reload();
 }
 
 QList<QModelIndex> IssueBrowserView::getSelection() const
@@ -324,14 +321,6 @@ void IssueBrowserView::hideIssues()
   setIssueVisibility(false);
 }
 
-void IssueBrowserView::invalidate()
-{
-  m_valid = false;
-  m_tableModel->setIssues({});
-
-  QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
-}
-
 void IssueBrowserView::validate()
 {
   if (!m_valid)
@@ -343,6 +332,16 @@ void IssueBrowserView::validate()
 
 // IssueBrowserModel
 
+namespace
+{
+std::vector<const Model::Node*> getNodes(const std::vector<const Model::Issue*>& issues)
+{
+  return kdl::vec_transform(issues, [](const auto* issue) {
+    return const_cast<const Model::Node*>(&issue->node());
+  });
+}
+} // namespace
+
 IssueBrowserModel::IssueBrowserModel(QObject* parent)
   : QAbstractTableModel{parent}
 {
@@ -352,9 +351,86 @@ void IssueBrowserModel::setIssues(std::vector<const Model::Issue*> issues)
 {
   beginResetModel();
   m_issues = std::move(issues);
+  m_issueNodes = getNodes(m_issues);
   endResetModel();
 }
 
+void IssueBrowserModel::addIssues(const std::vector<const Model::Issue*>& issues)
+{
+  if (issues.empty())
+  {
+    return;
+  }
+
+  const auto isNewer = [](const auto* lhs, const auto* rhs) {
+    return lhs->seqId() > rhs->seqId();
+  };
+
+  if (m_issues.empty() || isNewer(issues.back(), m_issues.front()))
+  {
+    // usually, all new issues are newer than the existing ones and go to the top
+    beginInsertRows(QModelIndex{}, 0, static_cast<int>(issues.size()) - 1);
+    const auto issueNodes = getNodes(issues);
+    m_issues.insert(m_issues.begin(), issues.begin(), issues.end());
+    m_issueNodes.insert(m_issueNodes.begin(), issueNodes.begin(), issueNodes.end());
+    endInsertRows();
+  }
+  else
+  {
+    // issues of nodes that were added back to the world, e.g. by undo, keep their
+    // sequence IDs
+    for (const auto* issue : issues)
+    {
+      const auto it = std::lower_bound(m_issues.begin(), m_issues.end(), issue, isNewer);
+      const auto row = std::distance(m_issues.begin(), it);
+
+      beginInsertRows(QModelIndex{}, static_cast<int>(row), static_cast<int>(row));
+      m_issues.insert(it, issue);
+      m_issueNodes.insert(std::next(m_issueNodes.begin(), row), &issue->node());
+      endInsertRows();
+    }
+  }
+}
+
+void IssueBrowserModel::removeIssues(const std::vector<const Model::Node*>& nodes)
+{
+  if (nodes.empty() || m_issues.empty())
+  {
+    return;
+  }
+
+  const auto nodeSet = kdl::vector_set<const Model::Node*>{nodes};
+
+  // remove contiguous runs of rows, starting at the bottom so that row indices stay valid
+  auto last = m_issueNodes.size();
+  while (last > 0)
+  {
+    if (nodeSet.count(m_issueNodes[last - 1]) == 0)
+    {
+      --last;
+      continue;
+    }
+
+    auto first = last - 1;
+    while (first > 0 && nodeSet.count(m_issueNodes[first - 1]) > 0)
+    {
+      --first;
+    }
+
+    beginRemoveRows(QModelIndex{}, static_cast<int>(first), static_cast<int>(last) - 1);
+    const auto firstOffset = static_cast<std::ptrdiff_t>(first);
+    const auto lastOffset = static_cast<std::ptrdiff_t>(last);
+    m_issues.erase(
+      std::next(m_issues.begin(), firstOffset), std::next(m_issues.begin(), lastOffset));
+    m_issueNodes.erase(
+      std::next(m_issueNodes.begin(), firstOffset),
+      std::next(m_issueNodes.begin(), lastOffset));
+    endRemoveRows();
+
+    last = first;
+  }
+}
+
 const std::vector<const Model::Issue*>& IssueBrowserModel::issues()
 {
   return m_issues;
@@ -36,6 +36,7 @@ namespace Model
 {
 class Issue;
 class IssueQuickFix;
+class Node;
 } // namespace Model
 
 namespace View
@@ -53,6 +54,7 @@ private:
   bool m_showHiddenIssues;
 
   bool m_valid;
+  bool m_reload;
 
   QTableView* m_tableView;
   IssueBrowserModel* m_tableModel;
@@ -68,11 +70,26 @@ public:
   int hiddenIssueTypes() const;
   void setHiddenIssueTypes(int hiddenIssueTypes);
   void setShowHiddenIssues(bool show);
+
+  /**
+   * Clears the table and fills it with all issues of the current world once the changed
+   * nodes have been validated.
+   */
   void reload();
+
+  /**
+   * Removes the issues of invalidated nodes from the table right away and schedules the
+   * validation of the changed nodes, whose issues are then added to the table. Must be
+   * called whenever the world has changed.
+   */
+  void invalidate();
+
   void deselectAll();
 
 private:
   void updateIssues();
+  std::vector<const Model::Issue*> filterIssues(
+    std::vector<const Model::Issue*> issues) const;
 
   std::vector<const Model::Issue*> collectIssues(const QList<QModelIndex>& indices) const;
   std::vector<const Model::IssueQuickFix*> collectQuickFixes(
@@ -91,26 +108,38 @@ private:
   void hideIssues();
   void applyQuickFix(const Model::IssueQuickFix& quickFix);
 
-private:
-  void invalidate();
 public slots:
   void validate();
 };
 
 /**
- * Trivial QAbstractTableModel subclass, when the issues list changes,
- * it just refreshes the entire list with beginResetModel()/endResetModel().
+ * Table model that keeps the issues sorted by descending sequence ID. Issues can be
+ * added and removed incrementally, so that only the affected rows are updated.
  */
 class IssueBrowserModel : public QAbstractTableModel
 {
   Q_OBJECT
 private:
   std::vector<const Model::Issue*> m_issues;
+  // the node of every issue, used to remove issues which have already been destroyed
+  std::vector<const Model::Node*> m_issueNodes;
 
 public:
   explicit IssueBrowserModel(QObject* parent);
 
   void setIssues(std::vector<const Model::Issue*> issues);
+
+  /**
+   * Adds the given issues, which must be sorted by descending sequence ID.
+   */
+  void addIssues(const std::vector<const Model::Issue*>& issues);
+
+  /**
+   * Removes the issues that belong to any of the given nodes. The issues are not
+   * accessed, so they may have been destroyed already.
+   */
+  void removeIssues(const std::vector<const Model::Node*>& nodes);
+
   const std::vector<const Model::Issue*>& issues();
 
 public: // QAbstractTableModel overrides
@@ -128,6 +128,7 @@
 #include <cstdlib> // for std::abs
 #include <map>
 #include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -368,6 +369,14 @@ bool applyAndSwap(
 
   return success;
 }
+
+std::optional<size_t> textureMemoryBudget()
+{
+  const auto textureMemoryBudget = pref(Preferences::TextureMemoryBudget);
+  return textureMemoryBudget > 0
+           ? std::optional{size_t(textureMemoryBudget) * 1024u * 1024u}
+           : std::nullopt;
+}
 } // namespace
 
 const vm::bbox3 MapDocument::DefaultWorldBounds(-32768.0, 32768.0);
@@ -394,6 +403,7 @@ MapDocument::MapDocument()
   , m_viewEffectsService(nullptr)
   , m_repeatStack(std::make_unique<RepeatStack>())
 {
+  m_textureManager->setMemoryBudget(textureMemoryBudget());
   connectObservers();
 }
 
@@ -641,6 +651,16 @@ void MapDocument::saveDocumentTo(const std::filesystem::path& path)
   });
 }
 
+std::string MapDocument::serializeDocument()
+{
+  ensure(m_game.get() != nullptr, "game is null");
+  ensure(m_world, "world is null");
+
+  auto stream = std::stringstream{};
+  m_game->writeMapToStream(*m_world, stream);
+  return stream.str();
+}
+
 Result<void> MapDocument::exportDocumentAs(const IO::ExportOptions& options)
 {
   return m_game->exportMap(*m_world, options);
@@ -893,7 +913,7 @@ void copyAndSetLinkIds(
   for (const auto& linkedGroupsToAdd : groupsByLinkId)
   {
     const auto& linkId = linkedGroupsToAdd.front()->linkId();
-    const auto existingLinkedNodes = Model::collectNodesWithLinkId({&worldNode}, linkId);
+    const auto existingLinkedNodes = Model::collectNodesWithLinkId(worldNode, linkId);
 
     if (!existingLinkedNodes.empty())
     {
@@ -1825,7 +1845,7 @@ void MapDocument::duplicateObjects()
 
     const auto isLinkedGroup =
       dynamic_cast<const Model::GroupNode*>(original) != nullptr
-      && Model::collectLinkedNodes({m_world.get()}, *original).size() > 1;
+      && Model::collectLinkedNodes(*m_world, *original).size() > 1;
     const auto setLinkIds =
       isLinkedGroup ? Model::SetLinkId::keep : Model::SetLinkId::generate;
     auto* clone = original->cloneRecursively(m_worldBounds, setLinkIds);
@@ -2225,7 +2245,7 @@ void MapDocument::selectLinkedGroups()
     m_selectedNodes.groups(), [](const auto* groupNode) { return groupNode->linkId(); }));
   const auto groupNodesToSelect =
     kdl::vec_flatten(kdl::vec_transform(linkIdsToSelect, [&](const auto& linkId) {
-      return Model::collectNodesWithLinkId({m_world.get()}, linkId);
+      return Model::collectNodesWithLinkId(*m_world, linkId);
     }));
 
   auto transaction = Transaction{*this, "Select Linked Groups"};
@@ -2298,7 +2318,7 @@ bool MapDocument::canSeparateLinkedGroups() const
 {
   return kdl::any_of(m_selectedNodes.groups(), [&](const auto* groupNode) {
     const auto linkedGroups =
-      Model::collectNodesWithLinkId({m_world.get()}, groupNode->linkId());
+      Model::collectNodesWithLinkId(*m_world, groupNode->linkId());
     return linkedGroups.size() > 1u
            && kdl::any_of(linkedGroups, [](const auto* linkedGroupNode) {
                 return !linkedGroupNode->selected();
@@ -2379,7 +2399,7 @@ void MapDocument::separateSelectedLinkedGroups(const bool relinkGroups)
 
   for (const auto& linkedGroupId : selectedLinkIds)
   {
-    auto linkedGroups = Model::collectGroupsWithLinkId({m_world.get()}, linkedGroupId);
+    auto linkedGroups = Model::collectGroupsWithLinkId(*m_world, linkedGroupId);
 
     // partition the linked groups into selected and unselected ones
     const auto it = std::partition(
@@ -2908,7 +2928,7 @@ bool MapDocument::transformObjects(
         [&](Model::BrushNode* brushNode) -> TransformResult {
           const bool lockTextures =
             lockTexturesPref
-            || Model::collectLinkedNodes({m_world.get()}, *brushNode).size() > 1;
+            || Model::collectLinkedNodes(*m_world, *brushNode).size() > 1;
 
           auto brush = brushNode->brush();
           return brush.transform(m_worldBounds, transformation, lockTextures)
@@ -3108,6 +3128,17 @@ bool MapDocument::csgSubtract()
   const auto subtrahends = kdl::vec_transform(
     subtrahendNodes, [](const auto* subtrahendNode) { return &subtrahendNode->brush(); });
 
+  // the minuends are independent of each other, so they can be processed in parallel
+  const auto mapFormat = m_world->mapFormat();
+  const auto& textureName = currentTextureName();
+  auto subtractionResults = kdl::vec_parallel_transform(
+    minuendNodes,
+    [&](const auto* minuendNode) {
+      return minuendNode->brush().subtract(
+        mapFormat, m_worldBounds, textureName, subtrahends);
+    },
+    1);
+
   auto toAdd = std::map<Model::Node*, std::vector<Model::Node*>>{};
   auto toRemove =
     std::vector<Model::Node*>{std::begin(subtrahendNodes), std::end(subtrahendNodes)};
@@ -3115,10 +3146,8 @@ bool MapDocument::csgSubtract()
   return kdl::fold_results(
            kdl::vec_transform(
              minuendNodes,
-             [&](auto* minuendNode) {
-               const auto& minuend = minuendNode->brush();
-               auto currentSubtractionResults = minuend.subtract(
-                 m_world->mapFormat(), m_worldBounds, currentTextureName(), subtrahends);
+             [&](auto* minuendNode, const size_t i) {
+               auto currentSubtractionResults = std::move(subtractionResults[i]);
 
                return kdl::fold_results(kdl::vec_filter(
                                           std::move(currentSubtractionResults),
@@ -3454,7 +3483,7 @@ std::optional<std::string> findUnprotectedPropertyValue(
   const Model::EntityNodeBase& entityNode,
   Model::WorldNode& worldNode)
 {
-  const auto linkedNodes = Model::collectLinkedNodes({&worldNode}, entityNode);
+  const auto linkedNodes = Model::collectLinkedNodes(worldNode, entityNode);
   if (linkedNodes.size() > 1)
   {
     if (const auto value = findUnprotectedPropertyValue(key, linkedNodes))
@@ -3511,7 +3540,7 @@ bool MapDocument::clearProtectedProperties()
       continue;
     }
 
-    const auto linkedEntities = Model::collectLinkedNodes({m_world.get()}, *entityNode);
+    const auto linkedEntities = Model::collectLinkedNodes(*m_world, *entityNode);
     if (linkedEntities.size() <= 1)
     {
       continue;
@@ -4140,6 +4169,11 @@ const std::string& MapDocument::redoCommandName() const
   return doGetRedoCommandName();
 }
 
+size_t MapDocument::undoMemoryUsage() const
+{
+  return doGetUndoMemoryUsage();
+}
+
 void MapDocument::undoCommand()
 {
   doUndoCommand();
@@ -4237,6 +4271,17 @@ void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) c
   }
 }
 
+void MapDocument::pickFirst(
+  const vm::ray3& pickRay,
+  const Model::HitFilter& filter,
+  Model::PickResult& pickResult) const
+{
+  if (m_world)
+  {
+    m_world->pickFirst(*m_editorContext, pickRay, filter, pickResult);
+  }
+}
+
 std::vector<Model::Node*> MapDocument::findNodesContaining(const vm::vec3& point) const
 {
   auto result = std::vector<Model::Node*>{};
@@ -4285,6 +4330,7 @@ void MapDocument::clearWorld()
 {
   m_world.reset();
   m_currentLayer = nullptr;
+  m_entityNodesAwaitingModels.clear();
 }
 
 Assets::EntityDefinitionFileSpec MapDocument::entityDefinitionFile() const
@@ -4522,7 +4568,8 @@ static auto makeSetTexturesVisitor(Assets::TextureManager& manager)
       for (size_t i = 0u; i < brush.faceCount(); ++i)
       {
         const Model::BrushFace& face = brush.face(i);
-        Assets::Texture* texture = manager.texture(face.attributes().textureName());
+        Assets::Texture* texture =
+          manager.texture(face.attributes().internedTextureName());
         brushNode->setFaceTexture(i, texture);
       }
     },
@@ -4569,7 +4616,8 @@ void MapDocument::setTextures(const std::vector<Model::BrushFaceHandle>& faceHan
   {
     Model::BrushNode* node = faceHandle.node();
     const Model::BrushFace& face = faceHandle.face();
-    Assets::Texture* texture = m_textureManager->texture(face.attributes().textureName());
+    Assets::Texture* texture =
+      m_textureManager->texture(face.attributes().internedTextureName());
     node->setFaceTexture(faceHandle.faceIndex(), texture);
   }
   textureUsageCountsDidChangeNotifier();
@@ -4654,11 +4702,14 @@ void MapDocument::reloadEntityDefinitionsInternal()
 void MapDocument::clearEntityModels()
 {
   unsetEntityModels();
+  m_entityNodesAwaitingModels.clear();
   m_entityModelManager->clear();
 }
 
 static auto makeSetEntityModelsVisitor(
-  Logger& logger, Assets::EntityModelManager& manager)
+  Logger& logger,
+  Assets::EntityModelManager& manager,
+  std::unordered_map<Model::EntityNode*, std::filesystem::path>& awaitingModels)
 {
   return kdl::overload(
     [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
@@ -4671,40 +4722,93 @@ static auto makeSetEntityModelsVisitor(
         });
       const auto* frame = manager.frame(modelSpec);
       entityNode->setModelFrame(frame);
+
+      if (frame == nullptr && manager.isLoading(modelSpec.path))
+      {
+        awaitingModels.insert_or_assign(entityNode, modelSpec.path);
+      }
+      else
+      {
+        awaitingModels.erase(entityNode);
+      }
     },
     [](Model::BrushNode*) {},
     [](Model::PatchNode*) {});
 }
 
-static auto makeUnsetEntityModelsVisitor()
+static auto makeUnsetEntityModelsVisitor(
+  std::unordered_map<Model::EntityNode*, std::filesystem::path>& awaitingModels)
 {
   return kdl::overload(
     [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
     [](auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
     [](auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
-    [](Model::EntityNode* entity) { entity->setModelFrame(nullptr); },
+    [&](Model::EntityNode* entity) {
+      entity->setModelFrame(nullptr);
+      awaitingModels.erase(entity);
+    },
     [](Model::BrushNode*) {},
     [](Model::PatchNode*) {});
 }
 
 void MapDocument::setEntityModels()
 {
-  m_world->accept(makeSetEntityModelsVisitor(*this, *m_entityModelManager));
+  m_world->accept(makeSetEntityModelsVisitor(
+    *this, *m_entityModelManager, m_entityNodesAwaitingModels));
 }
 
 void MapDocument::setEntityModels(const std::vector<Model::Node*>& nodes)
 {
-  Model::Node::visitAll(nodes, makeSetEntityModelsVisitor(*this, *m_entityModelManager));
+  Model::Node::visitAll(
+    nodes,
+    makeSetEntityModelsVisitor(*this, *m_entityModelManager, m_entityNodesAwaitingModels));
 }
 
 void MapDocument::unsetEntityModels()
 {
-  m_world->accept(makeUnsetEntityModelsVisitor());
+  m_world->accept(makeUnsetEntityModelsVisitor(m_entityNodesAwaitingModels));
 }
 
 void MapDocument::unsetEntityModels(const std::vector<Model::Node*>& nodes)
 {
-  Model::Node::visitAll(nodes, makeUnsetEntityModelsVisitor());
+  Model::Node::visitAll(nodes, makeUnsetEntityModelsVisitor(m_entityNodesAwaitingModels));
+}
+
+void MapDocument::updateLoadedEntityModels()
+{
+  const auto loadedPaths = m_entityModelManager->commitLoadedModels();
+  if (loadedPaths.empty())
+  {
+    return;
+  }
+
+  // only update the entities that are waiting for one of the loaded models
+  const auto loadedPathSet = kdl::vector_set<std::filesystem::path>{loadedPaths};
+  auto entityNodes = std::vector<Model::Node*>{};
+  for (auto it = m_entityNodesAwaitingModels.begin();
+       it != m_entityNodesAwaitingModels.end();)
+  {
+    if (loadedPathSet.count(it->second) > 0)
+    {
+      entityNodes.push_back(it->first);
+      it = m_entityNodesAwaitingModels.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  setEntityModels(entityNodes);
+  entityModelsWereLoadedNotifier(loadedPaths, entityNodes);
+}
+
+void MapDocument::updateDecodedTextures()
+{
+  if (m_textureManager->commitDecodedTextures() > 0)
+  {
+    texturesWereDecodedNotifier();
+  }
 }
 
 std::vector<std::filesystem::path> MapDocument::externalSearchPaths() const
@@ -5109,9 +5213,10 @@ void MapDocument::preferenceDidChange(const std::filesystem::path& path)
   {
     const Model::GameFactory& gameFactory = Model::GameFactory::instance();
     const std::filesystem::path newGamePath = gameFactory.gamePath(m_game->gameName());
-    m_game->setGamePath(newGamePath, logger());
 
+    // stop loading models in the background before the game file system changes
     clearEntityModels();
+    m_game->setGamePath(newGamePath, logger());
     setEntityModels();
 
     reloadTextures();
@@ -5126,6 +5231,10 @@ void MapDocument::preferenceDidChange(const std::filesystem::path& path)
     m_textureManager->setTextureMode(
       pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
   }
+  else if (path == Preferences::TextureMemoryBudget.path())
+  {
+    m_textureManager->setMemoryBudget(textureMemoryBudget());
+  }
 }
 
 void MapDocument::commandDone(Command& command)
@@ -21,6 +21,7 @@
 
 #include "FloatType.h"
 #include "Model/Game.h"
+#include "Model/HitFilter.h"
 #include "Model/MapFacade.h"
 #include "Model/NodeCollection.h"
 #include "Model/NodeContents.h"
@@ -40,6 +41,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -66,6 +68,7 @@ class BrushFaceHandle;
 class BrushFaceAttributes;
 class EditorContext;
 class Entity;
+class EntityNode;
 class Game;
 class Issue;
 enum class MapFormat;
@@ -121,6 +124,13 @@ protected:
 
   std::unique_ptr<Assets::EntityDefinitionManager> m_entityDefinitionManager;
   std::unique_ptr<Assets::EntityModelManager> m_entityModelManager;
+
+  /**
+   * The entity nodes whose models are being loaded in the background, with the paths of
+   * these models.
+   */
+  std::unordered_map<Model::EntityNode*, std::filesystem::path>
+    m_entityNodesAwaitingModels;
   std::unique_ptr<Assets::TextureManager> m_textureManager;
   std::unique_ptr<Model::TagManager> m_tagManager;
 
@@ -198,9 +208,22 @@ public: // notification
 
   Notifier<> textureUsageCountsDidChangeNotifier;
 
+  /**
+   * Notified when the pixel data of textures was decoded in the background, so that the
+   * views can upload and show them.
+   */
+  Notifier<> texturesWereDecodedNotifier;
+
   Notifier<> entityDefinitionsWillChangeNotifier;
   Notifier<> entityDefinitionsDidChangeNotifier;
 
+  /**
+   * Notified with the paths of the models that were loaded in the background and the
+   * entity nodes that were waiting for them.
+   */
+  Notifier<const std::vector<std::filesystem::path>&, const std::vector<Model::Node*>&>
+    entityModelsWereLoadedNotifier;
+
   Notifier<> modsWillChangeNotifier;
   Notifier<> modsDidChangeNotifier;
 
@@ -267,6 +290,17 @@ public:
 
   void setViewEffectsService(ViewEffectsService* viewEffectsService);
 
+  /**
+   * Assigns the entity models that were loaded in the background to the entities that
+   * use them.
+   */
+  void updateLoadedEntityModels();
+
+  /**
+   * Hands the pixel data of textures that was decoded in the background to the textures.
+   */
+  void updateDecodedTextures();
+
 public: // tag and entity definition actions
   template <typename ActionVisitor>
   void visitTagActions(const ActionVisitor& visitor) const
@@ -307,6 +341,11 @@ public: // new, load, save document
   void saveDocument();
   void saveDocumentAs(const std::filesystem::path& path);
   void saveDocumentTo(const std::filesystem::path& path);
+
+  /**
+   * Returns the contents of the map file that would be written when saving this document.
+   */
+  std::string serializeDocument();
   Result<void> exportDocumentAs(const IO::ExportOptions& options);
 
 private:
@@ -641,6 +680,7 @@ public: // command processing
   bool canRedoCommand() const;
   const std::string& undoCommandName() const;
   const std::string& redoCommandName() const;
+  size_t undoMemoryUsage() const;
   void undoCommand();
   void redoCommand();
   bool canRepeatCommands() const;
@@ -665,6 +705,7 @@ private: // subclassing interface for command processing
   virtual bool doCanRedoCommand() const = 0;
   virtual const std::string& doGetUndoCommandName() const = 0;
   virtual const std::string& doGetRedoCommandName() const = 0;
+  virtual size_t doGetUndoMemoryUsage() const = 0;
   virtual void doUndoCommand() = 0;
   virtual void doRedoCommand() = 0;
 
@@ -682,6 +723,15 @@ public: // asset state management
 
 public: // picking
   void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
+
+  /**
+   * Like pick(), but only ensures that the given pick result contains the closest hit
+   * matching the given filter. Use this if only the first matching hit is needed.
+   */
+  void pickFirst(
+    const vm::ray3& pickRay,
+    const Model::HitFilter& filter,
+    Model::PickResult& pickResult) const;
   std::vector<Model::Node*> findNodesContaining(const vm::vec3& point) const;
 
 private: // world management
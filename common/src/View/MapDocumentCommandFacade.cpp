@@ -58,6 +58,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -65,6 +66,16 @@ namespace TrenchBroom
 {
 namespace View
 {
+namespace
+{
+std::optional<size_t> undoMemoryBudget()
+{
+  const auto undoMemoryBudget = pref(Preferences::UndoMemoryBudget);
+  return undoMemoryBudget > 0 ? std::optional{size_t(undoMemoryBudget) * 1024u * 1024u}
+                              : std::nullopt;
+}
+} // namespace
+
 std::shared_ptr<MapDocument> MapDocumentCommandFacade::newMapDocument()
 {
   // can't use std::make_shared here because the constructor is private
@@ -74,6 +85,7 @@ std::shared_ptr<MapDocument> MapDocumentCommandFacade::newMapDocument()
 MapDocumentCommandFacade::MapDocumentCommandFacade()
   : m_commandProcessor(std::make_unique<CommandProcessor>(this))
 {
+  m_commandProcessor->setMemoryBudget(undoMemoryBudget());
   connectObservers();
 }
 
@@ -631,6 +643,18 @@ void MapDocumentCommandFacade::connectObservers()
     m_commandProcessor->transactionDoneNotifier.connect(transactionDoneNotifier);
   m_notifierConnection +=
     m_commandProcessor->transactionUndoneNotifier.connect(transactionUndoneNotifier);
+
+  auto& prefs = PreferenceManager::instance();
+  m_notifierConnection += prefs.preferenceDidChangeNotifier.connect(
+    this, &MapDocumentCommandFacade::undoPreferenceDidChange);
+}
+
+void MapDocumentCommandFacade::undoPreferenceDidChange(const std::filesystem::path& path)
+{
+  if (path == Preferences::UndoMemoryBudget.path())
+  {
+    m_commandProcessor->setMemoryBudget(undoMemoryBudget());
+  }
 }
 
 bool MapDocumentCommandFacade::isCurrentDocumentStateObservable() const
@@ -658,6 +682,11 @@ const std::string& MapDocumentCommandFacade::doGetRedoCommandName() const
   return m_commandProcessor->redoCommandName();
 }
 
+size_t MapDocumentCommandFacade::doGetUndoMemoryUsage() const
+{
+  return m_commandProcessor->memoryUsage();
+}
+
 void MapDocumentCommandFacade::doUndoCommand()
 {
   m_commandProcessor->undo();
@@ -26,6 +26,7 @@
 
 #include "vm/forward.h"
 
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <string>
@@ -117,6 +118,7 @@ public: // modification count
 
 private: // notification
   void connectObservers();
+  void undoPreferenceDidChange(const std::filesystem::path& path);
   void documentWasNewed(MapDocument* document);
   void documentWasLoaded(MapDocument* document);
 
@@ -127,6 +129,7 @@ private: // implement MapDocument interface
   bool doCanRedoCommand() const override;
   const std::string& doGetUndoCommandName() const override;
   const std::string& doGetRedoCommandName() const override;
+  size_t doGetUndoMemoryUsage() const override;
   void doUndoCommand() override;
   void doRedoCommand() override;
 
@@ -38,12 +38,16 @@
 #include <QVBoxLayout>
 #include <QtGlobal>
 
+#include "Assets/EntityModelManager.h"
+#include "Assets/TextureManager.h"
 #include "Console.h"
 #include "Error.h"
 #include "Exceptions.h"
 #include "FileLogger.h"
+#include "IO/DiskIO.h"
 #include "IO/ExportOptions.h"
 #include "IO/PathQt.h"
+#include "IO/SystemPaths.h"
 #include "Model/BrushNode.h"
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
@@ -158,6 +162,47 @@ MapFrame::MapFrame(FrameManager* frameManager, std::shared_ptr<MapDocument> docu
   m_document->setParentLogger(m_console);
   m_document->setViewEffectsService(m_mapView);
 
+  // load entity models in the background and hand them to the document on the main
+  // thread, one batch per event loop iteration
+  m_document->entityModelManager().setModelsLoadedCallback(
+    [document = std::weak_ptr<MapDocument>{m_document}]() {
+      QMetaObject::invokeMethod(
+        qApp,
+        [document]() {
+          if (auto lockedDocument = document.lock())
+          {
+            lockedDocument->updateLoadedEntityModels();
+          }
+        },
+        Qt::QueuedConnection);
+    });
+
+  // decode the pixel data of textures in the background in the same way
+  m_document->textureManager().setTexturesDecodedCallback(
+    [document = std::weak_ptr<MapDocument>{m_document}]() {
+      QMetaObject::invokeMethod(
+        qApp,
+        [document]() {
+          if (auto lockedDocument = document.lock())
+          {
+            lockedDocument->updateDecodedTextures();
+          }
+        },
+        Qt::QueuedConnection);
+    });
+
+  // remember the metadata of loaded textures so that they need not be decoded again
+  const auto textureCacheDirectory = IO::SystemPaths::userDataDirectory() / "cache";
+  IO::Disk::createDirectory(textureCacheDirectory)
+    .transform([&](auto) {
+      m_document->textureManager().setMetadataCachePath(
+        textureCacheDirectory / "TextureMetadata.txt");
+    })
+    .transform_error([&](const auto& e) {
+      m_document->logger().debug()
+        << "Could not create texture metadata cache directory: " << e.msg;
+    });
+
   m_autosaveTimer = new QTimer(this);
   m_autosaveTimer->start(1000);
 
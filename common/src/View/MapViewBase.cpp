@@ -171,6 +171,8 @@ void MapViewBase::connectObservers()
     document->selectionDidChangeNotifier.connect(this, &MapViewBase::selectionDidChange);
   m_notifierConnection += document->textureCollectionsDidChangeNotifier.connect(
     this, &MapViewBase::textureCollectionsDidChange);
+  m_notifierConnection += document->texturesWereDecodedNotifier.connect(
+    this, &MapViewBase::texturesWereDecoded);
   m_notifierConnection += document->entityDefinitionsDidChangeNotifier.connect(
     this, &MapViewBase::entityDefinitionsDidChange);
   m_notifierConnection +=
@@ -253,6 +255,11 @@ void MapViewBase::textureCollectionsDidChange()
   update();
 }
 
+void MapViewBase::texturesWereDecoded()
+{
+  update();
+}
+
 void MapViewBase::entityDefinitionsDidChange()
 {
   createActions();
@@ -156,6 +156,7 @@ private:
   void commandUndone(UndoableCommand& command);
   void selectionDidChange(const Selection& selection);
   void textureCollectionsDidChange();
+  void texturesWereDecoded();
   void entityDefinitionsDidChange();
   void modsDidChange();
   void editorContextDidChange();
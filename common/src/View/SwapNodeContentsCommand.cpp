@@ -19,23 +19,89 @@
 
 #include "SwapNodeContentsCommand.h"
 
+#include "Ensure.h"
+#include "Error.h"
+#include "Model/BezierPatch.h"
 #include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/BrushNode.h"
 #include "Model/Entity.h"
+#include "Model/EntityProperties.h"
 #include "Model/Node.h"
+#include "Model/Polyhedron.h"
 #include "View/MapDocumentCommandFacade.h"
 
+#include "kdl/overload.h"
+#include "kdl/parallel.h"
 #include "kdl/result.h"
+#include "kdl/result_fold.h"
 #include "kdl/vector_utils.h"
 
+#include <unordered_map>
+#include <variant>
+
 namespace TrenchBroom
 {
 namespace View
 {
+namespace
+{
+
+size_t estimateMemoryUsage(const Model::Brush& brush)
+{
+  // the faces' texture names are interned and not owned by the brush
+  auto result = brush.faces().capacity() * sizeof(Model::BrushFace);
+  if (brush.faceCount() > 0)
+  {
+    result += brush.vertexCount() * sizeof(Model::BrushVertex)
+              + brush.edgeCount() * sizeof(Model::BrushEdge)
+              + brush.edgeCount() * 2 * sizeof(Model::BrushHalfEdge)
+              + brush.faceCount() * sizeof(Model::BrushFaceGeometry);
+  }
+  return result;
+}
+
+size_t estimateMemoryUsage(const Model::Entity& entity)
+{
+  auto result = entity.properties().capacity() * sizeof(Model::EntityProperty);
+  for (const auto& property : entity.properties())
+  {
+    result += property.key().capacity() + property.value().capacity();
+  }
+  return result;
+}
+
+size_t estimateMemoryUsage(const Model::BezierPatch& patch)
+{
+  // unlike brush faces, patches still own their texture names
+  return patch.controlPoints().capacity() * sizeof(Model::BezierPatch::Point)
+         + patch.textureName().capacity();
+}
+
+/**
+ * Returns an estimate of the number of bytes allocated by the given node contents.
+ */
+size_t estimateMemoryUsage(const Model::NodeContents& contents)
+{
+  return std::visit(
+    kdl::overload(
+      [](const Model::Layer&) -> size_t { return 0; },
+      [](const Model::Group&) -> size_t { return 0; },
+      [](const Model::Entity& entity) { return estimateMemoryUsage(entity); },
+      [](const Model::Brush& brush) { return estimateMemoryUsage(brush); },
+      [](const Model::BezierPatch& patch) { return estimateMemoryUsage(patch); }),
+    contents.get());
+}
+
+} // namespace
+
 SwapNodeContentsCommand::SwapNodeContentsCommand(
   const std::string& name,
   std::vector<std::pair<Model::Node*, Model::NodeContents>> nodes)
   : UpdateLinkedGroupsCommandBase(name, true)
   , m_nodes(std::move(nodes))
+  , m_memoryUsage{computeMemoryUsage()}
 {
 }
 
@@ -44,15 +110,13 @@ SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformDo(
   MapDocumentCommandFacade* document)
 {
-  document->performSwapNodeContents(m_nodes);
-  return std::make_unique<CommandResult>(true);
+  return swapNodeContents(document);
 }
 
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformUndo(
   MapDocumentCommandFacade* document)
 {
-  document->performSwapNodeContents(m_nodes);
-  return std::make_unique<CommandResult>(true);
+  return swapNodeContents(document);
 }
 
 bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
@@ -67,10 +131,152 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
     kdl::vec_sort(myNodes);
     kdl::vec_sort(theirNodes);
 
-    return myNodes == theirNodes;
+    if (myNodes == theirNodes)
+    {
+      rebaseBrushDeltas(*other);
+      return true;
+    }
   }
 
   return false;
 }
+
+size_t SwapNodeContentsCommand::doGetMemoryUsage() const
+{
+  return m_memoryUsage;
+}
+
+std::unique_ptr<CommandResult> SwapNodeContentsCommand::swapNodeContents(
+  MapDocumentCommandFacade* document)
+{
+  return restoreBrushes(document->worldBounds())
+    .transform([&]() {
+      document->performSwapNodeContents(m_nodes);
+      m_compressed = false;
+      m_memoryUsage = computeMemoryUsage();
+      return std::make_unique<CommandResult>(true);
+    })
+    .transform_error([&](auto e) {
+      document->error() << "Could not restore brushes: " << e.msg;
+      return std::make_unique<CommandResult>(false);
+    })
+    .value();
+}
+
+void SwapNodeContentsCommand::doCompress(MapDocumentCommandFacade* /* document */)
+{
+  if (m_compressed)
+  {
+    return;
+  }
+
+  // brushes whose geometry cannot be rebuilt from their faces are kept in full
+  for (size_t i = 0; i < m_nodes.size(); ++i)
+  {
+    auto& [node, contents] = m_nodes[i];
+    if (const auto* brushNode = dynamic_cast<const Model::BrushNode*>(node))
+    {
+      const auto& brush = std::get<Model::Brush>(contents.get());
+      if (brush.canRebuildGeometryExactly())
+      {
+        m_brushDeltas.emplace_back(
+          i, Model::BrushDelta{brush.faces(), brushNode->brush().faces()});
+        contents = Model::NodeContents{Model::Brush{}};
+      }
+    }
+  }
+  m_compressed = true;
+  m_memoryUsage = computeMemoryUsage();
+}
+
+Result<void> SwapNodeContentsCommand::restoreBrushes(const vm::bbox3& worldBounds)
+{
+  const auto restoreBrush = [&](const auto* indexAndDelta) {
+    const auto& [index, brushDelta] = *indexAndDelta;
+    const auto* brushNode = static_cast<const Model::BrushNode*>(m_nodes[index].first);
+    return brushDelta.restore(worldBounds, brushNode->brush().faces());
+  };
+
+  auto brushDeltas = kdl::vec_transform(
+    m_brushDeltas, [](const auto& indexAndDelta) { return &indexAndDelta; });
+  return kdl::fold_results(
+           kdl::vec_parallel_transform(std::move(brushDeltas), restoreBrush))
+    .transform([&](auto brushes) {
+      for (size_t i = 0; i < brushes.size(); ++i)
+      {
+        const auto index = m_brushDeltas[i].first;
+        m_nodes[index].second = Model::NodeContents{std::move(brushes[i])};
+      }
+      m_brushDeltas.clear();
+      m_brushDeltas.shrink_to_fit();
+    });
+}
+
+void SwapNodeContentsCommand::rebaseBrushDeltas(const SwapNodeContentsCommand& other)
+{
+  // Our brush deltas are relative to the brushes which the other command has replaced,
+  // and the other command stores these brushes either as deltas or in full. If the other
+  // command has been compressed, this does not depend on the current brushes, which
+  // might have been changed by subsequent commands already. Otherwise, it has just been
+  // performed and is collated before it is stored, so the current brushes are the ones
+  // it has put in place.
+  auto theirBrushDeltas =
+    std::unordered_map<const Model::Node*, const Model::BrushDelta*>{};
+  for (const auto& [index, brushDelta] : other.m_brushDeltas)
+  {
+    theirBrushDeltas.emplace(other.m_nodes[index].first, &brushDelta);
+  }
+
+  auto theirBrushes = std::unordered_map<const Model::Node*, const Model::Brush*>{};
+  for (const auto& [node, contents] : other.m_nodes)
+  {
+    if (const auto* brush = std::get_if<Model::Brush>(&contents.get()))
+    {
+      theirBrushes.emplace(node, brush);
+    }
+  }
+
+  for (auto& [index, brushDelta] : m_brushDeltas)
+  {
+    const auto* node = m_nodes[index].first;
+    if (const auto it = theirBrushDeltas.find(node); it != theirBrushDeltas.end())
+    {
+      brushDelta = brushDelta.rebase(*it->second);
+    }
+    else
+    {
+      const auto brushIt = theirBrushes.find(node);
+      ensure(brushIt != theirBrushes.end(), "other command must have been performed");
+
+      // the other command stores the reference brush in full, so store our faces relative
+      // to the current brush if it is the other command's result, and all face attributes
+      // otherwise
+      const auto faces = brushDelta.restoreFaces(brushIt->second->faces());
+      brushDelta =
+        other.m_compressed
+          ? Model::BrushDelta{faces, {}}
+          : Model::BrushDelta{
+            faces, static_cast<const Model::BrushNode*>(node)->brush().faces()};
+    }
+  }
+
+  m_memoryUsage = computeMemoryUsage();
+}
+
+size_t SwapNodeContentsCommand::computeMemoryUsage() const
+{
+  auto result = sizeof(SwapNodeContentsCommand)
+                + m_nodes.capacity() * sizeof(decltype(m_nodes)::value_type)
+                + m_brushDeltas.capacity() * sizeof(decltype(m_brushDeltas)::value_type);
+  for (const auto& [node, contents] : m_nodes)
+  {
+    result += estimateMemoryUsage(contents);
+  }
+  for (const auto& [index, brushDelta] : m_brushDeltas)
+  {
+    result += brushDelta.memoryUsage();
+  }
+  return result;
+}
 } // namespace View
 } // namespace TrenchBroom
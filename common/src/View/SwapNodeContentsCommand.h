@@ -20,11 +20,16 @@
 #pragma once
 
 #include "Macros.h"
+#include "Model/BrushDelta.h"
 #include "Model/NodeContents.h"
+#include "Result.h"
 #include "View/UpdateLinkedGroupsCommandBase.h"
 
+#include "vm/bbox.h"
+
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -39,11 +44,28 @@ class Node;
 
 namespace View
 {
+/**
+ * Swaps the contents of the given nodes with the given contents.
+ *
+ * To keep the undo history small, the contents of brush nodes that are not currently in
+ * the document are not stored in full. Instead, they are stored as deltas against the
+ * brushes that replaced them, and their geometry is rebuilt when they are swapped back
+ * in. The corresponding entries in `m_nodes` hold empty brushes in the meantime. Brushes
+ * whose geometry cannot be rebuilt exactly from their faces are stored in full.
+ *
+ * The brushes are compressed when the command is stored in the undo history, and not
+ * when it is undone or when it is collated with its predecessor and discarded.
+ */
 class SwapNodeContentsCommand : public UpdateLinkedGroupsCommandBase
 {
 protected:
   std::vector<std::pair<Model::Node*, Model::NodeContents>> m_nodes;
 
+private:
+  std::vector<std::pair<size_t, Model::BrushDelta>> m_brushDeltas;
+  bool m_compressed = false;
+  size_t m_memoryUsage;
+
 public:
   SwapNodeContentsCommand(
     const std::string& name,
@@ -56,7 +78,18 @@ public:
 
   bool doCollateWith(UndoableCommand& command) override;
 
+  size_t doGetMemoryUsage() const override;
+  void doCompress(MapDocumentCommandFacade* document) override;
+
   deleteCopyAndMove(SwapNodeContentsCommand);
+
+private:
+  std::unique_ptr<CommandResult> swapNodeContents(MapDocumentCommandFacade* document);
+
+  Result<void> restoreBrushes(const vm::bbox3& worldBounds);
+  void rebaseBrushDeltas(const SwapNodeContentsCommand& other);
+
+  size_t computeMemoryUsage() const;
 };
 } // namespace View
 } // namespace TrenchBroom
@@ -64,6 +64,8 @@ TextureBrowserView::TextureBrowserView(
   auto document = kdl::mem_lock(m_document);
   m_notifierConnection += document->textureUsageCountsDidChangeNotifier.connect(
     this, &TextureBrowserView::usageCountDidChange);
+  m_notifierConnection += document->texturesWereDecodedNotifier.connect(
+    this, &TextureBrowserView::texturesWereDecoded);
 }
 
 TextureBrowserView::~TextureBrowserView()
@@ -139,6 +141,11 @@ void TextureBrowserView::usageCountDidChange()
   update();
 }
 
+void TextureBrowserView::texturesWereDecoded()
+{
+  update();
+}
+
 void TextureBrowserView::doInitLayout(Layout& layout)
 {
   const auto scaleFactor = pref(Preferences::TextureBrowserIconSize);
@@ -83,6 +83,7 @@ public:
 
 private:
   void usageCountDidChange();
+  void texturesWereDecoded();
 
   void doInitLayout(Layout& layout) override;
   void doReloadLayout(Layout& layout) override;
@@ -302,7 +302,7 @@ private:
 
     Renderer::ActiveShader shader(
       renderContext.shaderManager(), Renderer::Shaders::UVViewShader);
-    shader.set("ApplyTexture", true);
+    shader.set("ApplyTexture", texture->isUploaded());
     shader.set("Color", texture->averageColor());
     shader.set("Brightness", pref(Preferences::Brightness));
     shader.set("RenderGrid", true);
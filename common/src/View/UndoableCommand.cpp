@@ -75,11 +75,28 @@ bool UndoableCommand::collateWith(UndoableCommand& command)
   return false;
 }
 
+size_t UndoableCommand::memoryUsage() const
+{
+  return doGetMemoryUsage();
+}
+
+void UndoableCommand::compress(MapDocumentCommandFacade* document)
+{
+  doCompress(document);
+}
+
 bool UndoableCommand::doCollateWith(UndoableCommand&)
 {
   return false;
 }
 
+size_t UndoableCommand::doGetMemoryUsage() const
+{
+  return 0;
+}
+
+void UndoableCommand::doCompress(MapDocumentCommandFacade*) {}
+
 void UndoableCommand::setModificationCount(MapDocumentCommandFacade* document)
 {
   if (document && m_modificationCount)
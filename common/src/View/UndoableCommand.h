@@ -47,12 +47,39 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the number of bytes that this command uses to store the state
+   * it needs to be undone or redone.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * Reduces the memory used by this command to store the state it needs to be undone.
+   * This is called once the command has been performed and is stored in the undo history,
+   * i.e. when it is first pushed and when it is redone, but not when it is undone or when
+   * it is collated with its predecessor and discarded. It is called before any other
+   * command is performed.
+   */
+  void compress(MapDocumentCommandFacade* document);
+
 protected:
   virtual std::unique_ptr<CommandResult> doPerformUndo(
     MapDocumentCommandFacade* document) = 0;
 
   virtual bool doCollateWith(UndoableCommand& command);
 
+  /**
+   * Commands that do not store any considerable amount of state need not override this.
+   * The default implementation returns 0.
+   */
+  virtual size_t doGetMemoryUsage() const;
+
+  /**
+   * Commands that do not store any considerable amount of state need not override this.
+   * The default implementation does nothing.
+   */
+  virtual void doCompress(MapDocumentCommandFacade* document);
+
   void setModificationCount(MapDocumentCommandFacade* document);
   void resetModificationCount(MapDocumentCommandFacade* document);
 
@@ -143,7 +143,7 @@ Result<UpdateLinkedGroupsHelper::LinkedGroupUpdates> UpdateLinkedGroupsHelper::
              changedLinkedGroups,
              [&](const auto* groupNode) {
                const auto groupNodesToUpdate = kdl::vec_erase(
-                 Model::collectGroupsWithLinkId({document.world()}, groupNode->linkId()),
+                 Model::collectGroupsWithLinkId(*document.world(), groupNode->linkId()),
                  groupNode);
 
                return Model::updateLinkedGroups(
@@ -0,0 +1,384 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+
+#include "vm/bbox.h"
+#include "vm/distance.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom::View
+{
+
+/**
+ * A sparse uniform grid that buckets values by an anchor position.
+ *
+ * Every value has an anchor position and an extent, which is the radius of a sphere
+ * around the anchor that contains the geometry represented by the value. The grid only
+ * stores cells that contain at least one value. Additionally, the cells are grouped into
+ * blocks of BlockSize^3 cells so that ray queries can skip entire blocks.
+ *
+ * The queries return candidates only, callers are expected to test the candidates
+ * exactly.
+ *
+ * @tparam V the value type, must be equality comparable
+ */
+template <typename V>
+class VertexHandleGrid
+{
+private:
+  using CellKey = vm::vec<std::int64_t, 3>;
+
+  struct CellKeyHash
+  {
+    std::size_t operator()(const CellKey& key) const
+    {
+      auto result = std::size_t(0);
+      for (std::size_t i = 0; i < 3; ++i)
+      {
+        result ^= std::hash<std::int64_t>{}(key[i]) + 0x9e3779b9 + (result << 6)
+                  + (result >> 2);
+      }
+      return result;
+    }
+  };
+
+  struct Entry
+  {
+    vm::vec3 anchor;
+    FloatType extent;
+    V value;
+  };
+
+  struct Cell
+  {
+    std::vector<Entry> entries;
+    FloatType maxExtent = FloatType(0);
+  };
+
+  using CellMap = std::unordered_map<CellKey, Cell, CellKeyHash>;
+  using CellMapEntry = typename CellMap::value_type;
+
+  struct Block
+  {
+    // pointers to elements of an unordered_map remain valid until they are erased
+    std::vector<CellMapEntry*> cells;
+    FloatType maxExtent = FloatType(0);
+  };
+
+  static constexpr std::int64_t BlockShift = 3;
+  static constexpr std::int64_t BlockSize = std::int64_t(1) << BlockShift;
+
+  FloatType m_cellSize;
+  CellMap m_cells;
+  std::unordered_map<CellKey, Block, CellKeyHash> m_blocks;
+  std::size_t m_size = 0;
+
+public:
+  static constexpr FloatType DefaultCellSize = FloatType(64);
+
+  explicit VertexHandleGrid(const FloatType cellSize = DefaultCellSize)
+    : m_cellSize{cellSize}
+  {
+    assert(m_cellSize > FloatType(0));
+  }
+
+  /**
+   * Returns the number of values in this grid.
+   */
+  std::size_t size() const { return m_size; }
+
+  /**
+   * Indicates whether this grid contains no values.
+   */
+  bool empty() const { return m_size == 0; }
+
+  /**
+   * Adds the given value at the given anchor position.
+   *
+   * @param anchor the anchor position
+   * @param extent the radius of a sphere around the anchor that contains the value
+   * @param value the value to add
+   */
+  void insert(const vm::vec3& anchor, const FloatType extent, V value)
+  {
+    const auto key = cellKey(anchor);
+    auto& block = m_blocks[blockKey(key)];
+
+    const auto [cellIt, inserted] = m_cells.try_emplace(key);
+    if (inserted)
+    {
+      block.cells.push_back(&*cellIt);
+    }
+
+    auto& cell = cellIt->second;
+    cell.entries.push_back(Entry{anchor, extent, std::move(value)});
+    cell.maxExtent = std::max(cell.maxExtent, extent);
+    block.maxExtent = std::max(block.maxExtent, extent);
+    ++m_size;
+  }
+
+  /**
+   * Removes the given value from the given anchor position.
+   *
+   * @param anchor the anchor position that was passed when the value was inserted
+   * @param value the value to remove
+   * @return true if the value was found and removed and false otherwise
+   */
+  bool remove(const vm::vec3& anchor, const V& value)
+  {
+    const auto key = cellKey(anchor);
+    const auto cellIt = m_cells.find(key);
+    if (cellIt == m_cells.end())
+    {
+      return false;
+    }
+
+    auto& cell = cellIt->second;
+    const auto entryIt = std::find_if(
+      cell.entries.begin(), cell.entries.end(), [&](const auto& entry) {
+        return entry.value == value;
+      });
+    if (entryIt == cell.entries.end())
+    {
+      return false;
+    }
+
+    *entryIt = std::move(cell.entries.back());
+    cell.entries.pop_back();
+    --m_size;
+
+    if (cell.entries.empty())
+    {
+      removeFromBlock(&*cellIt);
+      m_cells.erase(cellIt);
+    }
+    else
+    {
+      // the block's max extent remains an upper bound and is updated when a cell is
+      // removed from the block
+      cell.maxExtent = FloatType(0);
+      for (const auto& entry : cell.entries)
+      {
+        cell.maxExtent = std::max(cell.maxExtent, entry.extent);
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Removes all values from this grid.
+   */
+  void clear()
+  {
+    m_cells.clear();
+    m_blocks.clear();
+    m_size = 0;
+  }
+
+  /**
+   * Calls the given function for every value whose anchor is contained in the given
+   * bounding box.
+   */
+  template <typename F>
+  void forEachInBox(const vm::bbox3& bounds, const F& f) const
+  {
+    forEachEntryInBox(bounds, [&](const Entry& entry) {
+      if (bounds.contains(entry.anchor))
+      {
+        f(entry.value);
+      }
+    });
+  }
+
+  /**
+   * Calls the given function for every value whose anchor is within the given distance
+   * of the given position.
+   */
+  template <typename F>
+  void forEachInRadius(const vm::vec3& position, const FloatType radius, const F& f) const
+  {
+    const auto squaredRadius = radius * radius;
+    const auto bounds =
+      vm::bbox3{position - vm::vec3::fill(radius), position + vm::vec3::fill(radius)};
+    forEachEntryInBox(bounds, [&](const Entry& entry) {
+      if (vm::squared_distance(entry.anchor, position) <= squaredRadius)
+      {
+        f(entry.value);
+      }
+    });
+  }
+
+  /**
+   * Calls the given function for every value that might be within the given pick radius
+   * of the given ray.
+   *
+   * The pick radius may vary with the position, e.g. for handles that have a constant
+   * size on screen. The given function pickRadius(center, radius) must return an upper
+   * bound for the pick radius of every point within radius of center.
+   */
+  template <typename R, typename F>
+  void forEachNearRay(const vm::ray3& ray, const R& pickRadius, const F& f) const
+  {
+    const auto mayBeHit =
+      [&](const vm::vec3& center, const FloatType halfSize, const FloatType maxExtent) {
+        const auto radius = halfSize * std::sqrt(FloatType(3)) + maxExtent;
+        const auto maxDistance = radius + pickRadius(center, radius);
+        return vm::squared_distance(ray, center).distance <= maxDistance * maxDistance;
+      };
+
+    const auto cellHalfSize = FloatType(0.5) * m_cellSize;
+    const auto blockHalfSize = cellHalfSize * FloatType(BlockSize);
+    for (const auto& [key, block] : m_blocks)
+    {
+      if (!mayBeHit(blockCenter(key), blockHalfSize, block.maxExtent))
+      {
+        continue;
+      }
+
+      for (const auto* cellEntry : block.cells)
+      {
+        const auto& cell = cellEntry->second;
+        if (!mayBeHit(cellCenter(cellEntry->first), cellHalfSize, cell.maxExtent))
+        {
+          continue;
+        }
+
+        for (const auto& entry : cell.entries)
+        {
+          if (mayBeHit(entry.anchor, FloatType(0), entry.extent))
+          {
+            f(entry.value);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  template <typename F>
+  void forEachEntryInBox(const vm::bbox3& bounds, const F& f) const
+  {
+    const auto min = cellKey(bounds.min);
+    const auto max = cellKey(bounds.max);
+    const auto visit = [&](const Cell& cell) {
+      for (const auto& entry : cell.entries)
+      {
+        f(entry);
+      }
+    };
+
+    if (cellCount(min, max) > double(m_cells.size()))
+    {
+      // the box covers more cells than the grid contains, so visit the grid's cells
+      for (const auto& [key, cell] : m_cells)
+      {
+        visit(cell);
+      }
+      return;
+    }
+
+    for (auto x = min.x(); x <= max.x(); ++x)
+    {
+      for (auto y = min.y(); y <= max.y(); ++y)
+      {
+        for (auto z = min.z(); z <= max.z(); ++z)
+        {
+          if (const auto cellIt = m_cells.find(CellKey{x, y, z}); cellIt != m_cells.end())
+          {
+            visit(cellIt->second);
+          }
+        }
+      }
+    }
+  }
+
+  CellKey cellKey(const vm::vec3& position) const
+  {
+    return CellKey{
+      static_cast<std::int64_t>(std::floor(position.x() / m_cellSize)),
+      static_cast<std::int64_t>(std::floor(position.y() / m_cellSize)),
+      static_cast<std::int64_t>(std::floor(position.z() / m_cellSize))};
+  }
+
+  static CellKey blockKey(const CellKey& key)
+  {
+    // arithmetic shift rounds towards negative infinity
+    return CellKey{key.x() >> BlockShift, key.y() >> BlockShift, key.z() >> BlockShift};
+  }
+
+  vm::vec3 cellCenter(const CellKey& key) const
+  {
+    return (vm::vec3{key} + vm::vec3::fill(FloatType(0.5))) * m_cellSize;
+  }
+
+  vm::vec3 blockCenter(const CellKey& key) const
+  {
+    return (vm::vec3{key} + vm::vec3::fill(FloatType(0.5))) * m_cellSize
+           * FloatType(BlockSize);
+  }
+
+  void removeFromBlock(CellMapEntry* cellEntry)
+  {
+    const auto blockIt = m_blocks.find(blockKey(cellEntry->first));
+    assert(blockIt != m_blocks.end());
+
+    auto& block = blockIt->second;
+    const auto it = std::find(block.cells.begin(), block.cells.end(), cellEntry);
+    assert(it != block.cells.end());
+    *it = block.cells.back();
+    block.cells.pop_back();
+
+    if (block.cells.empty())
+    {
+      m_blocks.erase(blockIt);
+    }
+    else
+    {
+      block.maxExtent = FloatType(0);
+      for (const auto* otherCellEntry : block.cells)
+      {
+        block.maxExtent = std::max(block.maxExtent, otherCellEntry->second.maxExtent);
+      }
+    }
+  }
+
+  static double cellCount(const CellKey& min, const CellKey& max)
+  {
+    auto result = 1.0;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      result *= static_cast<double>(max[i] - min[i] + 1);
+    }
+    return result;
+  }
+};
+
+} // namespace TrenchBroom::View
@@ -35,6 +35,42 @@ namespace TrenchBroom
 {
 namespace View
 {
+vm::vec3 handleAnchor(const vm::vec3& handle)
+{
+  return handle;
+}
+
+vm::vec3 handleAnchor(const vm::segment3& handle)
+{
+  return handle.center();
+}
+
+vm::vec3 handleAnchor(const vm::polygon3& handle)
+{
+  return handle.center();
+}
+
+FloatType handleExtent(const vm::vec3& /* handle */)
+{
+  return FloatType(0);
+}
+
+FloatType handleExtent(const vm::segment3& handle)
+{
+  return FloatType(0.5) * handle.length();
+}
+
+FloatType handleExtent(const vm::polygon3& handle)
+{
+  const auto center = handle.center();
+  auto result = FloatType(0);
+  for (const auto& vertex : handle.vertices())
+  {
+    result = vm::max(result, vm::distance(vertex, center));
+  }
+  return result;
+}
+
 VertexHandleManagerBase::~VertexHandleManagerBase() {}
 
 const Model::HitType::Type VertexHandleManager::HandleHitType =
@@ -45,34 +81,32 @@ void VertexHandleManager::pick(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    if (
-      const auto distance = camera.pickPointHandle(
-        pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius))))
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const vm::vec3& position) {
+    if (const auto distance = camera.pickPointHandle(pickRay, position, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *distance);
       const auto error = vm::squared_distance(pickRay, position).distance;
       pickResult.addHit(Model::Hit(HandleHitType, *distance, hitPoint, position, error));
     }
-  }
+  });
 }
 
-void VertexHandleManager::addHandles(const Model::BrushNode* brushNode)
+void VertexHandleManager::addHandles(Model::BrushNode* brushNode)
 {
   const Model::Brush& brush = brushNode->brush();
   for (const Model::BrushVertex* vertex : brush.vertices())
   {
-    add(vertex->position());
+    add(vertex->position(), brushNode);
   }
 }
 
-void VertexHandleManager::removeHandles(const Model::BrushNode* brushNode)
+void VertexHandleManager::removeHandles(Model::BrushNode* brushNode)
 {
   const Model::Brush& brush = brushNode->brush();
   for (const Model::BrushVertex* vertex : brush.vertices())
   {
-    assertResult(remove(vertex->position()));
+    assertResult(remove(vertex->position(), brushNode));
   }
 }
 
@@ -81,13 +115,6 @@ Model::HitType::Type VertexHandleManager::hitType() const
   return HandleHitType;
 }
 
-bool VertexHandleManager::isIncident(
-  const Handle& handle, const Model::BrushNode* brushNode) const
-{
-  const Model::Brush& brush = brushNode->brush();
-  return brush.hasVertex(handle);
-}
-
 const Model::HitType::Type EdgeHandleManager::HandleHitType = Model::HitType::freeType();
 
 void EdgeHandleManager::pickGridHandle(
@@ -96,24 +123,22 @@ void EdgeHandleManager::pickGridHandle(
   const Grid& grid,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  const auto handleRadius = FloatType(pref(Preferences::HandleRadius));
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const vm::segment3& position) {
     if (
-      const auto edgeDist = camera.pickLineSegmentHandle(
-        pickRay, position, FloatType(pref(Preferences::HandleRadius))))
+      const auto edgeDist = camera.pickLineSegmentHandle(pickRay, position, handleRadius))
     {
       const auto pointHandle =
         grid.snap(vm::point_at_distance(pickRay, *edgeDist), position);
       if (
-        const auto pointDist = camera.pickPointHandle(
-          pickRay, pointHandle, FloatType(pref(Preferences::HandleRadius))))
+        const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
       {
         const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
         pickResult.addHit(Model::Hit(
           HandleHitType, *pointDist, hitPoint, HitType(position, pointHandle)));
       }
     }
-  }
+  });
 }
 
 void EdgeHandleManager::pickCenterHandle(
@@ -121,36 +146,37 @@ void EdgeHandleManager::pickCenterHandle(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  const auto handleRadius = FloatType(pref(Preferences::HandleRadius));
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const vm::segment3& position) {
     const auto pointHandle = position.center();
 
-    if (
-      const auto pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, FloatType(pref(Preferences::HandleRadius))))
+    if (const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
       pickResult.addHit(Model::Hit(HandleHitType, *pointDist, hitPoint, position));
     }
-  }
+  });
 }
 
-void EdgeHandleManager::addHandles(const Model::BrushNode* brushNode)
+void EdgeHandleManager::addHandles(Model::BrushNode* brushNode)
 {
   const Model::Brush& brush = brushNode->brush();
   for (const Model::BrushEdge* edge : brush.edges())
   {
-    add(vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position()));
+    add(
+      vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position()),
+      brushNode);
   }
 }
 
-void EdgeHandleManager::removeHandles(const Model::BrushNode* brushNode)
+void EdgeHandleManager::removeHandles(Model::BrushNode* brushNode)
 {
   const Model::Brush& brush = brushNode->brush();
   for (const Model::BrushEdge* edge : brush.edges())
   {
     assertResult(remove(
-      vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position())));
+      vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position()),
+      brushNode));
   }
 }
 
@@ -159,13 +185,6 @@ Model::HitType::Type EdgeHandleManager::hitType() const
   return HandleHitType;
 }
 
-bool EdgeHandleManager::isIncident(
-  const Handle& handle, const Model::BrushNode* brushNode) const
-{
-  const Model::Brush& brush = brushNode->brush();
-  return brush.hasEdge(handle);
-}
-
 const Model::HitType::Type FaceHandleManager::HandleHitType = Model::HitType::freeType();
 
 void FaceHandleManager::pickGridHandle(
@@ -174,8 +193,9 @@ void FaceHandleManager::pickGridHandle(
   const Grid& grid,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  // the ray must intersect the polygon, so a pick radius of 0 suffices to find the
+  // candidates
+  forEachHandleNearRay(pickRay, camera, FloatType(0), [&](const vm::polygon3& position) {
     if (const auto plane = vm::from_points(std::begin(position), std::end(position)))
     {
       if (
@@ -195,7 +215,7 @@ void FaceHandleManager::pickGridHandle(
         }
       }
     }
-  }
+  });
 }
 
 void FaceHandleManager::pickCenterHandle(
@@ -203,35 +223,33 @@ void FaceHandleManager::pickCenterHandle(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const vm::polygon3& position) {
     const auto pointHandle = position.center();
 
-    if (
-      const auto pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius))))
+    if (const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
       pickResult.addHit(Model::Hit(HandleHitType, *pointDist, hitPoint, position));
     }
-  }
+  });
 }
 
-void FaceHandleManager::addHandles(const Model::BrushNode* brushNode)
+void FaceHandleManager::addHandles(Model::BrushNode* brushNode)
 {
   const Model::Brush& brush = brushNode->brush();
   for (const Model::BrushFace& face : brush.faces())
   {
-    add(face.polygon());
+    add(face.polygon(), brushNode);
   }
 }
 
-void FaceHandleManager::removeHandles(const Model::BrushNode* brushNode)
+void FaceHandleManager::removeHandles(Model::BrushNode* brushNode)
 {
   const Model::Brush& brush = brushNode->brush();
   for (const Model::BrushFace& face : brush.faces())
   {
-    assertResult(remove(face.polygon()));
+    assertResult(remove(face.polygon(), brushNode));
   }
 }
 
@@ -239,12 +257,5 @@ Model::HitType::Type FaceHandleManager::hitType() const
 {
   return HandleHitType;
 }
-
-bool FaceHandleManager::isIncident(
-  const Handle& handle, const Model::BrushNode* brushNode) const
-{
-  const Model::Brush& brush = brushNode->brush();
-  return brush.hasFace(handle);
-}
 } // namespace View
 } // namespace TrenchBroom
@@ -25,11 +25,14 @@
 #include "Model/HitType.h"
 #include "Model/PickResult.h"
 #include "Renderer/Camera.h"
+#include "View/VertexHandleGrid.h"
 
 #include "kdl/vector_set.h"
 
+#include "vm/polygon.h"
 #include "vm/segment.h"
 
+#include <algorithm>
 #include <iterator>
 #include <map>
 #include <vector>
@@ -45,6 +48,22 @@ namespace View
 {
 class Grid;
 
+/**
+ * Returns the position by which the given handle is stored in a handle manager's spatial
+ * index.
+ */
+vm::vec3 handleAnchor(const vm::vec3& handle);
+vm::vec3 handleAnchor(const vm::segment3& handle);
+vm::vec3 handleAnchor(const vm::polygon3& handle);
+
+/**
+ * Returns the radius of a sphere around the anchor of the given handle that contains the
+ * handle.
+ */
+FloatType handleExtent(const vm::vec3& handle);
+FloatType handleExtent(const vm::segment3& handle);
+FloatType handleExtent(const vm::polygon3& handle);
+
 class VertexHandleManagerBase
 {
 public:
@@ -73,7 +92,7 @@ public:
    *
    * @param brushNode the brush whose handles to add
    */
-  virtual void addHandles(const Model::BrushNode* brushNode) = 0;
+  virtual void addHandles(Model::BrushNode* brushNode) = 0;
 
   /**
    * Removes all handles of the given range of brushes from this handle manager.
@@ -97,7 +116,7 @@ public:
    *
    * @param brushNode the brush whose handles to remove
    */
-  virtual void removeHandles(const Model::BrushNode* brushNode) = 0;
+  virtual void removeHandles(Model::BrushNode* brushNode) = 0;
 };
 
 template <typename H>
@@ -111,12 +130,14 @@ private:
 protected:
   /**
    * Represents the status of a handle, i.e., how many duplicates exist at the same
-   * coordinates and whether or not all of these are selected.
+   * coordinates, which brushes they belong to and whether or not all of these are
+   * selected.
    */
   struct HandleInfo
   {
     size_t count;
     bool selected;
+    std::vector<Model::BrushNode*> brushes;
 
     HandleInfo()
       : count(0)
@@ -160,14 +181,28 @@ protected:
     }
 
     /**
-     * Increments the number of handles at the same coordinates.
+     * Increments the number of handles at the same coordinates and records the given
+     * brush as incident to this handle.
      */
-    void inc() { ++count; }
+    void inc(Model::BrushNode* brushNode)
+    {
+      ++count;
+      brushes.push_back(brushNode);
+    }
 
     /**
-     * Deccrements the number of handles at the same coordinates.
+     * Decrements the number of handles at the same coordinates and removes the given
+     * brush from the brushes incident to this handle.
      */
-    void dec() { --count; }
+    void dec(Model::BrushNode* brushNode)
+    {
+      --count;
+      if (const auto it = std::find(brushes.begin(), brushes.end(), brushNode);
+          it != brushes.end())
+      {
+        brushes.erase(it);
+      }
+    }
   };
 
   using HandleMap = std::map<H, HandleInfo>;
@@ -178,6 +213,12 @@ protected:
    */
   HandleMap m_handles;
 
+  /**
+   * Indexes the entries of m_handles by their position. Since m_handles is a node based
+   * container, the entries remain valid until they are erased.
+   */
+  VertexHandleGrid<HandleEntry*> m_handleGrid;
+
   /**
    * The total number of selected handles, not counting duplicates.
    */
@@ -318,34 +359,41 @@ public:
 
 public:
   /**
-   * Adds the given handle to this manager.
+   * Adds the given handle of the given brush to this manager.
    *
    * @param handle the handle to add
+   * @param brushNode the brush the handle belongs to
    */
-  void add(const Handle& handle)
+  void add(const Handle& handle, Model::BrushNode* brushNode)
   {
-    m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo
-                             // means its default constructor is called
+    const auto [it, inserted] = m_handles.try_emplace(handle);
+    if (inserted)
+    {
+      m_handleGrid.insert(handleAnchor(handle), handleExtent(handle), &*it);
+    }
+    it->second.inc(brushNode);
   }
 
   /**
-   * Removes the given handle from this manager.
+   * Removes the given handle of the given brush from this manager.
    *
    * @param handle the handle to remove
+   * @param brushNode the brush the handle belongs to
    * @return true if the given handle was contained in this manager (and therefore
    * removed) and false otherwise
    */
-  bool remove(const Handle& handle)
+  bool remove(const Handle& handle, Model::BrushNode* brushNode)
   {
     const auto it = m_handles.find(handle);
     if (it != std::end(m_handles))
     {
       HandleInfo& info = it->second;
-      info.dec();
+      info.dec(brushNode);
 
       if (info.count == 0)
       {
         deselect(info);
+        m_handleGrid.remove(handleAnchor(handle), &*it);
         m_handles.erase(it);
       }
       return true;
@@ -360,6 +408,7 @@ public:
   void clear()
   {
     m_handles.clear();
+    m_handleGrid.clear();
     m_selectedHandleCount = 0;
   }
 
@@ -466,13 +515,19 @@ private:
   void forEachCloseHandle(const H& otherHandle, F fun)
   {
     static const auto epsilon = 0.001 * 0.001;
-    for (auto& [handle, info] : m_handles)
-    {
+
+    // handles that are equal within epsilon have anchors that are within epsilon of each
+    // other, the bounds are enlarged to account for rounding errors
+    const auto anchor = handleAnchor(otherHandle);
+    const auto bounds = vm::bbox3{
+      anchor - vm::vec3::fill(2.0 * epsilon), anchor + vm::vec3::fill(2.0 * epsilon)};
+    m_handleGrid.forEachInBox(bounds, [&](HandleEntry* entry) {
+      auto& [handle, info] = *entry;
       if (compare(otherHandle, handle, epsilon) == 0)
       {
         fun(info);
       }
-    }
+    });
   }
 
   void select(HandleInfo& info)
@@ -530,83 +585,97 @@ public:
     }
   }
 
+protected:
+  /**
+   * Calls the given function for every handle that might be hit by the given picking
+   * ray in the context of the given camera. The candidates must still be tested exactly.
+   *
+   * @tparam F the type of the function to call, must accept a handle
+   * @param pickRay the picking ray
+   * @param camera the camera
+   * @param handleRadius the radius of the handles on screen
+   * @param f the function to call
+   */
+  template <typename F>
+  void forEachHandleNearRay(
+    const vm::ray3& pickRay,
+    const Renderer::Camera& camera,
+    const FloatType handleRadius,
+    const F& f) const
+  {
+    // The camera scales the pick radius of a handle by the perspective scaling factor at
+    // its position. This factor is either constant or proportional to the distance from
+    // the camera plane, so its rate of change is bounded by the change along the view
+    // direction.
+    const auto scalingFactor = [&](const vm::vec3f& position) {
+      return static_cast<FloatType>(camera.perspectiveScalingFactor(position));
+    };
+    const auto scalingRate = vm::abs(
+      scalingFactor(camera.position() + camera.direction())
+      - scalingFactor(camera.position()));
+
+    const auto pickRadius = [&](const vm::vec3& center, const FloatType radius) {
+      const auto maxScaling =
+        vm::abs(scalingFactor(vm::vec3f{center})) + scalingRate * radius;
+      // add some slack to account for the float conversions
+      return FloatType(2.0) * handleRadius * maxScaling * FloatType(1.01);
+    };
+
+    m_handleGrid.forEachNearRay(
+      pickRay, pickRadius, [&](const HandleEntry* entry) { f(entry->first); });
+  }
+
 public:
   /**
-   * Finds and returns all brushes in the given range which are incident to the given
-   * handle.
+   * Finds and returns all brushes which are incident to the given handle.
    *
-   * @tparam I the type of the range iterators
    * @param handle the handle
-   * @param begin the beginning of the range of brushes
-   * @param end the end of the range of brushes
    * @return a set of all brushes that are incident to the given handle
    */
-  template <typename I>
-  std::vector<Model::BrushNode*> findIncidentBrushes(
-    const Handle& handle, I begin, I end) const
+  std::vector<Model::BrushNode*> findIncidentBrushes(const Handle& handle) const
   {
     kdl::vector_set<Model::BrushNode*> result;
-    findIncidentBrushes(handle, begin, end, std::inserter(result, result.end()));
+    findIncidentBrushes(handle, std::inserter(result, result.end()));
     return result.release_data();
   }
 
   /**
-   * Finds and returns all brushes in the given range which are incident to any handle in
-   * the given range.
+   * Finds and returns all brushes which are incident to any handle in the given range.
    *
-   * @tparam I1 the type of range iterators for the range of handles
-   * @tparam I2 the type of range iterators for the range of brushes
+   * @tparam I the type of range iterators for the range of handles
    * @param hBegin the beginning of the range of handles
    * @param hEnd the end of the range of handles
-   * @param bBegin the beginning of the range of brushes
-   * @param bEnd the end of the range of brushes
    * @return a set containing all incident brushes
    */
-  template <typename I1, typename I2>
-  std::vector<Model::BrushNode*> findIncidentBrushes(
-    I1 hBegin, I1 hEnd, I2 bBegin, I2 bEnd) const
+  template <typename I>
+  std::vector<Model::BrushNode*> findIncidentBrushes(I hBegin, I hEnd) const
   {
     kdl::vector_set<Model::BrushNode*> result;
     auto out = std::inserter(result, std::end(result));
     for (auto hCur = hBegin; hCur != hEnd; ++hCur)
     {
-      findIncidentBrushes(*hCur, bBegin, bEnd, out);
+      findIncidentBrushes(*hCur, out);
     }
     return result.release_data();
   }
 
   /**
-   * Finds all brushes in the given range which are incident to the given handle.
+   * Finds all brushes which are incident to the given handle. The incident brushes are
+   * recorded when handles are added to this manager, so this does not need to inspect
+   * any brush.
    *
-   * @tparam I the type of the range iterators
    * @tparam O an output iterator to append the resulting brushes to
    * @param handle the handle
-   * @param begin the beginning of the range of brushes
-   * @param end the end of the range of brushes
    * @param out an output iterator that accepts the incident brushes
    */
-  template <typename I, typename O>
-  void findIncidentBrushes(const Handle& handle, I begin, I end, O out) const
+  template <typename O>
+  void findIncidentBrushes(const Handle& handle, O out) const
   {
-    for (auto cur = begin; cur != end; ++cur)
+    if (const auto it = m_handles.find(handle); it != std::end(m_handles))
     {
-      if (isIncident(handle, *cur))
-      {
-        out++ = *cur;
-      }
+      std::copy(it->second.brushes.begin(), it->second.brushes.end(), out);
     }
   }
-
-private:
-  /**
-   * Checks whether the given brush is incident to the given handle.
-   *
-   * @param handle the handle to check
-   * @param brushNode the brush to check
-   * @return true if and only if the given brush is incident to the given handle
-   */
-  virtual bool isIncident(
-    const Handle& handle, const Model::BrushNode* brushNode) const = 0;
 };
 
 /**
@@ -636,13 +705,10 @@ public:
     Model::PickResult& pickResult) const;
 
 public:
-  void addHandles(const Model::BrushNode* brushNode) override;
-  void removeHandles(const Model::BrushNode* brushNode) override;
+  void addHandles(Model::BrushNode* brushNode) override;
+  void removeHandles(Model::BrushNode* brushNode) override;
 
   Model::HitType::Type hitType() const override;
-
-private:
-  bool isIncident(const Handle& handle, const Model::BrushNode* brushNode) const override;
 };
 
 /**
@@ -694,13 +760,10 @@ public:
     Model::PickResult& pickResult) const;
 
 public:
-  void addHandles(const Model::BrushNode* brushNode) override;
-  void removeHandles(const Model::BrushNode* brushNode) override;
+  void addHandles(Model::BrushNode* brushNode) override;
+  void removeHandles(Model::BrushNode* brushNode) override;
 
   Model::HitType::Type hitType() const override;
-
-private:
-  bool isIncident(const Handle& handle, const Model::BrushNode* brushNode) const override;
 };
 
 /**
@@ -752,13 +815,10 @@ public:
     Model::PickResult& pickResult) const;
 
 public:
-  void addHandles(const Model::BrushNode* brushNode) override;
-  void removeHandles(const Model::BrushNode* brushNode) override;
+  void addHandles(Model::BrushNode* brushNode) override;
+  void removeHandles(Model::BrushNode* brushNode) override;
 
   Model::HitType::Type hitType() const override;
-
-private:
-  bool isIncident(const Handle& handle, const Model::BrushNode* brushNode) const override;
 };
 } // namespace View
 } // namespace TrenchBroom
@@ -143,26 +143,14 @@ public:
   std::vector<Model::BrushNode*> findIncidentBrushes(
     const M& manager, const H2& handle) const
   {
-    const std::vector<Model::BrushNode*>& brushes = selectedBrushes();
-    return manager.findIncidentBrushes(handle, std::begin(brushes), std::end(brushes));
+    return manager.findIncidentBrushes(handle);
   }
 
   // FIXME: use vector_set
   template <typename M, typename I>
   std::vector<Model::BrushNode*> findIncidentBrushes(const M& manager, I cur, I end) const
   {
-    const std::vector<Model::BrushNode*>& brushes = selectedBrushes();
-    kdl::vector_set<Model::BrushNode*> result;
-    auto out = std::inserter(result, std::end(result));
-
-    while (cur != end)
-    {
-      const auto& handle = *cur;
-      manager.findIncidentBrushes(handle, std::begin(brushes), std::end(brushes), out);
-      ++cur;
-    }
-
-    return result.release_data();
+    return manager.findIncidentBrushes(cur, end);
   }
 
   virtual void pick(
@@ -631,15 +619,15 @@ protected:
   void addHandles(
     const std::vector<Model::Node*>& nodes, VertexHandleManagerBaseT<HT>& handleManager)
   {
-    for (const auto* node : nodes)
+    for (auto* node : nodes)
     {
       node->accept(kdl::overload(
-        [](const Model::WorldNode*) {},
-        [](const Model::LayerNode*) {},
-        [](const Model::GroupNode*) {},
-        [](const Model::EntityNode*) {},
-        [&](const Model::BrushNode* brush) { handleManager.addHandles(brush); },
-        [](const Model::PatchNode*) {}));
+        [](Model::WorldNode*) {},
+        [](Model::LayerNode*) {},
+        [](Model::GroupNode*) {},
+        [](Model::EntityNode*) {},
+        [&](Model::BrushNode* brush) { handleManager.addHandles(brush); },
+        [](Model::PatchNode*) {}));
     }
   }
 
@@ -647,15 +635,15 @@ protected:
   void removeHandles(
     const std::vector<Model::Node*>& nodes, VertexHandleManagerBaseT<HT>& handleManager)
   {
-    for (const auto* node : nodes)
+    for (auto* node : nodes)
     {
       node->accept(kdl::overload(
-        [](const Model::WorldNode*) {},
-        [](const Model::LayerNode*) {},
-        [](const Model::GroupNode*) {},
-        [](const Model::EntityNode*) {},
-        [&](const Model::BrushNode* brush) { handleManager.removeHandles(brush); },
-        [](const Model::PatchNode*) {}));
+        [](Model::WorldNode*) {},
+        [](Model::LayerNode*) {},
+        [](Model::GroupNode*) {},
+        [](Model::EntityNode*) {},
+        [&](Model::BrushNode* brush) { handleManager.removeHandles(brush); },
+        [](Model::PatchNode*) {}));
     }
   }
 
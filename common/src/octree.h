@@ -38,6 +38,7 @@
 #include <cmath>
 #include <optional>
 #include <ostream>
+#include <tuple>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -553,6 +554,84 @@ public:
     }
   }
 
+  /**
+   * Visits every data item in this tree whose bounding box intersects with the given ray
+   * in front-to-back order, that is, in the order in which the ray enters the tree nodes
+   * that contain the data items.
+   *
+   * Before the data items of a tree node are visited, the given predicate is called with
+   * the distance at which the ray enters that node, or 0 if the node contains the ray
+   * origin. If the predicate returns false, the traversal stops. Since every data item is
+   * contained in its tree node, none of the remaining data items can be hit by the ray at
+   * a distance less than the given one. This allows callers who are only interested in
+   * the closest hit to stop as soon as they have found it.
+   *
+   * @tparam V the visitor type, must accept a const U&
+   * @tparam P the predicate type, must accept a T and return bool
+   * @param ray the ray to test
+   * @param visitor the visitor to call for every data item
+   * @param should_continue the predicate to call for every visited tree node
+   */
+  template <typename V, typename P>
+  void visit_intersectors_in_order(
+    const vm::ray<T, 3>& ray, const V& visitor, const P& should_continue) const
+  {
+    if (!m_root)
+    {
+      return;
+    }
+
+    // a min heap of tree nodes, ordered by the distance at which the ray enters them
+    using entry = std::tuple<T, const node*>;
+    const auto compare = [](const entry& lhs, const entry& rhs) {
+      return std::get<0>(lhs) > std::get<0>(rhs);
+    };
+    auto queue = std::vector<entry>{};
+
+    const auto push = [&](const node& node_) {
+      const auto bounds = get_address(node_).to_bounds(m_min_size);
+      if (bounds.contains(ray.origin))
+      {
+        queue.emplace_back(T(0), &node_);
+        std::push_heap(queue.begin(), queue.end(), compare);
+      }
+      else if (const auto distance = vm::intersect_ray_bbox(ray, bounds))
+      {
+        queue.emplace_back(*distance, &node_);
+        std::push_heap(queue.begin(), queue.end(), compare);
+      }
+    };
+
+    push(*m_root);
+    while (!queue.empty())
+    {
+      std::pop_heap(queue.begin(), queue.end(), compare);
+      const auto [distance, node_] = queue.back();
+      queue.pop_back();
+
+      if (!should_continue(distance))
+      {
+        return;
+      }
+
+      for (const auto& data : get_data(*node_))
+      {
+        visitor(data);
+      }
+
+      if (const auto* inner_node_ = std::get_if<inner_node>(node_))
+      {
+        for (const auto& child : inner_node_->children)
+        {
+          if (!is_leaf_node(child) || !get_data(child).empty())
+          {
+            push(child);
+          }
+        }
+      }
+    }
+  }
+
   /**
    * Finds every data item in this tree whose bounding box intersects with the given bbox
    * and returns a list of those items.
@@ -577,14 +656,34 @@ public:
    */
   template <typename O>
   void find_intersectors(const vm::bbox<T, 3>& bbox, O out) const
+  {
+    visit_intersectors(bbox, [&](const U& data) { *out++ = data; });
+  }
+
+  /**
+   * Calls the given visitor for every data item in this tree whose bounding box
+   * intersects with the given bbox.
+   *
+   * Since the tree does not store the bounding boxes of the data items, the visitor is
+   * called for every data item that is stored in a tree node that intersects with the
+   * given bbox. The caller must test the data items for intersection if necessary.
+   *
+   * @tparam V the visitor type, must accept a const U&
+   * @param bbox the bbox to test
+   * @param visitor the visitor to call for every data item
+   */
+  template <typename V>
+  void visit_intersectors(const vm::bbox<T, 3>& bbox, const V& visitor) const
   {
     if (m_root)
     {
       visit_node_if(
         *m_root,
         [&](const auto& node) {
-          const auto& data = get_data(node);
-          std::copy(data.begin(), data.end(), out);
+          for (const auto& data : get_data(node))
+          {
+            visitor(data);
+          }
         },
         [&](const auto& node) {
           const auto bounds = get_address(node).to_bounds(m_min_size);
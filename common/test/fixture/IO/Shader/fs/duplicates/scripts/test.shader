@@ -0,0 +1,5 @@
+textures/test/test // overrides two images with the same name
+{
+    qer_editorimage textures/test/editor_image.jpg
+    surfaceparm noimpact
+}
@@ -0,0 +1,171 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelManager.h"
+#include "Assets/ModelDefinition.h"
+#include "Exceptions.h"
+#include "IO/EntityModelLoader.h"
+#include "TestLogger.h"
+
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Assets
+{
+namespace
+{
+class TestEntityModelLoader : public IO::EntityModelLoader
+{
+public:
+  mutable std::atomic<size_t> initializeCount = 0;
+
+private:
+  std::unique_ptr<EntityModel> doInitializeModel(
+    const std::filesystem::path& path, Logger&) const override
+  {
+    ++initializeCount;
+    if (path.stem() == "missing")
+    {
+      throw GameException{"Could not load model " + path.string()};
+    }
+
+    auto model = std::make_unique<EntityModel>(
+      path.filename().string(), PitchType::Normal, Orientation::Oriented);
+    model->addFrame();
+    model->addFrame();
+    return model;
+  }
+
+  void doLoadFrame(
+    const std::filesystem::path&,
+    const size_t frameIndex,
+    EntityModel& model,
+    Logger&) const override
+  {
+    model.loadFrame(
+      frameIndex, "frame", vm::bbox3f{vm::vec3f::fill(-8.0f), vm::vec3f::fill(8.0f)});
+  }
+};
+
+class LoadedModelsWaiter
+{
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  size_t m_notificationCount = 0;
+
+public:
+  void notify()
+  {
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      ++m_notificationCount;
+    }
+    m_condition.notify_all();
+  }
+
+  bool waitForNotification(const size_t count)
+  {
+    auto lock = std::unique_lock{m_mutex};
+    return m_condition.wait_for(lock, std::chrono::seconds{10}, [&]() {
+      return m_notificationCount >= count;
+    });
+  }
+};
+} // namespace
+
+TEST_CASE("EntityModelManager")
+{
+  auto logger = TestLogger{};
+  auto loader = TestEntityModelLoader{};
+  auto manager = EntityModelManager{0, 0, logger};
+  manager.setLoader(&loader);
+
+  const auto spec = ModelSpecification{"progs/model.mdl", 0, 1};
+
+  SECTION("Loads models synchronously without callback")
+  {
+    const auto* frame = manager.frame(spec);
+    REQUIRE(frame != nullptr);
+    CHECK(frame->loaded());
+    CHECK(loader.initializeCount == 1);
+  }
+
+  SECTION("Loads models in the background with callback")
+  {
+    auto waiter = LoadedModelsWaiter{};
+    manager.setModelsLoadedCallback([&]() { waiter.notify(); });
+
+    CHECK(manager.frame(spec) == nullptr);
+    CHECK(manager.frame(spec) == nullptr);
+    CHECK(manager.frame(ModelSpecification{"progs/missing.mdl", 0, 0}) == nullptr);
+    CHECK(manager.isLoading("progs/model.mdl"));
+    CHECK(manager.isLoading("progs/missing.mdl"));
+
+    // the first notification may be sent before the second model is done
+    REQUIRE(waiter.waitForNotification(1));
+    auto loadedPaths = manager.commitLoadedModels();
+    if (loadedPaths.size() < 2)
+    {
+      REQUIRE(waiter.waitForNotification(2));
+      loadedPaths = kdl::vec_concat(std::move(loadedPaths), manager.commitLoadedModels());
+    }
+
+    CHECK_THAT(
+      loadedPaths,
+      Catch::Matchers::UnorderedEquals(std::vector<std::filesystem::path>{
+        "progs/model.mdl", "progs/missing.mdl"}));
+
+    // requests for models being loaded are ignored
+    CHECK(loader.initializeCount == 2);
+    CHECK_FALSE(manager.isLoading("progs/model.mdl"));
+    CHECK_FALSE(manager.isLoading("progs/missing.mdl"));
+
+    const auto* frame = manager.frame(spec);
+    REQUIRE(frame != nullptr);
+    CHECK(frame->loaded());
+
+    CHECK(manager.frame(ModelSpecification{"progs/missing.mdl", 0, 0}) == nullptr);
+    CHECK(loader.initializeCount == 2);
+  }
+
+  SECTION("Discards models being loaded when cleared")
+  {
+    manager.setModelsLoadedCallback([]() {});
+
+    CHECK(manager.frame(spec) == nullptr);
+    manager.clear();
+
+    CHECK_FALSE(manager.isLoading("progs/model.mdl"));
+    CHECK(manager.commitLoadedModels().empty());
+  }
+}
+
+} // namespace TrenchBroom::Assets
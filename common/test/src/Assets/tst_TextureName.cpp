@@ -0,0 +1,146 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
+#include "Assets/TextureManager.h"
+#include "Assets/TextureName.h"
+#include "Logger.h"
+
+#include "kdl/string_format.h"
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Assets
+{
+
+TEST_CASE("TextureName")
+{
+  SECTION("interning")
+  {
+    const auto name = TextureName{"some_texture"};
+    CHECK(name.name() == "some_texture");
+    CHECK(name == TextureName{"some_texture"});
+    CHECK(&name.name() == &TextureName{"some_texture"}.name());
+    CHECK(name != TextureName{"Some_Texture"});
+  }
+
+  SECTION("keyId")
+  {
+    const auto name = TextureName{"another_texture"};
+    CHECK(name.keyId() == TextureName{"ANOTHER_texture"}.keyId());
+    CHECK(name.keyId() != TextureName{"yet_another_texture"}.keyId());
+  }
+
+  SECTION("findKeyId")
+  {
+    CHECK(TextureName::findKeyId("never_interned_texture") == std::nullopt);
+
+    const auto name = TextureName{"interned_texture"};
+    CHECK(TextureName::findKeyId("Interned_Texture") == name.keyId());
+  }
+
+  SECTION("comparison")
+  {
+    CHECK(TextureName{"a"} < TextureName{"b"});
+    CHECK_FALSE(TextureName{"b"} < TextureName{"a"});
+    CHECK_FALSE(TextureName{"a"} < TextureName{"a"});
+  }
+
+  SECTION("stream output")
+  {
+    auto str = std::stringstream{};
+    str << TextureName{"texture"};
+    CHECK(str.str() == "texture");
+  }
+
+  SECTION("interning on multiple threads")
+  {
+    constexpr auto NameCount = 1000;
+
+    auto keyIds = std::vector<std::vector<size_t>>(4);
+    auto threads = std::vector<std::thread>{};
+    for (size_t i = 0; i < keyIds.size(); ++i)
+    {
+      threads.emplace_back([&, i]() {
+        for (size_t j = 0; j < NameCount; ++j)
+        {
+          auto name = "thread_texture_" + std::to_string(j);
+          if (i % 2 == 1)
+          {
+            name = kdl::str_to_upper(name);
+          }
+          keyIds[i].push_back(TextureName{name}.keyId());
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (size_t i = 1; i < keyIds.size(); ++i)
+    {
+      CHECK(keyIds[i] == keyIds[0]);
+    }
+  }
+}
+
+TEST_CASE("TextureManager.texture")
+{
+  auto logger = NullLogger{};
+  auto textureManager = TextureManager{0, 0, logger};
+
+  auto firstTextures = std::vector<Texture>{};
+  firstTextures.emplace_back("some_texture", 16, 16);
+  firstTextures.emplace_back("Other_Texture", 16, 16);
+
+  // textures in later collections override textures with the same name
+  auto secondTextures = std::vector<Texture>{};
+  secondTextures.emplace_back("other_texture", 32, 32);
+
+  auto collections = std::vector<TextureCollection>{};
+  collections.emplace_back(std::move(firstTextures));
+  collections.emplace_back(std::move(secondTextures));
+  textureManager.setTextureCollections(std::move(collections));
+
+  const auto& textures = textureManager.collections();
+  const auto* someTexture = &textures[0].textures()[0];
+  const auto* otherTexture = &textures[1].textures()[0];
+
+  CHECK(textureManager.texture(TextureName{"some_texture"}) == someTexture);
+  CHECK(textureManager.texture(TextureName{"SOME_TEXTURE"}) == someTexture);
+  CHECK(textureManager.texture(TextureName{"other_texture"}) == otherTexture);
+  CHECK(textureManager.texture(TextureName{"Other_Texture"}) == otherTexture);
+  CHECK(textureManager.texture(TextureName{"missing_texture"}) == nullptr);
+
+  CHECK(textureManager.texture("some_texture") == someTexture);
+  CHECK(textureManager.texture("Other_TEXTURE") == otherTexture);
+  CHECK(textureManager.texture("missing_texture") == nullptr);
+  CHECK(textureManager.texture("never_interned_missing_texture") == nullptr);
+
+  textureManager.clear();
+  CHECK(textureManager.texture(TextureName{"some_texture"}) == nullptr);
+}
+
+} // namespace TrenchBroom::Assets
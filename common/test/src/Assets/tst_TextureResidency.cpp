@@ -0,0 +1,201 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "Assets/TextureResidency.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Assets
+{
+
+namespace
+{
+TextureLoader makeLoader(const size_t size)
+{
+  return [=]() -> TextureDecoder {
+    return [=]() {
+      auto buffers = std::vector<TextureBuffer>{};
+      buffers.emplace_back(size);
+      return buffers;
+    };
+  };
+}
+
+Texture makeTexture(std::string name, const size_t size)
+{
+  auto texture = Texture{std::move(name), 16, 16};
+  texture.setLoader(makeLoader(size));
+  return texture;
+}
+} // namespace
+
+TEST_CASE("TextureResidency")
+{
+  auto t1 = makeTexture("t1", 100);
+  auto t2 = makeTexture("t2", 100);
+  auto t3 = makeTexture("t3", 100);
+
+  auto residency = TextureResidency{};
+
+  SECTION("stats")
+  {
+    residency.textureLoaded(t1, 100);
+    residency.requestTexture(t2);
+
+    CHECK(t2.buffersIfUnprepared().size() == 1u);
+    CHECK(residency.stats().decodedBytes == 100);
+    CHECK(residency.stats().residentCount == 2);
+    CHECK(residency.stats().residentBytes == 200);
+    CHECK(residency.stats().misses == 1);
+
+    residency.textureUploaded(t1);
+    residency.textureUploaded(t2);
+    CHECK(residency.stats().residentCount == 0);
+    CHECK(residency.stats().residentBytes == 0);
+    CHECK(residency.stats().hits == 1);
+    CHECK(residency.stats().misses == 1);
+    CHECK(residency.stats().evictions == 0);
+  }
+
+  SECTION("evicts least recently loaded pixel data")
+  {
+    residency.setMemoryBudget(250);
+
+    residency.textureLoaded(t1, 100);
+    residency.textureLoaded(t2, 100);
+    residency.textureLoaded(t3, 100);
+
+    CHECK_FALSE(residency.isResident(t1));
+    CHECK(residency.isResident(t2));
+    CHECK(residency.isResident(t3));
+    CHECK(residency.stats().residentBytes == 200);
+    CHECK(residency.stats().evictions == 1);
+  }
+
+  SECTION("evicts when the budget changes")
+  {
+    residency.textureLoaded(t1, 100);
+    residency.textureLoaded(t2, 100);
+
+    residency.setMemoryBudget(150);
+    CHECK(residency.stats().residentCount == 1);
+    CHECK(residency.isResident(t2));
+  }
+
+  SECTION("never evicts requested textures")
+  {
+    residency.setMemoryBudget(50);
+
+    residency.requestTexture(t1);
+    residency.requestTexture(t2);
+    CHECK(residency.isResident(t1));
+    CHECK(residency.isResident(t2));
+    CHECK(residency.stats().evictions == 0);
+
+    residency.textureLoaded(t3, 100);
+    CHECK_FALSE(residency.isResident(t3));
+    CHECK(residency.stats().evictions == 1);
+  }
+
+  SECTION("discards the loader if the texture cannot be loaded")
+  {
+    t1.setLoader([]() { return TextureDecoder{}; });
+    residency.requestTexture(t1);
+
+    CHECK_FALSE(residency.isResident(t1));
+    CHECK(t1.buffersIfUnprepared().empty());
+  }
+
+  SECTION("decodes in the background")
+  {
+    auto mutex = std::mutex{};
+    auto condition = std::condition_variable{};
+    auto callbacks = 0;
+
+    residency.setTexturesDecodedCallback([&]() {
+      const auto lock = std::lock_guard{mutex};
+      ++callbacks;
+      condition.notify_all();
+    });
+
+    residency.requestTexture(t1);
+    residency.requestTexture(t1);
+    CHECK(residency.isDecoding(t1));
+    CHECK(residency.stats().misses == 1);
+
+    {
+      auto lock = std::unique_lock{mutex};
+      condition.wait(lock, [&]() { return callbacks > 0; });
+    }
+
+    residency.textureMoved(t1, t2);
+    CHECK(residency.isDecoding(t2));
+
+    CHECK(residency.commitDecodedTextures() == 1u);
+    CHECK_FALSE(residency.isDecoding(t2));
+    CHECK(residency.isResident(t2));
+    CHECK(t2.buffersIfUnprepared().size() == 1u);
+    CHECK(residency.stats().decodedBytes == 100);
+  }
+
+  SECTION("discards pixel data of released textures")
+  {
+    auto decoded = std::atomic<bool>{false};
+    residency.setTexturesDecodedCallback([&]() { decoded = true; });
+
+    residency.requestTexture(t1);
+    residency.textureReleased(t1);
+    CHECK_FALSE(residency.isDecoding(t1));
+
+    while (!decoded)
+    {
+      std::this_thread::yield();
+    }
+
+    CHECK(residency.commitDecodedTextures() == 0u);
+    CHECK(t1.buffersIfUnprepared().empty());
+  }
+
+  SECTION("cancelDecoding")
+  {
+    residency.setTexturesDecodedCallback([]() {});
+
+    residency.requestTexture(t1);
+    residency.cancelDecoding();
+
+    CHECK_FALSE(residency.isDecoding(t1));
+    CHECK(residency.commitDecodedTextures() == 0u);
+  }
+
+  // the textures were never prepared, so they don't release themselves
+  for (const auto* texture : {&t1, &t2, &t3})
+  {
+    residency.textureReleased(*texture);
+  }
+}
+
+} // namespace TrenchBroom::Assets
@@ -95,6 +95,12 @@ TEST_CASE("DiskFileSystemTest")
     CHECK(fs.makeAbsolute("anotherDir") == env.dir() / "anotherDir");
   }
 
+  SECTION("diskFilePath")
+  {
+    CHECK(fs.diskFilePath("test.txt") == env.dir() / "test.txt");
+    CHECK(fs.diskFilePath("anotherDir/../test.txt") == env.dir() / "test.txt");
+  }
+
   SECTION("pathInfo")
   {
 #if defined _WIN32
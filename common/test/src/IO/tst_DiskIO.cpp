@@ -242,6 +242,46 @@ TEST_CASE("DiskIO")
     CHECK(file.is_success());
   }
 
+  SECTION("mapFile")
+  {
+    CHECK(
+      Disk::mapFile(env.dir() / "does_not_exist.txt")
+      == Result<std::shared_ptr<MappedFile>>{Error{
+        "Failed to open '" + (env.dir() / "does_not_exist.txt").string()
+        + "': path does not denote a file"}});
+    CHECK(
+      Disk::mapFile(env.dir() / "anotherDir")
+      == Result<std::shared_ptr<MappedFile>>{Error{
+        "Failed to open '" + (env.dir() / "anotherDir").string()
+        + "': path does not denote a file"}});
+
+    auto file = Disk::mapFile(env.dir() / "test.txt").value();
+    CHECK(file->size() == 12u);
+    CHECK(file->reader().readString(file->size()) == "some content");
+    CHECK(file->reader().buffer().stringView().data() == file->begin());
+
+    file = Disk::mapFile(env.dir() / "linkedTest2.map").value();
+    CHECK(file->size() == Disk::openFile(env.dir() / "linkedTest2.map").value()->size());
+
+    file = Disk::mapFile(env.dir() / "test.txt").value();
+    CHECK(file->checkUnchanged().is_success());
+
+    auto buffer = file->buffer(5, 7).value();
+    CHECK(buffer->reader().readString(buffer->size()) == "content");
+    CHECK(file->buffer(5, 8).is_error());
+
+    env.createFile("test.txt", "some other content");
+    CHECK(
+      file->checkUnchanged()
+      == Result<void>{
+        Error{"File " + (env.dir() / "test.txt").string() + " was changed on the disk"}});
+    CHECK(file->buffer(5, 7).is_error());
+
+    // the buffer does not refer to the mapped file
+    file.reset();
+    CHECK(buffer->reader().readString(buffer->size()) == "content");
+  }
+
   SECTION("withStream")
   {
     SECTION("withInputStream")
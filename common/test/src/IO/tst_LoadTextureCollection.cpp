@@ -25,6 +25,7 @@
 #include "IO/File.h"
 #include "IO/LoadTextureCollection.h"
 #include "IO/ReadMipTexture.h"
+#include "IO/TextureMetadataCache.h"
 #include "IO/VirtualFileSystem.h"
 #include "IO/WadFileSystem.h"
 #include "Logger.h"
@@ -215,6 +216,49 @@ TEST_CASE("loadTextureCollection")
         },
       });
   }
+
+  SECTION("loading with metadata cache")
+  {
+    const auto textureConfig = Model::TextureConfig{
+      "textures",
+      {".D"},
+      "fixture/test/palette.lmp",
+      "wad",
+      "",
+      {},
+    };
+
+    auto cache = TextureMetadataCache{};
+    const auto loadFirstTexture = [&]() {
+      auto result = loadTextureCollection("textures", fs, textureConfig, logger, &cache);
+      return makeInfo(result).value().textures.front();
+    };
+
+    CHECK(loadFirstTexture() == TextureInfo{"cr8_czg_1", 64, 64});
+    CHECK(cache.size() == 21);
+    CHECK(cache.modified());
+
+    const auto stamp = makeFileStamp(wadPath).value() + "|"
+                       + makeFileStamp("fixture/test/palette.lmp").value();
+    const auto key = wadPath.string() + "|textures/cr8_czg_1.D";
+    auto metadata = cache.get(key, stamp).value();
+    CHECK(metadata.width == 64);
+
+    metadata.width = 32;
+
+    SECTION("cached textures are not decoded again")
+    {
+      cache.put(key, stamp, metadata);
+      CHECK(loadFirstTexture() == TextureInfo{"cr8_czg_1", 32, 64});
+    }
+
+    SECTION("stale entries are replaced")
+    {
+      cache.put(key, "stale", metadata);
+      CHECK(loadFirstTexture() == TextureInfo{"cr8_czg_1", 64, 64});
+      CHECK(cache.get(key, stamp).value().width == 64);
+    }
+  }
 }
 
 } // namespace TrenchBroom::IO
@@ -37,6 +37,7 @@
 
 #include "kdl/result.h"
 #include "kdl/string_compare.h"
+#include "kdl/vector_utils.h"
 
 #include "vm/mat.h"
 #include "vm/mat_ext.h"
@@ -48,6 +49,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "CatchUtils/Matchers.h"
@@ -306,6 +308,147 @@ TEST_CASE("NodeWriterTest.writeWorldspawnWithBrushInDefaultLayer")
   CHECK(actual == expected);
 }
 
+TEST_CASE("NodeWriterTest.writeManyBrushes")
+{
+  // more brushes than the serializer formats in one batch
+  constexpr size_t BrushCount = 10'000;
+
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto map = Model::WorldNode{{}, {}, Model::MapFormat::Standard};
+  auto builder = Model::BrushBuilder{map.mapFormat(), worldBounds};
+
+  auto brushNodes = std::vector<Model::Node*>{};
+  for (size_t i = 0; i < BrushCount; ++i)
+  {
+    auto* brushNode = new Model::BrushNode{
+      builder.createCube(64.0, "texture" + std::to_string(i)).value()};
+    map.defaultLayer()->addChild(brushNode);
+    brushNodes.push_back(brushNode);
+  }
+
+  const auto brushString = [](const size_t brushNo, const size_t textureNo) {
+    return fmt::format(
+      R"(// brush {0}
+{{
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) texture{1} 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) texture{1} 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) texture{1} 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) texture{1} 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) texture{1} 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) texture{1} 0 0 0 1 1
+}}
+)",
+      brushNo,
+      textureNo);
+  };
+
+  auto expected = std::string{R"(// entity 0
+{
+"classname" "worldspawn"
+)"};
+
+  auto str = std::stringstream{};
+  auto writer = NodeWriter{map, str};
+
+  SECTION("Write map")
+  {
+    for (size_t i = 0; i < BrushCount; ++i)
+    {
+      expected += brushString(i, i);
+    }
+    writer.writeMap();
+  }
+
+  SECTION("Write nodes in reverse order")
+  {
+    for (size_t i = 0; i < BrushCount; ++i)
+    {
+      expected += brushString(i, BrushCount - i - 1);
+    }
+    writer.writeNodes(std::vector<Model::Node*>{brushNodes.rbegin(), brushNodes.rend()});
+  }
+
+  expected += "}\n";
+  CHECK(str.str() == expected);
+}
+
+TEST_CASE("NodeWriterTest.writeManyBrushesInGroupWithNestedEntity")
+{
+  // more brushes than the serializer formats in one batch, and the group's brushes are
+  // written before the brushes of the entity which is in between them
+  constexpr size_t BrushCount = 3'000;
+
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto map = Model::WorldNode{{}, {}, Model::MapFormat::Standard};
+  auto builder = Model::BrushBuilder{map.mapFormat(), worldBounds};
+
+  auto* groupNode = new Model::GroupNode{Model::Group{"Group"}};
+  Model::setLinkId(*groupNode, "group_link_id");
+  auto* entityNode =
+    new Model::EntityNode{Model::Entity{{}, {{"classname", "func_detail"}}}};
+  map.defaultLayer()->addChild(groupNode);
+
+  const auto addBrushes = [&](Model::Node& parent, const std::string& textureName) {
+    auto brushNodes = std::vector<const Model::BrushNode*>{};
+    for (size_t i = 0; i < BrushCount; ++i)
+    {
+      auto* brushNode = new Model::BrushNode{
+        builder.createCube(64.0, textureName + std::to_string(i)).value()};
+      parent.addChild(brushNode);
+      brushNodes.push_back(brushNode);
+    }
+    return brushNodes;
+  };
+
+  auto groupBrushNodes = addBrushes(*groupNode, "group_before");
+  groupNode->addChild(entityNode);
+  const auto entityBrushNodes = addBrushes(*entityNode, "entity");
+  groupBrushNodes = kdl::vec_concat(
+    std::move(groupBrushNodes), addBrushes(*groupNode, "group_after"));
+
+  auto str = std::stringstream{};
+  auto writer = NodeWriter{map, str};
+  writer.writeMap();
+
+  // write each brush on its own as a reference
+  const auto brushStrings = [&](const std::vector<const Model::BrushNode*>& brushNodes) {
+    auto result = std::string{};
+    for (size_t i = 0; i < brushNodes.size(); ++i)
+    {
+      auto brushStr = std::stringstream{};
+      NodeWriter{map, brushStr}.writeBrushFaces(brushNodes[i]->brush().faces());
+      result += fmt::format("// brush {}\n{{\n{}}}\n", i, brushStr.str());
+    }
+    return result;
+  };
+
+  const auto expected = fmt::format(
+    R"(// entity 0
+{{
+"classname" "worldspawn"
+}}
+// entity 1
+{{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "Group"
+"_tb_id" "{0}"
+"_tb_linked_group_id" "group_link_id"
+{1}}}
+// entity 2
+{{
+"classname" "func_detail"
+"_tb_group" "{0}"
+{2}}}
+)",
+    *groupNode->persistentId(),
+    brushStrings(groupBrushNodes),
+    brushStrings(entityBrushNodes));
+  CHECK(str.str() == expected);
+}
+
 TEST_CASE("NodeWriterTest.writeWorldspawnWithBrushInCustomLayer")
 {
   const auto worldBounds = vm::bbox3{8192.0};
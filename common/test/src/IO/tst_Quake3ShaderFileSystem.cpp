@@ -20,13 +20,17 @@
 #include "Assets/Quake3Shader.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/File.h"
 #include "IO/Quake3ShaderFileSystem.h"
 #include "IO/TraversalMode.h"
 #include "IO/VirtualFileSystem.h"
 #include "Logger.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <memory>
+#include <set>
+#include <string>
 
 #include "CatchUtils/Matchers.h"
 
@@ -81,6 +85,59 @@ TEST_CASE("Quake3ShaderFileSystemTest.testShaderLinking")
     }));
 }
 
+TEST_CASE("Quake3ShaderFileSystemTest.testShaderLinkingWithDuplicateImageNames")
+{
+  auto logger = NullLogger{};
+
+  // There are two images for the explicit shader and two images for the generated
+  // shader, which only differ by their extension.
+
+  const auto workDir = std::filesystem::current_path();
+  const auto testDir = workDir / "fixture/test/IO/Shader/fs/duplicates";
+  const auto fallbackDir = testDir / "fallback";
+  const auto texturePrefix = std::filesystem::path{"textures"};
+  const auto shaderSearchPath = std::filesystem::path{"scripts"};
+  const auto textureSearchPaths = std::vector<std::filesystem::path>{texturePrefix};
+
+  auto fs = VirtualFileSystem{};
+  fs.mount("", std::make_unique<DiskFileSystem>(fallbackDir));
+  fs.mount("", std::make_unique<DiskFileSystem>(testDir));
+
+  auto shaderFs = createImageFileSystem<Quake3ShaderFileSystem>(
+                    fs, shaderSearchPath, textureSearchPaths, logger)
+                    .value();
+
+  const auto openShader = [&](const auto& path) {
+    auto file = shaderFs->openFile(path).value();
+    const auto* shaderFile =
+      dynamic_cast<const ObjectFile<Assets::Quake3Shader>*>(file.get());
+    REQUIRE(shaderFile != nullptr);
+    return shaderFile->object();
+  };
+
+  const auto explicitShader = openShader(texturePrefix / "test/test");
+  CHECK(explicitShader.shaderPath == texturePrefix / "test/test");
+  CHECK(explicitShader.editorImage == texturePrefix / "test/editor_image.jpg");
+  CHECK(explicitShader.surfaceParms == std::set<std::string>{"noimpact"});
+
+  // the generated shader uses the first image that was found
+  const auto imagePaths =
+    fs.find(
+        texturePrefix,
+        TraversalMode::Recursive,
+        makeExtensionPathMatcher({".tga", ".png", ".jpg", ".jpeg"}))
+      .value();
+  const auto firstImageIt =
+    std::find_if(imagePaths.begin(), imagePaths.end(), [&](const auto& path) {
+      return path.stem() == "generated";
+    });
+  REQUIRE(firstImageIt != imagePaths.end());
+
+  const auto generatedShader = openShader(texturePrefix / "test/generated");
+  CHECK(generatedShader.shaderPath == texturePrefix / "test/generated");
+  CHECK(generatedShader.editorImage == *firstImageIt);
+}
+
 TEST_CASE("Quake3ShaderFileSystemTest.testSkipMalformedFiles")
 {
   auto logger = NullLogger{};
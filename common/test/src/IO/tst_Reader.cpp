@@ -46,6 +46,14 @@ static std::shared_ptr<File> file()
   return result;
 }
 
+static std::shared_ptr<File> mappedFile()
+{
+  static auto result =
+    Disk::mapFile(std::filesystem::current_path() / "fixture/test/IO/Reader/10byte")
+      .value();
+  return result;
+}
+
 static void createEmpty(Reader&& r)
 {
   CHECK(r.size() == 0U);
@@ -72,6 +80,14 @@ TEST_CASE("FileReaderTest.createEmpty")
   createEmpty(emptyFile->reader());
 }
 
+TEST_CASE("MappedFileReaderTest.createEmpty")
+{
+  const auto emptyFile =
+    Disk::mapFile(std::filesystem::current_path() / "fixture/test/IO/Reader/empty")
+      .value();
+  createEmpty(emptyFile->reader());
+}
+
 static void createNonEmpty(Reader&& r)
 {
   CHECK(r.size() == 10U);
@@ -107,6 +123,11 @@ TEST_CASE("FileReaderTest.createNonEmpty")
   createNonEmpty(file()->reader());
 }
 
+TEST_CASE("MappedFileReaderTest.createNonEmpty")
+{
+  createNonEmpty(mappedFile()->reader());
+}
+
 static void seekFromBegin(Reader&& r)
 {
   r.seekFromBegin(0U);
@@ -132,6 +153,11 @@ TEST_CASE("FileReaderTest.seekFromBegin")
   seekFromBegin(file()->reader());
 }
 
+TEST_CASE("MappedFileReaderTest.seekFromBegin")
+{
+  seekFromBegin(mappedFile()->reader());
+}
+
 static void seekFromEnd(Reader&& r)
 {
   r.seekFromEnd(0U);
@@ -226,5 +252,10 @@ TEST_CASE("FileReaderTest.subReader")
 {
   subReader(file()->reader());
 }
+
+TEST_CASE("MappedFileReaderTest.subReader")
+{
+  subReader(mappedFile()->reader());
+}
 } // namespace IO
 } // namespace TrenchBroom
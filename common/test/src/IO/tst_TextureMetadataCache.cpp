@@ -0,0 +1,225 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "IO/DiskIO.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TextureMetadataCache.h"
+#include "Renderer/GL.h"
+
+#include "kdl/result.h"
+
+#include <filesystem>
+#include <iterator>
+#include <string>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::IO
+{
+
+namespace
+{
+const auto opaqueMetadata = TextureMetadata{
+  64,
+  32,
+  Color{0.25f, 0.5f, 0.75f, 1.0f},
+  GL_RGBA,
+  Assets::TextureType::Opaque,
+  std::monostate{},
+};
+
+const auto q2Metadata = TextureMetadata{
+  128,
+  128,
+  Color{0.1f, 0.2f, 0.3f, 0.4f},
+  GL_BGRA,
+  Assets::TextureType::Masked,
+  Assets::Q2Data{1, 2, 3},
+};
+} // namespace
+
+TEST_CASE("TextureMetadataCache")
+{
+  auto cache = TextureMetadataCache{};
+
+  SECTION("get and put")
+  {
+    CHECK(cache.get("a", "1") == std::nullopt);
+    CHECK_FALSE(cache.modified());
+
+    cache.put("a", "1", opaqueMetadata);
+    CHECK(cache.size() == 1);
+    CHECK(cache.modified());
+
+    CHECK(cache.get("a", "1") == opaqueMetadata);
+    CHECK(cache.get("a", "2") == std::nullopt);
+    CHECK(cache.get("b", "1") == std::nullopt);
+
+    cache.put("a", "2", q2Metadata);
+    CHECK(cache.size() == 1);
+    CHECK(cache.get("a", "1") == std::nullopt);
+    CHECK(cache.get("a", "2") == q2Metadata);
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK_FALSE(cache.modified());
+  }
+
+  SECTION("save and load")
+  {
+    auto env = TestEnvironment{};
+    const auto path = env.dir() / "cache.txt";
+
+    cache.put("a", "1", opaqueMetadata);
+    cache.put("b", "2", q2Metadata);
+    REQUIRE(cache.save(path).is_success());
+    CHECK_FALSE(cache.modified());
+
+    auto loadedCache = TextureMetadataCache{};
+    REQUIRE(loadedCache.load(path).is_success());
+    CHECK(loadedCache.size() == 2);
+    CHECK_FALSE(loadedCache.modified());
+    CHECK(loadedCache.get("a", "1") == opaqueMetadata);
+    CHECK(loadedCache.get("b", "1") == std::nullopt);
+
+    SECTION("Entries that were not used are kept when saving")
+    {
+      REQUIRE(loadedCache.save(path).is_success());
+
+      auto reloadedCache = TextureMetadataCache{};
+      REQUIRE(reloadedCache.load(path).is_success());
+      CHECK(reloadedCache.size() == 2);
+    }
+
+    SECTION("Entries saved by another cache are merged")
+    {
+      auto otherCache = TextureMetadataCache{};
+      otherCache.put("c", "3", opaqueMetadata);
+      otherCache.put("a", "4", q2Metadata);
+      REQUIRE(otherCache.save(path).is_success());
+
+      loadedCache.put("d", "5", q2Metadata);
+      REQUIRE(loadedCache.save(path).is_success());
+
+      auto reloadedCache = TextureMetadataCache{};
+      REQUIRE(reloadedCache.load(path).is_success());
+      CHECK(reloadedCache.size() == 4);
+      // both entries for "a" were used today, so the entry saved last wins
+      CHECK(reloadedCache.get("a", "1") == opaqueMetadata);
+      CHECK(reloadedCache.get("b", "2") == q2Metadata);
+      CHECK(reloadedCache.get("c", "3") == opaqueMetadata);
+      CHECK(reloadedCache.get("d", "5") == q2Metadata);
+    }
+
+    SECTION("No temporary files are left behind")
+    {
+      CHECK(
+        std::distance(
+          std::filesystem::directory_iterator{env.dir()},
+          std::filesystem::directory_iterator{})
+        == 1);
+    }
+  }
+
+  SECTION("Entries that were not used for a long time are dropped when saving")
+  {
+    auto env = TestEnvironment{};
+    env.createFile(
+      "cache.txt",
+      "TrenchBroom texture metadata cache 2\n"
+      "a\t1\t0\t64\t32\t0.25\t0.5\t0.75\t1\t6408\t0\t-\n");
+    const auto path = env.dir() / "cache.txt";
+
+    REQUIRE(cache.load(path).is_success());
+    CHECK(cache.get("a", "1") == opaqueMetadata);
+
+    auto otherCache = TextureMetadataCache{};
+    otherCache.put("b", "2", q2Metadata);
+    REQUIRE(otherCache.save(path).is_success());
+
+    auto reloadedCache = TextureMetadataCache{};
+    REQUIRE(reloadedCache.load(path).is_success());
+    CHECK(reloadedCache.size() == 1);
+    CHECK(reloadedCache.get("b", "2") == q2Metadata);
+
+    SECTION("Using an entry renews it")
+    {
+      REQUIRE(cache.save(path).is_success());
+      REQUIRE(reloadedCache.load(path).is_success());
+      CHECK(reloadedCache.size() == 2);
+      CHECK(reloadedCache.get("a", "1") == opaqueMetadata);
+    }
+  }
+
+  SECTION("load malformed files")
+  {
+    auto env = TestEnvironment{};
+    cache.put("a", "1", opaqueMetadata);
+
+    const auto contents = GENERATE(
+      std::string{},
+      std::string{"some other file\n"},
+      std::string{"TrenchBroom texture metadata cache 1\n"
+                  "a\t1\t64\t32\t0.25\t0.5\t0.75\t1\t6408\t0\t-\n"},
+      std::string{"TrenchBroom texture metadata cache 2\n"
+                  "a\t1\t0\t64\t32\t0.25\t0.5\t0.75\t1\t6408\t0\n"},
+      std::string{"TrenchBroom texture metadata cache 2\n"
+                  "a\t1\t0\t0\t32\t0.25\t0.5\t0.75\t1\t6408\t0\t-\n"},
+      std::string{"TrenchBroom texture metadata cache 2\n"
+                  "a\t1\t0\t64\t32\t0.25\t0.5\t0.75\t1\t6408\t2\t-\n"},
+      std::string{"TrenchBroom texture metadata cache 2\n"
+                  "a\t1\tx\t64\t32\t0.25\t0.5\t0.75\t1\t6408\t0\t-\n"},
+      std::string{"TrenchBroom texture metadata cache 2\n"
+                  "a\t1\t0\t64\t32\t0.25\t0.5\t0.75\t1\t6408\t0\tq2\t1\t2\n"});
+
+    CAPTURE(contents);
+
+    env.withTempFile(contents, [&](const auto& path) {
+      CHECK(cache.load(path).is_error());
+      // a failed load does not modify the cache
+      CHECK(cache.get("a", "1") == opaqueMetadata);
+    });
+  }
+}
+
+TEST_CASE("makeFileStamp")
+{
+  auto env = TestEnvironment{};
+  env.createFile("file.txt", "some content");
+
+  const auto stamp = makeFileStamp(env.dir() / "file.txt");
+  CHECK(stamp.is_success());
+  CHECK(stamp == makeFileStamp(env.dir() / "file.txt"));
+
+  env.createFile("file.txt", "some other content");
+  CHECK(makeFileStamp(env.dir() / "file.txt") != stamp);
+
+  CHECK(makeFileStamp(env.dir() / "missing.txt").is_error());
+}
+
+TEST_CASE("createTexture")
+{
+  const auto texture = createTexture("texture", q2Metadata);
+  CHECK(texture.name() == "texture");
+  CHECK(getTextureMetadata(texture) == q2Metadata);
+  CHECK(texture.buffersIfUnprepared().empty());
+}
+
+} // namespace TrenchBroom::IO
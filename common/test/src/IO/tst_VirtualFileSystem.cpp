@@ -19,6 +19,7 @@
 
 #include "Error.h"
 #include "IO/File.h"
+#include "IO/ImageFileSystem.h"
 #include "IO/TestFileSystem.h"
 #include "IO/TraversalMode.h"
 #include "IO/VirtualFileSystem.h"
@@ -28,12 +29,39 @@
 #include "kdl/result.h"
 #include "kdl/result_io.h"
 
+#include <tuple>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
 {
 namespace IO
 {
+namespace
+{
+class TestImageFileSystem : public ImageFileSystemBase
+{
+public:
+  std::vector<std::tuple<std::filesystem::path, std::shared_ptr<File>>> files;
+
+  explicit TestImageFileSystem(
+    std::vector<std::tuple<std::filesystem::path, std::shared_ptr<File>>> files_)
+    : files{std::move(files_)}
+  {
+  }
+
+private:
+  Result<void> doReadDirectory() override
+  {
+    for (const auto& [path, file] : files)
+    {
+      addFile(path, [file = file]() -> Result<std::shared_ptr<File>> { return file; });
+    }
+    return kdl::void_success;
+  }
+};
+} // namespace
 
 TEST_CASE("VirtualFileSystem")
 {
@@ -519,5 +547,90 @@ TEST_CASE("VirtualFileSystem")
   }
 }
 
+
+TEST_CASE("VirtualFileSystem with image file systems")
+{
+  auto fs1_textures_a = makeObjectFile(1);
+  auto fs1_pics_tag = makeObjectFile(2);
+  auto fs2_textures_a = makeObjectFile(3);
+  auto fs3_textures_b = makeObjectFile(4);
+  auto fs4_x = makeObjectFile(5);
+
+  auto vfs = VirtualFileSystem{};
+
+  auto fs1 = createImageFileSystem<TestImageFileSystem>(
+               std::vector<std::tuple<std::filesystem::path, std::shared_ptr<File>>>{
+                 {"textures/A.tga", fs1_textures_a},
+                 {"pics/tag.pcx", fs1_pics_tag},
+               })
+               .value();
+  auto* fs1Ptr = fs1.get();
+  vfs.mount("", std::move(fs1));
+
+  // not indexed, so it must still be checked before fs1
+  vfs.mount(
+    "",
+    std::make_unique<TestFileSystem>(Entry{DirectoryEntry{
+      "",
+      {
+        DirectoryEntry{"textures", {FileEntry{"a.tga", fs2_textures_a}}},
+      }}}));
+
+  const auto fs3Id = vfs.mount(
+    "",
+    createImageFileSystem<TestImageFileSystem>(
+      std::vector<std::tuple<std::filesystem::path, std::shared_ptr<File>>>{
+        {"Textures/b.tga", fs3_textures_b},
+      })
+      .value());
+
+  vfs.mount(
+    "sub/dir",
+    createImageFileSystem<TestImageFileSystem>(
+      std::vector<std::tuple<std::filesystem::path, std::shared_ptr<File>>>{
+        {"x", fs4_x},
+      })
+      .value());
+
+  CHECK(vfs.pathInfo("textures") == PathInfo::Directory);
+  CHECK(vfs.pathInfo("TEXTURES") == PathInfo::Directory);
+  CHECK(vfs.pathInfo("pics/TAG.pcx") == PathInfo::File);
+  CHECK(vfs.pathInfo("sub") == PathInfo::Directory);
+  CHECK(vfs.pathInfo("sub/dir") == PathInfo::Directory);
+  CHECK(vfs.pathInfo("SUB/Dir/X") == PathInfo::File);
+  CHECK(vfs.pathInfo("x") == PathInfo::Unknown);
+
+  CHECK(vfs.openFile("textures/a.tga") == Result<std::shared_ptr<File>>{fs2_textures_a});
+  CHECK(vfs.openFile("textures/A.tga") == Result<std::shared_ptr<File>>{fs1_textures_a});
+  CHECK(vfs.openFile("textures/b.tga") == Result<std::shared_ptr<File>>{fs3_textures_b});
+  CHECK(vfs.openFile("pics/tag.pcx") == Result<std::shared_ptr<File>>{fs1_pics_tag});
+  CHECK(vfs.openFile("sub/dir/x") == Result<std::shared_ptr<File>>{fs4_x});
+
+  SECTION("unmount")
+  {
+    REQUIRE(vfs.unmount(fs3Id));
+
+    CHECK(vfs.pathInfo("textures/b.tga") == PathInfo::Unknown);
+    CHECK(
+      vfs.openFile("textures/A.tga") == Result<std::shared_ptr<File>>{fs1_textures_a});
+    CHECK(vfs.openFile("sub/dir/x") == Result<std::shared_ptr<File>>{fs4_x});
+  }
+
+  SECTION("reload")
+  {
+    auto fs1_pics_new = makeObjectFile(6);
+    fs1Ptr->files = {{"pics/new.pcx", fs1_pics_new}};
+    REQUIRE(fs1Ptr->reload().is_success());
+
+    CHECK(vfs.pathInfo("pics/tag.pcx") == PathInfo::Unknown);
+    CHECK(vfs.pathInfo("textures/b.tga") == PathInfo::File);
+
+    vfs.updateIndex();
+
+    CHECK(vfs.pathInfo("pics/tag.pcx") == PathInfo::Unknown);
+    CHECK(vfs.openFile("pics/new.pcx") == Result<std::shared_ptr<File>>{fs1_pics_new});
+  }
+}
+
 } // namespace IO
 } // namespace TrenchBroom
@@ -383,6 +383,63 @@ TEST_CASE("WorldReader.parseBrushWithCurlyBraceInTextureName")
     != nullptr);
 }
 
+TEST_CASE("WorldReader.parseBrushWithQuotedTextureNames")
+{
+  const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) "with space" 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) "with \"escaped\" quotes" 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) "" 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) unquoted 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) "quoted" 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) unquoted 0 0 0 1 1
+}
+})";
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{data, Model::MapFormat::Standard, {}};
+
+  auto world = reader.read(worldBounds, status);
+
+  CHECK(world->childCount() == 1u);
+  auto* defaultLayer = world->children().front();
+  CHECK(defaultLayer->childCount() == 1u);
+
+  auto* brushNode = static_cast<Model::BrushNode*>(defaultLayer->children().front());
+  const auto& faces = brushNode->brush().faces();
+  CHECK(faces.size() == 6u);
+
+  const auto textureName = [&](const auto& p1, const auto& p2, const auto& p3) {
+    const auto* face = findFaceByPoints(faces, p1, p2, p3);
+    REQUIRE(face != nullptr);
+    return face->attributes().textureName();
+  };
+
+  CHECK(
+    textureName(
+      vm::vec3{0.0, 0.0, -16.0}, vm::vec3{0.0, 0.0, 0.0}, vm::vec3{64.0, 0.0, -16.0})
+    == "with space");
+  CHECK(
+    textureName(
+      vm::vec3{0.0, 0.0, -16.0}, vm::vec3{0.0, 64.0, -16.0}, vm::vec3{0.0, 0.0, 0.0})
+    == "with \"escaped\" quotes");
+  CHECK(
+    textureName(
+      vm::vec3{0.0, 0.0, -16.0}, vm::vec3{64.0, 0.0, -16.0}, vm::vec3{0.0, 64.0, -16.0})
+    == "");
+  CHECK(
+    textureName(
+      vm::vec3{64.0, 64.0, 0.0}, vm::vec3{0.0, 64.0, 0.0}, vm::vec3{64.0, 64.0, -16.0})
+    == "unquoted");
+  CHECK(
+    textureName(
+      vm::vec3{64.0, 64.0, 0.0}, vm::vec3{64.0, 64.0, -16.0}, vm::vec3{64.0, 0.0, 0.0})
+    == "quoted");
+}
+
 TEST_CASE("WorldReader.parseValveBrush")
 {
   const auto data = R"(
@@ -1966,4 +2023,236 @@ TEST_CASE("WorldReader.parseUnknownFormatEmptyMap")
   CHECK(world->mapFormat() == Model::MapFormat::Standard);
 }
 
+TEST_CASE("WorldReader.splitIntoChunks")
+{
+  const auto data = R"({
+"classname" "worldspawn"
+"message" "{ not a brace }"
+// { not a brace
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) {water 1 2 3 4 5
+}
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+}
+}
+{
+"classname" "info_player_start"
+}
+)"s;
+
+  SECTION("Splits after every brush and entity if the chunk size is small")
+  {
+    const auto chunks = splitIntoChunks(data, 1);
+    REQUIRE(chunks.size() == 5u);
+
+    CHECK(chunks[0].line == 1u);
+    CHECK_FALSE(chunks[0].beginsInsideEntity);
+
+    CHECK(chunks[1].line == 7u);
+    CHECK(chunks[1].column == 2u);
+    CHECK(chunks[1].beginsInsideEntity);
+
+    CHECK(chunks[2].line == 10u);
+    CHECK(chunks[2].beginsInsideEntity);
+
+    CHECK(chunks[3].line == 11u);
+    CHECK_FALSE(chunks[3].beginsInsideEntity);
+
+    CHECK(chunks[4].line == 14u);
+    CHECK_FALSE(chunks[4].beginsInsideEntity);
+
+    auto joined = std::string{};
+    for (const auto& chunk : chunks)
+    {
+      joined += chunk.str;
+    }
+    CHECK(joined == data);
+  }
+
+  SECTION("Does not split an entity if a property follows the split")
+  {
+    const auto entityData = R"({
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+}
+"classname" "duplicate"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+}
+}
+{
+"classname" "info_player_start"
+}
+)"s;
+
+    const auto chunks = splitIntoChunks(entityData, 1);
+    REQUIRE(chunks.size() == 3u);
+
+    CHECK(chunks[0].line == 1u);
+    CHECK_FALSE(chunks[0].beginsInsideEntity);
+
+    CHECK(chunks[1].line == 10u);
+    CHECK_FALSE(chunks[1].beginsInsideEntity);
+
+    CHECK(chunks[2].line == 13u);
+    CHECK_FALSE(chunks[2].beginsInsideEntity);
+  }
+
+  SECTION("Does not split if the chunk size is large")
+  {
+    CHECK(splitIntoChunks(data, data.size()).size() == 1u);
+  }
+
+  SECTION("Does not split unbalanced input")
+  {
+    CHECK(splitIntoChunks("{\n{\n}\n", 1).size() == 1u);
+    CHECK(splitIntoChunks("{\n}\n}\n", 1).size() == 1u);
+    CHECK(splitIntoChunks("{\n\"unterminated }\n", 1).size() == 1u);
+  }
+}
+
+TEST_CASE("WorldReader.parseInChunksWithDuplicatePropertiesAfterBrushes")
+{
+  const auto data = R"(
+{
+"classname" "worldspawn"
+"message" "yay"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1 1
+}
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1 1
+}
+"message" "nay"
+}
+)";
+
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto parserChunkCount = GENERATE(1u, 2u, 3u, 100u);
+
+  CAPTURE(parserChunkCount);
+
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{data, Model::MapFormat::Standard, {}};
+  reader.setParserChunkCount(parserChunkCount);
+
+  auto world = reader.read(worldBounds, status);
+  REQUIRE(world != nullptr);
+  CHECK(*world->entity().property("message") == "yay");
+  CHECK(world->defaultLayer()->childCount() == 2u);
+  CHECK(status.countStatus(LogLevel::Warn) == 1u);
+}
+
+TEST_CASE("WorldReader.parseInChunks")
+{
+  const auto data = R"(
+{
+"classname" "worldspawn"
+"message" "yay"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1 1
+}
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1 1
+}
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "some group"
+"_tb_id" "1"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1 1
+}
+}
+{
+"classname" "func_door"
+"_tb_group" "1"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1 1
+}
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 1 2 3 4 5
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1 1
+}
+}
+)";
+
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto parserChunkCount = GENERATE(1u, 2u, 3u, 5u, 100u);
+
+  CAPTURE(parserChunkCount);
+
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{data, Model::MapFormat::Standard, {}};
+  reader.setParserChunkCount(parserChunkCount);
+
+  auto world = reader.read(worldBounds, status);
+  REQUIRE(world != nullptr);
+  CHECK(*world->entity().property("message") == "yay");
+
+  auto* defaultLayer = world->defaultLayer();
+  REQUIRE(defaultLayer->childCount() == 3u);
+
+  auto* brushNode1 = dynamic_cast<Model::BrushNode*>(defaultLayer->children()[0]);
+  REQUIRE(brushNode1 != nullptr);
+  CHECK(brushNode1->lineNumber() == 5u);
+  CHECK(brushNode1->containsLine(11u));
+  CHECK_FALSE(brushNode1->containsLine(12u));
+
+  auto* brushNode2 = dynamic_cast<Model::BrushNode*>(defaultLayer->children()[1]);
+  REQUIRE(brushNode2 != nullptr);
+  CHECK(brushNode2->lineNumber() == 13u);
+  CHECK(brushNode2->brush().faces().front().lineNumber() == 14u);
+
+  auto* groupNode = dynamic_cast<Model::GroupNode*>(defaultLayer->children()[2]);
+  REQUIRE(groupNode != nullptr);
+  CHECK(groupNode->lineNumber() == 22u);
+  REQUIRE(groupNode->childCount() == 2u);
+
+  auto* entityNode = dynamic_cast<Model::EntityNode*>(groupNode->children()[1]);
+  REQUIRE(entityNode != nullptr);
+  CHECK(entityNode->lineNumber() == 36u);
+  CHECK(entityNode->containsLine(54u));
+  CHECK_FALSE(entityNode->containsLine(55u));
+  REQUIRE(entityNode->childCount() == 2u);
+  CHECK(entityNode->children()[1]->lineNumber() == 47u);
+}
+
 } // namespace TrenchBroom::IO
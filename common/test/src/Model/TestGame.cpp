@@ -154,10 +154,14 @@ Result<std::unique_ptr<WorldNode>> TestGame::doLoadMap(
 Result<void> TestGame::doWriteMap(
   WorldNode& world, const std::filesystem::path& path) const
 {
-  return IO::Disk::withOutputStream(path, [&](auto& stream) {
-    IO::NodeWriter writer(world, stream);
-    writer.writeMap();
-  });
+  return IO::Disk::withOutputStream(
+    path, [&](auto& stream) { doWriteMapToStream(world, stream); });
+}
+
+void TestGame::doWriteMapToStream(WorldNode& world, std::ostream& stream) const
+{
+  IO::NodeWriter writer(world, stream);
+  writer.writeMap();
 }
 
 Result<void> TestGame::doExportMap(
@@ -47,6 +47,7 @@
 
 #include <fstream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "Catch2.h"
@@ -287,6 +288,144 @@ TEST_CASE("BrushTest.contractToZero")
   CHECK(brush1.expand(worldBounds, -64, true).is_error());
 }
 
+TEST_CASE("BrushTest.transform")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brush = builder
+                 .createBrush(
+                   std::vector<vm::vec3>{
+                     {64, -64, 16},
+                     {64, 64, 16},
+                     {64, -64, -16},
+                     {64, 64, -16},
+                     {48, 64, 16},
+                     {48, 64, -16}},
+                   "texture")
+                 .value();
+
+  using T = std::tuple<vm::mat4x4, std::vector<vm::vec3>>;
+
+  // clang-format off
+  const auto
+  [transformation,                                                 expectedVertices] = GENERATE(values<T>({
+  {vm::translation_matrix(vm::vec3{16, 32, 8}),                    {{80, -32, 24}, {80, 96, 24}, {80, -32, -8}, {80, 96, -8}, {64, 96, 24}, {64, 96, -8}}},
+  {vm::translation_matrix(vm::vec3{0.5, 0, 0}),                    {{64.5, -64, 16}, {64.5, 64, 16}, {64.5, -64, -16}, {64.5, 64, -16}, {48.5, 64, 16}, {48.5, 64, -16}}},
+  {vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0)),            {{64, 64, 16}, {-64, 64, 16}, {64, 64, -16}, {-64, 64, -16}, {-64, 48, 16}, {-64, 48, -16}}},
+  {vm::rotation_matrix(vm::to_radians(180.0), 0.0, 0.0),           {{64, 64, -16}, {64, -64, -16}, {64, 64, 16}, {64, -64, 16}, {48, -64, -16}, {48, -64, 16}}},
+  {vm::scaling_matrix(vm::vec3{2, 1, 1}),                          {{128, -64, 16}, {128, 64, 16}, {128, -64, -16}, {128, 64, -16}, {96, 64, 16}, {96, 64, -16}}},
+  {vm::mirror_matrix<double>(vm::axis::x),                         {{-64, -64, 16}, {-64, 64, 16}, {-64, -64, -16}, {-64, 64, -16}, {-48, 64, 16}, {-48, 64, -16}}},
+  }));
+  // clang-format on
+
+  CAPTURE(transformation);
+
+  REQUIRE(brush.transform(worldBounds, transformation, false).is_success());
+  CHECK_THAT(brush.vertexPositions(), Catch::UnorderedEquals(expectedVertices));
+
+  // the result must be the same as if the brush was built from the transformed faces
+  const auto rebuiltBrush = Brush::create(worldBounds, brush.faces()).value();
+  CHECK(brush.bounds() == rebuiltBrush.bounds());
+  CHECK_THAT(
+    brush.vertexPositions(), Catch::UnorderedEquals(rebuiltBrush.vertexPositions()));
+
+  for (const auto& face : brush.faces())
+  {
+    CHECK(face.geometry()->plane() == face.boundary());
+  }
+}
+
+TEST_CASE("BrushTest.transformFastPathMatchesRebuild")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  const auto brush = builder
+                       .createBrush(
+                         std::vector<vm::vec3>{
+                           {64, -64, 16},
+                           {64, 64, 16},
+                           {64, -64, -16},
+                           {64, 64, -16},
+                           {48, 64, 16},
+                           {48, 64, -16}},
+                         "texture")
+                       .value();
+
+  // clang-format off
+  const auto transformation = GENERATE(values<vm::mat4x4>({
+    vm::translation_matrix(vm::vec3{16, 32, 8}),
+    vm::mat4x4{0, -1, 0, 0,
+               1,  0, 0, 0,
+               0,  0, 1, 0,
+               0,  0, 0, 1},
+    vm::mat4x4{1,  0,  0, 16,
+               0, -1,  0,  0,
+               0,  0, -1,  0,
+               0,  0,  0,  1},
+    vm::mat4x4{0, 0, 1, 0,
+               0, 1, 0, 0,
+              -1, 0, 0, 0,
+               0, 0, 0, 1},
+  }));
+  // clang-format on
+
+  CAPTURE(transformation);
+
+  auto transformedBrush = brush;
+  REQUIRE(transformedBrush.transform(worldBounds, transformation, false).is_success());
+
+  // rebuild the brush from the transformed faces as Brush::transform does for other
+  // transformations
+  auto transformedFaces = brush.faces();
+  for (auto& face : transformedFaces)
+  {
+    REQUIRE(face.transform(transformation, false).is_success());
+  }
+  const auto rebuiltBrush = Brush::create(worldBounds, transformedFaces).value();
+
+  CHECK(transformedBrush == rebuiltBrush);
+  CHECK_THAT(
+    transformedBrush.vertexPositions(),
+    Catch::UnorderedEquals(rebuiltBrush.vertexPositions()));
+  CHECK(transformedBrush.canRebuildGeometryExactly());
+}
+
+TEST_CASE("BrushTest.canRebuildGeometryExactly")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brush = builder.createCube(64.0, "texture").value();
+  CHECK(brush.canRebuildGeometryExactly());
+  CHECK_FALSE(Brush{}.canRebuildGeometryExactly());
+
+  // the geometry of an off grid brush is transformed directly, and rebuilding it from the
+  // transformed face planes yields slightly different vertex positions
+  REQUIRE(
+    brush.transform(worldBounds, vm::translation_matrix(vm::vec3{0.1, 0.2, 0.3}), false)
+      .is_success());
+  CHECK_FALSE(brush.canRebuildGeometryExactly());
+
+  const auto copy = brush;
+  CHECK_FALSE(copy.canRebuildGeometryExactly());
+
+  // rebuilding the geometry from the faces makes it exact again
+  REQUIRE(brush.expand(worldBounds, 8.0, false).is_success());
+  CHECK(brush.canRebuildGeometryExactly());
+}
+
+TEST_CASE("BrushTest.transformPastWorldBounds")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brush = builder.createCube(64.0, "texture").value();
+  CHECK(brush.transform(worldBounds, vm::translation_matrix(vm::vec3{8192, 0, 0}), false)
+          .is_error());
+}
+
 TEST_CASE("BrushTest.moveVertex")
 {
   const vm::bbox3 worldBounds(4096.0);
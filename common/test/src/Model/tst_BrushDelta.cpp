@@ -0,0 +1,124 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushDelta.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/MapFormat.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Model
+{
+
+TEST_CASE("BrushDeltaTest.restore")
+{
+  const auto worldBounds = vm::bbox3{4096.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  const auto original = builder.createCube(64.0, "texture").value();
+
+  SECTION("Translated brush")
+  {
+    auto translated = original;
+    REQUIRE(translated
+              .transform(worldBounds, vm::translation_matrix(vm::vec3{16, 0, 0}), false)
+              .is_success());
+
+    const auto delta = BrushDelta{original.faces(), translated.faces()};
+    CHECK(delta.restore(worldBounds, translated.faces()).value() == original);
+  }
+
+  SECTION("Changed face attributes")
+  {
+    auto changed = original;
+    changed.face(0).setAttributes(
+      BrushFaceAttributes{"other", changed.face(0).attributes()});
+
+    const auto delta = BrushDelta{original.faces(), changed.faces()};
+    const auto reverseDelta = BrushDelta{changed.faces(), original.faces()};
+
+    CHECK(delta.restore(worldBounds, changed.faces()).value() == original);
+    CHECK(reverseDelta.restore(worldBounds, original.faces()).value() == changed);
+
+    // only the changed attributes are stored
+    const auto unchangedDelta = BrushDelta{original.faces(), original.faces()};
+    CHECK(unchangedDelta.memoryUsage() < delta.memoryUsage());
+  }
+
+  SECTION("Different number of faces")
+  {
+    const auto wedge = builder
+                         .createBrush(
+                           {
+                             {-32, -32, -32},
+                             {+32, -32, -32},
+                             {-32, +32, -32},
+                             {-32, -32, +32},
+                             {+32, -32, +32},
+                             {-32, +32, +32},
+                           },
+                           "wedge")
+                         .value();
+    REQUIRE(wedge.faceCount() < original.faceCount());
+
+    CHECK(
+      BrushDelta{original.faces(), wedge.faces()}.restore(worldBounds, wedge.faces())
+      == Result<Brush>{original});
+    CHECK(
+      BrushDelta{wedge.faces(), original.faces()}.restore(worldBounds, original.faces())
+      == Result<Brush>{wedge});
+  }
+}
+
+TEST_CASE("BrushDeltaTest.rebase")
+{
+  const auto worldBounds = vm::bbox3{4096.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  const auto brush0 = builder.createCube(64.0, "texture").value();
+
+  auto brush1 = brush0;
+  brush1.face(1).setAttributes(BrushFaceAttributes{"other", brush1.face(1).attributes()});
+
+  auto brush2 = brush1;
+  REQUIRE(brush2
+            .transform(worldBounds, vm::translation_matrix(vm::vec3{0, 16, 0}), false)
+            .is_success());
+
+  const auto delta01 = BrushDelta{brush0.faces(), brush1.faces()};
+  const auto delta12 = BrushDelta{brush1.faces(), brush2.faces()};
+
+  const auto delta02 = delta01.rebase(delta12);
+  CHECK(delta02.restore(worldBounds, brush2.faces()).value() == brush0);
+}
+
+} // namespace TrenchBroom::Model
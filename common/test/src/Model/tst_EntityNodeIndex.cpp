@@ -93,6 +93,38 @@ TEST_CASE("EntityNodeIndexTest.removeEntityNode")
   delete entity2;
 }
 
+TEST_CASE("EntityNodeIndexTest.rebuild")
+{
+  auto index = EntityNodeIndex{};
+
+  auto entity1 = EntityNode{{}, {{"test", "somevalue"}}};
+  auto entity2 = EntityNode{{}, {{"test", "somevalue"}, {"other", "someothervalue"}}};
+  auto entity3 = EntityNode{{}, {{"test", "yetanothervalue"}}};
+
+  index.addEntityNode(&entity3);
+  index.rebuild({&entity1, &entity2});
+
+  CHECK(findExactExact(index, "test", "yetanothervalue").empty());
+  CHECK_THAT(
+    findExactExact(index, "test", "somevalue"),
+    Catch::UnorderedEquals(std::vector<EntityNodeBase*>{&entity1, &entity2}));
+  CHECK_THAT(
+    findExactExact(index, "other", "someothervalue"),
+    Catch::UnorderedEquals(std::vector<EntityNodeBase*>{&entity2}));
+
+  index.removeEntityNode(&entity1);
+  index.addEntityNode(&entity3);
+
+  CHECK_THAT(
+    findExactExact(index, "test", "somevalue"),
+    Catch::UnorderedEquals(std::vector<EntityNodeBase*>{&entity2}));
+  CHECK_THAT(
+    findExactExact(index, "test", "yetanothervalue"),
+    Catch::UnorderedEquals(std::vector<EntityNodeBase*>{&entity3}));
+  CHECK_THAT(
+    index.allKeys(), Catch::UnorderedEquals(std::vector<std::string>{"test", "other"}));
+}
+
 TEST_CASE("EntityNodeIndexTest.addProperty")
 {
   EntityNodeIndex index;
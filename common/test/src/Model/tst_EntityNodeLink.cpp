@@ -145,6 +145,49 @@ TEST_CASE("EntityNodeLinkTest.testLoadLink")
   CHECK(targetNode->linkTargets().empty());
 }
 
+TEST_CASE("EntityNodeLinkTest.testLoadLinkWithBulkIndex")
+{
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  worldNode.disableEntityNodeIndexUpdates();
+
+  auto* sourceNode = new EntityNode(Entity{
+    {}, {{EntityPropertyKeys::Target, "a"}, {EntityPropertyKeys::Killtarget, "a"}}});
+  auto* targetNode = new EntityNode(Entity{{}, {{EntityPropertyKeys::Targetname, "a"}}});
+
+  worldNode.defaultLayer()->addChild(sourceNode);
+  worldNode.defaultLayer()->addChild(targetNode);
+
+  CHECK(sourceNode->linkTargets().empty());
+  CHECK(targetNode->linkSources().empty());
+
+  worldNode.rebuildEntityNodeIndex();
+  worldNode.enableEntityNodeIndexUpdates();
+
+  CHECK(sourceNode->linkSources().empty());
+  CHECK_THAT(
+    sourceNode->linkTargets(),
+    Catch::UnorderedEquals(std::vector<EntityNodeBase*>{targetNode}));
+  CHECK_THAT(
+    sourceNode->killTargets(),
+    Catch::UnorderedEquals(std::vector<EntityNodeBase*>{targetNode}));
+
+  CHECK_THAT(
+    targetNode->linkSources(),
+    Catch::UnorderedEquals(std::vector<EntityNodeBase*>{sourceNode}));
+  CHECK_THAT(
+    targetNode->killSources(),
+    Catch::UnorderedEquals(std::vector<EntityNodeBase*>{sourceNode}));
+  CHECK(targetNode->linkTargets().empty());
+
+  auto* otherSourceNode =
+    new EntityNode(Entity{{}, {{EntityPropertyKeys::Target, "a"}}});
+  worldNode.defaultLayer()->addChild(otherSourceNode);
+
+  CHECK_THAT(
+    targetNode->linkSources(),
+    Catch::UnorderedEquals(std::vector<EntityNodeBase*>{sourceNode, otherSourceNode}));
+}
+
 TEST_CASE("EntityNodeLinkTest.testCreateLinkByChangingSource")
 {
   auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
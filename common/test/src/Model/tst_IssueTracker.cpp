@@ -0,0 +1,122 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/EmptyGroupValidator.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/Issue.h"
+#include "Model/IssueTracker.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/NonIntegerVerticesValidator.h"
+#include "Model/WorldNode.h"
+
+#include "kdl/result.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
+
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Model
+{
+
+TEST_CASE("IssueTracker")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  worldNode.registerValidator(std::make_unique<EmptyGroupValidator>());
+  worldNode.registerValidator(std::make_unique<NonIntegerVerticesValidator>());
+  const auto validators = worldNode.registeredValidators();
+
+  auto& issueTracker = worldNode.issueTracker();
+
+  const auto getNodes = [](const std::vector<const Issue*>& issues) {
+    return kdl::vec_transform(
+      issues, [](const auto* issue) { return const_cast<const Node*>(&issue->node()); });
+  };
+
+  auto* groupNode = new GroupNode{Group{"group"}};
+  worldNode.defaultLayer()->addChild(groupNode);
+
+  REQUIRE(issueTracker.hasDirtyNodes());
+  CHECK(
+    getNodes(issueTracker.validate(validators)) == std::vector<const Node*>{groupNode});
+  CHECK(!issueTracker.hasDirtyNodes());
+  CHECK(issueTracker.takeInvalidatedNodes().empty());
+  CHECK(getNodes(issueTracker.issues()) == std::vector<const Node*>{groupNode});
+
+  SECTION("Validating without changes returns no issues")
+  {
+    CHECK(issueTracker.validate(validators).empty());
+    CHECK(getNodes(issueTracker.issues()) == std::vector<const Node*>{groupNode});
+  }
+
+  SECTION("Adding nodes only validates the changed nodes")
+  {
+    const auto builder = BrushBuilder{worldNode.mapFormat(), worldBounds};
+    auto* brushNode = new BrushNode{builder.createCube(64.0, "texture").value()};
+    auto* otherBrushNode = new BrushNode{
+      builder.createCuboid(vm::bbox3{{0, 0, 0}, {1.5, 1.5, 1.5}}, "texture").value()};
+
+    groupNode->addChild(brushNode);
+
+    CHECK(issueTracker.takeInvalidatedNodes() == std::vector<const Node*>{groupNode});
+    CHECK(issueTracker.validate(validators).empty());
+    CHECK(issueTracker.issues().empty());
+
+    worldNode.defaultLayer()->addChild(otherBrushNode);
+
+    CHECK(issueTracker.takeInvalidatedNodes().empty());
+    CHECK(
+      getNodes(issueTracker.validate(validators))
+      == std::vector<const Node*>{otherBrushNode});
+  }
+
+  SECTION("Removing nodes reports their issues as invalidated")
+  {
+    auto groupNodePtr = std::unique_ptr<Node>{groupNode};
+    worldNode.defaultLayer()->removeChild(groupNode);
+
+    CHECK(issueTracker.takeInvalidatedNodes() == std::vector<const Node*>{groupNode});
+    CHECK(issueTracker.validate(validators).empty());
+    CHECK(issueTracker.issues().empty());
+  }
+
+  SECTION("Registering a validator revalidates all nodes")
+  {
+    worldNode.registerValidator(std::make_unique<EmptyGroupValidator>());
+    const auto newValidators = worldNode.registeredValidators();
+
+    CHECK(issueTracker.takeInvalidatedNodes() == std::vector<const Node*>{groupNode});
+
+    const auto issues = issueTracker.validate(newValidators);
+    CHECK(getNodes(issues) == std::vector<const Node*>{groupNode, groupNode});
+    CHECK(issues.front()->seqId() > issues.back()->seqId());
+  }
+}
+
+} // namespace TrenchBroom::Model
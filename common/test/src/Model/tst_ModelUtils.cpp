@@ -340,6 +340,112 @@ TEST_CASE("ModelUtils.collectContainedNodes")
       std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
 }
 
+TEST_CASE("ModelUtils.collectMatchingNodesInWorld")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto builder = BrushBuilder{mapFormat, worldBounds};
+
+  const auto makeBrushNode = [&](const vm::bbox3d& bounds) {
+    return new BrushNode{builder.createCuboid(bounds, "texture").value()};
+  };
+
+  // a brush in the default layer
+  auto* brushNode = makeBrushNode({{0, 0, 0}, {64, 64, 64}});
+
+  // a point entity
+  auto* pointEntityNode = new EntityNode{Entity{}};
+  transformNode(
+    *pointEntityNode, vm::translation_matrix(vm::vec3d{256, 0, 0}), worldBounds);
+
+  // a brush entity with two brushes
+  auto* brushEntityNode = new EntityNode{Entity{}};
+  auto* entityBrushNode1 = makeBrushNode({{0, 256, 0}, {64, 320, 64}});
+  auto* entityBrushNode2 = makeBrushNode({{0, 512, 0}, {64, 576, 64}});
+  brushEntityNode->addChildren({entityBrushNode1, entityBrushNode2});
+
+  // a closed group whose brushes leave a gap between them
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* groupBrushNode1 = makeBrushNode({{1024, 0, 0}, {1088, 64, 64}});
+  auto* groupBrushNode2 = makeBrushNode({{1536, 0, 0}, {1600, 64, 64}});
+  groupNode->addChildren({groupBrushNode1, groupBrushNode2});
+
+  // a brush in a custom layer
+  auto* layerNode = new LayerNode{Layer{"layer"}};
+  auto* layerBrushNode = makeBrushNode({{0, 0, 1024}, {64, 64, 1088}});
+  layerNode->addChild(layerBrushNode);
+
+  worldNode.defaultLayer()->addChildren(
+    {brushNode, pointEntityNode, brushEntityNode, groupNode});
+  worldNode.addChild(layerNode);
+
+  const auto allNodes = std::vector<Node*>{&worldNode};
+
+  auto touchesBrushAndEntityBrush = BrushNode{
+    builder.createCuboid(vm::bbox3d{{16, 16, 16}, {48, 288, 48}}, "texture").value()};
+  auto touchesGroupGap = BrushNode{
+    builder.createCuboid(vm::bbox3d{{1280, 16, 16}, {1344, 48, 48}}, "texture").value()};
+  auto touchesLayerBrush = BrushNode{
+    builder.createCuboid(vm::bbox3d{{16, 16, 1000}, {48, 48, 1040}}, "texture").value()};
+  auto containsEverything = BrushNode{
+    builder.createCuboid(vm::bbox3d{{-64, -64, -64}, {2048, 1024, 2048}}, "texture")
+      .value()};
+
+  CHECK_THAT(
+    collectTouchingNodes(allNodes, {&touchesBrushAndEntityBrush}),
+    Catch::Matchers::UnorderedEquals(std::vector<Node*>{brushNode, entityBrushNode1}));
+
+  CHECK_THAT(
+    collectTouchingNodes(allNodes, {&touchesGroupGap}),
+    Catch::Matchers::UnorderedEquals(std::vector<Node*>{groupNode}));
+
+  CHECK_THAT(
+    collectTouchingNodes(allNodes, {&touchesLayerBrush, &touchesGroupGap}),
+    Catch::Matchers::UnorderedEquals(std::vector<Node*>{groupNode, layerBrushNode}));
+
+  CHECK_THAT(
+    collectContainedNodes(allNodes, {&containsEverything}),
+    Catch::Matchers::UnorderedEquals(std::vector<Node*>{
+      brushNode,
+      pointEntityNode,
+      entityBrushNode1,
+      entityBrushNode2,
+      groupNode,
+      layerBrushNode}));
+
+  CHECK(collectContainedNodes(allNodes, {&touchesGroupGap}).empty());
+
+  SECTION("Query brushes in the world are not collected")
+  {
+    CHECK_THAT(
+      collectTouchingNodes(allNodes, {brushNode}),
+      Catch::Matchers::UnorderedEquals(std::vector<Node*>{}));
+    CHECK_THAT(
+      collectTouchingNodes(allNodes, {entityBrushNode1, groupBrushNode1}),
+      Catch::Matchers::UnorderedEquals(std::vector<Node*>{groupNode}));
+  }
+
+  SECTION("Nodes in open groups are collected individually")
+  {
+    groupNode->open();
+    CHECK_THAT(
+      collectTouchingNodes(allNodes, {&touchesGroupGap}),
+      Catch::Matchers::UnorderedEquals(std::vector<Node*>{}));
+    CHECK_THAT(
+      collectContainedNodes(allNodes, {&containsEverything}),
+      Catch::Matchers::UnorderedEquals(std::vector<Node*>{
+        brushNode,
+        pointEntityNode,
+        entityBrushNode1,
+        entityBrushNode2,
+        groupBrushNode1,
+        groupBrushNode2,
+        layerBrushNode}));
+  }
+}
+
 TEST_CASE("ModelUtils.collectSelectedNodes")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
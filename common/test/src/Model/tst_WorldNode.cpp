@@ -21,6 +21,7 @@
 #include "Model/BrushBuilder.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
+#include "Model/EditorContext.h"
 #include "Model/EntityNode.h"
 #include "Model/Group.h"
 #include "Model/GroupNode.h"
@@ -28,6 +29,7 @@
 #include "Model/LayerNode.h"
 #include "Model/MapFormat.h"
 #include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Model/WorldNode.h"
 #include "TestUtils.h"
 #include "octree.h"
@@ -323,6 +325,100 @@ TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.pickFirst")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  const auto editorContext = EditorContext{};
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+
+  // a row of cubes along the X axis, none of them crossing the Y or Z axes so that they
+  // are not all stored in the root node of the node tree
+  const auto builder = BrushBuilder{mapFormat, worldBounds};
+  for (size_t i = 0; i < 32; ++i)
+  {
+    const auto x = FloatType(i) * 128.0 - 2048.0;
+    worldNode.defaultLayer()->addChild(new BrushNode{
+      builder.createCuboid(vm::bbox3{{x, 32, 32}, {x + 64, 96, 96}}, "texture")
+        .value()});
+  }
+
+  const auto filter = HitFilters::type(BrushNode::BrushHitType);
+  const auto ray = GENERATE(
+    vm::ray3{{-4096, 64, 64}, vm::vec3::pos_x()},
+    vm::ray3{{4096, 64, 64}, vm::vec3::neg_x()},
+    vm::ray3{{16, 64, 64}, vm::vec3::pos_x()},
+    vm::ray3{{16, 64, 64}, vm::vec3::neg_x()},
+    vm::ray3{{-4096, 64, 64}, vm::vec3::neg_x()});
+
+  CAPTURE(ray);
+
+  auto allHits = PickResult::byDistance();
+  worldNode.pick(editorContext, ray, allHits);
+
+  auto firstHits = PickResult::byDistance();
+  worldNode.pickFirst(editorContext, ray, filter, firstHits);
+
+  const auto& expectedHit = allHits.first(filter);
+  const auto& actualHit = firstHits.first(filter);
+  CHECK(actualHit.isMatch() == expectedHit.isMatch());
+  CHECK(actualHit.distance() == expectedHit.distance());
+  CHECK(actualHit.hitPoint() == expectedHit.hitPoint());
+  CHECK(firstHits.size() <= 2u);
+}
+
+TEST_CASE("WorldNodeTest.findNodesWithLinkId")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+
+  groupNode->setLinkId("group_link_id");
+  entityNode->setLinkId("link_id");
+  brushNode->setLinkId("link_id");
+
+  groupNode->addChild(entityNode);
+  groupNode->addChild(brushNode);
+  REQUIRE(worldNode.findNodesWithLinkId("link_id").empty());
+
+  worldNode.defaultLayer()->addChild(groupNode);
+  CHECK(worldNode.findNodesWithLinkId("group_link_id") == std::vector<Node*>{groupNode});
+  CHECK_THAT(
+    worldNode.findNodesWithLinkId("link_id"),
+    Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+
+  SECTION("Changing a link ID updates the index")
+  {
+    brushNode->setLinkId("other_link_id");
+    CHECK(worldNode.findNodesWithLinkId("link_id") == std::vector<Node*>{entityNode});
+    CHECK(
+      worldNode.findNodesWithLinkId("other_link_id") == std::vector<Node*>{brushNode});
+  }
+
+  SECTION("Removing nodes updates the index")
+  {
+    groupNode->removeChild(brushNode);
+    CHECK(worldNode.findNodesWithLinkId("link_id") == std::vector<Node*>{entityNode});
+
+    // changing the link ID of a node which is not in the world does not affect the index
+    brushNode->setLinkId("group_link_id");
+    CHECK(
+      worldNode.findNodesWithLinkId("group_link_id") == std::vector<Node*>{groupNode});
+    delete brushNode;
+
+    worldNode.defaultLayer()->removeChild(groupNode);
+    CHECK(worldNode.findNodesWithLinkId("group_link_id").empty());
+    CHECK(worldNode.findNodesWithLinkId("link_id").empty());
+    delete groupNode;
+  }
+}
+
 TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer")
 {
   auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
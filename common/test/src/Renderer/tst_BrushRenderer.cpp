@@ -0,0 +1,104 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+#include "Renderer/BrushRenderer.h"
+#include "Renderer/PerspectiveCamera.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+
+TEST_CASE("BrushRendererTest.visibleBuckets")
+{
+  using BucketKey = BrushRenderer::BucketKey;
+
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+
+  const auto makeBrushNode = [&](const vm::bbox3& bounds) {
+    return std::make_unique<Model::BrushNode>(
+      builder.createCuboid(bounds, "texture").value());
+  };
+
+  // in front of the camera
+  auto brushNode1 =
+    makeBrushNode(vm::bbox3{{2528.0, 480.0, 480.0}, {2592.0, 544.0, 544.0}});
+  // behind the camera
+  auto brushNode2 =
+    makeBrushNode(vm::bbox3{{-2592.0, 480.0, 480.0}, {-2528.0, 544.0, 544.0}});
+  // in front of the camera, but in the same bucket as brushNode1
+  auto brushNode3 =
+    makeBrushNode(vm::bbox3{{2112.0, 64.0, 64.0}, {2176.0, 128.0, 128.0}});
+
+  const auto bucket1 = BucketKey{2, 0, 0, 0};
+  const auto bucket2 = BucketKey{-3, 0, 0, 0};
+
+  const auto camera = PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    Camera::Viewport{0, 0, 1024, 768},
+    vm::vec3f{0.0f, 512.0f, 512.0f},
+    vm::vec3f::pos_x(),
+    vm::vec3f::pos_z()};
+
+  auto brushRenderer = BrushRenderer{};
+  brushRenderer.addBrush(brushNode1.get());
+  brushRenderer.addBrush(brushNode2.get());
+  brushRenderer.addBrush(brushNode3.get());
+
+  // brushes are sorted into buckets when they are validated
+  CHECK(brushRenderer.buckets().empty());
+  brushRenderer.validate();
+
+  CHECK_THAT(
+    brushRenderer.buckets(),
+    Catch::UnorderedEquals(std::vector<BucketKey>{bucket1, bucket2}));
+  CHECK(brushRenderer.visibleBuckets(camera) == std::vector<BucketKey>{bucket1});
+
+  SECTION("Removing the last brush of a bucket removes the bucket")
+  {
+    brushRenderer.removeBrush(brushNode1.get());
+    CHECK(brushRenderer.visibleBuckets(camera) == std::vector<BucketKey>{bucket1});
+
+    brushRenderer.removeBrush(brushNode3.get());
+    CHECK(brushRenderer.visibleBuckets(camera).empty());
+    CHECK(brushRenderer.buckets() == std::vector<BucketKey>{bucket2});
+  }
+
+  SECTION("Invalidating removes all buckets")
+  {
+    brushRenderer.invalidate();
+    CHECK(brushRenderer.buckets().empty());
+  }
+}
+
+} // namespace TrenchBroom::Renderer
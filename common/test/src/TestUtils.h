@@ -55,7 +55,7 @@ namespace IO
 template <typename FS>
 auto openFS(const std::filesystem::path& path)
 {
-  return Disk::openFile(path)
+  return Disk::mapFile(path)
     .and_then([](auto file) { return createImageFileSystem<FS>(std::move(file)); })
     .value();
 }
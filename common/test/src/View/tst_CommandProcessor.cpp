@@ -242,6 +242,56 @@ public:
   }
 };
 
+class MemoryUsingCommand : public NullCommand
+{
+private:
+  size_t m_memoryUsage;
+
+public:
+  MemoryUsingCommand(std::string name, const size_t memoryUsage)
+    : NullCommand{std::move(name)}
+    , m_memoryUsage{memoryUsage}
+  {
+  }
+
+  size_t doGetMemoryUsage() const override { return m_memoryUsage; }
+};
+
+class CompressingCommand : public NullCommand
+{
+private:
+  size_t& m_compressCount;
+  bool m_collate;
+  bool m_compressed = false;
+
+public:
+  CompressingCommand(std::string name, size_t& compressCount, const bool collate = false)
+    : NullCommand{std::move(name)}
+    , m_compressCount{compressCount}
+    , m_collate{collate}
+  {
+  }
+
+  bool doCollateWith(UndoableCommand&) override { return m_collate; }
+
+  std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade*) override
+  {
+    m_compressed = false;
+    return std::make_unique<CommandResult>(true);
+  }
+
+  size_t doGetMemoryUsage() const override { return m_compressed ? 10u : 100u; }
+
+  void doCompress(MapDocumentCommandFacade*) override
+  {
+    if (!m_compressed)
+    {
+      ++m_compressCount;
+      m_compressed = true;
+    }
+  }
+};
+
 TEST_CASE("CommandProcessorTest.doAndUndoSuccessfulCommand")
 {
   /*
@@ -818,5 +868,105 @@ TEST_CASE("CommandProcessorTest.collateTransactions")
 
   commandProcessor.undo();
 }
+TEST_CASE("CommandProcessorTest.memoryBudget")
+{
+  auto commandProcessor = CommandProcessor{nullptr};
+  commandProcessor.setMemoryBudget(250u);
+
+  commandProcessor.executeAndStore(std::make_unique<MemoryUsingCommand>("cmd1", 100u));
+  commandProcessor.executeAndStore(std::make_unique<MemoryUsingCommand>("cmd2", 100u));
+  CHECK(commandProcessor.memoryUsage() == 200u);
+
+  SECTION("Oldest commands are evicted when the budget is exceeded")
+  {
+    commandProcessor.executeAndStore(std::make_unique<MemoryUsingCommand>("cmd3", 100u));
+    CHECK(commandProcessor.memoryUsage() == 200u);
+
+    CHECK(commandProcessor.undo()->success());
+    CHECK(commandProcessor.undo()->success());
+    CHECK_FALSE(commandProcessor.canUndo());
+    CHECK(commandProcessor.redoCommandName() == "cmd2");
+  }
+
+  SECTION("Undone commands still count towards the memory usage")
+  {
+    CHECK(commandProcessor.undo()->success());
+    CHECK(commandProcessor.memoryUsage() == 200u);
+  }
+
+  SECTION("The most recent command is kept even if it exceeds the budget")
+  {
+    commandProcessor.executeAndStore(std::make_unique<MemoryUsingCommand>("cmd3", 300u));
+    CHECK(commandProcessor.memoryUsage() == 300u);
+    CHECK(commandProcessor.undoCommandName() == "cmd3");
+  }
+
+  SECTION("Lowering the budget evicts commands immediately")
+  {
+    commandProcessor.setMemoryBudget(150u);
+    CHECK(commandProcessor.memoryUsage() == 100u);
+    CHECK(commandProcessor.undoCommandName() == "cmd2");
+  }
+
+  SECTION("Removing the budget")
+  {
+    commandProcessor.setMemoryBudget(std::nullopt);
+    commandProcessor.executeAndStore(std::make_unique<MemoryUsingCommand>("cmd3", 100u));
+    CHECK(commandProcessor.memoryUsage() == 300u);
+  }
+}
+
+TEST_CASE("CommandProcessorTest.compressCommands")
+{
+  auto commandProcessor = CommandProcessor{nullptr};
+  auto compressCount = size_t(0);
+
+  SECTION("Commands are compressed when they are stored and when they are redone")
+  {
+    commandProcessor.executeAndStore(
+      std::make_unique<CompressingCommand>("cmd", compressCount));
+    CHECK(compressCount == 1u);
+    CHECK(commandProcessor.memoryUsage() == 10u);
+
+    CHECK(commandProcessor.undo()->success());
+    CHECK(compressCount == 1u);
+    CHECK(commandProcessor.memoryUsage() == 100u);
+
+    CHECK(commandProcessor.redo()->success());
+    CHECK(compressCount == 2u);
+    CHECK(commandProcessor.memoryUsage() == 10u);
+  }
+
+  SECTION("Commands in a transaction are compressed when they are stored")
+  {
+    commandProcessor.startTransaction("transaction", TransactionScope::Oneshot);
+    commandProcessor.executeAndStore(
+      std::make_unique<CompressingCommand>("cmd1", compressCount));
+    commandProcessor.executeAndStore(
+      std::make_unique<CompressingCommand>("cmd2", compressCount));
+    CHECK(compressCount == 2u);
+
+    commandProcessor.commitTransaction();
+    CHECK(compressCount == 2u);
+    CHECK(commandProcessor.memoryUsage() == 20u);
+
+    CHECK(commandProcessor.undo()->success());
+    CHECK(commandProcessor.redo()->success());
+    CHECK(compressCount == 4u);
+    CHECK(commandProcessor.memoryUsage() == 20u);
+  }
+
+  SECTION("Commands that are collated with their predecessor are not compressed")
+  {
+    commandProcessor.executeAndStore(
+      std::make_unique<CompressingCommand>("cmd1", compressCount, true));
+    CHECK(compressCount == 1u);
+
+    commandProcessor.executeAndStore(
+      std::make_unique<CompressingCommand>("cmd2", compressCount, true));
+    CHECK(compressCount == 1u);
+    CHECK(commandProcessor.memoryUsage() == 10u);
+  }
+}
 } // namespace View
 } // namespace TrenchBroom
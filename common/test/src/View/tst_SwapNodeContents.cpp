@@ -23,6 +23,7 @@
 #include "FloatType.h"
 #include "Model/BezierPatch.h"
 #include "Model/Brush.h"
+#include "Model/BrushFaceAttributes.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
@@ -37,6 +38,7 @@
 
 #include "kdl/memory_utils.h"
 #include "kdl/result.h"
+#include "kdl/vector_utils.h"
 
 #include "vm/bbox.h"
 #include "vm/bbox_io.h"
@@ -77,6 +79,74 @@ TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.swapBrushes")
   CHECK(brushNode->brush() == originalBrush);
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.collateBrushChanges")
+{
+  auto* brushNode = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode}}});
+
+  const auto originalBrush = brushNode->brush();
+
+  auto translatedBrush = originalBrush;
+  REQUIRE(translatedBrush
+            .transform(
+              document->worldBounds(), vm::translation_matrix(vm::vec3(16, 0, 0)), false)
+            .is_success());
+
+  auto retexturedBrush = translatedBrush;
+  retexturedBrush.face(0).setAttributes(
+    Model::BrushFaceAttributes{"other", retexturedBrush.face(0).attributes()});
+
+  auto nodesToSwap = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
+  nodesToSwap.emplace_back(brushNode, translatedBrush);
+  document->swapNodeContents("Swap Nodes", std::move(nodesToSwap), {});
+
+  nodesToSwap = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
+  nodesToSwap.emplace_back(brushNode, retexturedBrush);
+  document->swapNodeContents("Swap Nodes", std::move(nodesToSwap), {});
+
+  CHECK(brushNode->brush() == retexturedBrush);
+  CHECK(document->undoMemoryUsage() > 0u);
+
+  // the commands were collated, so both changes are undone at once
+  document->undoCommand();
+  CHECK(brushNode->brush() == originalBrush);
+
+  document->redoCommand();
+  CHECK(brushNode->brush() == retexturedBrush);
+}
+
+TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.undoVertexMoveOfOffGridBrush")
+{
+  // the geometry of an off grid brush cannot be rebuilt exactly from its faces, so the
+  // undo history must not store it as a delta
+  const auto offset = vm::vec3{0.1, 0.2, 0.3};
+  auto* brushNode = createBrushNode("texture", [&](auto& brush) {
+    REQUIRE(brush.transform(document->worldBounds(), vm::translation_matrix(offset), false)
+              .is_success());
+  });
+  document->addNodes({{document->parentForNodes(), {brushNode}}});
+  document->selectNodes({brushNode});
+
+  const auto originalBrush = brushNode->brush();
+  const auto originalVertices = kdl::vec_sort(originalBrush.vertexPositions());
+
+  // the undo stack's memory budget is enforced when the command is stored
+  REQUIRE(
+    document->moveVertices({vm::vec3{16, 16, 16} + offset}, vm::vec3{-8, -4, 0}).success);
+  REQUIRE(document->undoMemoryUsage() > 0u);
+
+  const auto movedBrush = brushNode->brush();
+  const auto movedVertices = kdl::vec_sort(movedBrush.vertexPositions());
+
+  document->undoCommand();
+  CHECK(brushNode->brush() == originalBrush);
+  CHECK(kdl::vec_sort(brushNode->brush().vertexPositions()) == originalVertices);
+
+  document->redoCommand();
+  CHECK(brushNode->brush() == movedBrush);
+  CHECK(kdl::vec_sort(brushNode->brush().vertexPositions()) == movedVertices);
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.swapPatches")
 {
   auto* patchNode = createPatchNode();
@@ -0,0 +1,169 @@
+/*
+ Copyright (C) 2026 agent
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "View/VertexHandleGrid.h"
+
+#include "vm/bbox.h"
+#include "vm/distance.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::View
+{
+namespace
+{
+template <typename Q>
+std::vector<int> collect(const Q& query)
+{
+  auto result = std::vector<int>{};
+  query([&](const int value) { result.push_back(value); });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+} // namespace
+
+TEST_CASE("VertexHandleGridTest.insertAndRemove")
+{
+  auto grid = VertexHandleGrid<int>{16.0};
+  CHECK(grid.empty());
+
+  grid.insert(vm::vec3{1, 2, 3}, 0.0, 1);
+  grid.insert(vm::vec3{1, 2, 3}, 0.0, 2);
+  grid.insert(vm::vec3{-100, 50, 0}, 0.0, 3);
+  CHECK(grid.size() == 3u);
+
+  CHECK(grid.remove(vm::vec3{1, 2, 3}, 1));
+  CHECK_FALSE(grid.remove(vm::vec3{1, 2, 3}, 1));
+  CHECK_FALSE(grid.remove(vm::vec3{100, 2, 3}, 2));
+  CHECK(grid.size() == 2u);
+
+  const auto all = [&]() {
+    return collect([&](const auto& f) { grid.forEachInBox(vm::bbox3{1024.0}, f); });
+  };
+  CHECK(all() == std::vector<int>{2, 3});
+
+  CHECK(grid.remove(vm::vec3{-100, 50, 0}, 3));
+  CHECK(all() == std::vector<int>{2});
+
+  grid.clear();
+  CHECK(grid.empty());
+  CHECK(all().empty());
+}
+
+TEST_CASE("VertexHandleGridTest.forEachInBox")
+{
+  auto grid = VertexHandleGrid<int>{16.0};
+  grid.insert(vm::vec3{0, 0, 0}, 0.0, 1);
+  grid.insert(vm::vec3{-1, -1, -1}, 0.0, 2);
+  grid.insert(vm::vec3{15, 15, 15}, 0.0, 3);
+  grid.insert(vm::vec3{17, 0, 0}, 0.0, 4);
+  grid.insert(vm::vec3{-300, 0, 0}, 0.0, 5);
+
+  const auto query = [&](const vm::bbox3& bounds) {
+    return collect([&](const auto& f) { grid.forEachInBox(bounds, f); });
+  };
+
+  CHECK(query(vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{0, 0, 0}}) == std::vector<int>{1});
+  CHECK(query(vm::bbox3{1.0}) == std::vector<int>{1, 2});
+  CHECK(
+    query(vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{16, 16, 16}}) == std::vector<int>{1, 3});
+  CHECK(
+    query(vm::bbox3{vm::vec3{0, -1, -1}, vm::vec3{20, 1, 1}}) == std::vector<int>{1, 4});
+  CHECK(query(vm::bbox3{1000.0}) == std::vector<int>{1, 2, 3, 4, 5});
+}
+
+TEST_CASE("VertexHandleGridTest.forEachInRadius")
+{
+  auto grid = VertexHandleGrid<int>{16.0};
+  grid.insert(vm::vec3{0, 0, 0}, 0.0, 1);
+  grid.insert(vm::vec3{3, 0, 0}, 0.0, 2);
+  grid.insert(vm::vec3{3, 3, 3}, 0.0, 3);
+
+  const auto query = [&](const vm::vec3& position, const FloatType radius) {
+    return collect([&](const auto& f) { grid.forEachInRadius(position, radius, f); });
+  };
+
+  CHECK(query(vm::vec3{0, 0, 0}, 1.0) == std::vector<int>{1});
+  CHECK(query(vm::vec3{0, 0, 0}, 3.0) == std::vector<int>{1, 2});
+  CHECK(query(vm::vec3{0, 0, 0}, 5.2) == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("VertexHandleGridTest.forEachNearRay")
+{
+  auto engine = std::mt19937{};
+  auto dist = std::uniform_real_distribution<FloatType>{-512.0, 512.0};
+  const auto randomPoint = [&]() {
+    return vm::vec3{dist(engine), dist(engine), dist(engine)};
+  };
+
+  auto grid = VertexHandleGrid<int>{32.0};
+  auto anchors = std::vector<vm::vec3>{};
+  auto extents = std::vector<FloatType>{};
+  for (int i = 0; i < 2000; ++i)
+  {
+    anchors.push_back(randomPoint());
+    extents.push_back(FloatType(i % 4) * 8.0);
+    grid.insert(anchors.back(), extents.back(), i);
+  }
+
+  for (int i = 0; i < 2000; i += 3)
+  {
+    grid.remove(anchors[size_t(i)], i);
+  }
+
+  // a pick radius that grows with the distance from the origin, like a perspective camera
+  const auto pickRadius = [](const vm::vec3& center, const FloatType radius) {
+    return (vm::length(center) + radius) / 64.0;
+  };
+
+  for (int i = 0; i < 50; ++i)
+  {
+    const auto ray = vm::ray3{randomPoint(), vm::normalize(randomPoint())};
+
+    auto expected = std::vector<int>{};
+    for (int j = 0; j < int(anchors.size()); ++j)
+    {
+      if (j % 3 == 0)
+      {
+        continue;
+      }
+
+      const auto maxDistance =
+        extents[size_t(j)] + pickRadius(anchors[size_t(j)], extents[size_t(j)]);
+      if (
+        vm::squared_distance(ray, anchors[size_t(j)]).distance
+        <= maxDistance * maxDistance)
+      {
+        expected.push_back(j);
+      }
+    }
+
+    CHECK(
+      collect([&](const auto& f) { grid.forEachNearRay(ray, pickRadius, f); })
+      == expected);
+  }
+}
+
+} // namespace TrenchBroom::View
@@ -22,10 +22,14 @@
 #include "kdl/string_utils.h"
 
 #include "vm/bbox.h"
+#include "vm/bbox_io.h"
 #include "vm/forward.h"
 #include "vm/ray.h"
 #include "vm/vec.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -620,6 +624,66 @@ TEST_CASE("octree.find_intersectors-ray")
   }
 }
 
+TEST_CASE("octree.visit_intersectors_in_order")
+{
+  auto tree = octree<double, int>{32.0};
+
+  const auto visit = [&](const vm::ray3d& ray, const double max_distance) {
+    auto visited = std::vector<int>{};
+    auto distances = std::vector<double>{};
+    tree.visit_intersectors_in_order(
+      ray,
+      [&](const int data) { visited.push_back(data); },
+      [&](const double distance) {
+        distances.push_back(distance);
+        return distance <= max_distance;
+      });
+
+    CHECK(std::is_sorted(distances.begin(), distances.end()));
+    return visited;
+  };
+
+  SECTION("empty tree")
+  {
+    CHECK(visit(vm::ray3d{{0, 0, 0}, {1, 0, 0}}, 1000.0).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.insert({{96, 32, 32}, {128, 64, 64}}, 2);
+    tree.insert({{-64, 32, 32}, {-32, 64, 64}}, 3);
+    // crosses zero and is stored in the root node
+    tree.insert({{-16, 32, 32}, {16, 64, 64}}, 4);
+    // not hit by the rays below
+    tree.insert({{32, -64, 32}, {64, -32, 64}}, 5);
+
+    CHECK(
+      visit(vm::ray3d{{-200, 48, 48}, {1, 0, 0}}, 1000.0)
+      == std::vector<int>{4, 3, 1, 2});
+    CHECK(
+      visit(vm::ray3d{{200, 48, 48}, {-1, 0, 0}}, 1000.0)
+      == std::vector<int>{4, 2, 1, 3});
+
+    // the ray starts inside of the node containing 1
+    CHECK(visit(vm::ray3d{{48, 48, 48}, {1, 0, 0}}, 1000.0) == std::vector<int>{4, 1, 2});
+
+    // stop before entering the node containing 1
+    CHECK(visit(vm::ray3d{{-200, 48, 48}, {1, 0, 0}}, 200.0) == std::vector<int>{4, 3});
+
+    // not hitting anything
+    CHECK(visit(vm::ray3d{{-200, 48, 48}, {-1, 0, 0}}, 1000.0).empty());
+
+    // visits the same data items as find_intersectors
+    const auto ray = vm::ray3d{{-200, 48, 48}, {1, 0, 0}};
+    auto expected = tree.find_intersectors(ray);
+    auto actual = visit(ray, 1000.0);
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    CHECK(actual == expected);
+  }
+}
+
 TEST_CASE("octree.find_intersectors-bbox")
 {
   auto tree = octree<double, int>{32.0};
@@ -682,6 +746,41 @@ TEST_CASE("octree.find_intersectors-bbox")
   }
 }
 
+TEST_CASE("octree.visit_intersectors-bbox")
+{
+  auto tree = octree<double, int>{32.0};
+  tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+  tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+  tree.insert({{-16, -16, -16}, {16, 16, 16}}, 3);
+
+  const auto visit = [&](const vm::bbox3d& bbox) {
+    auto result = std::vector<int>{};
+    tree.visit_intersectors(bbox, [&](const int data) { result.push_back(data); });
+    return result;
+  };
+
+  // visits the same data items as find_intersectors
+  for (const auto& bbox : {
+         vm::bbox3d{{0, 0, 0}, {1, 1, 1}},
+         vm::bbox3d{{40, 40, 40}, {48, 48, 48}},
+         vm::bbox3d{{-48, -48, -48}, {-40, -40, -40}},
+         vm::bbox3d{{-128, -128, -128}, {128, 128, 128}},
+         vm::bbox3d{{256, 256, 256}, {512, 512, 512}},
+       })
+  {
+    CAPTURE(bbox);
+    CHECK_THAT(visit(bbox), Catch::Matchers::UnorderedEquals(tree.find_intersectors(bbox)));
+  }
+
+  CHECK_THAT(
+    visit(vm::bbox3d{{40, 40, 40}, {48, 48, 48}}),
+    Catch::Matchers::UnorderedEquals(std::vector<int>{1, 3}));
+  CHECK_THAT(
+    visit(vm::bbox3d{{-128, -128, -128}, {128, 128, 128}}),
+    Catch::Matchers::UnorderedEquals(std::vector<int>{1, 2, 3}));
+  CHECK(visit(vm::bbox3d{{256, 256, 256}, {512, 512, 512}}).empty());
+}
+
 TEST_CASE("octree.find_containers")
 {
   auto tree = octree<double, int>{32.0};
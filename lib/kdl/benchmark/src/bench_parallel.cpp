@@ -0,0 +1,177 @@
+/*
+ Copyright 2026 agent
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/parallel.h"
+#include "kdl/thread_pool.h"
+
+#include "benchmark_utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+namespace
+{
+// reference implementation that spawns a thread per hardware thread on every call
+template <class L>
+void spawning_parallel_for(const size_t count, L&& lambda)
+{
+  const auto thread_count =
+    std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(1));
+
+  auto next_index = std::atomic<size_t>{0};
+  auto threads = std::vector<std::future<void>>{};
+  for (size_t i = 0; i < thread_count; ++i)
+  {
+    threads.push_back(std::async(std::launch::async, [&]() {
+      for (auto index = next_index++; index < count; index = next_index++)
+      {
+        lambda(index);
+      }
+    }));
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.wait();
+  }
+}
+
+double work(const size_t i)
+{
+  auto result = static_cast<double>(i);
+  for (size_t j = 0; j < 100; ++j)
+  {
+    result = std::sqrt(result + static_cast<double>(j));
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("parallel_for dispatch overhead for tiny workloads")
+{
+  constexpr size_t Calls = 1'000;
+  constexpr size_t Count = 16;
+
+  auto counter = std::atomic<size_t>{0};
+  const auto increment = [&](const size_t) { ++counter; };
+
+  time_lambda(
+    [&]() {
+      for (size_t i = 0; i < Calls; ++i)
+      {
+        for (size_t j = 0; j < Count; ++j)
+        {
+          increment(j);
+        }
+      }
+    },
+    "sequential, " + std::to_string(Calls) + " x " + std::to_string(Count));
+
+  time_lambda(
+    [&]() {
+      for (size_t i = 0; i < Calls; ++i)
+      {
+        spawning_parallel_for(Count, increment);
+      }
+    },
+    "spawning threads, " + std::to_string(Calls) + " x " + std::to_string(Count));
+
+  time_lambda(
+    [&]() {
+      for (size_t i = 0; i < Calls; ++i)
+      {
+        parallel_for(Count, increment, 1);
+      }
+    },
+    "thread pool, grain size 1, " + std::to_string(Calls) + " x "
+      + std::to_string(Count));
+
+  time_lambda(
+    [&]() {
+      for (size_t i = 0; i < Calls; ++i)
+      {
+        parallel_for(Count, increment);
+      }
+    },
+    "thread pool, default grain size, " + std::to_string(Calls) + " x "
+      + std::to_string(Count));
+
+  CHECK(counter == 4 * Calls * Count);
+}
+
+TEST_CASE("parallel_for throughput for large workloads")
+{
+  constexpr size_t Count = 1'000'000;
+
+  auto results = std::vector<double>(Count);
+  const auto compute = [&](const size_t i) { results[i] = work(i); };
+
+  time_lambda(
+    [&]() {
+      for (size_t i = 0; i < Count; ++i)
+      {
+        compute(i);
+      }
+    },
+    "sequential, " + std::to_string(Count));
+
+  time_lambda(
+    [&]() { spawning_parallel_for(Count, compute); },
+    "spawning threads, " + std::to_string(Count));
+
+  time_lambda(
+    [&]() { parallel_for(Count, compute, 1); },
+    "thread pool, grain size 1, " + std::to_string(Count));
+
+  time_lambda(
+    [&]() { parallel_for(Count, compute); },
+    "thread pool, default grain size, " + std::to_string(Count));
+
+  CHECK(results[Count - 1] == work(Count - 1));
+}
+
+TEST_CASE("vec_parallel_transform dispatch overhead")
+{
+  constexpr size_t Calls = 1'000;
+
+  auto input = std::vector<size_t>(8);
+  auto total = size_t(0);
+  time_lambda(
+    [&]() {
+      for (size_t i = 0; i < Calls; ++i)
+      {
+        total += vec_parallel_transform(input, work).size();
+      }
+    },
+    "vec_parallel_transform, " + std::to_string(Calls) + " x "
+      + std::to_string(input.size()));
+
+  CHECK(total == Calls * input.size());
+}
+} // namespace kdl
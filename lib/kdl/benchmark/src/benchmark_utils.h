@@ -0,0 +1,40 @@
+/*
+ Copyright 2026 agent
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace kdl
+{
+template <class L>
+double time_lambda(L&& lambda, const std::string& message)
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  lambda();
+  const auto end = std::chrono::high_resolution_clock::now();
+
+  const auto elapsed = std::chrono::duration<double>(end - start).count() * 1000.0;
+  std::printf("Time elapsed for '%s': %fms\n", message.c_str(), elapsed);
+  return elapsed;
+}
+} // namespace kdl
@@ -21,15 +21,19 @@
 #pragma once
 
 #include "kdl/string_compare.h"
-#include "kdl/string_format.h"
-#include "kdl/vector_utils.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
-#include <exception>
-#include <set>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace kdl
@@ -64,14 +68,235 @@ namespace kdl
  * - { key: "test, values: { "test value" } }
  *   - { key: "ing, values: { "testing testing" } }
  *
+ * All nodes are stored in a single vector and refer to each other by index. The children
+ * of a node form a singly linked list of siblings which is ordered by the first character
+ * of their keys. No two siblings have keys that start with the same character. Nodes that
+ * are removed from the trie are recycled by later insertions.
+ *
+ * A trie that is constructed from a range of entries is built in bulk: the entries are
+ * sorted by their keys and the nodes are created in depth first order, so that no node
+ * needs to be split and that the nodes of each subtree are stored next to each other.
+ *
  * @tparam V the type of the values associated with each node
  */
 template <typename V>
 class compact_trie
 {
 private:
-  struct node_cmp;
-  class node;
+  using node_index = std::size_t;
+  static constexpr node_index no_node = std::numeric_limits<node_index>::max();
+
+  /**
+   * Maps a value to the number of times it was stored in a node. Most nodes store only a
+   * few values, so these are kept in a vector, and a hash map is only allocated once a
+   * node stores many different values.
+   */
+  class value_container
+  {
+  private:
+    static constexpr std::size_t max_small_size = 16u;
+
+    std::vector<std::pair<V, std::size_t>> m_small;
+    std::unique_ptr<std::unordered_map<V, std::size_t>> m_large;
+
+  public:
+    value_container() = default;
+
+    value_container(const value_container& other)
+      : m_small{other.m_small}
+      , m_large{
+          other.m_large
+            ? std::make_unique<std::unordered_map<V, std::size_t>>(*other.m_large)
+            : nullptr}
+    {
+    }
+
+    value_container(value_container&& other) noexcept = default;
+
+    value_container& operator=(value_container other) noexcept
+    {
+      using std::swap;
+      swap(m_small, other.m_small);
+      swap(m_large, other.m_large);
+      return *this;
+    }
+
+    bool empty() const { return m_small.empty() && !m_large; }
+
+    void insert(const V& value)
+    {
+      if (m_large)
+      {
+        ++(*m_large)[value];
+        return;
+      }
+
+      const auto it = find_small(value);
+      if (it != m_small.end())
+      {
+        ++it->second;
+      }
+      else if (m_small.size() < max_small_size)
+      {
+        m_small.emplace_back(value, 1u);
+      }
+      else
+      {
+        m_large = std::make_unique<std::unordered_map<V, std::size_t>>(
+          m_small.begin(), m_small.end());
+        m_small.clear();
+        m_small.shrink_to_fit();
+        ++(*m_large)[value];
+      }
+    }
+
+    /**
+     * Inserts the values of the given range of entries, reserving storage for all of them
+     * at once.
+     */
+    template <typename I>
+    void insert_all(I first, const I last)
+    {
+      const auto count = static_cast<std::size_t>(std::distance(first, last));
+      if (!m_large && m_small.size() + count > max_small_size)
+      {
+        m_large = std::make_unique<std::unordered_map<V, std::size_t>>(
+          m_small.begin(), m_small.end());
+        m_small.clear();
+        m_small.shrink_to_fit();
+      }
+
+      if (m_large)
+      {
+        m_large->reserve(m_large->size() + count);
+      }
+
+      for (; first != last; ++first)
+      {
+        insert(*first->second);
+      }
+    }
+
+    bool remove(const V& value)
+    {
+      if (m_large)
+      {
+        const auto it = m_large->find(value);
+        if (it == m_large->end())
+        {
+          return false;
+        }
+        if (--it->second == 0u)
+        {
+          m_large->erase(it);
+          if (m_large->empty())
+          {
+            m_large.reset();
+          }
+        }
+        return true;
+      }
+
+      const auto it = find_small(value);
+      if (it == m_small.end())
+      {
+        return false;
+      }
+      if (--it->second == 0u)
+      {
+        *it = std::move(m_small.back());
+        m_small.pop_back();
+      }
+      return true;
+    }
+
+    void clear()
+    {
+      m_small.clear();
+      m_large.reset();
+    }
+
+    template <typename O>
+    void get_values(O& out) const
+    {
+      const auto add_values = [&](const auto& value, const auto count) {
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+          out++ = value;
+        }
+      };
+
+      if (m_large)
+      {
+        for (const auto& [value, count] : *m_large)
+        {
+          add_values(value, count);
+        }
+      }
+      else
+      {
+        for (const auto& [value, count] : m_small)
+        {
+          add_values(value, count);
+        }
+      }
+    }
+
+  private:
+    auto find_small(const V& value)
+    {
+      return std::find_if(m_small.begin(), m_small.end(), [&](const auto& entry) {
+        return entry.first == value;
+      });
+    }
+  };
+
+  /**
+   * A trie node.
+   */
+  struct node
+  {
+    /**
+     * The partial key of this node.
+     */
+    std::string key;
+
+    /**
+     * The values stored in this node.
+     */
+    value_container values;
+
+    /**
+     * The first child of this node, or `no_node` if this node has no children.
+     */
+    node_index first_child = no_node;
+
+    /**
+     * The next sibling of this node, or `no_node` if this node is the last child of its
+     * parent.
+     */
+    node_index next_sibling = no_node;
+
+    /**
+     * The number of children of this node.
+     */
+    std::size_t child_count = 0u;
+
+    explicit node(std::string i_key)
+      : key{std::move(i_key)}
+    {
+    }
+  };
+
+  /**
+   * Siblings are ordered by the first characters of their keys, compared as unsigned
+   * characters. This is the same order in which std::string_view compares strings, which
+   * is used when building a trie in bulk.
+   */
+  static bool char_less(const char lhs, const char rhs)
+  {
+    return static_cast<unsigned char>(lhs) < static_cast<unsigned char>(rhs);
+  }
 
   /**
    * To avoid matching the same node multiple times using different partial patterns, we
@@ -91,7 +316,7 @@ private:
       /**
        * The parent of a node.
        */
-      const node* parent;
+      node_index parent;
 
       /**
        * Indicates whether a node was matched by a pattern.
@@ -108,9 +333,9 @@ private:
        * Creates a new state with the given parent. `node_matched` is initialized to
        * `false` and `fully_matched_children` to 0.
        *
-       * @param i_parent the parent, can be null
+       * @param i_parent the parent, can be `no_node`
        */
-      explicit node_match_state(const node* i_parent)
+      explicit node_match_state(const node_index i_parent)
         : parent(i_parent)
         , node_matched(false)
         , fully_matched_children(0u)
@@ -118,18 +343,23 @@ private:
       }
     };
 
-    std::unordered_map<const node*, node_match_state> m_state;
+    const std::vector<node>& m_nodes;
+    std::unordered_map<node_index, node_match_state> m_state;
 
   public:
+    explicit match_state(const std::vector<node>& nodes)
+      : m_nodes{nodes}
+    {
+    }
+
     /**
      * Inserts a match state for the given node and its parent.
      *
-     * @param n the node, must not be null
-     * @param parent the parent, may be null
+     * @param n the node
+     * @param parent the parent, may be `no_node`
      */
-    void insert(const node* n, const node* parent)
+    void insert(const node_index n, const node_index parent)
     {
-      assert(n != nullptr);
       m_state.try_emplace(n, parent);
     }
 
@@ -142,12 +372,13 @@ private:
      * @param n the node to check
      * @return true if the given node is fully matched and false otherwise
      */
-    bool is_fully_matched(const node* n)
+    bool is_fully_matched(const node_index n)
     {
       auto it = m_state.find(n);
       assert(it != std::end(m_state));
       const auto& state = it->second;
-      return state.node_matched && state.fully_matched_children == n->m_children.size();
+      return state.node_matched
+             && state.fully_matched_children == m_nodes[n].child_count;
     }
 
     /**
@@ -160,14 +391,14 @@ private:
      *
      * @param n the node to set to fully matched
      */
-    void set_fully_matched(const node* n)
+    void set_fully_matched(const node_index n)
     {
       auto it = m_state.find(n);
       assert(it != std::end(m_state));
 
       auto& state = it->second;
       state.node_matched = true;
-      state.fully_matched_children = n->m_children.size();
+      state.fully_matched_children = m_nodes[n].child_count;
       update_parent_states(state.parent);
     }
 
@@ -184,7 +415,7 @@ private:
      * @param n the node to set to matched
      * @return `false` if the given node is already matched, and `true` otherwise
      */
-    bool set_matched(const node* n)
+    bool set_matched(const node_index n)
     {
       auto it = m_state.find(n);
       assert(it != std::end(m_state));
@@ -196,7 +427,7 @@ private:
       }
 
       state.node_matched = true;
-      if (state.fully_matched_children == n->m_children.size())
+      if (state.fully_matched_children == m_nodes[n].child_count)
       {
         // update the subtree match counts of all nodes on the path to the given node
         update_parent_states(state.parent);
@@ -206,16 +437,17 @@ private:
     }
 
   private:
-    void update_parent_states(const node* n)
+    void update_parent_states(node_index n)
     {
-      while (n != nullptr)
+      while (n != no_node)
       {
         auto it = m_state.find(n);
         assert(it != std::end(m_state));
 
         auto& state = it->second;
         state.fully_matched_children += 1u;
-        if (!state.node_matched || state.fully_matched_children < n->m_children.size())
+        if (
+          !state.node_matched || state.fully_matched_children < m_nodes[n].child_count)
         {
           // parent is not fully matched, so it cannot contribute to its parents' subtree
           // match count yet
@@ -227,635 +459,753 @@ private:
     }
   };
 
+private:
+  std::vector<node> m_nodes;
+  std::vector<node_index> m_free_nodes;
+
+  static constexpr node_index root = 0u;
+
+public:
   /**
-   * A trie node. Children are stored in a set ordered by `node_cmp`. Each node can store
-   * a given value multiple times.
-   *
-   * A trie node has only const methods and therefore appears to be immutable, but this is
-   * not the case. All of its members are actually declared as mutable and may be modified
-   * by the `insert` or `remove` member functions. The reason for this peculiar design
-   * choice is that trie nodes are stored by value in a `std::set`, and `std::set` does
-   * not allow its contents to be modified, since that might affect the position of the
-   * value in the set.
-   *
-   * But in this particular case, the position of a node in the containing set depends
-   * only on the node's key, and the node's key is changed only in ways that does not
-   * affect its position. The key can only become shorter or longer, that is, key "abc"
-   * might be changed to "ab" or "abcd", and neither of these changes affects how the key
-   * compares to other keys due to the order introduce by `node_cmp`, which consideres two
-   * keys equivalent if they share a non-empty prefix.
-   *
-   * This implies that the following two conditions hold for a node with key "abc":
-   * - There is no sibling node with a key that is a prefix of "abc".
-   * - There is no sibling node with a key that that has "abc" as a prefix.
-   *
-   * Therefore, shortening or extending a node's key does not affect its position in the
-   * containing set, and we can update a node's key without violating any invariants of
-   * the containing set.
+   * Creates a new empty trie.
    */
-  class node
+  compact_trie()
   {
-  private:
-    friend struct node_cmp;
-    friend class match_state;
+    m_nodes.emplace_back("");
+  }
 
-    using value_container = std::unordered_map<V, std::size_t>;
-    using node_set = std::set<node, node_cmp>;
+  /**
+   * Creates a trie that contains the given entries. Each entry must be a pair of a key
+   * that is convertible to std::string_view and a value. This is much faster than
+   * inserting the entries one by one.
+   *
+   * @tparam I the type of the iterators
+   * @param first the beginning of the range of entries
+   * @param last the end of the range of entries
+   */
+  template <typename I>
+  compact_trie(I first, I last)
+  {
+    auto entries = std::vector<build_entry>{};
+    for (auto it = first; it != last; ++it)
+    {
+      const auto& [key, value] = *it;
+      entries.emplace_back(std::string_view{key}, &value);
+    }
 
-    /**
-     * The partical key of this node.
-     */
-    mutable std::string m_key;
+    auto buffer = std::vector<build_entry>(entries.size());
+    m_nodes.reserve(entries.size() + 1u);
+    m_nodes.emplace_back("");
+    build_subtree(root, entries.begin(), entries.end(), 0u, buffer.begin());
+  }
 
-    /**
-     * Maps a value to the number of times it was stored in this node.
-     */
-    mutable value_container m_values;
+  /**
+   * Creates a trie that contains the entries of the given range, see above.
+   *
+   * @tparam R the type of the range
+   * @param range the range of entries
+   */
+  template <typename R>
+  static compact_trie build(const R& range)
+  {
+    return compact_trie(std::begin(range), std::end(range));
+  }
 
-    /**
-     * The children of this node.
+  /**
+   * Inserts the given value under the given key.
+   *
+   * @param key the key to insert
+   * @param value the value to insert
+   */
+  void insert(std::string_view key, const V& value)
+  {
+    /*
+     Possible cases for insertion:
+      index: 01234567 |   | #m_key: 6
+      m_key: target   | ^ | #key | conditions              | todo
+     =================|===|======|=========================|======
+      case:  key:     |   |      |                         |
+         0:  blah     | 0 | 4    | ^ = 0                   | this is the root node, find
+                      |   |      |                         | or create child 'blah' and
+                      |   |      |                         | insert there
+         1:  targetli | 6 | 8    | ^ < #key AND ^ = #m_key | find or create child 'li'
+                      |   |      |                         | and insert there
+         2:  tarus    | 3 | 5    | ^ < #key AND ^ < #m_key | split this node in 'tar' and
+                      |   |      |                         | 'get', create child 'us' and
+                      |   |      |                         | insert there
+         3:  tar      | 3 | 3    | ^ = #key AND ^ < #m_key | split this node in 'tar' and
+                      |   |      |                         | 'get', insert here
+         4:  target   | 6 | 6    | ^ = #key AND ^ = #m_key | insert here
+     ==================================================================================
+      ^ indicates where key and m_key first differ
      */
-    mutable node_set m_children;
 
-  public:
-    /**
-     * Creates a new node with the given key.
-     *
-     * @param key the key
-     */
-    explicit node(std::string key)
-      : m_key(std::move(key))
+    auto n = root;
+    while (true)
     {
-    }
-
-    /**
-     * Inserts the given value into this node's subtree. If this node's key is empty, then
-     * it is the root node.
-     *
-     * Precondition: Unless this node is the root node, the given key must share a
-     * non-empty prefix with this node's key.
-     *
-     * @param key the key to insert
-     * @param value the value to insert
-     */
-    void insert(const std::string_view key, const V& value) const
-    {
-      /*
-       Possible cases for insertion:
-        index: 01234567 |   | #m_key: 6
-        m_key: target   | ^ | #key | conditions              | todo
-       =================|===|======|=========================|======
-        case:  key:     |   |      |                         |
-           0:  blah     | 0 | 4    | ^ = 0                   | this is the root node, find
-       or create child 'blah' and insert there; ^        |   |      | | 1:  targetli | 6 |
-       8    | ^ < #key AND ^ = #m_key | try insert in all children, if none match, create
-       child 'li' and insert there; ^  |   |      |                         | 2:  tarus |
-       3 | 5    | ^ < #key AND ^ < #m_key | split this node in 'tar' and 'get'; create
-       child 'us' and insert there; ^     |   |      |                         | 3:  tar
-       | 3 | 3    | ^ = #key AND ^ < #m_key | split this node in 'tar' and 'get'; insert
-       here; return true; ^     |   |      | | 4:  target   | 6 | 6    | ^ = #key AND ^ =
-       #m_key | insert here; return true; ^  |   |      |                         |
-       ==================================================================================
-        ^ indicates where key and m_key first differ
-       */
-
       // find the index of the first character where the given key and this node's key
       // differ
-      const std::size_t mismatch = kdl::cs::str_mismatch(key, m_key);
-      assert(mismatch > 0u || m_key.empty());
+      const auto mismatch = kdl::cs::str_mismatch(key, m_nodes[n].key);
+      assert(mismatch > 0u || m_nodes[n].key.empty());
 
       if (mismatch < key.size())
       {
-        // cases 0, 1, 2: key and m_key have a common prefix, or m_key is a prefix of key
-        if (mismatch == m_key.size())
+        if (mismatch == m_nodes[n].key.size())
         {
           // case 0, 1: m_key is a prefix of key, find or create a child that has a common
-          // prefix with the remainder of key and insert there
-          const auto remainder = key.substr(mismatch);
-          const auto& child = *m_children.insert(node(std::string(remainder))).first;
-          child.insert(remainder, value);
+          // prefix with the remainder of key and continue there
+          key = key.substr(mismatch);
+          const auto child = find_child(n, key[0]);
+          if (child == no_node)
+          {
+            const auto new_child = add_child(n, std::string{key});
+            m_nodes[new_child].values.insert(value);
+            return;
+          }
+          n = child;
         }
         else
-        { // mismatch == m_key.size()
-          // case 2: key and m_key have a common prefix, split this node and insert again
-          split_node(mismatch);
-          insert(key, value);
+        {
+          // case 2: key and m_key have a common prefix, split this node and try again
+          split_node(n, mismatch);
         }
       }
-      else if (mismatch == key.size())
+      else
       {
         // cases 3, 4: key is a prefix of m_key, or key == m_key
-        if (mismatch < m_key.size())
+        if (mismatch < m_nodes[n].key.size())
         {
           // case 3: key is a prefix of m_key, split this node
-          split_node(mismatch);
+          split_node(n, mismatch);
         }
-        insert_value(value);
+        m_nodes[n].values.insert(value);
+        return;
       }
     }
+  }
 
-    /**
-     * Removes the given value from this node's subtree.
-     *
-     * @param key the key to remove
-     * @param value the value to remove
-     * @return true if the given key and value were removed from this node's subtree
-     */
-    bool remove(const std::string_view key, const V& value) const
-    {
-      bool result = false;
+  /**
+   * Removes the given value using the given key.
+   *
+   * @param key the key to remove
+   * @param value the value to remove
+   * @return `true` if the given value was found under the given key, and `false`
+   * otherwise
+   */
+  bool remove(std::string_view key, const V& value)
+  {
+    auto path = std::vector<node_index>{};
+    auto result = false;
 
-      const std::size_t mismatch = kdl::cs::str_mismatch(key, m_key);
-      if (m_key.size() <= key.length() && mismatch == m_key.length())
+    auto n = root;
+    while (n != no_node)
+    {
+      const auto& current = m_nodes[n];
+      const auto mismatch = kdl::cs::str_mismatch(key, current.key);
+      if (current.key.size() > key.size() || mismatch != current.key.size())
       {
-        // m_key is a prefix of key or m_key == key
-        if (mismatch < key.length())
-        {
-          // m_key is a true prefix of key, continue at the corresponding child node
-          const auto remainder = key.substr(mismatch);
-          const auto it = m_children.find(remainder);
-          assert(it != std::end(m_children));
-
-          result = it->remove(remainder, value);
-          if (!it->m_key.empty() && it->m_values.empty() && it->m_children.empty())
-          {
-            m_children.erase(it);
-          }
-        }
-        else
-        {
-          // m_key == key
-          result = remove_value(value);
-        }
-
-        if (!m_key.empty() && m_values.empty() && m_children.size() == 1u)
-        {
-          merge_node();
-        }
+        break;
       }
 
-      return result;
+      // m_key is a prefix of key or m_key == key
+      path.push_back(n);
+      if (mismatch < key.size())
+      {
+        // m_key is a true prefix of key, continue at the corresponding child node
+        key = key.substr(mismatch);
+        n = find_child(n, key[0]);
+      }
+      else
+      {
+        // m_key == key
+        result = m_nodes[n].values.remove(value);
+        break;
+      }
     }
 
-    /**
-     * Finds every node in this node's subtree whose keys match a pattern, and adds the
-     * values to the given output iterator.
-     *
-     * The keys are matched against a suffix of the given pattern starting at the given
-     * position. The matching algorithm uses an auxiliary `match_State` to prevent
-     * matching unnecessarily matching nodes. This state is updated in the following
-     * situations:
-     *
-     * - a node is visited for the first time
-     * - a node is matches the given pattern (this might also update the node's parent's
-     * states)
-     * - an entire subtree matches the given pattern (due to a trailing wildcard in the
-     * pattern)
-     *
-     * Using this information, the algorithm will stop matching a node if every node in
-     * its subtree was already matched against the pattern. Furthermore, it will not add a
-     * node's values multiple times if the node's key matches the pattern in more than one
-     * way. The latter situation can arise due to wildcards in the pattern.
-     *
-     * @tparam O the type of the given output iterator
-     * @param pattern the pattern to match
-     * @param pattern_position where to start matching the pattern
-     * @param parent this node's parent (used to update the match_state)
-     * @param match_state the match state
-     * @param out the output iterator to which the values of matched nodes are added
-     *
-     * @throws std::invalid_argument if the given pattern contains an invalid escape
-     * sequence
-     */
-    template <typename O>
-    void find_matches(
-      const std::string_view pattern,
-      const std::size_t pattern_position,
-      const node* parent,
-      match_state& match_state,
-      O out) const
+    // remove empty nodes and merge nodes with a single child on the way back up
+    for (auto i = path.size(); i > 0u; --i)
     {
-      using match_task = std::pair<std::size_t, std::size_t>;
-
-      match_state.insert(this, parent);
-
-      std::vector<match_task> match_tasks({{0u, pattern_position}});
-      while (!match_tasks.empty())
+      const auto parent = path[i - 1u];
+      if (i < path.size())
       {
-        if (match_state.is_fully_matched(this))
+        const auto child = path[i];
+        if (m_nodes[child].values.empty() && m_nodes[child].child_count == 0u)
         {
-          // this node and all of its subtrees have been fully matched, so we are done
-          // here
-          return;
+          remove_child(parent, child);
         }
+      }
 
-        const auto [k_i, p_i] = match_tasks.back();
-        match_tasks.pop_back();
+      const auto& current = m_nodes[parent];
+      if (!current.key.empty() && current.values.empty() && current.child_count == 1u)
+      {
+        merge_node(parent);
+      }
+    }
 
-        if (k_i == m_key.length() && p_i == pattern.length())
-        {
-          if (match_state.set_matched(this))
-          {
-            // this node was not matched yet, so fetch the results
-            get_values(out);
-          }
+    return result;
+  }
 
-          // there might still be children of this node that could be matched by a pending
-          // match task, so continue matching
-          continue;
-        }
+  /**
+   * Clears this trie.
+   */
+  void clear()
+  {
+    m_nodes.clear();
+    m_free_nodes.clear();
+    m_nodes.emplace_back("");
+  }
 
-        if (p_i == pattern.length())
-        {
-          // the pattern is consumed by the key isn't, we cannot have a match here
-          continue;
-        }
+  /**
+   * Finds all values whose keys match the given glob pattern. See `kdl::str_matches_glob`
+   * for the definition and semantics of glob patterns and adds the values to the given
+   * output iterator.
+   *
+   * @tparam O the type of the output iterator
+   * @param pattern the pattern to match
+   * @param out the output iterator
+   *
+   * @throws std::invalid_argument if the given pattern contains an invalid escape
+   * sequence
+   */
+  template <typename O>
+  void find_matches(const std::string_view pattern, O out) const
+  {
+    auto state = match_state{m_nodes};
+    find_matches(root, pattern, 0u, no_node, state, out);
+  }
 
-        // after this point, we can assume that the pattern is not consumed, but the key
-        // might be
-        if (pattern[p_i] == '\\' && p_i < pattern.length() - 1u)
-        {
-          // handle escaped characters in the pattern
-          const auto& n = pattern[p_i + 1u];
+  /**
+   * Adds the keys of all nodes in this trie to the give output iterator.
+   *
+   * @tparam O the type of the output iterator
+   * @param out the output iterator
+   */
+  template <typename O>
+  void get_keys(O out) const
+  {
+    get_keys(root, "", out);
+  }
 
-          if (k_i < m_key.length())
-          {
-            // check the next character in the pattern against the next character in the
-            // key
-            if (n == '*' || n == '?' || n == '%' || n == '\\')
-            {
-              if (m_key[k_i] == n)
-              {
-                // the key matches the escaped character, continue
-                match_tasks.emplace_back(k_i + 1u, p_i + 2u);
-              }
-            }
-            else
-            {
-              throw std::invalid_argument("invalid escape sequence in pattern");
-            }
-          }
-          else
-          {
-            // the key is consumed, so continue matching at the children
-            for (const auto& c : {"*", "?", "%", "\\"})
-            {
-              const auto it = m_children.find(c);
-              if (it != std::end(m_children))
-              {
-                it->find_matches(pattern, p_i, this, match_state, out);
-              }
-            }
-          }
-        }
-        else if (pattern[p_i] == '*')
-        {
-          // handle '*' in the pattern
-          if (p_i == pattern.length() - 1u)
-          {
-            // the pattern is consumed after the '*', so it matches all keys in this
-            // node's subtree
-            match_state.set_fully_matched(this);
-            get_values_and_recurse(out);
-            return;
-          }
+private:
+  using build_entry = std::pair<std::string_view, const V*>;
+  using build_iterator = typename std::vector<build_entry>::iterator;
 
-          if (k_i < m_key.length())
-          {
-            // '*' matches any character
-            // consume the '*' and continue matching at the current character of the key
-            match_tasks.emplace_back(k_i, p_i + 1u);
-            // consume the current character of the key and continue matching at '*'
-            match_tasks.emplace_back(k_i + 1u, p_i);
-          }
-          else
-          {
-            // the key is consumed, so continue matching at the children
-            for (const auto& child : m_children)
-            {
-              child.find_matches(pattern, p_i, this, match_state, out);
-            }
-          }
-        }
-        else if (pattern[p_i] == '?')
-        {
-          // handle '?' in the pattern
-          if (k_i < m_key.length())
-          {
-            // '?' matches any character, continue at the next chars in both the pattern
-            // and the key
-            match_tasks.emplace_back(k_i + 1u, p_i + 1u);
-          }
-          else
-          {
-            // the key is consumed, so continue matching at the children
-            for (const auto& child : m_children)
-            {
-              child.find_matches(pattern, p_i, this, match_state, out);
-            }
-          }
-        }
-        else if (pattern[p_i] == '%')
-        {
-          // handle '%' in the pattern
-          if (p_i < pattern.length() - 1u && pattern[p_i + 1u] == '*')
-          {
-            // handle "%*" in the pattern
-            // try to continue matching after "%*"
-            match_tasks.emplace_back(k_i, p_i + 2u);
-            if (k_i < m_key.length())
-            {
-              if (m_key[k_i] >= '0' && m_key[k_i] <= '9')
-              {
-                // try to match more digits
-                match_tasks.emplace_back(k_i + 1u, p_i);
-              }
-            }
-            else
-            {
-              // the key is consumed, so continue matching at the children
-              for (auto it = m_children.lower_bound("0"),
-                        end = m_children.upper_bound("9");
-                   it != end;
-                   ++it)
-              {
-                it->find_matches(pattern, p_i, this, match_state, out);
-              }
-            }
-          }
-          else
-          {
-            if (k_i < m_key.length())
-            {
-              // handle '%' in the pattern (not followed by '*')
-              if (m_key[k_i] >= '0' && m_key[k_i] <= '9')
-              {
-                // continue matching after the digit
-                match_tasks.emplace_back(k_i + 1u, p_i + 1u);
-              }
-            }
-            else
-            {
-              // the key is consumed, so continue matching at the children
-              for (auto it = m_children.lower_bound("0"),
-                        end = m_children.upper_bound("9");
-                   it != end;
-                   ++it)
-              {
-                it->find_matches(pattern, p_i, this, match_state, out);
-              }
-            }
-          }
-        }
-        else
-        {
-          if (k_i < m_key.length())
-          {
-            if (pattern[p_i] == m_key[k_i])
-            {
-              // handle a regular character in the pattern
-              match_tasks.emplace_back(k_i + 1u, p_i + 1u);
-            }
-          }
-          else
-          {
-            // the key is consumed, so continue matching at the children
-            for (auto [it, end] = m_children.equal_range(pattern.substr(p_i, 1u));
-                 it != end;
-                 ++it)
-            {
-              it->find_matches(pattern, p_i, this, match_state, out);
-            }
-          }
-        }
-      }
-    }
+  /**
+   * Creates the children of the given node from the given range of entries. The keys of
+   * all entries start with the full key of the given node, which has the given length.
+   *
+   * The entries are ordered by their keys as the subtree is built, one character at a
+   * time, so the entries never need to be sorted as a whole. The given buffer must
+   * provide room for at least as many entries as the given range.
+   */
+  void build_subtree(
+    const node_index n,
+    build_iterator first,
+    const build_iterator last,
+    const std::size_t offset,
+    const build_iterator buffer)
+  {
+    partition_entries(first, last, offset, buffer);
 
-    /**
-     * Adds the keys of all nodes in this subtree to the given output iterator.
-     *
-     * @tparam O the type of the output iterator
-     * @param prefix the prefix of all keys in this subtree
-     * @param out the output iterator
-     */
-    template <typename O>
-    void get_keys(const std::string& prefix, O out) const
+    // entries whose keys end here belong to the given node and come first
+    const auto values_last = std::find_if(
+      first, last, [&](const auto& entry) { return entry.first.size() != offset; });
+    m_nodes[n].values.insert_all(first, values_last);
+    first = values_last;
+
+    auto last_child = no_node;
+    while (first != last)
     {
-      const auto key = prefix + m_key;
-      if (!m_values.empty())
+      // all entries whose keys continue with the same character go into the same child
+      const auto c = first->first[offset];
+      const auto group_last = std::find_if(
+        first, last, [&](const auto& entry) { return entry.first[offset] != c; });
+
+      // the key of the child is the longest common prefix of the group
+      const auto first_key = first->first.substr(offset);
+      auto prefix_length = first_key.size();
+      for (auto it = std::next(first); it != group_last && prefix_length > 1u; ++it)
       {
-        out++ = key;
+        prefix_length = std::min(
+          prefix_length, kdl::cs::str_mismatch(first_key, it->first.substr(offset)));
       }
 
-      for (const auto& child : m_children)
+      const auto child = allocate_node(std::string{first_key.substr(0u, prefix_length)});
+      if (last_child == no_node)
       {
-        child.get_keys(key, out);
-      }
-    }
-
-  private:
-    void insert_value(const V& value) const { m_values[value]++; }
-
-    bool remove_value(const V& value) const
-    {
-      auto it = m_values.find(value);
-      if (it == std::end(m_values))
-      {
-        return false;
+        m_nodes[n].first_child = child;
       }
       else
       {
-        if (--(it->second) == 0u)
-        {
-          m_values.erase(it);
-        }
-        return true;
+        m_nodes[last_child].next_sibling = child;
       }
-    }
+      m_nodes[n].child_count += 1u;
+      last_child = child;
 
-    /**
-     * Splits this node into two nodes at the given index of its key. For example, given a
-     * node n with key "abcd" and index 2, the following will happen:
-     * - n's key will be shortened to "ab"
-     * - a new node c will be created to n with key "cd"
-     * - all of n's children and values will be moved to c
-     * - c will be added to n's children
-     *
-     * Precondition: This node's key has at least two characters, and the index is chosen
-     * in such a way that neither of the resulting keys is empty.
-     *
-     * @param index the index at which to split the node's key
-     */
-    void split_node(const std::size_t index) const
-    {
-      assert(m_key.length() > 1u);
-
-      auto new_key = m_key.substr(0u, index);
-      auto remainder = m_key.substr(index);
-
-      assert(!new_key.empty());
-      assert(!remainder.empty());
+      build_subtree(child, first, group_last, offset + prefix_length, buffer);
+      first = group_last;
+    }
+  }
 
-      using std::swap;
-      node_set new_children;
-      swap(new_children, m_children);
+  /**
+   * Orders the given range of entries by the character at the given offset of their keys.
+   * Entries whose keys end at the given offset come first.
+   */
+  static void partition_entries(
+    const build_iterator first,
+    const build_iterator last,
+    const std::size_t offset,
+    const build_iterator buffer)
+  {
+    // bucket 0 holds the entries whose keys end at the offset
+    const auto bucket = [&](const auto& entry) -> std::size_t {
+      return entry.first.size() == offset
+               ? 0u
+               : std::size_t(static_cast<unsigned char>(entry.first[offset])) + 1u;
+    };
 
-      const node& new_child = *m_children.insert(node(std::move(remainder))).first;
-      swap(new_child.m_children, new_children);
-      swap(new_child.m_values, m_values);
+    const auto count = std::distance(first, last);
+    if (count < 64)
+    {
+      std::sort(first, last, [&](const auto& lhs, const auto& rhs) {
+        return bucket(lhs) < bucket(rhs);
+      });
+      return;
+    }
 
-      m_key = std::move(new_key);
+    auto bucket_starts = std::array<std::size_t, 258u>{};
+    for (auto it = first; it != last; ++it)
+    {
+      ++bucket_starts[bucket(*it) + 1u];
+    }
+    for (std::size_t i = 1u; i < bucket_starts.size(); ++i)
+    {
+      bucket_starts[i] += bucket_starts[i - 1u];
     }
 
-    /**
-     * Merges this node with its only child. Thereby, this child node's key is appended to
-     * this node's key, the child's children and values are moved to this node, and the
-     * child is removed.
-     *
-     * Precondition: This node has only one child, and this node has no values of its own.
-     */
-    void merge_node() const
+    for (auto it = first; it != last; ++it)
     {
-      assert(m_children.size() == 1u);
-      assert(m_values.empty());
+      *(buffer + std::ptrdiff_t(bucket_starts[bucket(*it)]++)) = *it;
+    }
+    std::copy(buffer, buffer + count, first);
+  }
 
-      using std::swap;
-      node_set old_children;
-      swap(old_children, m_children);
+  node_index allocate_node(std::string key)
+  {
+    if (!m_free_nodes.empty())
+    {
+      const auto n = m_free_nodes.back();
+      m_free_nodes.pop_back();
+      m_nodes[n].key = std::move(key);
+      return n;
+    }
 
-      const node& child = *std::begin(old_children);
-      swap(m_children, child.m_children);
-      swap(m_values, child.m_values);
+    m_nodes.emplace_back(std::move(key));
+    return m_nodes.size() - 1u;
+  }
 
-      m_key += child.m_key;
-    }
+  void free_node(const node_index n)
+  {
+    auto& current = m_nodes[n];
+    current.key.clear();
+    current.values.clear();
+    current.first_child = no_node;
+    current.next_sibling = no_node;
+    current.child_count = 0u;
+    m_free_nodes.push_back(n);
+  }
 
-    template <typename O>
-    void get_values(O out) const
+  /**
+   * Returns the child of the given node whose key starts with the given character, or
+   * `no_node` if there is no such child.
+   */
+  node_index find_child(const node_index n, const char c) const
+  {
+    for (auto child = m_nodes[n].first_child; child != no_node;
+         child = m_nodes[child].next_sibling)
     {
-      for (const auto& [value, count] : m_values)
+      const auto first = m_nodes[child].key[0];
+      if (first == c)
       {
-        for (std::size_t i = 0u; i < count; ++i)
-        {
-          out++ = value;
-        }
+        return child;
       }
-    }
-
-    template <typename O>
-    void get_values_and_recurse(O out) const
-    {
-      get_values(out);
-      for (const auto& child : m_children)
+      if (char_less(c, first))
       {
-        child.get_values_and_recurse(out);
+        break;
       }
     }
-  };
+    return no_node;
+  }
 
   /**
-   * Compares nodes against each other or nodes against strings.
-   *
-   * Two nodes are compared by their keys.
-   * A node is compared to a string by comparing its key to the string.
+   * Creates a new child of the given node with the given key and inserts it at the
+   * correct position among the node's children.
    *
-   * Two strings are compared by their first character only, soif two nodes share a
-   * non-empty prefix, they are considered equivalent. Therefore, the keys "ab" and "abc"
-   * are equivalent. Conversely, the keys "ab" and "bc" are not equivalent because they do
-   * not share a prefix, more specifically, "ab" is considered less than "bc".
-   *
-   * Precondition: the strings to copmare are not empty.
+   * Precondition: the node has no child whose key starts with the same character.
    */
-  struct node_cmp
+  node_index add_child(const node_index n, std::string key)
   {
-    using is_transparent = void;
+    const auto c = key[0];
+    const auto child = allocate_node(std::move(key));
 
-    bool operator()(const node& lhs, const node& rhs) const
+    auto previous = no_node;
+    auto next = m_nodes[n].first_child;
+    while (next != no_node && char_less(m_nodes[next].key[0], c))
     {
-      return compare(lhs.m_key, rhs.m_key);
+      previous = next;
+      next = m_nodes[next].next_sibling;
     }
 
-    bool operator()(const std::string_view lhs, const node& rhs) const
+    m_nodes[child].next_sibling = next;
+    if (previous == no_node)
     {
-      return compare(lhs, rhs.m_key);
+      m_nodes[n].first_child = child;
     }
-
-    bool operator()(const node& lhs, const std::string_view rhs) const
+    else
     {
-      return compare(lhs.m_key, rhs);
+      m_nodes[previous].next_sibling = child;
     }
+    m_nodes[n].child_count += 1u;
 
-    bool compare(const std::string_view lhs, const std::string_view& rhs) const
-    {
-      assert(!lhs.empty() && !rhs.empty());
-      return lhs[0] < rhs[0];
-    }
-  };
-
-private:
-  node m_root;
+    return child;
+  }
 
-public:
-  /**
-   * Creates a new empty trie.
-   */
-  compact_trie()
-    : m_root(node(""))
+  void remove_child(const node_index n, const node_index child)
   {
+    if (m_nodes[n].first_child == child)
+    {
+      m_nodes[n].first_child = m_nodes[child].next_sibling;
+    }
+    else
+    {
+      auto previous = m_nodes[n].first_child;
+      while (m_nodes[previous].next_sibling != child)
+      {
+        previous = m_nodes[previous].next_sibling;
+      }
+      m_nodes[previous].next_sibling = m_nodes[child].next_sibling;
+    }
+    m_nodes[n].child_count -= 1u;
+    free_node(child);
   }
 
   /**
-   * Inserts the given value under the given key.
+   * Splits the given node into two nodes at the given index of its key. For example,
+   * given a node n with key "abcd" and index 2, the following will happen:
+   * - n's key will be shortened to "ab"
+   * - a new node c will be created to n with key "cd"
+   * - all of n's children and values will be moved to c
+   * - c will become n's only child
    *
-   * @param key the key to insert
-   * @param value the value to insert
+   * Precondition: The node's key has at least two characters, and the index is chosen
+   * in such a way that neither of the resulting keys is empty.
    */
-  void insert(const std::string_view key, const V& value) { m_root.insert(key, value); }
+  void split_node(const node_index n, const std::size_t index)
+  {
+    assert(m_nodes[n].key.length() > 1u);
+    assert(index > 0u && index < m_nodes[n].key.length());
+
+    const auto child = allocate_node(m_nodes[n].key.substr(index));
+
+    auto& current = m_nodes[n];
+    auto& new_child = m_nodes[child];
+    new_child.values = std::move(current.values);
+    new_child.first_child = current.first_child;
+    new_child.child_count = current.child_count;
+
+    current.key.resize(index);
+    current.values = value_container{};
+    current.first_child = child;
+    current.child_count = 1u;
+  }
 
   /**
-   * Removes the given value using the given key.
+   * Merges the given node with its only child. Thereby, the child node's key is appended
+   * to the node's key, the child's children and values are moved to the node, and the
+   * child is removed.
    *
-   * @param key the key to remove
-   * @param value the value to remove
-   * @return `true` if the given value was found under the given key, and `false`
-   * otherwise
+   * Precondition: The node has only one child, and the node has no values of its own.
    */
-  bool remove(const std::string_view key, const V& value)
+  void merge_node(const node_index n)
   {
-    return m_root.remove(key, value);
-  }
+    assert(m_nodes[n].child_count == 1u);
+    assert(m_nodes[n].values.empty());
 
-  /**
-   * Clears this trie.
-   */
-  void clear() { m_root = node(""); }
+    const auto child = m_nodes[n].first_child;
+    auto& current = m_nodes[n];
+    auto& old_child = m_nodes[child];
+
+    current.key += old_child.key;
+    current.values = std::move(old_child.values);
+    current.first_child = old_child.first_child;
+    current.child_count = old_child.child_count;
+
+    old_child.first_child = no_node;
+    old_child.child_count = 0u;
+    free_node(child);
+  }
 
   /**
-   * Finds all values whose keys match the given glob pattern. See `kdl::str_matches_glob`
-   * for the definition and semantics of glob patterns and adds the values to the given
-   * output iterator.
+   * Finds every node in the given node's subtree whose keys match a pattern, and adds
+   * the values to the given output iterator.
    *
-   * @tparam O the type of the output iterator
+   * The keys are matched against a suffix of the given pattern starting at the given
+   * position. The matching algorithm uses an auxiliary `match_State` to prevent
+   * matching unnecessarily matching nodes. This state is updated in the following
+   * situations:
+   *
+   * - a node is visited for the first time
+   * - a node is matches the given pattern (this might also update the node's parent's
+   * states)
+   * - an entire subtree matches the given pattern (due to a trailing wildcard in the
+   * pattern)
+   *
+   * Using this information, the algorithm will stop matching a node if every node in
+   * its subtree was already matched against the pattern. Furthermore, it will not add a
+   * node's values multiple times if the node's key matches the pattern in more than one
+   * way. The latter situation can arise due to wildcards in the pattern.
+   *
+   * @tparam O the type of the given output iterator
+   * @param n the node to match
    * @param pattern the pattern to match
-   * @param out the output iterator
+   * @param pattern_position where to start matching the pattern
+   * @param parent the node's parent (used to update the match_state)
+   * @param match_state the match state
+   * @param out the output iterator to which the values of matched nodes are added
+   *
+   * @throws std::invalid_argument if the given pattern contains an invalid escape
+   * sequence
    */
   template <typename O>
-  void find_matches(const std::string_view pattern, O out) const
+  void find_matches(
+    const node_index n,
+    const std::string_view pattern,
+    const std::size_t pattern_position,
+    const node_index parent,
+    match_state& match_state,
+    O& out) const
   {
-    match_state match_state;
-    m_root.find_matches(pattern, {0u}, nullptr, match_state, out);
+    using match_task = std::pair<std::size_t, std::size_t>;
+
+    match_state.insert(n, parent);
+
+    const auto& key = m_nodes[n].key;
+    const auto match_children = [&](const std::size_t p_i, const auto& predicate) {
+      for (auto child = m_nodes[n].first_child; child != no_node;
+           child = m_nodes[child].next_sibling)
+      {
+        if (predicate(m_nodes[child].key[0]))
+        {
+          find_matches(child, pattern, p_i, n, match_state, out);
+        }
+      }
+    };
+    const auto any_char = [](const char) { return true; };
+    const auto digit = [](const char c) { return c >= '0' && c <= '9'; };
+
+    std::vector<match_task> match_tasks({{0u, pattern_position}});
+    while (!match_tasks.empty())
+    {
+      if (match_state.is_fully_matched(n))
+      {
+        // this node and all of its subtrees have been fully matched, so we are done
+        // here
+        return;
+      }
+
+      const auto [k_i, p_i] = match_tasks.back();
+      match_tasks.pop_back();
+
+      if (k_i == key.length() && p_i == pattern.length())
+      {
+        if (match_state.set_matched(n))
+        {
+          // this node was not matched yet, so fetch the results
+          m_nodes[n].values.get_values(out);
+        }
+
+        // there might still be children of this node that could be matched by a pending
+        // match task, so continue matching
+        continue;
+      }
+
+      if (p_i == pattern.length())
+      {
+        // the pattern is consumed by the key isn't, we cannot have a match here
+        continue;
+      }
+
+      // after this point, we can assume that the pattern is not consumed, but the key
+      // might be
+      if (pattern[p_i] == '\\' && p_i < pattern.length() - 1u)
+      {
+        // handle escaped characters in the pattern
+        const auto& c = pattern[p_i + 1u];
+
+        if (k_i < key.length())
+        {
+          // check the next character in the pattern against the next character in the
+          // key
+          if (c == '*' || c == '?' || c == '%' || c == '\\')
+          {
+            if (key[k_i] == c)
+            {
+              // the key matches the escaped character, continue
+              match_tasks.emplace_back(k_i + 1u, p_i + 2u);
+            }
+          }
+          else
+          {
+            throw std::invalid_argument("invalid escape sequence in pattern");
+          }
+        }
+        else
+        {
+          // the key is consumed, so continue matching at the children
+          match_children(p_i, [](const char first) {
+            return first == '*' || first == '?' || first == '%' || first == '\\';
+          });
+        }
+      }
+      else if (pattern[p_i] == '*')
+      {
+        // handle '*' in the pattern
+        if (p_i == pattern.length() - 1u)
+        {
+          // the pattern is consumed after the '*', so it matches all keys in this
+          // node's subtree
+          match_state.set_fully_matched(n);
+          get_values_and_recurse(n, out);
+          return;
+        }
+
+        if (k_i < key.length())
+        {
+          // '*' matches any character
+          // consume the '*' and continue matching at the current character of the key
+          match_tasks.emplace_back(k_i, p_i + 1u);
+          // consume the current character of the key and continue matching at '*'
+          match_tasks.emplace_back(k_i + 1u, p_i);
+        }
+        else
+        {
+          // the key is consumed, so continue matching at the children
+          match_children(p_i, any_char);
+        }
+      }
+      else if (pattern[p_i] == '?')
+      {
+        // handle '?' in the pattern
+        if (k_i < key.length())
+        {
+          // '?' matches any character, continue at the next chars in both the pattern
+          // and the key
+          match_tasks.emplace_back(k_i + 1u, p_i + 1u);
+        }
+        else
+        {
+          // the key is consumed, so continue matching at the children
+          match_children(p_i, any_char);
+        }
+      }
+      else if (pattern[p_i] == '%')
+      {
+        // handle '%' in the pattern
+        if (p_i < pattern.length() - 1u && pattern[p_i + 1u] == '*')
+        {
+          // handle "%*" in the pattern
+          // try to continue matching after "%*"
+          match_tasks.emplace_back(k_i, p_i + 2u);
+          if (k_i < key.length())
+          {
+            if (digit(key[k_i]))
+            {
+              // try to match more digits
+              match_tasks.emplace_back(k_i + 1u, p_i);
+            }
+          }
+          else
+          {
+            // the key is consumed, so continue matching at the children
+            match_children(p_i, digit);
+          }
+        }
+        else
+        {
+          if (k_i < key.length())
+          {
+            // handle '%' in the pattern (not followed by '*')
+            if (digit(key[k_i]))
+            {
+              // continue matching after the digit
+              match_tasks.emplace_back(k_i + 1u, p_i + 1u);
+            }
+          }
+          else
+          {
+            // the key is consumed, so continue matching at the children
+            match_children(p_i, digit);
+          }
+        }
+      }
+      else
+      {
+        if (k_i < key.length())
+        {
+          if (pattern[p_i] == key[k_i])
+          {
+            // handle a regular character in the pattern
+            match_tasks.emplace_back(k_i + 1u, p_i + 1u);
+          }
+        }
+        else
+        {
+          // the key is consumed, so continue matching at the child that starts with the
+          // current character of the pattern
+          const auto child = find_child(n, pattern[p_i]);
+          if (child != no_node)
+          {
+            find_matches(child, pattern, p_i, n, match_state, out);
+          }
+        }
+      }
+    }
   }
 
   /**
-   * Adds the keys of all nodes in this trie to the give output iterator.
+   * Adds the keys of all nodes in the given node's subtree to the given output iterator.
    *
    * @tparam O the type of the output iterator
+   * @param n the node
+   * @param prefix the prefix of all keys in the subtree
    * @param out the output iterator
    */
   template <typename O>
-  void get_keys(O out) const
+  void get_keys(const node_index n, const std::string& prefix, O& out) const
+  {
+    const auto key = prefix + m_nodes[n].key;
+    if (!m_nodes[n].values.empty())
+    {
+      out++ = key;
+    }
+
+    for (auto child = m_nodes[n].first_child; child != no_node;
+         child = m_nodes[child].next_sibling)
+    {
+      get_keys(child, key, out);
+    }
+  }
+
+  template <typename O>
+  void get_values_and_recurse(const node_index n, O& out) const
   {
-    m_root.get_keys("", out);
+    m_nodes[n].values.get_values(out);
+    for (auto child = m_nodes[n].first_child; child != no_node;
+         child = m_nodes[child].next_sibling)
+    {
+      get_values_and_recurse(child, out);
+    }
   }
 };
 } // namespace kdl
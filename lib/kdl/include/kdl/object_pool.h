@@ -0,0 +1,356 @@
+/*
+ Copyright 2026 agent
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace kdl
+{
+
+/**
+ * A process wide pool of fixed size memory blocks for objects of type T.
+ *
+ * Blocks are carved out of large chunks and are kept in free lists. Every thread has its
+ * own free list, so that allocating and deallocating a block is O(1) and does not
+ * require any synchronization. When a thread's free list runs empty, it takes a batch of
+ * free blocks from a shared depot, or if the depot is empty, it allocates a new chunk.
+ * When a thread's free list grows too long, e.g. because the thread deallocates blocks
+ * that were allocated by another thread, it returns a batch of blocks to the depot. When
+ * a thread exits, all of its free blocks are returned to the depot.
+ *
+ * The depot keeps track of the free blocks of each chunk. Once all blocks of a chunk have
+ * been returned to the depot, the chunk is released, unless the depot would then have
+ * fewer than a batch of free blocks left. When a thread exits, all unused chunks are
+ * released.
+ *
+ * @tparam T the type of the objects to allocate
+ */
+template <typename T>
+class object_pool
+{
+private:
+  union block
+  {
+    block* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  static constexpr std::size_t round_up_to_power_of_two(const std::size_t value)
+  {
+    auto result = std::size_t(1);
+    while (result < value)
+    {
+      result *= 2;
+    }
+    return result;
+  }
+
+  /**
+   * Chunks are aligned to their size so that the chunk of a block can be found by its
+   * address.
+   */
+  static constexpr std::size_t chunk_size =
+    round_up_to_power_of_two(std::max(std::size_t(65536), 64 * sizeof(block)));
+
+  static constexpr std::size_t blocks_per_chunk = chunk_size / sizeof(block);
+
+  /**
+   * The maximum number of blocks that are moved between a thread's free list and the
+   * depot at once.
+   */
+  static constexpr std::size_t batch_size = blocks_per_chunk;
+
+  struct free_list
+  {
+    block* first = nullptr;
+    std::size_t size = 0;
+
+    void push(block* b)
+    {
+      b->next = first;
+      first = b;
+      ++size;
+    }
+
+    block* pop()
+    {
+      auto* b = first;
+      first = b->next;
+      --size;
+      return b;
+    }
+
+    free_list split(const std::size_t count)
+    {
+      auto result = free_list{first, count};
+
+      auto* last = first;
+      for (std::size_t i = 1; i < count; ++i)
+      {
+        last = last->next;
+      }
+
+      first = last->next;
+      size -= count;
+      last->next = nullptr;
+      return result;
+    }
+  };
+
+  struct depot
+  {
+    std::mutex mutex;
+
+    /**
+     * The free blocks of every chunk, by the chunk's address.
+     */
+    std::unordered_map<std::uintptr_t, free_list> chunks;
+
+    /**
+     * The addresses of the chunks that have free blocks.
+     */
+    std::unordered_set<std::uintptr_t> available_chunks;
+
+    std::size_t free_block_count = 0;
+
+    static std::uintptr_t chunk_address(const block* b)
+    {
+      return reinterpret_cast<std::uintptr_t>(b) & ~std::uintptr_t(chunk_size - 1);
+    }
+
+    free_list take()
+    {
+      const auto lock = std::lock_guard{mutex};
+      if (available_chunks.empty())
+      {
+        allocate_chunk();
+      }
+
+      auto result = free_list{};
+      while (result.size < batch_size && !available_chunks.empty())
+      {
+        const auto address = *available_chunks.begin();
+        auto& chunk_blocks = chunks[address];
+        while (result.size < batch_size && chunk_blocks.size > 0)
+        {
+          result.push(chunk_blocks.pop());
+        }
+        if (chunk_blocks.size == 0)
+        {
+          available_chunks.erase(address);
+        }
+      }
+
+      free_block_count -= result.size;
+      return result;
+    }
+
+    void put(free_list list, const bool release_all_unused)
+    {
+      if (list.size > 0)
+      {
+        const auto lock = std::lock_guard{mutex};
+        free_block_count += list.size;
+
+        while (list.size > 0)
+        {
+          auto* b = list.pop();
+          const auto address = chunk_address(b);
+          auto& chunk_blocks = chunks[address];
+          chunk_blocks.push(b);
+          if (chunk_blocks.size == 1)
+          {
+            available_chunks.insert(address);
+          }
+          if (
+            chunk_blocks.size == blocks_per_chunk
+            && (release_all_unused || free_block_count >= blocks_per_chunk + batch_size))
+          {
+            release_chunk(address);
+          }
+        }
+      }
+
+      if (release_all_unused)
+      {
+        const auto lock = std::lock_guard{mutex};
+        for (auto it = chunks.begin(); it != chunks.end();)
+        {
+          const auto address = it->first;
+          const auto unused = it->second.size == blocks_per_chunk;
+          ++it;
+
+          if (unused)
+          {
+            release_chunk(address);
+          }
+        }
+      }
+    }
+
+    std::size_t chunk_count()
+    {
+      const auto lock = std::lock_guard{mutex};
+      return chunks.size();
+    }
+
+  private:
+    void allocate_chunk()
+    {
+      auto* chunk = static_cast<block*>(
+        ::operator new(chunk_size, std::align_val_t{chunk_size}));
+
+      auto& chunk_blocks = chunks[chunk_address(chunk)];
+      for (std::size_t i = 0; i < blocks_per_chunk; ++i)
+      {
+        chunk_blocks.push(&chunk[blocks_per_chunk - i - 1]);
+      }
+
+      available_chunks.insert(chunk_address(chunk));
+      free_block_count += blocks_per_chunk;
+    }
+
+    void release_chunk(const std::uintptr_t address)
+    {
+      chunks.erase(address);
+      available_chunks.erase(address);
+      free_block_count -= blocks_per_chunk;
+
+      ::operator delete(
+        reinterpret_cast<void*>(address), chunk_size, std::align_val_t{chunk_size});
+    }
+  };
+
+  struct thread_cache
+  {
+    free_list blocks;
+
+    ~thread_cache()
+    {
+      get_depot().put(blocks, true);
+      t_cache_destroyed = true;
+    }
+  };
+
+  // set when the calling thread's cache was destroyed during thread exit
+  static inline thread_local bool t_cache_destroyed = false;
+
+  static depot& get_depot()
+  {
+    // never destroyed so that objects can be deallocated during static destruction
+    static auto* d = new depot{};
+    return *d;
+  }
+
+  static thread_cache& get_thread_cache()
+  {
+    static thread_local auto cache = thread_cache{};
+    return cache;
+  }
+
+public:
+  /**
+   * Returns a block of memory that can hold an object of type T.
+   */
+  static void* allocate()
+  {
+    if (t_cache_destroyed)
+    {
+      auto list = get_depot().take();
+      auto* b = list.pop();
+      get_depot().put(list, true);
+      return b;
+    }
+
+    auto& cache = get_thread_cache();
+    if (cache.blocks.size == 0)
+    {
+      cache.blocks = get_depot().take();
+    }
+    return cache.blocks.pop();
+  }
+
+  /**
+   * Returns the given block of memory to this pool.
+   *
+   * @param ptr a pointer that was returned by allocate()
+   */
+  static void deallocate(void* ptr)
+  {
+    auto* b = static_cast<block*>(ptr);
+    if (t_cache_destroyed)
+    {
+      auto list = free_list{};
+      list.push(b);
+      get_depot().put(list, true);
+      return;
+    }
+
+    auto& cache = get_thread_cache();
+    cache.blocks.push(b);
+    if (cache.blocks.size >= 2 * batch_size)
+    {
+      get_depot().put(cache.blocks.split(batch_size), false);
+    }
+  }
+
+  /**
+   * Returns the number of chunks that are currently allocated by this pool.
+   */
+  static std::size_t chunk_count() { return get_depot().chunk_count(); }
+};
+
+/**
+ * Base class that makes a type allocate its instances from an object_pool.
+ *
+ * Instances of subclasses of T are allocated with the global operator new.
+ *
+ * @tparam T the type that derives from this class
+ */
+template <typename T>
+class pool_allocated
+{
+public:
+  static void* operator new(const std::size_t size)
+  {
+    return size == sizeof(T) ? object_pool<T>::allocate() : ::operator new(size);
+  }
+
+  static void operator delete(void* ptr, const std::size_t size)
+  {
+    if (size == sizeof(T))
+    {
+      object_pool<T>::deallocate(ptr);
+    }
+    else
+    {
+      ::operator delete(ptr);
+    }
+  }
+};
+
+} // namespace kdl
@@ -20,102 +20,195 @@
 
 #pragma once
 
+#include "kdl/thread_pool.h"
 #include "kdl/vector_utils.h"
 
-#ifdef _WIN32
-#include <ppl.h>
-#endif
-
+#include <algorithm>
 #include <atomic>
-#include <future> // for std::async
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <thread>
 #include <utility> // for std::declval
 #include <vector>
 
 namespace kdl
 {
+namespace detail
+{
+struct parallel_for_state
+{
+  std::atomic<size_t> next_chunk = 0;
+  std::atomic<size_t> finished_chunks = 0;
+  std::atomic<bool> failed = false;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::exception_ptr exception;
+};
+
+template <class L>
+void run_parallel_for_chunks(
+  parallel_for_state& state,
+  L* lambda,
+  const size_t count,
+  const size_t grain_size,
+  const size_t chunk_count)
+{
+  while (true)
+  {
+    const auto chunk = state.next_chunk++;
+    if (chunk >= chunk_count)
+    {
+      return;
+    }
+
+    if (!state.failed)
+    {
+      try
+      {
+        const auto first = chunk * grain_size;
+        const auto last = std::min(first + grain_size, count);
+        for (auto i = first; i < last; ++i)
+        {
+          (*lambda)(i);
+        }
+      }
+      catch (...)
+      {
+        const auto lock = std::lock_guard{state.mutex};
+        if (!state.exception)
+        {
+          state.exception = std::current_exception();
+        }
+        state.failed = true;
+      }
+    }
+
+    if (++state.finished_chunks == chunk_count)
+    {
+      const auto lock = std::lock_guard{state.mutex};
+      state.condition.notify_all();
+    }
+  }
+}
+} // namespace detail
+
 /**
  * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
  *
- * Lambda is executed in parallel, using the number of threads returned by
- * std::thread::hardware_concurrency().
+ * The index range is split into chunks of `grain_size` consecutive indices. The chunks
+ * are executed by the given thread pool and by the calling thread, which takes part in
+ * the work and returns once all chunks are done. Since the calling thread never waits for
+ * a chunk that has not been started by another thread, parallel_for can be called from
+ * within a lambda that is run by parallel_for.
  *
- * Because the threads are spawned with std::async(std::launch::async, ...) and no thread
- * pool is used, there is a relatively large overhead and this should only be used on
- * large/slow to process data sets.
+ * If the lambda throws an exception, the remaining chunks are skipped and the first
+ * exception is rethrown by parallel_for.
  *
  * @tparam L type of lambda
+ * @param pool the thread pool to use
  * @param count the maximum value (exclusive) to pass to lambda
  * @param lambda the lambda to run
+ * @param grain_size the number of indices per chunk, if 0, a grain size is chosen that
+ * creates a few chunks per thread
  */
 template <class L>
-void parallel_for(const size_t count, L&& lambda)
+void parallel_for(
+  thread_pool& pool, const size_t count, L&& lambda, size_t grain_size = 0)
 {
-#ifdef _WIN32
-  concurrency::parallel_for<size_t>(0, count, lambda);
-#else
-  size_t numThreads = static_cast<size_t>(std::thread::hardware_concurrency());
-  if (numThreads == 0)
+  if (count == 0)
+  {
+    return;
+  }
+
+  const auto thread_count = pool.thread_count() + 1;
+  if (grain_size == 0)
   {
-    numThreads = 1;
+    grain_size = std::max(count / (thread_count * 4), size_t(1));
   }
 
-  std::atomic<size_t> nextIndex(0);
+  const auto chunk_count = (count + grain_size - 1) / grain_size;
+  if (chunk_count == 1 || thread_count == 1)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      lambda(i);
+    }
+    return;
+  }
 
-  std::vector<std::future<void>> threads;
-  threads.resize(numThreads);
+  auto state = std::make_shared<detail::parallel_for_state>();
+  auto* lambda_ptr = &lambda;
 
-  for (size_t i = 0; i < numThreads; ++i)
+  const auto helper_count = std::min(pool.thread_count(), chunk_count - 1);
+  for (size_t i = 0; i < helper_count; ++i)
   {
-    threads[i] = std::async(std::launch::async, [&]() {
-      while (true)
-      {
-        const size_t ourIndex = std::atomic_fetch_add(&nextIndex, static_cast<size_t>(1));
-        if (ourIndex >= count)
-        {
-          break;
-        }
-        lambda(ourIndex);
-      }
+    // a helper that starts after all chunks are taken returns without calling lambda
+    pool.submit([=]() {
+      detail::run_parallel_for_chunks(*state, lambda_ptr, count, grain_size, chunk_count);
     });
   }
 
-  for (size_t i = 0; i < numThreads; ++i)
+  detail::run_parallel_for_chunks(*state, lambda_ptr, count, grain_size, chunk_count);
+
+  {
+    auto lock = std::unique_lock{state->mutex};
+    state->condition.wait(lock, [&]() { return state->finished_chunks == chunk_count; });
+  }
+
+  if (state->exception)
   {
-    threads[i].wait();
+    std::rethrow_exception(state->exception);
   }
-#endif
+}
+
+/**
+ * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
+ *
+ * The lambda is executed in parallel by the process wide thread pool, see
+ * default_thread_pool().
+ *
+ * @tparam L type of lambda
+ * @param count the maximum value (exclusive) to pass to lambda
+ * @param lambda the lambda to run
+ * @param grain_size the number of indices per chunk, if 0, a grain size is chosen
+ * automatically
+ */
+template <class L>
+void parallel_for(const size_t count, L&& lambda, const size_t grain_size = 0)
+{
+  parallel_for(default_thread_pool(), count, std::forward<L>(lambda), grain_size);
 }
 
 /**
  * Applies the given lambda to each element of the input (passing elements as rvalue
  * references), and returns a vector of the resulting values, in their original order.
  *
- * The lambda is executed in parallel, using the number of threads returned by
- * std::thread::hardware_concurrency().
- *
- * Because the threads are spawned with std::async(std::launch::async, ...) and no thread
- * pool is used, there is a relatively large overhead and this should only be used on
- * large/slow to process data sets.
+ * The lambda is executed in parallel by the process wide thread pool, see parallel_for.
  *
  * @tparam T the type of the vector elements
  * @tparam L the type of the lambda to apply
  * @param input the vector
  * @param transform the lambda to apply, must be of type `auto(T&&)`
+ * @param grain_size the number of elements per chunk, if 0, a grain size is chosen
+ * automatically
  * @return a vector containing the transformed values
  */
 template <class T, class L>
-auto vec_parallel_transform(std::vector<T> input, L&& transform)
+auto vec_parallel_transform(
+  std::vector<T> input, L&& transform, const size_t grain_size = 0)
 {
   using ResultType = std::optional<decltype(transform(std::declval<T&&>()))>;
 
   std::vector<ResultType> result;
   result.resize(input.size());
 
-  parallel_for(input.size(), [&](const size_t index) {
-    result[index] = transform(std::move(input[index]));
-  });
+  parallel_for(
+    input.size(),
+    [&](const size_t index) { result[index] = transform(std::move(input[index])); },
+    grain_size);
 
   return vec_transform(std::move(result), [](ResultType&& x) { return std::move(*x); });
 }
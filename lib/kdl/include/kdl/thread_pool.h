@@ -0,0 +1,222 @@
+/*
+ Copyright 2026 agent
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace kdl
+{
+
+/**
+ * A fixed size pool of worker threads.
+ *
+ * Every worker owns a task queue. Tasks submitted from a worker thread are pushed to
+ * that worker's queue, while tasks submitted from any other thread are distributed
+ * among the queues in a round robin fashion. A worker takes tasks from the back of its
+ * own queue, and if that is empty, it steals tasks from the front of the other workers'
+ * queues.
+ *
+ * Tasks must not throw exceptions. The pool's destructor waits until all pending tasks
+ * have been executed.
+ */
+class thread_pool
+{
+private:
+  using task = std::function<void()>;
+
+  struct task_queue
+  {
+    std::mutex mutex;
+    std::deque<task> tasks;
+  };
+
+  std::vector<std::unique_ptr<task_queue>> m_queues;
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  size_t m_pending_tasks = 0;
+  bool m_stop = false;
+
+  std::atomic<size_t> m_next_queue = 0;
+
+  static inline thread_local const thread_pool* t_current_pool = nullptr;
+  static inline thread_local size_t t_current_queue = 0;
+
+public:
+  /**
+   * Creates a pool with the given number of worker threads.
+   */
+  explicit thread_pool(const size_t thread_count)
+  {
+    m_queues.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+      m_queues.push_back(std::make_unique<task_queue>());
+    }
+
+    m_threads.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+      m_threads.emplace_back([this, i]() { run(i); });
+    }
+  }
+
+  ~thread_pool()
+  {
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      m_stop = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * Returns the number of worker threads of this pool.
+   */
+  size_t thread_count() const { return m_threads.size(); }
+
+  /**
+   * Indicates whether the calling thread is one of this pool's workers.
+   */
+  bool is_worker_thread() const { return t_current_pool == this; }
+
+  /**
+   * Schedules the given task for execution by one of the workers.
+   *
+   * If this pool has no workers, the task is executed immediately.
+   */
+  void submit(task t)
+  {
+    if (m_queues.empty())
+    {
+      t();
+      return;
+    }
+
+    // increment the counter before pushing the task so that it can never underflow
+    // when a worker takes the task right away
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      ++m_pending_tasks;
+    }
+
+    const auto queue_index = is_worker_thread() ? t_current_queue
+                                                : m_next_queue++ % m_queues.size();
+    {
+      auto& queue = *m_queues[queue_index];
+      const auto lock = std::lock_guard{queue.mutex};
+      queue.tasks.push_back(std::move(t));
+    }
+
+    m_condition.notify_one();
+  }
+
+private:
+  std::optional<task> pop(const size_t queue_index)
+  {
+    // take the most recently submitted task from our own queue
+    {
+      auto& queue = *m_queues[queue_index];
+      const auto lock = std::lock_guard{queue.mutex};
+      if (!queue.tasks.empty())
+      {
+        auto t = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return t;
+      }
+    }
+
+    // steal the oldest task from another queue
+    for (size_t i = 1; i < m_queues.size(); ++i)
+    {
+      auto& queue = *m_queues[(queue_index + i) % m_queues.size()];
+      const auto lock = std::lock_guard{queue.mutex};
+      if (!queue.tasks.empty())
+      {
+        auto t = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return t;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  void run(const size_t queue_index)
+  {
+    t_current_pool = this;
+    t_current_queue = queue_index;
+
+    while (true)
+    {
+      if (auto t = pop(queue_index))
+      {
+        {
+          const auto lock = std::lock_guard{m_mutex};
+          --m_pending_tasks;
+        }
+        (*t)();
+        continue;
+      }
+
+      auto lock = std::unique_lock{m_mutex};
+      m_condition.wait(lock, [&]() { return m_stop || m_pending_tasks > 0; });
+      if (m_stop && m_pending_tasks == 0)
+      {
+        return;
+      }
+    }
+  }
+};
+
+/**
+ * Returns the process wide thread pool used by parallel_for and vec_parallel_transform.
+ *
+ * Since the calling thread takes part in the work, the pool has one thread less than the
+ * hardware supports.
+ */
+inline thread_pool& default_thread_pool()
+{
+  static auto pool = thread_pool{
+    std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(2)) - 1};
+  return pool;
+}
+
+} // namespace kdl
@@ -208,4 +208,98 @@ TEST_CASE("compact_trie_test.get_keys")
     Catch::UnorderedEquals(
       std::vector<std::string>{"key", "key2", "key22", "key22bs", "k1"}));
 }
+
+TEST_CASE("compact_trie_test.build")
+{
+  const auto entries = std::vector<std::pair<std::string, std::string>>{
+    {"key", "value"},
+    {"key2", "value"},
+    {"key22", "value2"},
+    {"k1", "value3"},
+    {"test", "value4"},
+    {"key2", "value"},
+    {"", "value5"},
+  };
+
+  const auto index = test_index::build(entries);
+
+  assertMatches(index, "whoops", {});
+  assertMatches(index, "", {"value5"});
+  assertMatches(index, "key2", {"value", "value"});
+  assertMatches(index, "key22*", {"value2"});
+  assertMatches(index, "key%*", {"value", "value", "value", "value2"});
+  assertMatches(index, "k*2", {"value", "value", "value2"});
+  assertMatches(index, "test%*", {"value4"});
+  assertMatches(
+    index, "*", {"value", "value", "value", "value2", "value3", "value4", "value5"});
+
+  std::vector<std::string> keys;
+  index.get_keys(std::back_inserter(keys));
+  CHECK_THAT(
+    keys,
+    Catch::UnorderedEquals(
+      std::vector<std::string>{"", "key", "key2", "key22", "k1", "test"}));
+}
+
+TEST_CASE("compact_trie_test.build_then_modify")
+{
+  const auto entries = std::vector<std::pair<std::string, std::string>>{
+    {"andrew", "value"},
+    {"andreas", "value"},
+    {"andrar", "value2"},
+    {"andrary", "value3"},
+    {"andy", "value4"},
+  };
+
+  auto index = test_index::build(entries);
+  assertMatches(index, "*", {"value", "value", "value2", "value3", "value4"});
+
+  CHECK(index.remove("andrary", "value3"));
+  CHECK(index.remove("andy", "value4"));
+  assertMatches(index, "andr*", {"value", "value", "value2"});
+
+  index.insert("andra", "value5");
+  index.insert("anders", "value6");
+  assertMatches(index, "andr?", {"value5"});
+  assertMatches(index, "and*s", {"value", "value6"});
+
+  CHECK(index.remove("andreas", "value"));
+  CHECK(index.remove("andrew", "value"));
+  CHECK(index.remove("andrar", "value2"));
+  CHECK(index.remove("andra", "value5"));
+  assertMatches(index, "*", {"value6"});
+
+  index.clear();
+  assertMatches(index, "*", {});
+}
+
+TEST_CASE("compact_trie_test.build_matches_insert")
+{
+  auto entries = std::vector<std::pair<std::string, std::string>>{};
+  for (std::size_t i = 0u; i < 500u; ++i)
+  {
+    entries.emplace_back(
+      "prefix_" + std::to_string(i % 37u) + "_" + std::to_string(i),
+      std::to_string(i % 20u));
+  }
+
+  auto inserted = test_index{};
+  for (const auto& [key, value] : entries)
+  {
+    inserted.insert(key, value);
+  }
+  const auto built = test_index::build(entries);
+
+  for (const auto& pattern :
+       {"*", "prefix_1*", "prefix_%_%", "prefix_%*_1?", "*_3", "prefix_2_2"})
+  {
+    std::vector<std::string> expected;
+    inserted.find_matches(pattern, std::back_inserter(expected));
+
+    std::vector<std::string> actual;
+    built.find_matches(pattern, std::back_inserter(actual));
+
+    CHECK_THAT(actual, Catch::UnorderedEquals(expected));
+  }
+}
 } // namespace kdl
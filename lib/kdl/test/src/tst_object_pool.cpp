@@ -0,0 +1,205 @@
+/*
+ Copyright 2026 agent
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/object_pool.h"
+
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+namespace
+{
+struct pooled : public pool_allocated<pooled>
+{
+  int value;
+  explicit pooled(const int i_value)
+    : value{i_value}
+  {
+  }
+};
+
+struct chunked : public pool_allocated<chunked>
+{
+  int value;
+  explicit chunked(const int i_value)
+    : value{i_value}
+  {
+  }
+};
+
+struct derived_from_pooled : public pooled
+{
+  double extra;
+  explicit derived_from_pooled(const int i_value, const double i_extra)
+    : pooled{i_value}
+    , extra{i_extra}
+  {
+  }
+};
+} // namespace
+
+TEST_CASE("object_pool.allocate")
+{
+  auto objects = std::vector<std::unique_ptr<pooled>>{};
+  for (int i = 0; i < 10000; ++i)
+  {
+    objects.push_back(std::make_unique<pooled>(i));
+  }
+
+  auto addresses = std::set<const pooled*>{};
+  for (int i = 0; i < 10000; ++i)
+  {
+    CHECK(objects[size_t(i)]->value == i);
+    addresses.insert(objects[size_t(i)].get());
+  }
+  CHECK(addresses.size() == objects.size());
+}
+
+TEST_CASE("object_pool.reuse")
+{
+  auto* first = new pooled{1};
+  delete first;
+
+  auto* second = new pooled{2};
+  CHECK(second == first);
+  CHECK(second->value == 2);
+  delete second;
+}
+
+TEST_CASE("object_pool.subclass")
+{
+  auto derived = std::make_unique<derived_from_pooled>(1, 2.0);
+  CHECK(derived->value == 1);
+  CHECK(derived->extra == 2.0);
+
+  auto base = std::unique_ptr<pooled>{std::make_unique<pooled>(3)};
+  CHECK(base->value == 3);
+}
+
+TEST_CASE("object_pool.deallocate_on_other_thread")
+{
+  constexpr auto count = 20000;
+
+  auto objects = std::vector<pooled*>{};
+  auto producer = std::thread{[&]() {
+    for (int i = 0; i < count; ++i)
+    {
+      objects.push_back(new pooled{i});
+    }
+  }};
+  producer.join();
+
+  auto consumer = std::thread{[&]() {
+    for (int i = 0; i < count; ++i)
+    {
+      CHECK(objects[size_t(i)]->value == i);
+      delete objects[size_t(i)];
+    }
+  }};
+  consumer.join();
+
+  // the freed blocks must be available again
+  for (int i = 0; i < count; ++i)
+  {
+    objects[size_t(i)] = new pooled{i};
+  }
+  for (auto* object : objects)
+  {
+    delete object;
+  }
+}
+
+TEST_CASE("object_pool.allocate_and_deallocate_does_not_grow_chunks")
+{
+  constexpr auto count = 20000;
+
+  const auto allocate_and_deallocate = [&]() {
+    auto objects = std::vector<chunked*>{};
+    for (int i = 0; i < count; ++i)
+    {
+      objects.push_back(new chunked{i});
+    }
+    for (auto* object : objects)
+    {
+      delete object;
+    }
+  };
+
+  allocate_and_deallocate();
+  const auto chunk_count = object_pool<chunked>::chunk_count();
+  CHECK(chunk_count > 0u);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    allocate_and_deallocate();
+    CHECK(object_pool<chunked>::chunk_count() <= chunk_count);
+  }
+
+  // objects allocated on one thread and deallocated on another
+  for (int i = 0; i < 10; ++i)
+  {
+    auto objects = std::vector<chunked*>{};
+    auto producer = std::thread{[&]() {
+      for (int j = 0; j < count; ++j)
+      {
+        objects.push_back(new chunked{j});
+      }
+    }};
+    producer.join();
+
+    auto consumer = std::thread{[&]() {
+      for (auto* object : objects)
+      {
+        delete object;
+      }
+    }};
+    consumer.join();
+
+    CHECK(object_pool<chunked>::chunk_count() <= chunk_count);
+  }
+}
+
+TEST_CASE("object_pool.release_chunks_on_thread_exit")
+{
+  const auto chunk_count = object_pool<chunked>::chunk_count();
+
+  auto worker = std::thread{[&]() {
+    auto objects = std::vector<chunked*>{};
+    for (int i = 0; i < 100000; ++i)
+    {
+      objects.push_back(new chunked{i});
+    }
+    CHECK(object_pool<chunked>::chunk_count() > chunk_count);
+
+    for (auto* object : objects)
+    {
+      delete object;
+    }
+  }};
+  worker.join();
+
+  CHECK(object_pool<chunked>::chunk_count() <= chunk_count);
+}
+} // namespace kdl
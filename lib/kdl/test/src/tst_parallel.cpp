@@ -21,11 +21,13 @@
 #include "test_utils.h"
 
 #include "kdl/parallel.h"
+#include "kdl/thread_pool.h"
 
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -73,6 +75,85 @@ TEST_CASE("for 10000")
   }
 }
 
+TEST_CASE("for with grain size")
+{
+  constexpr size_t TestSize = 1'001;
+
+  auto pool = thread_pool{3};
+  for (const auto grainSize : {size_t(0), size_t(1), size_t(7), size_t(1'000), size_t(5'000)})
+  {
+    auto counts = std::vector<std::atomic<size_t>>(TestSize);
+    kdl::parallel_for(
+      pool, TestSize, [&](const size_t i) { ++counts[i]; }, grainSize);
+
+    for (size_t i = 0; i < TestSize; ++i)
+    {
+      CHECK(counts[i] == 1u);
+    }
+  }
+}
+
+TEST_CASE("nested for")
+{
+  constexpr size_t OuterSize = 20;
+  constexpr size_t InnerSize = 100;
+
+  auto pool = thread_pool{2};
+  auto counter = std::atomic<size_t>{0};
+  kdl::parallel_for(
+    pool,
+    OuterSize,
+    [&](const size_t) {
+      kdl::parallel_for(
+        pool, InnerSize, [&](const size_t) { ++counter; }, 1);
+    },
+    1);
+
+  CHECK(counter == OuterSize * InnerSize);
+}
+
+TEST_CASE("for rethrows exception")
+{
+  auto pool = thread_pool{2};
+  CHECK_THROWS_AS(
+    kdl::parallel_for(
+      pool,
+      100,
+      [](const size_t i) {
+        if (i == 50)
+        {
+          throw std::runtime_error{"error"};
+        }
+      },
+      1),
+    std::runtime_error);
+
+  // the pool is still usable
+  auto counter = std::atomic<size_t>{0};
+  kdl::parallel_for(pool, 100, [&](const size_t) { ++counter; });
+  CHECK(counter == 100u);
+}
+
+TEST_CASE("thread pool runs submitted tasks")
+{
+  auto counter = std::atomic<size_t>{0};
+  {
+    auto pool = thread_pool{3};
+    CHECK(pool.thread_count() == 3u);
+    CHECK_FALSE(pool.is_worker_thread());
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+      pool.submit([&]() { ++counter; });
+    }
+  }
+  CHECK(counter == 100u);
+
+  auto pool = thread_pool{0};
+  pool.submit([&]() { ++counter; });
+  CHECK(counter == 101u);
+}
+
 TEST_CASE("transform")
 {
   const auto L = [](const int& v) { return v * 10; };
@@ -0,0 +1,237 @@
+/*
+ Copyright 2026 agent
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "vm/batch.h"
+#include "vm/bbox.h"
+#include "vm/forward.h"
+#include "vm/intersection.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/plane.h"
+#include "vm/ray.h"
+#include "vm/simd.h"
+#include "vm/vec.h"
+
+#include "benchmark_utils.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace vm
+{
+namespace
+{
+constexpr std::size_t Count = 100'000;
+constexpr std::size_t Repetitions = 100;
+
+std::vector<vec3f> make_points(std::mt19937& rng)
+{
+  auto dist = std::uniform_real_distribution<float>{-1000.0f, 1000.0f};
+
+  auto result = std::vector<vec3f>{};
+  result.reserve(Count);
+  for (std::size_t i = 0; i < Count; ++i)
+  {
+    result.emplace_back(dist(rng), dist(rng), dist(rng));
+  }
+  return result;
+}
+
+std::vector<bbox3f> make_boxes(std::mt19937& rng)
+{
+  auto size_dist = std::uniform_real_distribution<float>{1.0f, 64.0f};
+
+  auto result = std::vector<bbox3f>{};
+  result.reserve(Count);
+  for (const auto& center : make_points(rng))
+  {
+    const auto size = vec3f{size_dist(rng), size_dist(rng), size_dist(rng)};
+    result.emplace_back(center - size, center + size);
+  }
+  return result;
+}
+
+std::string describe(const std::string& name)
+{
+  return name + ", " + std::to_string(Repetitions) + " x " + std::to_string(Count);
+}
+
+std::string describe_simd(const std::string& name)
+{
+  return describe(name + " (" + detail::simd_instruction_set() + ")");
+}
+} // namespace
+
+TEST_CASE("batch intersect_ray_bbox")
+{
+  auto rng = std::mt19937{};
+  const auto boxes = make_boxes(rng);
+  const auto boxes_soa = bbox_soa<float, 3>{boxes};
+  const auto r = ray3f{vec3f{-2000, -1500, -1000}, normalize(vec3f{4, 3, 2})};
+
+  auto distances = std::vector<float>(Count);
+  const auto count_hits = [&]() {
+    return std::size_t(std::count_if(
+      distances.begin(), distances.end(), [](const auto d) { return !is_nan(d); }));
+  };
+
+  auto scalar_hits = std::size_t(0);
+  time_lambda(
+    [&]() {
+      for (std::size_t i = 0; i < Repetitions; ++i)
+      {
+        for (std::size_t j = 0; j < Count; ++j)
+        {
+          distances[j] = intersect_ray_bbox(r, boxes[j]).value_or(nan<float>());
+        }
+        scalar_hits += count_hits();
+      }
+    },
+    describe("one at a time"));
+
+  auto batch_hits = std::size_t(0);
+  time_lambda(
+    [&]() {
+      for (std::size_t i = 0; i < Repetitions; ++i)
+      {
+        detail::intersect_ray_bbox_batch<detail::scalar_ops<float>>(
+          r, boxes_soa, distances.data(), 0, Count);
+        batch_hits += count_hits();
+      }
+    },
+    describe("batch without SIMD"));
+
+  time_lambda(
+    [&]() {
+      for (std::size_t i = 0; i < Repetitions; ++i)
+      {
+        intersect_ray_bbox(r, boxes_soa, distances.data());
+        batch_hits += count_hits();
+      }
+    },
+    describe_simd("batch"));
+
+  CHECK(batch_hits == 2 * scalar_hits);
+}
+
+TEST_CASE("batch point_status")
+{
+  auto rng = std::mt19937{};
+  const auto points = make_points(rng);
+  const auto points_soa = vec_soa<float, 3>{points};
+  const auto p = plane3f{10.0f, normalize(vec3f{1, 2, 3})};
+
+  auto result = std::vector<plane_status>(Count);
+  const auto count_above = [&]() {
+    return std::size_t(std::count(result.begin(), result.end(), plane_status::above));
+  };
+
+  auto scalar_above = std::size_t(0);
+  time_lambda(
+    [&]() {
+      for (std::size_t i = 0; i < Repetitions; ++i)
+      {
+        for (std::size_t j = 0; j < Count; ++j)
+        {
+          result[j] = p.point_status(points[j]);
+        }
+        scalar_above += count_above();
+      }
+    },
+    describe("one at a time"));
+
+  auto batch_above = std::size_t(0);
+  time_lambda(
+    [&]() {
+      for (std::size_t i = 0; i < Repetitions; ++i)
+      {
+        detail::point_status_batch<detail::scalar_ops<float>>(
+          p,
+          points_soa,
+          result.data(),
+          constants<float>::point_status_epsilon(),
+          0,
+          Count);
+        batch_above += count_above();
+      }
+    },
+    describe("batch without SIMD"));
+
+  time_lambda(
+    [&]() {
+      for (std::size_t i = 0; i < Repetitions; ++i)
+      {
+        point_status(p, points_soa, result.data());
+        batch_above += count_above();
+      }
+    },
+    describe_simd("batch"));
+
+  CHECK(batch_above == 2 * scalar_above);
+}
+
+TEST_CASE("batch transform")
+{
+  auto rng = std::mt19937{};
+  const auto points = make_points(rng);
+  const auto points_soa = vec_soa<float, 3>{points};
+  const auto m = translation_matrix(vec3f{1, 2, 3})
+                 * rotation_matrix(vec3f::pos_z(), to_radians(30.0f))
+                 * scaling_matrix(vec3f{2, 2, 0.5f});
+
+  auto scalar_result = std::vector<vec3f>{};
+  time_lambda(
+    [&]() {
+      for (std::size_t i = 0; i < Repetitions; ++i)
+      {
+        scalar_result = m * points;
+      }
+    },
+    describe("one at a time"));
+
+  auto batch_result = vec_soa<float, 3>{};
+  batch_result.resize(Count);
+  time_lambda(
+    [&]() {
+      for (std::size_t i = 0; i < Repetitions; ++i)
+      {
+        detail::transform_batch<detail::scalar_ops<float>>(
+          m, points_soa, batch_result, 0, Count);
+      }
+    },
+    describe("batch without SIMD"));
+
+  time_lambda(
+    [&]() {
+      for (std::size_t i = 0; i < Repetitions; ++i)
+      {
+        batch_result = m * points_soa;
+      }
+    },
+    describe_simd("batch"));
+
+  CHECK(is_equal(batch_result[Count - 1], scalar_result[Count - 1], 0.001f));
+}
+} // namespace vm
@@ -0,0 +1,470 @@
+/*
+ Copyright 2026 agent
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "vm/bbox.h"
+#include "vm/constants.h"
+#include "vm/mat.h"
+#include "vm/plane.h"
+#include "vm/ray.h"
+#include "vm/scalar.h"
+#include "vm/simd.h"
+#include "vm/util.h"
+#include "vm/vec.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace vm
+{
+/**
+ * A list of vectors stored as a structure of arrays, i.e., every component of the vectors
+ * is stored in its own contiguous array. This allows the batch functions below to process
+ * several vectors at once using SIMD instructions.
+ *
+ * @tparam T the component type
+ * @tparam S the number of components
+ */
+template <typename T, std::size_t S>
+class vec_soa
+{
+  static_assert(S > 0, "vec_soa must have at least one component");
+
+private:
+  std::array<std::vector<T>, S> m_components;
+
+public:
+  /**
+   * Creates a new empty list.
+   */
+  vec_soa() = default;
+
+  /**
+   * Creates a new list containing the given vectors.
+   *
+   * @param vecs the vectors
+   */
+  explicit vec_soa(const std::vector<vec<T, S>>& vecs)
+  {
+    reserve(vecs.size());
+    for (const auto& v : vecs)
+    {
+      push_back(v);
+    }
+  }
+
+  std::size_t size() const { return m_components[0].size(); }
+
+  bool empty() const { return m_components[0].empty(); }
+
+  void reserve(const std::size_t capacity)
+  {
+    for (auto& component : m_components)
+    {
+      component.reserve(capacity);
+    }
+  }
+
+  void resize(const std::size_t size)
+  {
+    for (auto& component : m_components)
+    {
+      component.resize(size);
+    }
+  }
+
+  void clear()
+  {
+    for (auto& component : m_components)
+    {
+      component.clear();
+    }
+  }
+
+  void push_back(const vec<T, S>& v)
+  {
+    for (std::size_t c = 0; c < S; ++c)
+    {
+      m_components[c].push_back(v[c]);
+    }
+  }
+
+  /**
+   * Returns the vector at the given index.
+   */
+  vec<T, S> operator[](const std::size_t i) const
+  {
+    assert(i < size());
+    auto result = vec<T, S>{};
+    for (std::size_t c = 0; c < S; ++c)
+    {
+      result[c] = m_components[c][i];
+    }
+    return result;
+  }
+
+  /**
+   * Replaces the vector at the given index.
+   */
+  void set(const std::size_t i, const vec<T, S>& v)
+  {
+    assert(i < size());
+    for (std::size_t c = 0; c < S; ++c)
+    {
+      m_components[c][i] = v[c];
+    }
+  }
+
+  /**
+   * Returns the array that contains the given component of all vectors.
+   */
+  const T* component(const std::size_t c) const
+  {
+    assert(c < S);
+    return m_components[c].data();
+  }
+
+  T* component(const std::size_t c)
+  {
+    assert(c < S);
+    return m_components[c].data();
+  }
+};
+
+/**
+ * A list of bounding boxes stored as a structure of arrays.
+ *
+ * @tparam T the component type
+ * @tparam S the number of components
+ */
+template <typename T, std::size_t S>
+class bbox_soa
+{
+private:
+  vec_soa<T, S> m_min;
+  vec_soa<T, S> m_max;
+
+public:
+  /**
+   * Creates a new empty list.
+   */
+  bbox_soa() = default;
+
+  /**
+   * Creates a new list containing the given boxes.
+   *
+   * @param boxes the boxes
+   */
+  explicit bbox_soa(const std::vector<bbox<T, S>>& boxes)
+  {
+    reserve(boxes.size());
+    for (const auto& b : boxes)
+    {
+      push_back(b);
+    }
+  }
+
+  std::size_t size() const { return m_min.size(); }
+
+  bool empty() const { return m_min.empty(); }
+
+  void reserve(const std::size_t capacity)
+  {
+    m_min.reserve(capacity);
+    m_max.reserve(capacity);
+  }
+
+  void clear()
+  {
+    m_min.clear();
+    m_max.clear();
+  }
+
+  void push_back(const bbox<T, S>& b)
+  {
+    m_min.push_back(b.min);
+    m_max.push_back(b.max);
+  }
+
+  /**
+   * Returns the box at the given index.
+   */
+  bbox<T, S> operator[](const std::size_t i) const { return {m_min[i], m_max[i]}; }
+
+  const vec_soa<T, S>& min() const { return m_min; }
+  const vec_soa<T, S>& max() const { return m_max; }
+};
+
+namespace detail
+{
+/*
+ * The batch kernels process the elements in [first, last) using the given ops type, see
+ * simd.h. The number of elements in that range must be a multiple of the pack width.
+ * They perform the same operations in the same order as their scalar counterparts.
+ */
+
+template <typename Ops, typename T, std::size_t S>
+void intersect_ray_bbox_batch(
+  const ray<T, S>& r,
+  const bbox_soa<T, S>& boxes,
+  T* distances,
+  const std::size_t first,
+  const std::size_t last)
+{
+  using pack = typename Ops::pack;
+  using mask = typename Ops::mask;
+
+  const auto zero = Ops::broadcast(T(0));
+  const auto minus_one = Ops::broadcast(T(-1));
+  const auto no_hit = Ops::broadcast(nan<T>());
+  const auto no_lanes = Ops::not_(Ops::all_true());
+
+  for (auto i = first; i < last; i += Ops::width)
+  {
+    pack b_min[S], b_max[S], dists[S];
+    mask inside[S];
+    auto all_inside = Ops::all_true();
+
+    // compute the candidate planes and intersect them with the ray
+    for (std::size_t c = 0; c < S; ++c)
+    {
+      const auto origin = Ops::broadcast(r.origin[c]);
+      b_min[c] = Ops::load(boxes.min().component(c) + i);
+      b_max[c] = Ops::load(boxes.max().component(c) + i);
+
+      const auto below = Ops::lt(origin, b_min[c]);
+      const auto above = Ops::gt(origin, b_max[c]);
+      inside[c] = Ops::not_(Ops::or_(below, above));
+      all_inside = Ops::and_(all_inside, inside[c]);
+
+      const auto plane = Ops::select(
+        below,
+        b_min[c],
+        Ops::select(above, b_max[c], r.direction[c] < T(0) ? b_min[c] : b_max[c]));
+      dists[c] = r.direction[c] != T(0)
+                   ? Ops::div(Ops::sub(plane, origin), Ops::broadcast(r.direction[c]))
+                   : minus_one;
+    }
+
+    // if the origin is inside, find the closest plane that was hit, otherwise find the
+    // farthest plane that was hit
+    auto dist_inside = dists[0];
+    auto dist_outside = minus_one;
+    auto found_outside = no_lanes;
+    mask best_inside[S], best_outside[S];
+    for (std::size_t c = 0; c < S; ++c)
+    {
+      const auto closer = c == 0 ? Ops::all_true() : Ops::lt(dists[c], dist_inside);
+      dist_inside = Ops::select(closer, dists[c], dist_inside);
+
+      const auto outside = Ops::not_(inside[c]);
+      const auto farther = Ops::and_(
+        outside, Ops::or_(Ops::not_(found_outside), Ops::gt(dists[c], dist_outside)));
+      dist_outside = Ops::select(farther, dists[c], dist_outside);
+      found_outside = Ops::or_(found_outside, outside);
+
+      for (std::size_t k = 0; k < c; ++k)
+      {
+        best_inside[k] = Ops::and_(best_inside[k], Ops::not_(closer));
+        best_outside[k] = Ops::and_(best_outside[k], Ops::not_(farther));
+      }
+      best_inside[c] = closer;
+      best_outside[c] = farther;
+    }
+
+    // check if the final candidate actually hits the box
+    const auto dist = Ops::select(all_inside, dist_inside, dist_outside);
+    auto miss = Ops::lt(dist, zero);
+    for (std::size_t c = 0; c < S; ++c)
+    {
+      const auto best = Ops::select(all_inside, best_inside[c], best_outside[c]);
+      const auto coord = Ops::add(
+        Ops::broadcast(r.origin[c]), Ops::mul(dist, Ops::broadcast(r.direction[c])));
+      const auto outside = Ops::or_(Ops::lt(coord, b_min[c]), Ops::gt(coord, b_max[c]));
+      miss = Ops::or_(miss, Ops::and_(Ops::not_(best), outside));
+    }
+
+    Ops::store(distances + i, Ops::select(miss, no_hit, dist));
+  }
+}
+
+template <typename Ops, typename T, std::size_t S>
+void point_status_batch(
+  const plane<T, S>& p,
+  const vec_soa<T, S>& points,
+  plane_status* result,
+  const T epsilon,
+  const std::size_t first,
+  const std::size_t last)
+{
+  const auto distance = Ops::broadcast(p.distance);
+  const auto positive_epsilon = Ops::broadcast(epsilon);
+  const auto negative_epsilon = Ops::broadcast(-epsilon);
+
+  for (auto i = first; i < last; i += Ops::width)
+  {
+    auto dot = Ops::broadcast(T(0));
+    for (std::size_t c = 0; c < S; ++c)
+    {
+      dot = Ops::add(
+        dot, Ops::mul(Ops::load(points.component(c) + i), Ops::broadcast(p.normal[c])));
+    }
+    const auto dist = Ops::sub(dot, distance);
+
+    // a point cannot be both above and below, so the last entry is never used
+    constexpr plane_status statuses[] = {
+      plane_status::inside,
+      plane_status::above,
+      plane_status::below,
+      plane_status::inside,
+    };
+
+    const auto above = Ops::bits(Ops::gt(dist, positive_epsilon));
+    const auto below = Ops::bits(Ops::lt(dist, negative_epsilon));
+    for (std::size_t l = 0; l < Ops::width; ++l)
+    {
+      result[i + l] = statuses[((above >> l) & 1u) | (((below >> l) & 1u) << 1)];
+    }
+  }
+}
+
+template <typename Ops, typename T, std::size_t S>
+void transform_batch(
+  const mat<T, S, S>& m,
+  const vec_soa<T, S - 1>& points,
+  vec_soa<T, S - 1>& result,
+  const std::size_t first,
+  const std::size_t last)
+{
+  using pack = typename Ops::pack;
+
+  for (auto i = first; i < last; i += Ops::width)
+  {
+    pack in[S - 1];
+    for (std::size_t c = 0; c < S - 1; ++c)
+    {
+      in[c] = Ops::load(points.component(c) + i);
+    }
+
+    // multiply by the matrix in homogeneous coordinates, where the last component is 1
+    pack out[S];
+    for (std::size_t r = 0; r < S; ++r)
+    {
+      out[r] = Ops::broadcast(T(0));
+      for (std::size_t c = 0; c < S - 1; ++c)
+      {
+        out[r] = Ops::add(out[r], Ops::mul(Ops::broadcast(m[c][r]), in[c]));
+      }
+      out[r] = Ops::add(out[r], Ops::broadcast(m[S - 1][r]));
+    }
+
+    // convert back to cartesian coordinates
+    for (std::size_t c = 0; c < S - 1; ++c)
+    {
+      Ops::store(result.component(c) + i, Ops::div(out[c], out[S - 1]));
+    }
+  }
+}
+
+template <typename T>
+std::size_t simd_end(const std::size_t count)
+{
+  return count - count % simd_ops<T>::width;
+}
+} // namespace detail
+
+/**
+ * Computes the distances from the origin of the given ray to its points of intersection
+ * with each of the given boxes. This is equivalent to calling intersect_ray_bbox for
+ * every box, but processes several boxes at once if SIMD instructions are available.
+ *
+ * @tparam T the component type
+ * @tparam S the number of components
+ * @param r the ray
+ * @param boxes the boxes
+ * @param distances an array of at least boxes.size() elements that receives the distance
+ * to each box, or NaN if the ray does not intersect that box
+ */
+template <typename T, std::size_t S>
+void intersect_ray_bbox(const ray<T, S>& r, const bbox_soa<T, S>& boxes, T* distances)
+{
+  const auto count = boxes.size();
+  const auto end = detail::simd_end<T>(count);
+  detail::intersect_ray_bbox_batch<detail::simd_ops<T>>(r, boxes, distances, 0, end);
+  detail::intersect_ray_bbox_batch<detail::scalar_ops<T>>(
+    r, boxes, distances, end, count);
+}
+
+/**
+ * Determines the position of each of the given points relative to the given plane. This
+ * is equivalent to calling plane::point_status for every point, but processes several
+ * points at once if SIMD instructions are available.
+ *
+ * @tparam T the component type
+ * @tparam S the number of components
+ * @param p the plane
+ * @param points the points
+ * @param result an array of at least points.size() elements that receives the status of
+ * each point
+ * @param epsilon an epsilon value (the maximum absolute distance up to which a point
+ * will be considered to be inside)
+ */
+template <typename T, std::size_t S>
+void point_status(
+  const plane<T, S>& p,
+  const vec_soa<T, S>& points,
+  plane_status* result,
+  const T epsilon = constants<T>::point_status_epsilon())
+{
+  const auto count = points.size();
+  const auto end = detail::simd_end<T>(count);
+  detail::point_status_batch<detail::simd_ops<T>>(p, points, result, epsilon, 0, end);
+  detail::point_status_batch<detail::scalar_ops<T>>(
+    p, points, result, epsilon, end, count);
+}
+
+/**
+ * Multiplies the given points with the given matrix in homogeneous coordinates. This is
+ * equivalent to multiplying every point with the given matrix, but processes several
+ * points at once if SIMD instructions are available.
+ *
+ * @tparam T the component type
+ * @tparam S the number of rows and columns of the matrix
+ * @param lhs the matrix
+ * @param rhs the points
+ * @return the products of the given matrix and the given points
+ */
+template <typename T, std::size_t S>
+vec_soa<T, S - 1> operator*(const mat<T, S, S>& lhs, const vec_soa<T, S - 1>& rhs)
+{
+  const auto count = rhs.size();
+  const auto end = detail::simd_end<T>(count);
+
+  auto result = vec_soa<T, S - 1>{};
+  result.resize(count);
+  detail::transform_batch<detail::simd_ops<T>>(lhs, rhs, result, 0, end);
+  detail::transform_batch<detail::scalar_ops<T>>(lhs, rhs, result, end, count);
+  return result;
+}
+
+} // namespace vm
@@ -0,0 +1,363 @@
+/*
+ Copyright 2026 agent
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(VM_NO_SIMD)
+#if defined(__AVX__)
+#define VM_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VM_SIMD_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define VM_SIMD_NEON
+#endif
+#endif
+
+#if defined(VM_SIMD_AVX)
+#include <immintrin.h>
+#elif defined(VM_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(VM_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * Minimal wrappers around the SIMD instruction sets used by the batch functions in
+ * batch.h. Every ops type provides the same static functions on packs of values and
+ * masks so that the batch kernels can be written once and instantiated for each
+ * instruction set. The instruction set is selected at compile time from the target
+ * architecture. Define VM_NO_SIMD to always use the scalar implementation.
+ */
+
+namespace vm::detail
+{
+/**
+ * Processes one value at a time. Used as a fallback if no instruction set is available
+ * and to process the elements that remain after the last full pack.
+ *
+ * @tparam T the component type
+ */
+template <typename T>
+struct scalar_ops
+{
+  using value_type = T;
+  using pack = T;
+  using mask = bool;
+
+  static constexpr std::size_t width = 1;
+
+  static pack load(const T* p) { return *p; }
+  static void store(T* p, const pack v) { *p = v; }
+  static pack broadcast(const T t) { return t; }
+
+  static pack add(const pack a, const pack b) { return a + b; }
+  static pack sub(const pack a, const pack b) { return a - b; }
+  static pack mul(const pack a, const pack b) { return a * b; }
+  static pack div(const pack a, const pack b) { return a / b; }
+
+  static mask lt(const pack a, const pack b) { return a < b; }
+  static mask gt(const pack a, const pack b) { return a > b; }
+
+  static mask all_true() { return true; }
+  static mask and_(const mask a, const mask b) { return a && b; }
+  static mask or_(const mask a, const mask b) { return a || b; }
+  static mask not_(const mask a) { return !a; }
+
+  static pack select(const mask m, const pack a, const pack b) { return m ? a : b; }
+  static mask select(const mask m, const mask a, const mask b) { return m ? a : b; }
+
+  /**
+   * Returns a bit mask whose i-th bit is set if the i-th lane of the given mask is set.
+   */
+  static unsigned bits(const mask m) { return m ? 1u : 0u; }
+};
+
+#if defined(VM_SIMD_AVX)
+
+template <typename T>
+struct simd_ops : scalar_ops<T>
+{
+};
+
+template <>
+struct simd_ops<float>
+{
+  using value_type = float;
+  using pack = __m256;
+  using mask = __m256;
+
+  static constexpr std::size_t width = 8;
+
+  static pack load(const float* p) { return _mm256_loadu_ps(p); }
+  static void store(float* p, const pack v) { _mm256_storeu_ps(p, v); }
+  static pack broadcast(const float t) { return _mm256_set1_ps(t); }
+
+  static pack add(const pack a, const pack b) { return _mm256_add_ps(a, b); }
+  static pack sub(const pack a, const pack b) { return _mm256_sub_ps(a, b); }
+  static pack mul(const pack a, const pack b) { return _mm256_mul_ps(a, b); }
+  static pack div(const pack a, const pack b) { return _mm256_div_ps(a, b); }
+
+  static mask lt(const pack a, const pack b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  static mask gt(const pack a, const pack b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+
+  static mask all_true() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+  static mask and_(const mask a, const mask b) { return _mm256_and_ps(a, b); }
+  static mask or_(const mask a, const mask b) { return _mm256_or_ps(a, b); }
+  static mask not_(const mask a) { return _mm256_xor_ps(a, all_true()); }
+
+  static pack select(const mask m, const pack a, const pack b)
+  {
+    return _mm256_blendv_ps(b, a, m);
+  }
+
+  static unsigned bits(const mask m) { return unsigned(_mm256_movemask_ps(m)); }
+};
+
+template <>
+struct simd_ops<double>
+{
+  using value_type = double;
+  using pack = __m256d;
+  using mask = __m256d;
+
+  static constexpr std::size_t width = 4;
+
+  static pack load(const double* p) { return _mm256_loadu_pd(p); }
+  static void store(double* p, const pack v) { _mm256_storeu_pd(p, v); }
+  static pack broadcast(const double t) { return _mm256_set1_pd(t); }
+
+  static pack add(const pack a, const pack b) { return _mm256_add_pd(a, b); }
+  static pack sub(const pack a, const pack b) { return _mm256_sub_pd(a, b); }
+  static pack mul(const pack a, const pack b) { return _mm256_mul_pd(a, b); }
+  static pack div(const pack a, const pack b) { return _mm256_div_pd(a, b); }
+
+  static mask lt(const pack a, const pack b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+  static mask gt(const pack a, const pack b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+
+  static mask all_true() { return _mm256_castsi256_pd(_mm256_set1_epi32(-1)); }
+  static mask and_(const mask a, const mask b) { return _mm256_and_pd(a, b); }
+  static mask or_(const mask a, const mask b) { return _mm256_or_pd(a, b); }
+  static mask not_(const mask a) { return _mm256_xor_pd(a, all_true()); }
+
+  static pack select(const mask m, const pack a, const pack b)
+  {
+    return _mm256_blendv_pd(b, a, m);
+  }
+
+  static unsigned bits(const mask m) { return unsigned(_mm256_movemask_pd(m)); }
+};
+
+#elif defined(VM_SIMD_SSE2)
+
+template <typename T>
+struct simd_ops : scalar_ops<T>
+{
+};
+
+template <>
+struct simd_ops<float>
+{
+  using value_type = float;
+  using pack = __m128;
+  using mask = __m128;
+
+  static constexpr std::size_t width = 4;
+
+  static pack load(const float* p) { return _mm_loadu_ps(p); }
+  static void store(float* p, const pack v) { _mm_storeu_ps(p, v); }
+  static pack broadcast(const float t) { return _mm_set1_ps(t); }
+
+  static pack add(const pack a, const pack b) { return _mm_add_ps(a, b); }
+  static pack sub(const pack a, const pack b) { return _mm_sub_ps(a, b); }
+  static pack mul(const pack a, const pack b) { return _mm_mul_ps(a, b); }
+  static pack div(const pack a, const pack b) { return _mm_div_ps(a, b); }
+
+  static mask lt(const pack a, const pack b) { return _mm_cmplt_ps(a, b); }
+  static mask gt(const pack a, const pack b) { return _mm_cmpgt_ps(a, b); }
+
+  static mask all_true() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+  static mask and_(const mask a, const mask b) { return _mm_and_ps(a, b); }
+  static mask or_(const mask a, const mask b) { return _mm_or_ps(a, b); }
+  static mask not_(const mask a) { return _mm_xor_ps(a, all_true()); }
+
+  static pack select(const mask m, const pack a, const pack b)
+  {
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+  }
+
+  static unsigned bits(const mask m) { return unsigned(_mm_movemask_ps(m)); }
+};
+
+template <>
+struct simd_ops<double>
+{
+  using value_type = double;
+  using pack = __m128d;
+  using mask = __m128d;
+
+  static constexpr std::size_t width = 2;
+
+  static pack load(const double* p) { return _mm_loadu_pd(p); }
+  static void store(double* p, const pack v) { _mm_storeu_pd(p, v); }
+  static pack broadcast(const double t) { return _mm_set1_pd(t); }
+
+  static pack add(const pack a, const pack b) { return _mm_add_pd(a, b); }
+  static pack sub(const pack a, const pack b) { return _mm_sub_pd(a, b); }
+  static pack mul(const pack a, const pack b) { return _mm_mul_pd(a, b); }
+  static pack div(const pack a, const pack b) { return _mm_div_pd(a, b); }
+
+  static mask lt(const pack a, const pack b) { return _mm_cmplt_pd(a, b); }
+  static mask gt(const pack a, const pack b) { return _mm_cmpgt_pd(a, b); }
+
+  static mask all_true() { return _mm_castsi128_pd(_mm_set1_epi32(-1)); }
+  static mask and_(const mask a, const mask b) { return _mm_and_pd(a, b); }
+  static mask or_(const mask a, const mask b) { return _mm_or_pd(a, b); }
+  static mask not_(const mask a) { return _mm_xor_pd(a, all_true()); }
+
+  static pack select(const mask m, const pack a, const pack b)
+  {
+    return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+  }
+
+  static unsigned bits(const mask m) { return unsigned(_mm_movemask_pd(m)); }
+};
+
+#elif defined(VM_SIMD_NEON)
+
+template <typename T>
+struct simd_ops : scalar_ops<T>
+{
+};
+
+template <>
+struct simd_ops<float>
+{
+  using value_type = float;
+  using pack = float32x4_t;
+  using mask = uint32x4_t;
+
+  static constexpr std::size_t width = 4;
+
+  static pack load(const float* p) { return vld1q_f32(p); }
+  static void store(float* p, const pack v) { vst1q_f32(p, v); }
+  static pack broadcast(const float t) { return vdupq_n_f32(t); }
+
+  static pack add(const pack a, const pack b) { return vaddq_f32(a, b); }
+  static pack sub(const pack a, const pack b) { return vsubq_f32(a, b); }
+  static pack mul(const pack a, const pack b) { return vmulq_f32(a, b); }
+  static pack div(const pack a, const pack b) { return vdivq_f32(a, b); }
+
+  static mask lt(const pack a, const pack b) { return vcltq_f32(a, b); }
+  static mask gt(const pack a, const pack b) { return vcgtq_f32(a, b); }
+
+  static mask all_true() { return vdupq_n_u32(~0u); }
+  static mask and_(const mask a, const mask b) { return vandq_u32(a, b); }
+  static mask or_(const mask a, const mask b) { return vorrq_u32(a, b); }
+  static mask not_(const mask a) { return vmvnq_u32(a); }
+
+  static pack select(const mask m, const pack a, const pack b)
+  {
+    return vbslq_f32(m, a, b);
+  }
+
+  static mask select(const mask m, const mask a, const mask b)
+  {
+    return vbslq_u32(m, a, b);
+  }
+
+  static unsigned bits(const mask m)
+  {
+    static const std::uint32_t weights[] = {1u, 2u, 4u, 8u};
+    return unsigned(vaddvq_u32(vandq_u32(m, vld1q_u32(weights))));
+  }
+};
+
+template <>
+struct simd_ops<double>
+{
+  using value_type = double;
+  using pack = float64x2_t;
+  using mask = uint64x2_t;
+
+  static constexpr std::size_t width = 2;
+
+  static pack load(const double* p) { return vld1q_f64(p); }
+  static void store(double* p, const pack v) { vst1q_f64(p, v); }
+  static pack broadcast(const double t) { return vdupq_n_f64(t); }
+
+  static pack add(const pack a, const pack b) { return vaddq_f64(a, b); }
+  static pack sub(const pack a, const pack b) { return vsubq_f64(a, b); }
+  static pack mul(const pack a, const pack b) { return vmulq_f64(a, b); }
+  static pack div(const pack a, const pack b) { return vdivq_f64(a, b); }
+
+  static mask lt(const pack a, const pack b) { return vcltq_f64(a, b); }
+  static mask gt(const pack a, const pack b) { return vcgtq_f64(a, b); }
+
+  static mask all_true() { return vdupq_n_u64(~std::uint64_t(0)); }
+  static mask and_(const mask a, const mask b) { return vandq_u64(a, b); }
+  static mask or_(const mask a, const mask b) { return vorrq_u64(a, b); }
+  static mask not_(const mask a) { return veorq_u64(a, all_true()); }
+
+  static pack select(const mask m, const pack a, const pack b)
+  {
+    return vbslq_f64(m, a, b);
+  }
+
+  static mask select(const mask m, const mask a, const mask b)
+  {
+    return vbslq_u64(m, a, b);
+  }
+
+  static unsigned bits(const mask m)
+  {
+    static const std::uint64_t weights[] = {1u, 2u};
+    return unsigned(vaddvq_u64(vandq_u64(m, vld1q_u64(weights))));
+  }
+};
+
+#else
+
+template <typename T>
+struct simd_ops : scalar_ops<T>
+{
+};
+
+#endif
+
+/**
+ * Returns the name of the instruction set used by simd_ops.
+ */
+constexpr const char* simd_instruction_set()
+{
+#if defined(VM_SIMD_AVX)
+  return "AVX";
+#elif defined(VM_SIMD_SSE2)
+  return "SSE2";
+#elif defined(VM_SIMD_NEON)
+  return "NEON";
+#else
+  return "none";
+#endif
+}
+
+} // namespace vm::detail
@@ -0,0 +1,292 @@
+/*
+ Copyright 2026 agent
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "vm/batch.h"
+#include "vm/bbox.h"
+#include "vm/bbox_io.h"
+#include "vm/forward.h"
+#include "vm/intersection.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/mat_io.h"
+#include "vm/plane.h"
+#include "vm/ray.h"
+#include "vm/ray_io.h"
+#include "vm/scalar.h"
+#include "vm/vec.h"
+#include "vm/vec_io.h"
+
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace vm
+{
+namespace
+{
+// not a multiple of any SIMD width so that the scalar tail is processed, too
+constexpr std::size_t Count = 1003;
+
+template <typename T>
+std::vector<vec<T, 3>> make_points(std::mt19937& rng, const std::size_t count)
+{
+  auto dist = std::uniform_real_distribution<T>{T(-10), T(10)};
+
+  auto result = std::vector<vec<T, 3>>{};
+  result.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    result.emplace_back(dist(rng), dist(rng), dist(rng));
+  }
+  return result;
+}
+
+template <typename T>
+std::vector<bbox<T, 3>> make_boxes(std::mt19937& rng, const std::size_t count)
+{
+  auto size_dist = std::uniform_real_distribution<T>{T(0), T(4)};
+
+  auto result = std::vector<bbox<T, 3>>{};
+  result.reserve(count);
+  for (const auto& center : make_points<T>(rng, count))
+  {
+    const auto size = vec<T, 3>{size_dist(rng), size_dist(rng), size_dist(rng)};
+    result.emplace_back(center - size, center + size);
+  }
+  return result;
+}
+
+template <typename T>
+std::vector<ray<T, 3>> make_rays(const std::vector<bbox<T, 3>>& boxes)
+{
+  return {
+    ray<T, 3>{vec<T, 3>{T(-20), T(-20), T(-20)}, normalize(vec<T, 3>{T(1), T(1), T(1)})},
+    ray<T, 3>{vec<T, 3>{T(0), T(0), T(-20)}, vec<T, 3>::pos_z()},
+    ray<T, 3>{vec<T, 3>{T(3), T(-1), T(20)}, vec<T, 3>::neg_z()},
+    ray<T, 3>{vec<T, 3>{T(0), T(1), T(0)}, normalize(vec<T, 3>{T(1), T(-2), T(0)})},
+    // starts inside a box
+    ray<T, 3>{boxes.front().center(), normalize(vec<T, 3>{T(-1), T(2), T(3)})},
+  };
+}
+
+template <typename T, typename F>
+void check_intersect_ray_bbox(const F& intersect)
+{
+  auto rng = std::mt19937{};
+  const auto boxes = make_boxes<T>(rng, Count);
+  const auto boxes_soa = bbox_soa<T, 3>{boxes};
+  REQUIRE(boxes_soa.size() == Count);
+
+  auto hits = std::size_t(0);
+  for (const auto& r : make_rays(boxes))
+  {
+    auto distances = std::vector<T>(Count);
+    intersect(r, boxes_soa, distances.data());
+
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+      CAPTURE(r, boxes[i]);
+
+      if (const auto expected = intersect_ray_bbox(r, boxes[i]))
+      {
+        CHECK(distances[i] == Approx(*expected));
+        ++hits;
+      }
+      else
+      {
+        CHECK(is_nan(distances[i]));
+      }
+    }
+  }
+
+  CHECK(hits > 0u);
+}
+
+template <typename T, typename F>
+void check_point_status(const F& status)
+{
+  auto rng = std::mt19937{};
+  const auto p = plane<T, 3>{T(2), normalize(vec<T, 3>{T(1), T(-2), T(3)})};
+
+  auto points = make_points<T>(rng, Count);
+  // move every third point onto the plane
+  for (std::size_t i = 0; i < points.size(); i += 3)
+  {
+    points[i] = p.project_point(points[i]);
+  }
+
+  auto result = std::vector<plane_status>(Count);
+  status(p, vec_soa<T, 3>{points}, result.data());
+
+  for (std::size_t i = 0; i < Count; ++i)
+  {
+    CAPTURE(points[i]);
+    CHECK(result[i] == p.point_status(points[i]));
+  }
+}
+
+template <typename T, typename F>
+void check_transform(const F& transform)
+{
+  auto rng = std::mt19937{};
+  const auto points = make_points<T>(rng, Count);
+  const auto points_soa = vec_soa<T, 3>{points};
+
+  const auto matrices = std::vector<mat<T, 4, 4>>{
+    mat<T, 4, 4>::identity(),
+    translation_matrix(vec<T, 3>{T(1), T(2), T(3)})
+      * rotation_matrix(vec<T, 3>::pos_z(), to_radians(T(30)))
+      * scaling_matrix(vec<T, 3>{T(2), T(2), T(0.5)}),
+    perspective_matrix(T(90), T(1), T(100), 800, 600),
+  };
+
+  for (const auto& m : matrices)
+  {
+    const auto result = transform(m, points_soa);
+    REQUIRE(result.size() == Count);
+
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+      const auto expected = m * points[i];
+      CAPTURE(m, points[i], expected, result[i]);
+      const auto epsilon = T(0.0001) * (T(1) + abs(get_abs_max_component(expected)));
+      CHECK(is_equal(result[i], expected, epsilon));
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("batch.vec_soa")
+{
+  const auto vecs = std::vector<vec3f>{{1, 2, 3}, {4, 5, 6}};
+
+  auto soa = vec_soa<float, 3>{vecs};
+  CHECK(soa.size() == 2u);
+  CHECK(soa[0] == vecs[0]);
+  CHECK(soa[1] == vecs[1]);
+  CHECK(soa.component(1)[0] == 2.0f);
+  CHECK(soa.component(1)[1] == 5.0f);
+
+  soa.set(1, vec3f{7, 8, 9});
+  soa.push_back(vec3f{10, 11, 12});
+  CHECK(soa.size() == 3u);
+  CHECK(soa[1] == vec3f{7, 8, 9});
+  CHECK(soa[2] == vec3f{10, 11, 12});
+
+  soa.clear();
+  CHECK(soa.empty());
+}
+
+TEST_CASE("batch.bbox_soa")
+{
+  const auto boxes = std::vector<bbox3f>{
+    {{-1, -2, -3}, {1, 2, 3}},
+    {{4, 5, 6}, {7, 8, 9}},
+  };
+
+  const auto soa = bbox_soa<float, 3>{boxes};
+  CHECK(soa.size() == 2u);
+  CHECK(soa[0] == boxes[0]);
+  CHECK(soa[1] == boxes[1]);
+  CHECK(soa.min()[1] == vec3f{4, 5, 6});
+  CHECK(soa.max()[1] == vec3f{7, 8, 9});
+}
+
+TEST_CASE("batch.intersect_ray_bbox")
+{
+  SECTION("float")
+  {
+    check_intersect_ray_bbox<float>(
+      [](const auto& r, const auto& boxes, auto* distances) {
+        intersect_ray_bbox(r, boxes, distances);
+      });
+  }
+
+  SECTION("double")
+  {
+    check_intersect_ray_bbox<double>(
+      [](const auto& r, const auto& boxes, auto* distances) {
+        intersect_ray_bbox(r, boxes, distances);
+      });
+  }
+
+  SECTION("scalar")
+  {
+    check_intersect_ray_bbox<float>(
+      [](const auto& r, const auto& boxes, auto* distances) {
+        detail::intersect_ray_bbox_batch<detail::scalar_ops<float>>(
+          r, boxes, distances, 0, boxes.size());
+      });
+  }
+}
+
+TEST_CASE("batch.point_status")
+{
+  SECTION("float")
+  {
+    check_point_status<float>([](const auto& p, const auto& points, auto* result) {
+      point_status(p, points, result);
+    });
+  }
+
+  SECTION("double")
+  {
+    check_point_status<double>([](const auto& p, const auto& points, auto* result) {
+      point_status(p, points, result);
+    });
+  }
+
+  SECTION("scalar")
+  {
+    check_point_status<float>([](const auto& p, const auto& points, auto* result) {
+      detail::point_status_batch<detail::scalar_ops<float>>(
+        p, points, result, constants<float>::point_status_epsilon(), 0, points.size());
+    });
+  }
+}
+
+TEST_CASE("batch.transform")
+{
+  SECTION("float")
+  {
+    check_transform<float>([](const auto& m, const auto& points) { return m * points; });
+  }
+
+  SECTION("double")
+  {
+    check_transform<double>([](const auto& m, const auto& points) { return m * points; });
+  }
+
+  SECTION("scalar")
+  {
+    check_transform<float>([](const auto& m, const auto& points) {
+      auto result = vec_soa<float, 3>{};
+      result.resize(points.size());
+      detail::transform_batch<detail::scalar_ops<float>>(
+        m, points, result, 0, points.size());
+      return result;
+    });
+  }
+}
+} // namespace vm